@@ -37,6 +37,7 @@ SET(EMBREE_TASKING_SYSTEM @EMBREE_TASKING_SYSTEM@)
 SET(EMBREE_GEOMETRY_TRIANGLES @EMBREE_GEOMETRY_TRIANGLES@)
 SET(EMBREE_GEOMETRY_QUADS @EMBREE_GEOMETRY_QUADS@)
 SET(EMBREE_GEOMETRY_LINES @EMBREE_GEOMETRY_LINES@)
+SET(EMBREE_GEOMETRY_POINTS @EMBREE_GEOMETRY_POINTS@)
 SET(EMBREE_GEOMETRY_HAIR @EMBREE_GEOMETRY_HAIR@)
 SET(EMBREE_GEOMETRY_SUBDIV @EMBREE_GEOMETRY_SUBDIV@)
 SET(EMBREE_GEOMETRY_USER @EMBREE_GEOMETRY_USER@)
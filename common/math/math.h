@@ -48,6 +48,31 @@ namespace embree
     union { float f; int i; } v; v.i = i; return v.f;
   }
 
+  /*! converts a 16 bit half precision float to a float */
+  __forceinline float half_to_float(unsigned short h)
+  {
+    const unsigned sign = (unsigned(h) & 0x8000) << 16;
+    const unsigned exp  = (unsigned(h) >> 10) & 0x1F;
+    const unsigned mant = unsigned(h) & 0x3FF;
+    if (exp == 0x1F) return cast_i2f(sign | 0x7F800000 | (mant << 13)); // inf and nan
+    if (exp != 0) return cast_i2f(sign | ((exp+112) << 23) | (mant << 13));
+    const float f = float(mant)*(1.0f/16777216.0f); // denormals
+    return sign ? -f : f;
+  }
+
+  /*! converts a float to a 16 bit half precision float, rounds to nearest and flushes denormals to zero */
+  __forceinline unsigned short float_to_half(float f)
+  {
+    const unsigned i = unsigned(cast_f2i(f));
+    const unsigned sign = (i >> 16) & 0x8000;
+    const int exp = int((i >> 23) & 0xFF) - 112;
+    const unsigned mant = i & 0x7FFFFF;
+    if (exp >= 0x1F) return (unsigned short)(sign | 0x7C00 | ((exp == 0x8F && mant) ? 0x200 : 0)); // overflow, inf, and nan
+    if (exp <= 0) return (unsigned short) sign;
+    const unsigned h = (unsigned(exp) << 10) + ((mant + 0x1000) >> 13); // rounding may carry into the exponent
+    return (unsigned short)(sign | (h < 0x7C00 ? h : 0x7C00));
+  }
+
 #if defined(__WIN32__)
   __forceinline bool finite ( const float x ) { return _finite(x) != 0; }
 #endif
@@ -668,6 +668,10 @@ namespace embree
     return v;
   }
 
+  __forceinline vfloat16 gather16f(const vboolf16& mask, const float *const ptr, const vint16& index, const int scale = 4) {
+    return _mm512_mask_i32gather_ps(_mm512_setzero_ps(),mask,index,ptr,scale);
+  }
+
   __forceinline vfloat16 gather_4f_zlc(const vint16 &v_mask,
                                        const void *__restrict__ const ptr0,
                                        const void *__restrict__ const ptr1,
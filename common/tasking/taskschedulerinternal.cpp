@@ -78,23 +78,64 @@ namespace embree
       parent->add_dependencies(-1);
   }
 
+  __dllexport TaskScheduler::TaskQueue::TaskQueue ()
+    : left(0), right(0), stackPtr(0) 
+  {
+    for (size_t i=0; i<MAX_TASK_BLOCKS; i++)
+      taskBlocks[i].store(nullptr);
+    for (size_t i=0; i<MAX_CLOSURE_BLOCKS; i++)
+      closureBlocks[i] = nullptr;
+
+    allocTaskBlock(0);
+    allocClosureBlock(0);
+  }
+
+  __dllexport TaskScheduler::TaskQueue::~TaskQueue ()
+  {
+    for (size_t i=0; i<MAX_TASK_BLOCKS; i++)
+      alignedFree(taskBlocks[i].load());
+    for (size_t i=0; i<MAX_CLOSURE_BLOCKS; i++)
+      alignedFree(closureBlocks[i]);
+  }
+
+  __dllexport void TaskScheduler::TaskQueue::allocTaskBlock(size_t block)
+  {
+    if (block >= MAX_TASK_BLOCKS)
+      THROW_RUNTIME_ERROR("task stack overflow");
+
+    Task* tasks = (Task*) alignedMalloc(TASK_BLOCK_SIZE*sizeof(Task),64);
+    for (size_t i=0; i<TASK_BLOCK_SIZE; i++)
+      new (&tasks[i]) Task;
+
+    /* publish the block before the task stack grows into it */
+    taskBlocks[block].store(tasks);
+  }
+
+  __dllexport void TaskScheduler::TaskQueue::allocClosureBlock(size_t block)
+  {
+    if (block >= MAX_CLOSURE_BLOCKS)
+      THROW_RUNTIME_ERROR("closure stack overflow");
+
+    closureBlocks[block] = (char*) alignedMalloc(CLOSURE_BLOCK_SIZE,64);
+  }
+
   __dllexport bool TaskScheduler::TaskQueue::execute_local(Thread& thread, Task* parent)
   {
     /* stop if we run out of local tasks or reach the waiting task */
-    if (right == 0 || &tasks[right-1] == parent)
+    if (right == 0 || &task(right-1) == parent)
       return false;
     
     /* execute task */
     size_t oldRight = right;
-    tasks[right-1].run(thread);
+    task(right-1).run(thread);
     if (right != oldRight) {
       THROW_RUNTIME_ERROR("you have to wait for spawned subtasks");
     }
     
     /* pop task and closure from stack */
     right--;
-    if (tasks[right].stackPtr != size_t(-1))
-      stackPtr = tasks[right].stackPtr;
+    if (task(right).stackPtr != size_t(-1))
+      stackPtr = task(right).stackPtr;
     
     /* also move left pointer */
     if (left >= right) left.store(right.load());
@@ -104,13 +145,16 @@ namespace embree
   
   bool TaskScheduler::TaskQueue::steal(Thread& thread) 
   {
+    /* claim the leftmost task, a thread that loses the race simply
+     * fails instead of skipping over the claimed task */
     size_t l = left;
-    if (l < right) 
-      l = left++;
-    else 
+    if (l >= right) 
       return false;
-    
-    if (!tasks[l].try_steal(thread.tasks.tasks[thread.tasks.right]))
+    if (!left.compare_exchange_strong(l,l+1))
+      return false;
+
+    /* the owning thread may already execute the claimed task */
+    if (!task(l).try_steal(thread.tasks.reserve()))
       return false;
     
     thread.tasks.right++;
@@ -120,8 +164,9 @@ namespace embree
   /* we steal from the left */
   size_t TaskScheduler::TaskQueue::getTaskSizeAtLeft() 
   {	
-    if (left >= right) return 0;
-    return tasks[left].N;
+    const size_t l = left;
+    if (l >= right) return 0;
+    return task(l).N;
   }
 
   static MutexSys g_mutex;
@@ -136,7 +181,7 @@ namespace embree
   }
 
   TaskScheduler::ThreadPool::ThreadPool(bool set_affinity)
-    : numThreads(0), numThreadsRunning(0), set_affinity(set_affinity), running(false) {}
+    : numThreads(0), numThreadsRunning(0), set_affinity(set_affinity), running(false), maxPriority(std::numeric_limits<int>::min()) {}
 
   __dllexport void TaskScheduler::ThreadPool::startThreads()
   {
@@ -194,20 +239,38 @@ namespace embree
   __dllexport void TaskScheduler::ThreadPool::add(const Ref<TaskScheduler>& scheduler)
   {
     mutex.lock();
-    schedulers.push_back(scheduler);
+    /* insert behind all schedulers of the same or higher priority */
+    std::list<Ref<TaskScheduler> >::iterator it = schedulers.begin();
+    while (it != schedulers.end() && (*it)->priority >= scheduler->priority) it++;
+    schedulers.insert(it,scheduler);
+    updateMaxPriority();
     mutex.unlock();
     condition.notify_all();
   }
 
   __dllexport void TaskScheduler::ThreadPool::remove(const Ref<TaskScheduler>& scheduler)
   {
-    Lock<MutexSys> lock(mutex);
+    mutex.lock();
     for (std::list<Ref<TaskScheduler> >::iterator it = schedulers.begin(); it != schedulers.end(); it++) {
       if (scheduler == *it) {
         schedulers.erase(it);
-        return;
+        updateMaxPriority();
+        break;
       }
     }
+    mutex.unlock();
+    condition.notify_all();
+  }
+
+  void TaskScheduler::ThreadPool::updateMaxPriority() 
+  {
+    if (schedulers.empty()) maxPriority = std::numeric_limits<int>::min();
+    else                    maxPriority = schedulers.front()->priority.load();
+  }
+
+  bool TaskScheduler::ThreadPool::hasWork() const {
+    /* a scheduler without running tasks got finished and is about to get removed */
+    return !schedulers.empty() && schedulers.front()->anyTasksRunning > 0;
   }
 
   void TaskScheduler::ThreadPool::thread_loop(size_t globalThreadIndex)
@@ -218,17 +281,32 @@ namespace embree
       ssize_t threadIndex = -1;
       {
         Lock<MutexSys> lock(mutex);
-        condition.wait(mutex, [&] () { return globalThreadIndex >= numThreadsRunning || !schedulers.empty(); });
+        condition.wait(mutex, [&] () { return globalThreadIndex >= numThreadsRunning || hasWork(); });
         if (globalThreadIndex >= numThreadsRunning) break;
         scheduler = schedulers.front();
         threadIndex = scheduler->allocThreadIndex();
       }
-      scheduler->thread_loop(threadIndex);
+      scheduler->thread_loop(threadIndex,this);
+    }
+  }
+
+  void TaskScheduler::ThreadPool::join_higher_priority(int priority)
+  {
+    Ref<TaskScheduler> scheduler = NULL;
+    ssize_t threadIndex = -1;
+    {
+      /* sleep while the scheduler of higher priority finishes, instead of re-entering it until it got removed */
+      Lock<MutexSys> lock(mutex);
+      condition.wait(mutex, [&] () { return schedulers.empty() || schedulers.front()->priority <= priority || hasWork(); });
+      if (schedulers.empty() || schedulers.front()->priority <= priority) return;
+      scheduler = schedulers.front();
+      threadIndex = scheduler->allocThreadIndex();
     }
+    scheduler->thread_loop(threadIndex,this);
   }
   
   TaskScheduler::TaskScheduler()
-    : threadCounter(0), anyTasksRunning(0), hasRootTask(false) 
+    : threadCounter(0), anyTasksRunning(0), hasRootTask(false), priority(0)
   {
     threadLocal.resize(2*getNumberOfLogicalThreads()); // FIXME: this has to be 2x as in the join mode the worker threads also join
     for (size_t i=0; i<threadLocal.size(); i++)
@@ -316,7 +394,7 @@ namespace embree
     return thread->scheduler->cancellingException == nullptr;
   }
 
-  std::exception_ptr TaskScheduler::thread_loop(size_t threadIndex)
+  std::exception_ptr TaskScheduler::thread_loop(size_t threadIndex, ThreadPool* pool)
   {
     /* allocate thread structure */
     std::unique_ptr<Thread> mthread(new Thread(threadIndex,this)); // too large for stack allocation
@@ -327,13 +405,18 @@ namespace embree
     /* main thread loop */
     while (anyTasksRunning)
     {
+      /* threads of the pool only look for work while no scheduler of higher priority exists */
       steal_loop(thread,
-                 [&] () { return anyTasksRunning > 0; },
+                 [&] () { return anyTasksRunning > 0 && !(pool && pool->preempts(priority)); },
                  [&] () { 
                    anyTasksRunning++;
                    while (thread.tasks.execute_local(thread,nullptr));
                    anyTasksRunning--;
                  });
+
+      /* our local task stack is empty here, thus we can help the other scheduler and return later */
+      if (pool && pool->preempts(priority))
+        pool->join_higher_priority(priority);
     }
     threadLocal[threadIndex].store(nullptr);
     swapThread(oldThread);
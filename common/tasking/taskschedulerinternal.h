@@ -53,8 +53,10 @@ namespace embree
     ALIGNED_STRUCT;
     friend class Device;
 
-    static const size_t TASK_STACK_SIZE = 2*1024;           //!< task structure stack, FIXME: gcc-baxsed run throws assertion
-    static const size_t CLOSURE_STACK_SIZE = 256*1024;    //!< stack for task closures
+    static const size_t TASK_BLOCK_SIZE = 256;             //!< number of tasks per block of the task stack
+    static const size_t MAX_TASK_BLOCKS = 256;             //!< maximal number of blocks of the task stack
+    static const size_t CLOSURE_BLOCK_SIZE = 64*1024;      //!< bytes per block of the closure stack
+    static const size_t MAX_CLOSURE_BLOCKS = 256;          //!< maximal number of blocks of the closure stack
 
     struct Thread;
     
@@ -156,26 +158,54 @@ namespace embree
       size_t N;                          //!< approximative size of task
     };
 
+    /*! Work stealing deque. The owning thread pushes and pops tasks
+     *  on the right and pulls the left index back when the stack
+     *  shrinks below it, other threads claim tasks on the left with a
+     *  compare and swap. The task state decides whether the owner or a
+     *  thief runs a task. Tasks and closures are stored in blocks that
+     *  get allocated on demand and never move, as parent pointers and
+     *  stolen closures reference them directly. */
     struct TaskQueue
     {
-      TaskQueue ()
-      : left(0), right(0), stackPtr(0) {}
-      
-      __forceinline void* alloc(size_t bytes, size_t align = 64) {
-        stackPtr += bytes + ((align - stackPtr) & (align-1));
-        assert(stackPtr <= CLOSURE_STACK_SIZE);
-        return &stack[stackPtr-bytes];
+      __dllexport TaskQueue ();
+      __dllexport ~TaskQueue ();
+
+      /*! returns the task at the specified position of the task stack */
+      __forceinline Task& task(size_t i) {
+        return taskBlocks[i/TASK_BLOCK_SIZE].load()[i%TASK_BLOCK_SIZE];
+      }
+
+      /*! returns the next free task slot, only called by the owning thread */
+      __forceinline Task& reserve() 
+      {
+        const size_t block = right/TASK_BLOCK_SIZE;
+        if (unlikely(taskBlocks[block].load() == nullptr)) allocTaskBlock(block);
+        return task(right);
+      }
+
+      __forceinline void* alloc(size_t bytes, size_t align = 64) 
+      {
+        assert(bytes <= CLOSURE_BLOCK_SIZE);
+        size_t ofs = stackPtr + ((align - stackPtr) & (align-1));
+
+        /* a closure never crosses the boundary of two closure blocks */
+        if (unlikely(ofs/CLOSURE_BLOCK_SIZE != (ofs+bytes-1)/CLOSURE_BLOCK_SIZE))
+          ofs = (ofs/CLOSURE_BLOCK_SIZE+1)*CLOSURE_BLOCK_SIZE;
+
+        const size_t block = ofs/CLOSURE_BLOCK_SIZE;
+        if (unlikely(closureBlocks[block] == nullptr)) allocClosureBlock(block);
+        stackPtr = ofs+bytes;
+        return &closureBlocks[block][ofs%CLOSURE_BLOCK_SIZE];
       }
       
       template<typename Closure>
       __forceinline void push_right(Thread& thread, const size_t size, const Closure& closure) 
       {
-        assert(right < TASK_STACK_SIZE);
-        
 	/* allocate new task on right side of stack */
         size_t oldStackPtr = stackPtr;
         TaskFunction* func = new (alloc(sizeof(ClosureTaskFunction<Closure>))) ClosureTaskFunction<Closure>(closure);
-        new (&tasks[right++]) Task(func,thread.task,oldStackPtr,size);
+        new (&reserve()) Task(func,thread.task,oldStackPtr,size);
+        right++;
 
 	/* also move left pointer */
 	if (left >= right-1) left = right-1;
@@ -187,15 +217,19 @@ namespace embree
 
       bool empty() { return right == 0; }
 
+    private:
+      __dllexport void allocTaskBlock(size_t block);
+      __dllexport void allocClosureBlock(size_t block);
+
     public:
 
       /* task stack */
-      Task tasks[TASK_STACK_SIZE];
+      std::atomic<Task*> taskBlocks[MAX_TASK_BLOCKS];
       __aligned(64) std::atomic<size_t> left;   //!< threads steal from left
       __aligned(64) std::atomic<size_t> right;  //!< new tasks are added to the right
       
       /* closure stack */
-      __aligned(64) char stack[CLOSURE_STACK_SIZE];
+      __aligned(64) char* closureBlocks[MAX_CLOSURE_BLOCKS];
       size_t stackPtr;
     };
     
@@ -240,6 +274,12 @@ namespace embree
 
       /*! main loop for all threads */
       void thread_loop(size_t threadIndex);
+
+      /*! returns true if some scheduler has a higher priority than the specified one */
+      __forceinline bool preempts(int priority) const { return maxPriority > priority; }
+
+      /*! lets the calling worker thread help the scheduler with the highest priority if that is higher than the specified one */
+      void join_higher_priority(int priority);
       
     private:
       std::atomic<size_t> numThreads;
@@ -248,10 +288,17 @@ namespace embree
       std::atomic<bool> running;
       std::vector<thread_t> threads;
 
+    private:
+      void updateMaxPriority();
+
+      /*! returns true if the scheduler of highest priority has running tasks, has to get called with the mutex locked */
+      bool hasWork() const;
+
     private:
       MutexSys mutex;
       ConditionSys condition;
-      std::list<Ref<TaskScheduler> > schedulers;
+      std::list<Ref<TaskScheduler> > schedulers; //!< schedulers sorted by decreasing priority
+      std::atomic<int> maxPriority;              //!< highest priority of all schedulers
     };
 
     TaskScheduler ();
@@ -273,8 +320,11 @@ namespace embree
     /*! wait for some number of threads available (threadCount includes main thread) */
     void wait_for_threads(size_t threadCount);
 
-    /*! thread loop for all worker threads */
-    std::exception_ptr thread_loop(size_t threadIndex);
+    /*! thread loop for all worker threads, threads of the pool leave for schedulers of higher priority */
+    std::exception_ptr thread_loop(size_t threadIndex, ThreadPool* pool = nullptr);
+
+    /*! sets the priority of this scheduler, worker threads prefer schedulers of higher priority */
+    void setPriority(int priority) { this->priority = priority; }
 
     /*! steals a task from a different thread */
     bool steal_from_other_threads(Thread& thread);
@@ -391,6 +441,7 @@ namespace embree
     std::atomic<size_t> threadCounter;
     std::atomic<size_t> anyTasksRunning;
     std::atomic<bool> hasRootTask;
+    std::atomic<int> priority;
     std::exception_ptr cancellingException;
     MutexSys mutex;
     ConditionSys condition;
@@ -168,6 +168,7 @@ enum RTCParameter {
   RTC_CONFIG_HAIR_GEOMETRY = 20,              //!< checks if hair geometries are supported
   RTC_CONFIG_SUBDIV_GEOMETRY = 21,           //!< checks if subdiv geometries are supported
   RTC_CONFIG_USER_GEOMETRY = 22,             //!< checks if user geometries are supported
+  RTC_CONFIG_POINT_GEOMETRY = 23,            //!< checks if point geometries are supported
 };
 
 /*! \brief Configures some parameters. 
@@ -248,6 +249,7 @@ RTCORE_API RTCORE_DEPRECATED void rtcDebug(); // FIXME: remove
 #include "rtcore_scene.h"
 #include "rtcore_geometry.h"
 #include "rtcore_geometry_user.h"
+#include "rtcore_builder.h"
 
 /*! \brief Helper to easily combing scene flags */
 inline RTCSceneFlags operator|(const RTCSceneFlags a, const RTCSceneFlags b) {
@@ -0,0 +1,155 @@
+// ======================================================================== //
+// Copyright 2009-2016 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#ifndef __RTCORE_BUILDER_H__
+#define __RTCORE_BUILDER_H__
+
+/*! \ingroup embree_kernel_api */
+/*! \{ */
+
+/*! \brief Defines an opaque BVH type */
+typedef struct __RTCBVH {}* RTCBVH;
+
+/*! \brief Defines an opaque thread local allocator type */
+typedef struct __RTCThreadLocalAllocator {}* RTCThreadLocalAllocator;
+
+/*! maximal number of primitives passed to the create leaf function */
+#define RTC_BUILD_MAX_PRIMITIVES_PER_LEAF 32
+
+/*! Primitive reference passed to the BVH builder. The builder only
+ *  looks at the bounds, geomID and primID are passed through
+ *  unmodified to the leaf creation function. Spatial split builds
+ *  require the geomID to be smaller than 2^24. */
+struct RTCORE_ALIGN(32) RTCBuildPrimitive
+{
+  float lower_x, lower_y, lower_z;
+  int geomID;
+  float upper_x, upper_y, upper_z;
+  int primID;
+};
+
+/*! Quality of the BVH to build. */
+enum RTCBuildQuality
+{
+  RTC_BUILD_QUALITY_LOW    = 0,  //!< build low quality BVH using the morton builder
+  RTC_BUILD_QUALITY_MEDIUM = 1,  //!< build medium quality BVH using the binned SAH builder
+  RTC_BUILD_QUALITY_HIGH   = 2   //!< build high quality BVH using the SAH builder with spatial splits
+};
+
+/*! Settings for the BVH builder. */
+struct RTCBuildSettings
+{
+  unsigned size;                 //!< size of this structure in bytes
+  RTCBuildQuality quality;       //!< quality of BVH build
+  unsigned maxBranchingFactor;   //!< maximal branching factor of BVH to build
+  unsigned maxDepth;             //!< maximal depth of BVH to build
+  unsigned sahBlockSize;         //!< block size for SAH heuristic, has to be a power of 2
+  unsigned minLeafSize;          //!< minimal size of a leaf
+  unsigned maxLeafSize;          //!< maximal size of a leaf
+  float travCost;                //!< estimated cost of one traversal step
+  float intCost;                 //!< estimated cost of one primitive intersection
+  unsigned extraSpace;           //!< number of unused primitive slots at the end of the primitive array that spatial splits may use
+};
+
+/*! Returns the default build settings. */
+inline RTCBuildSettings rtcDefaultBuildSettings()
+{
+  RTCBuildSettings settings;
+  settings.size = sizeof(settings);
+  settings.quality = RTC_BUILD_QUALITY_MEDIUM;
+  settings.maxBranchingFactor = 2;
+  settings.maxDepth = 32;
+  settings.sahBlockSize = 1;
+  settings.minLeafSize = 1;
+  settings.maxLeafSize = 32;
+  settings.travCost = 1.0f;
+  settings.intCost = 1.0f;
+  settings.extraSpace = 0;
+  return settings;
+}
+
+/*! Callback to create a node with the specified number of children. */
+typedef void* (*RTCCreateNodeFunc) (RTCThreadLocalAllocator allocator, /*!< thread local allocator to allocate the node with */
+                                    size_t numChildren,                /*!< number of children of the node */
+                                    void* userPtr                      /*!< user pointer passed to rtcBuildBVH */);
+
+/*! Callback to set the pointers to all children of a node. */
+typedef void  (*RTCSetNodeChildrenFunc) (void* nodePtr,        /*!< node created by the create node callback */
+                                         void** children,      /*!< children of the node */
+                                         size_t numChildren,   /*!< number of children */
+                                         void* userPtr         /*!< user pointer passed to rtcBuildBVH */);
+
+/*! Callback to set the bounds of all children of a node. */
+typedef void  (*RTCSetNodeBoundsFunc) (void* nodePtr,           /*!< node created by the create node callback */
+                                       const RTCBounds** bounds, /*!< bounds of the children of the node */
+                                       size_t numChildren,      /*!< number of children */
+                                       void* userPtr            /*!< user pointer passed to rtcBuildBVH */);
+
+/*! Callback to create a leaf node. */
+typedef void* (*RTCCreateLeafFunc) (RTCThreadLocalAllocator allocator,   /*!< thread local allocator to allocate the leaf with */
+                                    const RTCBuildPrimitive* primitives, /*!< primitives of the leaf */
+                                    size_t numPrimitives,                /*!< number of primitives of the leaf */
+                                    void* userPtr                        /*!< user pointer passed to rtcBuildBVH */);
+
+/*! Callback to split a primitive into two sub-primitives at the
+ *  specified position along the specified dimension. Only invoked for
+ *  RTC_BUILD_QUALITY_HIGH. */
+typedef void  (*RTCSplitPrimitiveFunc) (const RTCBuildPrimitive* primitive, /*!< primitive to split */
+                                        unsigned dimension,                 /*!< dimension to split along */
+                                        float position,                     /*!< position to split at */
+                                        RTCBounds* leftBounds,              /*!< returns bounds of the left part */
+                                        RTCBounds* rightBounds,             /*!< returns bounds of the right part */
+                                        void* userPtr                       /*!< user pointer passed to rtcBuildBVH */);
+
+/*! Callback to report build progress. */
+typedef void  (*RTCBuildProgressFunc) (size_t dn,    /*!< number of primitives processed since the last call */
+                                       void* userPtr /*!< user pointer passed to rtcBuildBVH */);
+
+/*! Creates a new BVH object that owns the memory of all nodes and
+ *  leaves allocated through the thread local allocators passed to
+ *  the callbacks. */
+RTCORE_API RTCBVH rtcNewBVH(RTCDevice device);
+
+/*! Builds a BVH over the specified primitives and returns the root
+ *  created by the callbacks. The builder reorders the primitive array
+ *  in place. All memory of a previous build of the same BVH object is
+ *  reused, thus nodes of a previous build become invalid. The split
+ *  primitive function is only required for RTC_BUILD_QUALITY_HIGH. */
+RTCORE_API void* rtcBuildBVH(RTCBVH bvh,                              /*!< BVH to build */
+                             const RTCBuildSettings& settings,        /*!< settings for BVH builder */
+                             RTCBuildPrimitive* primitives,           /*!< list of input primitives */
+                             size_t numPrimitives,                    /*!< number of input primitives */
+                             RTCCreateNodeFunc createNode,            /*!< creates a node */
+                             RTCSetNodeChildrenFunc setNodeChildren,  /*!< sets the children of a node */
+                             RTCSetNodeBoundsFunc setNodeBounds,      /*!< sets the bounds of the children of a node */
+                             RTCCreateLeafFunc createLeaf,            /*!< creates a leaf */
+                             RTCSplitPrimitiveFunc splitPrimitive,    /*!< splits a primitive, may be NULL for non spatial split builds */
+                             RTCBuildProgressFunc buildProgress,      /*!< reports build progress, may be NULL */
+                             void* userPtr                            /*!< user pointer passed to all callbacks */);
+
+/*! Allocates memory using the thread local allocator. The memory
+ *  stays valid until the BVH is rebuilt or deleted. */
+RTCORE_API void* rtcThreadLocalAlloc(RTCThreadLocalAllocator allocator, size_t bytes, size_t align);
+
+/*! Frees temporary build data and makes the BVH immutable. */
+RTCORE_API void rtcMakeStaticBVH(RTCBVH bvh);
+
+/*! Deletes the BVH including all nodes and leaves. */
+RTCORE_API void rtcDeleteBVH(RTCBVH bvh);
+
+/*! @} */
+
+#endif
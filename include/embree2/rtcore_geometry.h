@@ -45,6 +45,10 @@ enum RTCBufferType {
   RTC_VERTEX_CREASE_WEIGHT_BUFFER = 0x08000000,
 
   RTC_HOLE_BUFFER          = 0x09000001,
+
+  RTC_NORMAL_BUFFER        = 0x0A000000,
+  RTC_NORMAL_BUFFER0       = 0x0A000000,
+  RTC_NORMAL_BUFFER1       = 0x0A000001,
 };
 
 /*! \brief Supported types of matrix layout for functions involving matrices */
@@ -70,6 +74,22 @@ enum RTCBoundaryMode
   RTC_BOUNDARY_EDGE_AND_CORNER = 2     //!< boundary corner vertices are sharp vertices
 };
 
+/*! \brief Basis of the control points of hair and curve geometries */
+enum RTCCurveBasis
+{
+  RTC_BASIS_BEZIER = 0,                //!< cubic Bezier basis (default)
+  RTC_BASIS_BSPLINE = 1,               //!< uniform cubic B-spline basis
+  RTC_BASIS_CATMULL_ROM = 2            //!< uniform Catmull-Rom basis
+};
+
+/*! \brief Storage format of the vertex buffers of triangle and quad meshes */
+enum RTCVertexFormat
+{
+  RTC_VERTEX_FORMAT_FLOAT3 = 0,        //!< three 32 bit floats per vertex (default)
+  RTC_VERTEX_FORMAT_HALF3 = 1,         //!< three 16 bit half precision floats per vertex
+  RTC_VERTEX_FORMAT_FIXED16 = 2        //!< three 16 bit unsigned integers per vertex, scaled and offset per geometry
+};
+
 /*! Intersection filter function for single rays. */
 typedef void (*RTCFilterFunc)(void* ptr,           /*!< pointer to user data */
                               RTCRay& ray          /*!< intersection to filter */);
@@ -307,11 +327,52 @@ RTCORE_API unsigned rtcNewCurveGeometry (RTCScene scene,                    //!<
                                          size_t numTimeSteps = 1            //!< number of motion blur time steps
   );
 
+/*! \brief Creates a new ribbon geometry, consisting of multiple flat
+  ribbons represented as cubic bezier curves with varying radii that
+  are oriented by a per vertex normal. The intersected surface is
+  the curve tessellated into the number of segments set through
+  rtcSetTessellationRate, each segment extended by the radius to both
+  sides along the direction perpendicular to the curve tangent and
+  the interpolated normal. The ribbon thus faces into the direction
+  of the normal. Besides the curve index buffer (RTC_INDEX_BUFFER)
+  and the curve vertex buffer (RTC_VERTEX_BUFFER), which have the
+  same layout as for hair geometry, a normal buffer
+  (RTC_NORMAL_BUFFER) has to get set that stores one single precision
+  (x,y,z) normal per vertex, using the same stride as the vertex
+  buffer. In case of linear motion blur, two vertex buffers
+  (RTC_VERTEX_BUFFER0, RTC_VERTEX_BUFFER1) and two normal buffers
+  (RTC_NORMAL_BUFFER0, RTC_NORMAL_BUFFER1) have to get filled, one
+  for each time step. The v hit coordinate goes from 0 to 1 across
+  the ribbon. */
+RTCORE_API unsigned rtcNewRibbonGeometry (RTCScene scene,                    //!< the scene the curves belong to
+                                          RTCGeometryFlags flags,            //!< geometry flags
+                                          size_t numCurves,                  //!< number of curves
+                                          size_t numVertices,                //!< number of vertices
+                                          size_t numTimeSteps = 1            //!< number of motion blur time steps
+  );
+
 /*! Sets a uniform tessellation rate for subdiv meshes and hair
  *  geometry. For subdivision meshes the RTC_LEVEL_BUFFER can also be used
  *  optionally to set a different tessellation rate per edge.*/
 RTCORE_API void rtcSetTessellationRate (RTCScene scene, unsigned geomID, float tessellationRate);
 
+/*! Sets the basis of the control points of a hair or curve
+ *  geometry. With the B-spline and Catmull-Rom basis each curve
+ *  still references 4 consecutive vertices through the index buffer,
+ *  but neighboring curve segments can share 3 of these vertices by
+ *  storing start indices that differ by one. The control points are
+ *  converted to Bezier form on the fly during build and
+ *  traversal. */
+RTCORE_API void rtcSetCurveBasis (RTCScene scene, unsigned geomID, RTCCurveBasis basis);
+
+/*! Sets the storage format of the vertex buffers of a triangle or
+ *  quad mesh. The half and fixed point formats store 6 bytes per
+ *  vertex and require vertex buffers aligned to 2 bytes. Fixed point
+ *  vertices are decoded as offset+scale*v, where scale and offset
+ *  point to 3 floats each. Vertices are decoded on the fly during
+ *  build and traversal. */
+RTCORE_API void rtcSetVertexFormat (RTCScene scene, unsigned geomID, RTCVertexFormat format, const float* scale = NULL, const float* offset = NULL);
+
 /*! \brief Creates a new line segment geometry, consisting of multiple
   segments with varying radii. The number of line segments (numSegments),
   number of vertices (numVertices), and number of time steps (1 for
@@ -336,6 +397,33 @@ RTCORE_API unsigned rtcNewLineSegments (RTCScene scene,                    //!<
                                         size_t numTimeSteps = 1            //!< number of motion blur time steps
   );
 
+/*! \brief Creates a new point geometry, consisting of multiple spheres
+  with varying radii. The number of points (numPoints) and number of
+  time steps (1 for normal points, and 2 for linear motion blur), have
+  to get specified at construction time. The vertex buffer
+  (RTC_VERTEX_BUFFER) stores one point per primitive, each consisting
+  of a single precision (x,y,z) position and radius, stored in that
+  order in memory. In case of linear motion blur, two vertex buffers
+  have to get filled (RTC_VERTEX_BUFFER0, RTC_VERTEX_BUFFER1), one for
+  each time step. There is no index buffer, the primitive ID of a hit
+  is the index of the point in the vertex buffer. */
+RTCORE_API unsigned rtcNewPoints (RTCScene scene,                    //!< the scene the points belong to
+                                  RTCGeometryFlags flags,            //!< geometry flags
+                                  size_t numPoints,                  //!< number of points
+                                  size_t numTimeSteps = 1            //!< number of motion blur time steps
+  );
+
+/*! \brief Creates a new point geometry that renders each point as a
+  disc that always faces the ray. The disc is centered at the point
+  position and has the radius of the point, the geometry normal
+  returned for a hit is the negated ray direction. Otherwise the
+  geometry is specified like for rtcNewPoints. */
+RTCORE_API unsigned rtcNewDiscPoints (RTCScene scene,                    //!< the scene the points belong to
+                                      RTCGeometryFlags flags,            //!< geometry flags
+                                      size_t numPoints,                  //!< number of points
+                                      size_t numTimeSteps = 1            //!< number of motion blur time steps
+  );
+
 /*! \brief Sets 32 bit ray mask. */
 RTCORE_API void rtcSetMask (RTCScene scene, unsigned geomID, int mask);
 
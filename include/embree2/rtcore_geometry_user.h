@@ -31,6 +31,27 @@ typedef void (*RTCBoundsFunc2)(void* userPtr,         /*!< pointer to user data
                                size_t item,           /*!< item to calculate bounds for */
                                RTCBounds* bounds_o    /*!< returns calculated bounds */);
 
+/*! Output arrays of a bounds function for a range of items. The
+ *  bounds of item begin+i are written to the i'th entry of each
+ *  array. */
+struct RTCBoundsSoA
+{
+  float* lower_x;     /*!< x coordinates of lower bounds */
+  float* lower_y;     /*!< y coordinates of lower bounds */
+  float* lower_z;     /*!< z coordinates of lower bounds */
+  float* upper_x;     /*!< x coordinates of upper bounds */
+  float* upper_y;     /*!< y coordinates of upper bounds */
+  float* upper_z;     /*!< z coordinates of upper bounds */
+};
+
+/*! Type of bounding function for a range of items. */
+typedef void (*RTCBoundsFuncSoA)(void* userPtr,           /*!< pointer to user data */
+                                 void* geomUserPtr,       /*!< pointer to geometry user data */
+                                 size_t begin,            /*!< first item to calculate bounds for */
+                                 size_t end,              /*!< one past the last item to calculate bounds for */
+                                 size_t timeStep,         /*!< motion blur time step to calculate bounds for */
+                                 const RTCBoundsSoA* bounds_o /*!< returns calculated bounds */);
+
 /*! Type of intersect function pointer for single rays. */
 typedef void (*RTCIntersectFunc)(void* ptr,           /*!< pointer to user data */
                                  RTCRay& ray,         /*!< ray to intersect */
@@ -69,6 +90,13 @@ typedef void (*RTCIntersectFuncN)(const int* valid,                        /*!<
                                   size_t N,                                /*!< number of rays in packet */
                                   size_t item                              /*!< item to intersect */);
 
+/*! Type of intersect function pointer for all items of a BVH leaf. */
+typedef void (*RTCIntersectFuncLeaf)(void* ptr,                              /*!< pointer to geometry user data */
+                                     const RTCIntersectContext* context,  /*!< intersection context as passed to rtcIntersect/rtcOccluded */
+                                     RTCRay& ray,                            /*!< ray to intersect */
+                                     const unsigned* items,                  /*!< items to intersect */
+                                     size_t numItems                         /*!< number of items to intersect */);
+
 /*! Type of occlusion function pointer for single rays. */
 typedef void (*RTCOccludedFunc) (void* ptr,           /*!< pointer to user data */ 
                                  RTCRay& ray,         /*!< ray to test occlusion */
@@ -107,6 +135,13 @@ typedef void (*RTCOccludedFuncN) (const int* valid,                      /*! poi
                                   size_t N,                              /*!< number of rays in packet */
                                   size_t item                            /*!< item to test for occlusion */);
 
+/*! Type of occlusion function pointer for all items of a BVH leaf. */
+typedef void (*RTCOccludedFuncLeaf) (void* ptr,                             /*!< pointer to geometry user data */
+                                     const RTCIntersectContext* context, /*!< intersection context as passed to rtcIntersect/rtcOccluded */
+                                     RTCRay& ray,                           /*!< ray to test occlusion */
+                                     const unsigned* items,                 /*!< items to test for occlusion */
+                                     size_t numItems                        /*!< number of items to test for occlusion */);
+
 /*! Creates a new user geometry object. This feature makes it possible
  *  to add arbitrary types of geometry to the scene by providing
  *  appropiate bounding, intersect and occluded functions. A user
@@ -139,6 +174,13 @@ RTCORE_API void rtcSetBoundsFunction (RTCScene scene, unsigned geomID, RTCBounds
  *  tight. */
 RTCORE_API void rtcSetBoundsFunction2 (RTCScene scene, unsigned geomID, RTCBoundsFunc2 bounds, void* userPtr);
 
+/*! Sets a bounding function that calculates the bounds of a range
+ *  of items at once. When set, this function is used instead of the
+ *  per item bounding function, which amortizes the call overhead for
+ *  user geometries with many items. The function is called once per
+ *  time step for motion blurred user geometries. */
+RTCORE_API void rtcSetBoundsFunctionSoA (RTCScene scene, unsigned geomID, RTCBoundsFuncSoA bounds, void* userPtr);
+
 /*! Set intersect function for single rays. The rtcIntersect function
  *  will call the passed function for intersecting the user
  *  geometry. */
@@ -169,6 +211,16 @@ RTCORE_API void rtcSetIntersectFunction1Mp (RTCScene scene, unsigned geomID, RTC
  *  geometry. */
 RTCORE_API void rtcSetIntersectFunctionN (RTCScene scene, unsigned geomID, RTCIntersectFuncN intersect);
 
+/*! Set intersect function for all items of a BVH leaf. The
+ *  rtcIntersect function will call the passed function once for all
+ *  items of this geometry that are stored in the same leaf, instead of
+ *  calling the single ray intersect function for each item. The
+ *  number of items per leaf is controlled by the
+ *  object_accel_max_leaf_size device configuration. The single ray
+ *  intersect function still has to be set, as it is used by the
+ *  other traversal kernels. */
+RTCORE_API void rtcSetIntersectFunctionLeaf (RTCScene scene, unsigned geomID, RTCIntersectFuncLeaf intersect);
+
 /*! Set occlusion function for single rays. The rtcOccluded function
  *  will call the passed function for intersecting the user
  *  geometry. */
@@ -199,6 +251,11 @@ RTCORE_API void rtcSetOccludedFunction1Mp (RTCScene scene, unsigned geomID, RTCO
  *  geometry. */
 RTCORE_API void rtcSetOccludedFunctionN (RTCScene scene, unsigned geomID, RTCOccludedFuncN occluded);
 
+/*! Set occlusion function for all items of a BVH leaf. The
+ *  rtcOccluded function will call the passed function once for all
+ *  items of this geometry that are stored in the same leaf. */
+RTCORE_API void rtcSetOccludedFunctionLeaf (RTCScene scene, unsigned geomID, RTCOccludedFuncLeaf occluded);
+
 
 /*! @} */
 
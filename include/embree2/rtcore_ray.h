@@ -268,6 +268,46 @@ public:
 };
 #endif
 
+/*! Pinhole or thin lens camera for primary ray generation inside
+ *  Embree. The ray through the center of pixel (x,y) has direction
+ *  dir00 + (x+0.5)*dirdx + (y+0.5)*dirdy. For a lens radius larger
+ *  than zero, the origin of all rays of a call gets moved to the lens
+ *  position org + lensRadius*(lensSample[0]*ex + lensSample[1]*ey),
+ *  where ex and ey are dirdx and dirdy normalized, and the rays are
+ *  focused at focalDistance times their pinhole direction. */
+#ifndef __RTCCamera__
+#define __RTCCamera__
+struct RTCCamera
+{
+  float org[3];         //!< camera position
+  float dir00[3];       //!< direction to the corner of pixel (0,0)
+  float dirdx[3];       //!< direction offset between pixels in x
+  float dirdy[3];       //!< direction offset between pixels in y
+  float lensRadius;     //!< radius of the lens, 0 for a pinhole camera
+  float focalDistance;  //!< distance of the focal plane along the pixel directions
+  float lensSample[2];  //!< lens sample in [-1,1]^2 used for all rays of a call
+  float tnear;          //!< start of the ray segments
+  float tfar;           //!< end of the ray segments
+  float time;           //!< time of the rays for motion blur
+  unsigned mask;        //!< used to mask out objects during traversal
+};
+#endif
+
+/*! Hit record written for each pixel of a tile. */
+#ifndef __RTCTileHit__
+#define __RTCTileHit__
+struct RTCTileHit
+{
+  float t;           //!< hit distance
+  float u;           //!< Barycentric u coordinate of hit
+  float v;           //!< Barycentric v coordinate of hit
+  float Ng[3];       //!< Unnormalized geometry normal
+  unsigned geomID;   //!< geometry ID, RTC_INVALID_GEOMETRY_ID if nothing got hit
+  unsigned primID;   //!< primitive ID
+  unsigned instID;   //!< instance ID
+};
+#endif
+
 /* Helper functions to access hit packets of size N */
 #ifndef __RTCHitN__
 #define __RTCHitN__
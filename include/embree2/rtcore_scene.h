@@ -26,6 +26,8 @@ struct RTCRay4;
 struct RTCRay8;
 struct RTCRay16;
 struct RTCRayNp;
+struct RTCCamera;
+struct RTCTileHit;
 
 /*! scene flags */
 enum RTCSceneFlags 
@@ -41,7 +43,8 @@ enum RTCSceneFlags
   RTC_SCENE_HIGH_QUALITY = (1 << 11),  //!< create higher quality data structures
 
   /* traversal algorithm flags */
-  RTC_SCENE_ROBUST     = (1 << 16)     //!< use more robust traversal algorithms
+  RTC_SCENE_ROBUST     = (1 << 16),    //!< use more robust traversal algorithms
+  RTC_SCENE_LARGE      = (1 << 17)     //!< optimize traversal for scenes much larger than the caches
 };
 
 /*! enabled algorithm flags */
@@ -59,7 +62,35 @@ enum RTCAlgorithmFlags
 enum RTCIntersectFlags
 {
   RTC_INTERSECT_COHERENT                 = 0,  //!< optimize for coherent rays
-  RTC_INTERSECT_INCOHERENT               = 1   //!< optimize for incoherent rays
+  RTC_INTERSECT_INCOHERENT               = 1,  //!< optimize for incoherent rays
+  RTC_INTERSECT_DISTANCE_ONLY            = 2,  //!< only report tfar, geomID, and primID of hits, u, v, and Ng are not written
+  RTC_INTERSECT_CLIP_VOLUME              = 4,  //!< only report hits inside the clip volume of the context
+  RTC_INTERSECT_OCCLUSION_CACHE          = 8   //!< test the last occluder of the occlusion cache slot of the context first
+};
+
+/*! maximal number of planes of a clip volume */
+#define RTC_MAX_CLIP_PLANES 6
+
+/*! convex clip volume given as the intersection of half spaces, a
+ *  point (x,y,z) is inside if a*x+b*y+c*z+d >= 0 holds for the plane
+ *  equations (a,b,c,d) of all active planes */
+struct RTCClipVolume
+{
+  unsigned int numPlanes;                //!< number of active clip planes
+  float planes[RTC_MAX_CLIP_PLANES][4];  //!< plane equations (a,b,c,d)
+};
+
+/*! number of slots of an occlusion cache */
+#define RTC_OCCLUSION_CACHE_SLOTS 16
+
+/*! Cache of the leaves that occluded the previous shadow rays of
+ *  each slot, e.g. one slot per light source. The cache has to get
+ *  zero initialized, must not be used by multiple threads at the same
+ *  time, and has to get cleared when a scene is deleted. */
+struct RTCOcclusionCache
+{
+  unsigned int slot;                                  //!< slot used by the next occlusion query
+  size_t entries[RTC_OCCLUSION_CACHE_SLOTS][3];       //!< opaque cache entries
 };
 
 /*! intersection context passed to intersect/occluded calls */
@@ -67,6 +98,8 @@ struct RTCIntersectContext
 {
   RTCIntersectFlags flags;   //!< intersection flags
   void* userRayExt;          //!< can be used to pass extended ray data to callbacks
+  const RTCClipVolume* clipVolume; //!< clip volume, only accessed if RTC_INTERSECT_CLIP_VOLUME is set
+  RTCOcclusionCache* occlusionCache; //!< occlusion cache, only accessed if RTC_INTERSECT_OCCLUSION_CACHE is set
 };
 
 /*! \brief Defines an opaque scene type */
@@ -80,6 +113,17 @@ RTCORE_API RTCORE_DEPRECATED RTCScene rtcNewScene (RTCSceneFlags flags, RTCAlgor
 /*! Creates a new scene. */
 RTCORE_API RTCScene rtcDeviceNewScene (RTCDevice device, RTCSceneFlags flags, RTCAlgorithmFlags aflags);
 
+struct RTCBuildSettings;
+
+/*! Creates a new scene whose SAH builders use the specified settings
+ *  instead of their defaults. The leaf size is additionally limited
+ *  by the maximal leaf size of the primitive type. A build quality of
+ *  RTC_BUILD_QUALITY_HIGH enables spatial splits like the
+ *  RTC_SCENE_HIGH_QUALITY flag, lower qualities disable them. The
+ *  branching factor, maximal depth, and extra space settings are
+ *  ignored. */
+RTCORE_API RTCScene rtcDeviceNewScene2 (RTCDevice device, RTCSceneFlags flags, RTCAlgorithmFlags aflags, const RTCBuildSettings& settings);
+
 /*! \brief Type of progress callback function. */
 typedef bool (*RTCProgressMonitorFunc)(void* ptr, const double n);
 RTCORE_DEPRECATED typedef RTCProgressMonitorFunc RTC_PROGRESS_MONITOR_FUNCTION;
@@ -87,6 +131,13 @@ RTCORE_DEPRECATED typedef RTCProgressMonitorFunc RTC_PROGRESS_MONITOR_FUNCTION;
 /*! \brief Sets the progress callback function which is called during hierarchy build of this scene. */
 RTCORE_API void rtcSetProgressMonitorFunction(RTCScene scene, RTCProgressMonitorFunc func, void* ptr);
 
+/*! \brief Sets the priority of the hierarchy build of this scene
+ *  (default 0). Worker threads leave the builds of other scenes for
+ *  a build of higher priority, e.g. to commit an interactive scene
+ *  while a background scene gets built. Only supported by the
+ *  internal tasking system. */
+RTCORE_API void rtcSetBuildPriority(RTCScene scene, int priority);
+
 /*! Commits the geometry of the scene. After initializing or modifying
  *  geometries, commit has to get called before tracing
  *  rays. */
@@ -104,6 +155,12 @@ RTCORE_API void rtcCommit (RTCScene scene);
  *  coprocessor. */
 RTCORE_API void rtcCommitThread(RTCScene scene, unsigned int threadID, unsigned int numThreads);
 
+/*! Commits the geometry of many scenes of the same device in one
+ *  parallel job. Each scene is built by a single task, which scales
+ *  much better than committing many small scenes one after the
+ *  other. Scenes that are not modified are skipped. */
+RTCORE_API void rtcCommitMany(RTCScene* scenes, size_t numScenes);
+
 /*! Returns to AABB of the scene. rtcCommit has to get called
  *  previously to this function. */
 RTCORE_API void rtcGetBounds(RTCScene scene, RTCBounds& bounds_o);
@@ -151,6 +208,17 @@ RTCORE_API void rtcIntersectNM (RTCScene scene, const RTCIntersectContext* conte
  *  of the ray packet. */
 RTCORE_API void rtcIntersectNp (RTCScene scene, const RTCIntersectContext* context, const RTCRayNp& rays, const size_t N);
 
+/*! Generates the primary rays of a camera for the pixels [x0,x0+width)
+ *  x [y0,y0+height) inside Embree and intersects them with the
+ *  scene. For each pixel a hit record gets written to the hits array
+ *  in row major order, with stride bytes between consecutive rows of
+ *  the tile. Only the geomID is written for pixels that hit
+ *  nothing. This function can only be called for scenes with the
+ *  RTC_INTERSECT_STREAM flag set. */
+RTCORE_API void rtcIntersectTile (RTCScene scene, const RTCIntersectContext* context, const RTCCamera& camera,
+                                  const unsigned x0, const unsigned y0, const unsigned width, const unsigned height,
+                                  RTCTileHit* hits, const size_t stride);
+
 /*! Tests if a single ray is occluded by the scene. The ray has to be
  *  aligned to 16 bytes. This function can only be called for scenes
  *  with the RTC_INTERSECT1 flag set. */
@@ -196,6 +264,47 @@ RTCORE_API void rtcOccludedNM (RTCScene scene, const RTCIntersectContext* contex
  *  of the ray packet. */
 RTCORE_API void rtcOccludedNp (RTCScene scene, const RTCIntersectContext* context, const RTCRayNp& rays, const size_t N);
 
+/*! \brief Defines an opaque ray queue type */
+typedef struct __RTCRayQueue {}* RTCRayQueue;
+
+/*! type of the ray queries a ray queue performs */
+enum RTCRayQueueType
+{
+  RTC_RAY_QUEUE_INTERSECT = 0,  //!< rays get intersected with the scene
+  RTC_RAY_QUEUE_OCCLUDED  = 1   //!< rays get tested for occlusion
+};
+
+/*! Callback invoked for each chunk of traced rays of a ray queue. The
+ *  rays are passed together with the IDs they got appended with, and
+ *  are only valid during the callback. */
+typedef void (*RTCRayQueueFunc)(void* userPtr, RTCRay* rays, const unsigned int* rayIDs, size_t N);
+
+/*! Creates a persistent ray queue for the scene. Rays appended to the
+ *  queue are traced in large chunks and returned through the
+ *  callback. The context is copied, but a clip volume it points to has
+ *  to stay alive, RTC_INTERSECT_OCCLUSION_CACHE is not supported and
+ *  gets ignored. The scene has to have the
+ *  RTC_INTERSECT_STREAM flag set and has to stay alive and committed
+ *  until the queue got deleted. */
+RTCORE_API RTCRayQueue rtcNewRayQueue (RTCScene scene, const RTCIntersectContext* context, RTCRayQueueType type, RTCRayQueueFunc func, void* userPtr);
+
+/*! Appends a stream of M rays with IDs to the ray queue. The stride
+ *  specifies the offset between rays in bytes. Rays with tnear > tfar
+ *  are dropped, thus terminated paths do not occupy SIMD lanes. This
+ *  function can get called by multiple threads concurrently. The
+ *  thread that fills a chunk traces it and invokes the callback,
+ *  which may append further rays to the queue. */
+RTCORE_API void rtcRayQueueAppend (RTCRayQueue queue, const RTCRay* rays, const unsigned int* rayIDs, const size_t M, const size_t stride);
+
+/*! Traces the partially filled chunk of the ray queue until the
+ *  queue is empty, including rays the callback appends during the
+ *  flush. This function must not get called concurrently with
+ *  rtcRayQueueAppend from other threads. */
+RTCORE_API void rtcRayQueueFlush (RTCRayQueue queue);
+
+/*! Deletes the ray queue. Rays not flushed are discarded. */
+RTCORE_API void rtcDeleteRayQueue (RTCRayQueue queue);
+
 /*! Deletes the scene. All contained geometry get also destroyed. */
 RTCORE_API void rtcDeleteScene (RTCScene scene);
 
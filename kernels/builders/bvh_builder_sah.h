@@ -115,7 +115,7 @@ namespace embree
           do {
             
             /* find best child with largest bounding box area */
-            size_t bestChild = -1;
+            ssize_t bestChild = -1;
             size_t bestSize = 0;
             for (size_t i=0; i<numChildren; i++)
             {
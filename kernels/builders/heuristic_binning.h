@@ -93,6 +93,11 @@ namespace embree
           return floori((p-ofs16)*scale16);
         }
 
+        /*! maps 16 centroids of dimension dim to bins at once */
+        __forceinline vint16 bin16(const vfloat16& p, const size_t dim) const {
+          return floori((p-vfloat16(ofs[dim]))*vfloat16(scale[dim]));
+        }
+
         __forceinline int bin_unsafe(const PrimRef &ref,
                                      const vint16  vSplitPos,
                                      const vbool16 splitDimMask) const
@@ -542,60 +547,69 @@ namespace embree
         count2 = vint16::zero();
 
         const vint16 step16(step);
+        const vint16 stride16 = step16*int(sizeof(PrimRef)/sizeof(float));
+        __aligned(64) int bins[3][16];
 
-	for (size_t i=0; i<N; i++)
+	for (size_t i=0; i<N; i+=16)
         {
-          /*! map even and odd primitive to bin */
-          const BBox3fa prim0 = prims[i].bounds();
-          const vfloat16 center0 = vfloat16((vfloat4)prim0.lower) + vfloat16((vfloat4)prim0.upper); 
-          const vint16 bin = mapping.bin16(center0);
-
-          const vfloat16 b_min_x = prims[i].lower.x;
-          const vfloat16 b_min_y = prims[i].lower.y;
-          const vfloat16 b_min_z = prims[i].lower.z;
-          const vfloat16 b_max_x = prims[i].upper.x;
-          const vfloat16 b_max_y = prims[i].upper.y;
-          const vfloat16 b_max_z = prims[i].upper.z;
-
-          const vint16 bin0 = shuffle<0>(bin);
-          const vint16 bin1 = shuffle<1>(bin);
-          const vint16 bin2 = shuffle<2>(bin);
-
-          const vbool16 m_update_x = step16 == bin0;
-          const vbool16 m_update_y = step16 == bin1;
-          const vbool16 m_update_z = step16 == bin2;
-
-          assert(__popcnt((size_t)m_update_x) == 1);
-          assert(__popcnt((size_t)m_update_y) == 1);
-          assert(__popcnt((size_t)m_update_z) == 1);
-
-          min_x0 = mask_min(m_update_x,min_x0,min_x0,b_min_x);
-          min_y0 = mask_min(m_update_x,min_y0,min_y0,b_min_y);
-          min_z0 = mask_min(m_update_x,min_z0,min_z0,b_min_z);
-          // ------------------------------------------------------------------------      
-          max_x0 = mask_max(m_update_x,max_x0,max_x0,b_max_x);
-          max_y0 = mask_max(m_update_x,max_y0,max_y0,b_max_y);
-          max_z0 = mask_max(m_update_x,max_z0,max_z0,b_max_z);
-          // ------------------------------------------------------------------------
-          min_x1 = mask_min(m_update_y,min_x1,min_x1,b_min_x);
-          min_y1 = mask_min(m_update_y,min_y1,min_y1,b_min_y);
-          min_z1 = mask_min(m_update_y,min_z1,min_z1,b_min_z);      
-          // ------------------------------------------------------------------------      
-          max_x1 = mask_max(m_update_y,max_x1,max_x1,b_max_x);
-          max_y1 = mask_max(m_update_y,max_y1,max_y1,b_max_y);
-          max_z1 = mask_max(m_update_y,max_z1,max_z1,b_max_z);
-          // ------------------------------------------------------------------------
-          min_x2 = mask_min(m_update_z,min_x2,min_x2,b_min_x);
-          min_y2 = mask_min(m_update_z,min_y2,min_y2,b_min_y);
-          min_z2 = mask_min(m_update_z,min_z2,min_z2,b_min_z);
-          // ------------------------------------------------------------------------      
-          max_x2 = mask_max(m_update_z,max_x2,max_x2,b_max_x);
-          max_y2 = mask_max(m_update_z,max_y2,max_y2,b_max_y);
-          max_z2 = mask_max(m_update_z,max_z2,max_z2,b_max_z);
-          // ------------------------------------------------------------------------
-          count0 = mask_add(m_update_x,count0,count0,vint16(1));
-          count1 = mask_add(m_update_y,count1,count1,vint16(1));
-          count2 = mask_add(m_update_z,count2,count2,vint16(1));      
+          /*! gather 16 centroids and map them to bins at once */
+          const size_t n = min(N-i,size_t(16));
+          const vboolf16 valid = step16 < vint16(int(n));
+          const float* base = (const float*) &prims[i];
+          const vfloat16 center_x = gather16f(valid,base+0,stride16) + gather16f(valid,base+4,stride16);
+          const vfloat16 center_y = gather16f(valid,base+1,stride16) + gather16f(valid,base+5,stride16);
+          const vfloat16 center_z = gather16f(valid,base+2,stride16) + gather16f(valid,base+6,stride16);
+          vint16::store(bins[0],mapping.bin16(center_x,0));
+          vint16::store(bins[1],mapping.bin16(center_y,1));
+          vint16::store(bins[2],mapping.bin16(center_z,2));
+
+          /*! in-register updates of the bins, every primitive updates exactly one lane per dimension */
+          for (size_t j=0; j<n; j++)
+          {
+            const PrimRef& prim = prims[i+j];
+            const vfloat16 b_min_x = prim.lower.x;
+            const vfloat16 b_min_y = prim.lower.y;
+            const vfloat16 b_min_z = prim.lower.z;
+            const vfloat16 b_max_x = prim.upper.x;
+            const vfloat16 b_max_y = prim.upper.y;
+            const vfloat16 b_max_z = prim.upper.z;
+
+            const vbool16 m_update_x = step16 == vint16(bins[0][j]);
+            const vbool16 m_update_y = step16 == vint16(bins[1][j]);
+            const vbool16 m_update_z = step16 == vint16(bins[2][j]);
+
+            assert(__popcnt((size_t)m_update_x) == 1);
+            assert(__popcnt((size_t)m_update_y) == 1);
+            assert(__popcnt((size_t)m_update_z) == 1);
+
+            min_x0 = mask_min(m_update_x,min_x0,min_x0,b_min_x);
+            min_y0 = mask_min(m_update_x,min_y0,min_y0,b_min_y);
+            min_z0 = mask_min(m_update_x,min_z0,min_z0,b_min_z);
+            // ------------------------------------------------------------------------      
+            max_x0 = mask_max(m_update_x,max_x0,max_x0,b_max_x);
+            max_y0 = mask_max(m_update_x,max_y0,max_y0,b_max_y);
+            max_z0 = mask_max(m_update_x,max_z0,max_z0,b_max_z);
+            // ------------------------------------------------------------------------
+            min_x1 = mask_min(m_update_y,min_x1,min_x1,b_min_x);
+            min_y1 = mask_min(m_update_y,min_y1,min_y1,b_min_y);
+            min_z1 = mask_min(m_update_y,min_z1,min_z1,b_min_z);      
+            // ------------------------------------------------------------------------      
+            max_x1 = mask_max(m_update_y,max_x1,max_x1,b_max_x);
+            max_y1 = mask_max(m_update_y,max_y1,max_y1,b_max_y);
+            max_z1 = mask_max(m_update_y,max_z1,max_z1,b_max_z);
+            // ------------------------------------------------------------------------
+            min_x2 = mask_min(m_update_z,min_x2,min_x2,b_min_x);
+            min_y2 = mask_min(m_update_z,min_y2,min_y2,b_min_y);
+            min_z2 = mask_min(m_update_z,min_z2,min_z2,b_min_z);
+            // ------------------------------------------------------------------------      
+            max_x2 = mask_max(m_update_z,max_x2,max_x2,b_max_x);
+            max_y2 = mask_max(m_update_z,max_y2,max_y2,b_max_y);
+            max_z2 = mask_max(m_update_z,max_z2,max_z2,b_max_z);
+            // ------------------------------------------------------------------------
+            count0 = mask_add(m_update_x,count0,count0,vint16(1));
+            count1 = mask_add(m_update_y,count1,count1,vint16(1));
+            count2 = mask_add(m_update_z,count2,count2,vint16(1));      
+          }
         }
 
         lower[0] = Vec3vf16( min_x0, min_y0, min_z0 );
@@ -43,6 +43,11 @@ namespace embree
         static const size_t PARALLEL_FIND_BLOCK_SIZE = 1024;
         static const size_t PARALLEL_PARITION_BLOCK_SIZE = 128;
 #endif
+        /*! ranges above this size only bin a subset of their primitives */
+        static const size_t SAMPLING_THRESHOLD = 1024*1024;
+        static const size_t SAMPLING_BLOCK_SIZE = 64;
+        static const size_t SAMPLING_SIZE = 128*1024;
+
         __forceinline HeuristicArrayBinningSAH ()
           : prims(nullptr) {}
         
@@ -69,15 +74,15 @@ namespace embree
         const Split find(const PrimInfo& pinfo, const size_t logBlockSize)
         {
           Set set(pinfo.begin,pinfo.end);
-          if (likely(pinfo.size() < PARALLEL_THRESHOLD)) return sequential_find(set,pinfo,logBlockSize);
-          else                                           return   parallel_find(set,pinfo,logBlockSize);
+          return find(set,pinfo,logBlockSize);
         }
 
         /*! finds the best split */
         const Split find(const Set& set, const PrimInfo& pinfo, const size_t logBlockSize)
         {
           if (likely(pinfo.size() < PARALLEL_THRESHOLD)) return sequential_find(set,pinfo,logBlockSize);
-          else                                           return   parallel_find(set,pinfo,logBlockSize);
+          else if (pinfo.size() < SAMPLING_THRESHOLD)    return   parallel_find(set,pinfo,logBlockSize);
+          else                                           return    sampled_find(set,pinfo,logBlockSize);
         }
         
         /*! finds the best split */
@@ -101,6 +106,31 @@ namespace embree
           return binner.best(mapping,logBlockSize);
         }
         
+        /*! approximates the best split by binning equally spaced blocks of primitives */
+        __noinline const Split sampled_find(const Set& set, const PrimInfo& pinfo, const size_t logBlockSize)
+        {
+          Binner binner(empty);
+          const BinMapping<BINS> mapping(pinfo);
+          const BinMapping<BINS>& _mapping = mapping; // CLANG 3.4 parser bug workaround
+          const size_t numBlocks = set.size()/SAMPLING_BLOCK_SIZE;
+          const size_t numSamples = SAMPLING_SIZE/SAMPLING_BLOCK_SIZE;
+          const size_t stride = numBlocks/numSamples;
+          assert(stride >= 1);
+          binner = parallel_reduce(size_t(0),numSamples,size_t(16),binner,
+                                   [&] (const range<size_t>& r) -> Binner {
+                                     Binner binner(empty);
+                                     for (size_t i=r.begin(); i<r.end(); i++)
+                                       binner.bin(prims+set.begin()+i*stride*SAMPLING_BLOCK_SIZE,SAMPLING_BLOCK_SIZE,_mapping);
+                                     return binner;
+                                   },
+                                   [&] (const Binner& b0, const Binner& b1) -> Binner { Binner r = b0; r.merge(b1,_mapping.size()); return r; });
+          
+          /* scale SAH of the split to the full primitive count to keep it comparable with the leaf SAH */
+          Split split = binner.best(mapping,logBlockSize);
+          split.sah *= float(set.size())/float(SAMPLING_SIZE);
+          return split;
+        }
+        
         /*! array partitioning */
         void split(const Split& spliti, const PrimInfo& pinfo, PrimInfo& left, PrimInfo& right) 
         {
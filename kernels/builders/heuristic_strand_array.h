@@ -65,15 +65,15 @@ namespace embree
         : prims(prims) {}
       
       /*! finds the best split */
-      const Split find(const PrimInfo& pinfo)
+      const Split find(const PrimInfo& pinfo, const size_t logBlockSize)
       {
         Set set(pinfo.begin,pinfo.end);
-        if (likely(pinfo.size() < PARALLEL_THRESHOLD)) return sequential_find(set,pinfo);
-        else                                           return   parallel_find(set,pinfo);
+        if (likely(pinfo.size() < PARALLEL_THRESHOLD)) return sequential_find(set,pinfo,logBlockSize);
+        else                                           return   parallel_find(set,pinfo,logBlockSize);
       }
       
       /*! finds the best split */
-      const Split sequential_find(const Set& set, const PrimInfo& pinfo)
+      const Split sequential_find(const Set& set, const PrimInfo& pinfo, const size_t logBlockSize)
       {
         /* first curve determines first axis */
         Vec3fa axis0 = normalize(prims[set.begin()].p3 - prims[set.begin()].p0);
@@ -113,12 +113,13 @@ namespace embree
           return Split(inf,axis0,axis1);
       
         /*! calculate sah for the split */
-        const float sah = float(lnum)*halfArea(lbounds) + float(rnum)*halfArea(rbounds);
+        const size_t blocks_add = (size_t(1) << logBlockSize)-1;
+        const float sah = float((lnum+blocks_add) >> logBlockSize)*halfArea(lbounds) + float((rnum+blocks_add) >> logBlockSize)*halfArea(rbounds);
         return Split(sah,axis0,axis1);
       }
 
       /*! finds the best split */
-      const Split parallel_find(const Set& set, const PrimInfo& pinfo)
+      const Split parallel_find(const Set& set, const PrimInfo& pinfo, const size_t logBlockSize)
       {
         /* first curve determines first axis */
         const Vec3fa axis0 = normalize(prims[set.begin()].p3 - prims[set.begin()].p0);
@@ -204,7 +205,8 @@ namespace embree
           return Split(inf,axis0,axis1);
       
         /*! calculate sah for the split */
-        const float sah = float(info.lnum)*halfArea(info.lbounds) + float(info.rnum)*halfArea(info.rbounds);
+        const size_t blocks_add = (size_t(1) << logBlockSize)-1;
+        const float sah = float((info.lnum+blocks_add) >> logBlockSize)*halfArea(info.lbounds) + float((info.rnum+blocks_add) >> logBlockSize)*halfArea(info.rbounds);
         return Split(sah,axis0,axis1);
       }
       
@@ -103,6 +103,82 @@ namespace embree
       right_o = intersect(right,bounds);
     }
 
+    __forceinline void splitQuad(const PrimRef& prim, int dim, float pos, 
+                                 const Vec3fa& a, const Vec3fa& b, const Vec3fa& c, const Vec3fa& d, PrimRef& left_o, PrimRef& right_o)
+    {
+      /* a quad consists of the triangles (a,b,d) and (c,d,b) that are in
+       * general not coplanar, thus both triangles get clipped as the
+       * diagonal may cross the splitting location outside the outline */
+      PrimRef left0, right0, left1, right1;
+      splitTriangle(prim,dim,pos,a,b,d,left0,right0);
+      splitTriangle(prim,dim,pos,c,d,b,left1,right1);
+
+      new (&left_o ) PrimRef(merge(left0 .bounds(),left1 .bounds()), prim.geomID(), prim.primID());
+      new (&right_o) PrimRef(merge(right0.bounds(),right1.bounds()), prim.geomID(), prim.primID());
+    }
+
+    __forceinline void splitLine(const PrimRef& prim, int dim, float pos, 
+                                 const Vec3fa& a, const Vec3fa& b, const float radius, PrimRef& left_o, PrimRef& right_o)
+    {
+      BBox3fa left = empty, right = empty;
+      const float ad = a[dim], bd = b[dim];
+
+      if (ad <= pos) left. extend(a);
+      if (ad >= pos) right.extend(a);
+      if (bd <= pos) left. extend(b);
+      if (bd >= pos) right.extend(b);
+
+      if ((ad < pos && pos < bd) || (bd < pos && pos < ad)) // the segment crosses the splitting location
+      {
+        const Vec3fa c = a + (pos-ad)/(bd-ad)*(b-a);
+        left.extend(c);
+        right.extend(c);
+      }
+
+      /* the thickness of the line extends both halves beyond the split position */
+      if (!left .empty()) left  = enlarge(left ,Vec3fa(radius));
+      if (!right.empty()) right = enlarge(right,Vec3fa(radius));
+
+      /* clip against current bounds */
+      BBox3fa bounds = prim.bounds();
+      BBox3fa cleft (max(left .lower,bounds.lower),min(left .upper,bounds.upper));
+      BBox3fa cright(max(right.lower,bounds.lower),min(right.upper,bounds.upper));
+
+      new (&left_o ) PrimRef(cleft, prim.geomID(), prim.primID());
+      new (&right_o) PrimRef(cright,prim.geomID(), prim.primID());
+    }
+
+    /*! splits the primitive referenced by some primref at the specified
+     *  position, the upper 8 bits of the geometry ID are ignored as the
+     *  spatial split builders store the number of splits there */
+    template<typename Mesh>
+      void splitPrimRef(const Scene* scene, const PrimRef& prim, int dim, float pos, PrimRef& left_o, PrimRef& right_o);
+
+    template<>
+      __forceinline void splitPrimRef<TriangleMesh>(const Scene* scene, const PrimRef& prim, int dim, float pos, PrimRef& left_o, PrimRef& right_o)
+    {
+      const TriangleMesh* mesh = scene->getTriangleMesh(prim.geomID() & 0x00FFFFFF);
+      const TriangleMesh::Triangle& tri = mesh->triangle(prim.primID());
+      splitTriangle(prim,dim,pos,mesh->vertex(tri.v[0]),mesh->vertex(tri.v[1]),mesh->vertex(tri.v[2]),left_o,right_o);
+    }
+
+    template<>
+      __forceinline void splitPrimRef<QuadMesh>(const Scene* scene, const PrimRef& prim, int dim, float pos, PrimRef& left_o, PrimRef& right_o)
+    {
+      const QuadMesh* mesh = scene->getQuadMesh(prim.geomID() & 0x00FFFFFF);
+      const QuadMesh::Quad& quad = mesh->quad(prim.primID());
+      splitQuad(prim,dim,pos,mesh->vertex(quad.v[0]),mesh->vertex(quad.v[1]),mesh->vertex(quad.v[2]),mesh->vertex(quad.v[3]),left_o,right_o);
+    }
+
+    template<>
+      __forceinline void splitPrimRef<LineSegments>(const Scene* scene, const PrimRef& prim, int dim, float pos, PrimRef& left_o, PrimRef& right_o)
+    {
+      const LineSegments* mesh = scene->getLineSegments(prim.geomID() & 0x00FFFFFF);
+      const unsigned int index = mesh->segment(prim.primID());
+      const float radius = max(mesh->radius(index+0),mesh->radius(index+1));
+      splitLine(prim,dim,pos,mesh->vertex(index+0),mesh->vertex(index+1),radius,left_o,right_o);
+    }
+
     template<size_t N>
       struct PrimRefBoundsN {
         Vec3<vfloat<N>> lower;
@@ -319,14 +395,7 @@ namespace embree
                         return boxArea;
                       },
                       [&] (const PrimRef& prim, const int dim, const float pos, PrimRef& lprim, PrimRef& rprim) {
-                        const size_t geomID = prim.geomID();
-                        const size_t primID = prim.primID();
-                        const TriangleMesh* mesh = scene->getTriangleMesh(geomID);
-                        const TriangleMesh::Triangle& tri = mesh->triangle(primID);
-                        const Vec3fa v0 = mesh->vertex(tri.v[0]);
-                        const Vec3fa v1 = mesh->vertex(tri.v[1]);
-                        const Vec3fa v2 = mesh->vertex(tri.v[2]);
-                        splitTriangle(prim,dim,pos,v0,v1,v2,lprim,rprim);
+                        splitPrimRef<TriangleMesh>(scene,prim,dim,pos,lprim,rprim);
                       });
     }
   }
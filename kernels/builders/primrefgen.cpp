@@ -23,6 +23,44 @@ namespace embree
 {
   namespace isa
   {
+    /* creates the primrefs of the valid primitives of a range of a mesh */
+    template<typename Mesh>
+    __forceinline PrimInfo createPrimRefs(Mesh* mesh, const range<size_t>& r, mvector<PrimRef>& prims, size_t& k)
+    {
+      PrimInfo pinfo(empty);
+      for (size_t j=r.begin(); j<r.end(); j++)
+      {
+        BBox3fa bounds = empty;
+        if (!mesh->valid(j,&bounds)) continue;
+        const PrimRef prim(bounds,mesh->id,unsigned(j));
+        pinfo.add(bounds,bounds.center2());
+        prims[k++] = prim;
+      }
+      return pinfo;
+    }
+
+    /* user geometries query the bounds of a block of items at once to amortize the callback overhead */
+    template<>
+    __forceinline PrimInfo createPrimRefs<AccelSet>(AccelSet* accel, const range<size_t>& r, mvector<PrimRef>& prims, size_t& k)
+    {
+      PrimInfo pinfo(empty);
+      BBox3fa bounds[AccelSet::MAX_BOUNDS_BLOCK_SIZE];
+      for (size_t b=r.begin(); b<r.end(); b+=AccelSet::MAX_BOUNDS_BLOCK_SIZE)
+      {
+        const size_t e = min(b+AccelSet::MAX_BOUNDS_BLOCK_SIZE,r.end());
+        accel->bounds(b,e,0,bounds);
+        for (size_t j=b; j<e; j++)
+        {
+          const BBox3fa& box = bounds[j-b];
+          if (!isvalid(box)) continue;
+          const PrimRef prim(box,accel->id,unsigned(j));
+          pinfo.add(box,box.center2());
+          prims[k++] = prim;
+        }
+      }
+      return pinfo;
+    }
+
     template<typename Mesh>
     PrimInfo createPrimRefArray(Mesh* mesh, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor)
     {
@@ -32,17 +70,7 @@ namespace embree
       PrimInfo pinfo = parallel_prefix_sum( pstate, size_t(0), mesh->size(), size_t(1024), PrimInfo(empty), [&](const range<size_t>& r, const PrimInfo& base) -> PrimInfo
       {
         size_t k = r.begin();
-        PrimInfo pinfo(empty);
-        for (size_t j=r.begin(); j<r.end(); j++)
-        {
-          BBox3fa bounds = empty;
-          if (!mesh->valid(j,&bounds)) continue;
-
-          const PrimRef prim(bounds,mesh->id,unsigned(j));          
-          pinfo.add(bounds,bounds.center2());
-          prims[k++] = prim;
-        }
-        return pinfo;
+        return createPrimRefs(mesh,r,prims,k);
       }, [](const PrimInfo& a, const PrimInfo& b) -> PrimInfo { return PrimInfo::merge(a,b); });
 
       /* if we need to filter out geometry, run again */
@@ -52,16 +80,7 @@ namespace embree
         pinfo = parallel_prefix_sum( pstate, size_t(0), mesh->size(), size_t(1024), PrimInfo(empty), [&](const range<size_t>& r, const PrimInfo& base) -> PrimInfo
         {
           size_t k = base.size();
-          PrimInfo pinfo(empty);
-          for (size_t j=r.begin(); j<r.end(); j++)
-          {
-            BBox3fa bounds = empty;
-            if (!mesh->valid(j,&bounds)) continue;
-            const PrimRef prim(bounds,mesh->id,unsigned(j));
-            pinfo.add(bounds,bounds.center2());
-            prims[k++] = prim;
-          }
-          return pinfo;
+          return createPrimRefs(mesh,r,prims,k);
         }, [](const PrimInfo& a, const PrimInfo& b) -> PrimInfo { return PrimInfo::merge(a,b); });
       }
       return pinfo;
@@ -78,16 +97,7 @@ namespace embree
       pstate.init(iter,size_t(1024));
       PrimInfo pinfo = parallel_for_for_prefix_sum( pstate, iter, PrimInfo(empty), [&](Mesh* mesh, const range<size_t>& r, size_t k, const PrimInfo& base) -> PrimInfo
       {
-        PrimInfo pinfo(empty);
-        for (size_t j=r.begin(); j<r.end(); j++)
-        {
-          BBox3fa bounds = empty;
-          if (!mesh->valid(j,&bounds)) continue;
-          const PrimRef prim(bounds,mesh->id,unsigned(j));
-          pinfo.add(bounds,bounds.center2());
-          prims[k++] = prim;
-        }
-        return pinfo;
+        return createPrimRefs(mesh,r,prims,k);
       }, [](const PrimInfo& a, const PrimInfo& b) -> PrimInfo { return PrimInfo::merge(a,b); });
       
       /* if we need to filter out geometry, run again */
@@ -97,16 +107,7 @@ namespace embree
         pinfo = parallel_for_for_prefix_sum( pstate, iter, PrimInfo(empty), [&](Mesh* mesh, const range<size_t>& r, size_t k, const PrimInfo& base) -> PrimInfo
         {
           k = base.size();
-          PrimInfo pinfo(empty);
-          for (size_t j=r.begin(); j<r.end(); j++)
-          {
-            BBox3fa bounds = empty;
-            if (!mesh->valid(j,&bounds)) continue;
-            const PrimRef prim(bounds,mesh->id,unsigned(j));
-            pinfo.add(bounds,bounds.center2());
-            prims[k++] = prim;
-          }
-          return pinfo;
+          return createPrimRefs(mesh,r,prims,k);
         }, [](const PrimInfo& a, const PrimInfo& b) -> PrimInfo { return PrimInfo::merge(a,b); });
       }
       return pinfo;
@@ -156,16 +157,14 @@ namespace embree
           if ((ssize_t)ofs < 0 || ofs+3 >= mesh->numVertices())
             continue;
 
-	  Vec3fa p0 = mesh->vertex(ofs+0,0);
-	  Vec3fa p1 = mesh->vertex(ofs+1,0);
-	  Vec3fa p2 = mesh->vertex(ofs+2,0);
-	  Vec3fa p3 = mesh->vertex(ofs+3,0);
-	  if (timeSteps == 2) {
-	    p0 = 0.5f*(p0+mesh->vertex(ofs+0,1));
-	    p1 = 0.5f*(p1+mesh->vertex(ofs+1,1));
-	    p2 = 0.5f*(p2+mesh->vertex(ofs+2,1));
-	    p3 = 0.5f*(p3+mesh->vertex(ofs+3,1));
-	  }
+          Vec3fa p0,p1,p2,p3; mesh->gather(p0,p1,p2,p3,ofs,0);
+          if (timeSteps == 2) {
+            Vec3fa q0,q1,q2,q3; mesh->gather(q0,q1,q2,q3,ofs,1);
+            p0 = 0.5f*(p0+q0);
+            p1 = 0.5f*(p1+q1);
+            p2 = 0.5f*(p2+q2);
+            p3 = 0.5f*(p3+q3);
+          }
           if (!isvalid((vfloat4)p0) || !isvalid((vfloat4)p1) || !isvalid((vfloat4)p2) || !isvalid((vfloat4)p3))
               continue;
 
@@ -191,15 +190,13 @@ namespace embree
             if ((ssize_t)ofs < 0 || ofs+3 >= mesh->numVertices())
               continue;
 
-            Vec3fa p0 = mesh->vertex(ofs+0,0);
-            Vec3fa p1 = mesh->vertex(ofs+1,0);
-            Vec3fa p2 = mesh->vertex(ofs+2,0);
-            Vec3fa p3 = mesh->vertex(ofs+3,0);
+            Vec3fa p0,p1,p2,p3; mesh->gather(p0,p1,p2,p3,ofs,0);
             if (timeSteps == 2) {
-              p0 = 0.5f*(p0+mesh->vertex(ofs+0,1));
-              p1 = 0.5f*(p1+mesh->vertex(ofs+1,1));
-              p2 = 0.5f*(p2+mesh->vertex(ofs+2,1));
-              p3 = 0.5f*(p3+mesh->vertex(ofs+3,1));
+              Vec3fa q0,q1,q2,q3; mesh->gather(q0,q1,q2,q3,ofs,1);
+              p0 = 0.5f*(p0+q0);
+              p1 = 0.5f*(p1+q1);
+              p2 = 0.5f*(p2+q2);
+              p3 = 0.5f*(p3+q3);
             }
             if (!isvalid((vfloat4)p0) || !isvalid((vfloat4)p1) || !isvalid((vfloat4)p2) || !isvalid((vfloat4)p3))
               continue;
@@ -219,6 +216,7 @@ namespace embree
     template PrimInfo createPrimRefArray<QuadMesh>(QuadMesh* mesh, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor);
     template PrimInfo createPrimRefArray<BezierCurves>(BezierCurves* mesh, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor);
     template PrimInfo createPrimRefArray<LineSegments>(LineSegments* mesh, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor);
+    template PrimInfo createPrimRefArray<Points>(Points* mesh, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor);
     template PrimInfo createPrimRefArray<AccelSet>(AccelSet* mesh, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor);
 
     template PrimInfo createPrimRefArray<TriangleMesh,1>(Scene* scene, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor);
@@ -228,6 +226,8 @@ namespace embree
     template PrimInfo createPrimRefArray<BezierCurves,1>(Scene* scene, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor);
     template PrimInfo createPrimRefArray<LineSegments,1>(Scene* scene, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor);
     template PrimInfo createPrimRefArray<LineSegments,2>(Scene* scene, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor);
+    template PrimInfo createPrimRefArray<Points,1>(Scene* scene, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor);
+    template PrimInfo createPrimRefArray<Points,2>(Scene* scene, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor);
     template PrimInfo createPrimRefArray<SubdivMesh,1>(Scene* scene, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor);
     template PrimInfo createPrimRefArray<AccelSet,1>(Scene* scene, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor);
     template PrimInfo createPrimRefArray<AccelSet,2>(Scene* scene, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor);
@@ -19,6 +19,7 @@
 
 #include "../geometry/bezier1v.h"
 #include "../geometry/bezier1i.h"
+#include "../geometry/bezierv.h"
 
 #if defined(EMBREE_GEOMETRY_HAIR)
 
@@ -95,9 +96,9 @@ namespace embree
 
             [&] (size_t depth, const PrimInfo& pinfo, FastAllocator::ThreadLocal2* alloc) -> NodeRef
             {
-              size_t items = pinfo.size();
+              size_t items = Primitive::blocks(pinfo.size());
               size_t start = pinfo.begin;
-              Primitive* accel = (Primitive*) alloc->alloc1.malloc(items*sizeof(Primitive));
+              Primitive* accel = (Primitive*) alloc->alloc1.malloc(items*sizeof(Primitive),BVH::byteNodeAlignment);
               NodeRef node = bvh->encodeLeaf((char*)accel,items);
               for (size_t i=0; i<items; i++) {
                 accel[i].fill(prims.data(),start,pinfo.end,bvh->scene,false);
@@ -105,7 +106,7 @@ namespace embree
               return node;
             },
             progress,
-            prims.data(),pinfo,N,BVH::maxBuildDepthLeaf,1,1,BVH::maxLeafBlocks);
+            prims.data(),pinfo,N,BVH::maxBuildDepthLeaf,__bsf(Primitive::max_size()),Primitive::max_size(),Primitive::max_size()*BVH::maxLeafBlocks);
         
         bvh->set(root,pinfo.geomBounds,pinfo.size());
         
@@ -203,7 +204,7 @@ namespace embree
               return node;
             },
             progress,
-            prims.data(),pinfo,N,BVH::maxBuildDepthLeaf,1,1,BVH::maxLeafBlocks);
+            prims.data(),pinfo,N,BVH::maxBuildDepthLeaf,__bsf(Primitive::max_size()),1,BVH::maxLeafBlocks);
         
         bvh->set(root,pinfo.geomBounds,pinfo.size());
 
@@ -227,11 +228,13 @@ namespace embree
     Builder* BVH4Bezier1vBuilder_OBB_New   (void* bvh, Scene* scene, size_t mode) { return new BVHNHairBuilderSAH<4,Bezier1v>((BVH4*)bvh,scene); }
     Builder* BVH4Bezier1iBuilder_OBB_New   (void* bvh, Scene* scene, size_t mode) { return new BVHNHairBuilderSAH<4,Bezier1i>((BVH4*)bvh,scene); }
     Builder* BVH4Bezier1iMBBuilder_OBB_New (void* bvh, Scene* scene, size_t mode) { return new BVHNHairMBBuilderSAH<4,Bezier1i>((BVH4*)bvh,scene); }
+    Builder* BVH4Bezier4vBuilder_OBB_New   (void* bvh, Scene* scene, size_t mode) { return new BVHNHairBuilderSAH<4,Bezier4v>((BVH4*)bvh,scene); }
 
 #if defined(__AVX__)
     Builder* BVH8Bezier1vBuilder_OBB_New   (void* bvh, Scene* scene, size_t mode) { return new BVHNHairBuilderSAH<8,Bezier1v>((BVH8*)bvh,scene); }
     Builder* BVH8Bezier1iBuilder_OBB_New   (void* bvh, Scene* scene, size_t mode) { return new BVHNHairBuilderSAH<8,Bezier1i>((BVH8*)bvh,scene); }
     Builder* BVH8Bezier1iMBBuilder_OBB_New (void* bvh, Scene* scene, size_t mode) { return new BVHNHairMBBuilderSAH<8,Bezier1i>((BVH8*)bvh,scene); }
+    Builder* BVH8Bezier8vBuilder_OBB_New   (void* bvh, Scene* scene, size_t mode) { return new BVHNHairBuilderSAH<8,Bezier8v>((BVH8*)bvh,scene); }
 #endif
 
   }
@@ -133,14 +133,15 @@ namespace embree
       /*! performs split */
       bool split(const PrimInfo& pinfo, PrimInfo& linfo, PrimInfo& rinfo)
       {
-        /* variable to track the SAH of the best splitting approach */
+        /* variable to track the SAH of the best splitting approach, the
+         * SAH counts leaf blocks of 2^logBlockSize curves */
         float bestSAH = inf;
-        const float leafSAH = intCost*float(pinfo.size())*halfArea(pinfo.geomBounds);
+        const float leafSAH = intCost*pinfo.leafSAH(logBlockSize);
         
         /* perform standard binning in aligned space */
         float alignedObjectSAH = inf;
         HeuristicArrayBinningSAH<BezierPrim>::Split alignedObjectSplit;
-        alignedObjectSplit = alignedHeuristic.find(pinfo,0);
+        alignedObjectSplit = alignedHeuristic.find(pinfo,logBlockSize);
         alignedObjectSAH = travCostAligned*halfArea(pinfo.geomBounds) + intCost*alignedObjectSplit.splitSAH();
         bestSAH = min(alignedObjectSAH,bestSAH);
         
@@ -151,7 +152,7 @@ namespace embree
         if (alignedObjectSAH > 0.7f*leafSAH) {
           uspace = unalignedHeuristic.computeAlignedSpace(pinfo); 
           const PrimInfo       sinfo = unalignedHeuristic.computePrimInfo(pinfo,uspace);
-          unalignedObjectSplit = unalignedHeuristic.find(sinfo,0,uspace);    	
+          unalignedObjectSplit = unalignedHeuristic.find(sinfo,logBlockSize,uspace);    	
           unalignedObjectSAH = travCostUnaligned*halfArea(pinfo.geomBounds) + intCost*unalignedObjectSplit.splitSAH();
           bestSAH = min(unalignedObjectSAH,bestSAH);
         }
@@ -160,7 +161,7 @@ namespace embree
         HeuristicStrandSplit::Split strandSplit;
         float strandSAH = inf;
         if (alignedObjectSAH > 0.6f*leafSAH) {
-          strandSplit = strandHeuristic.find(pinfo);
+          strandSplit = strandHeuristic.find(pinfo,logBlockSize);
           strandSAH = travCostUnaligned*halfArea(pinfo.geomBounds) + intCost*strandSplit.splitSAH();
           bestSAH = min(strandSAH,bestSAH);
         }
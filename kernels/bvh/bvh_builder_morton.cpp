@@ -230,7 +230,7 @@ namespace embree
         *current.parent = BVH::encodeLeaf((char*)accel,1);
         
         vint4 vgeomID = -1, vprimID = -1;
-        Vec3f* v0[4] = { nullptr, nullptr, nullptr, nullptr };
+        const Vec3f* v0[4];
         vint4 v1 = zero, v2 = zero;
         
         for (size_t i=0; i<items; i++)
@@ -247,15 +247,13 @@ namespace embree
           upper = max(upper,(vfloat4)p0,(vfloat4)p1,(vfloat4)p2);
           vgeomID[i] = geomID;
           vprimID[i] = primID;
-          v0[i] = (Vec3f*) mesh->vertexPtr(tri.v[0]); 
-          v1[i] = int(ssize_t((int*)   mesh->vertexPtr(tri.v[1])-(int*)v0[i])); 
-          v2[i] = int(ssize_t((int*)   mesh->vertexPtr(tri.v[2])-(int*)v0[i])); 
+          Triangle4i::encode(mesh,tri,v0[i],v1[i],v2[i]);
         }
         
         for (size_t i=items; i<4; i++)
         {
-          vgeomID[i] = -1;
-          vprimID[i] = -1;
+          vgeomID[i] = vgeomID[0]; // always valid geomIDs
+          vprimID[i] = -1;         // indicates invalid data
           v0[i] = v0[0];
           v1[i] = 0; 
           v2[i] = 0;
@@ -23,9 +23,11 @@
 #include "../geometry/bezier1v.h"
 #include "../geometry/bezier1i.h"
 #include "../geometry/linei.h"
+#include "../geometry/pointi.h"
 #include "../geometry/triangle.h"
 #include "../geometry/trianglev.h"
 #include "../geometry/trianglei.h"
+#include "../geometry/trianglec.h"
 #include "../geometry/trianglev_mb.h"
 #include "../geometry/quadv.h"
 #include "../geometry/quadi.h"
@@ -44,6 +46,55 @@ namespace embree
     static const float travCost = 1.0f;
     static const float defaultPresplitFactor = 1.2f;
 
+    /*! returns the number of primitive references to allocate including
+     *  the headroom for splits, the headroom shrinks to stay inside the
+     *  build memory budget of the device */
+    static size_t numPrimRefsInBudget(const Device* device, const size_t numPrimitives, const size_t numSplitPrimitives)
+    {
+      if (device->build_memory_budget == 0) 
+        return max(numPrimitives,numSplitPrimitives);
+
+      const size_t maxPrimitives = device->build_memory_budget/sizeof(PrimRef);
+      if (numPrimitives > maxPrimitives)
+        throw_RTCError(RTC_OUT_OF_MEMORY,"build memory budget exceeded");
+      return min(max(numPrimitives,numSplitPrimitives),maxPrimitives);
+    }
+
+    static size_t numPrimRefsInBudget(const Device* device, const size_t numPrimitives, const float splitFactor) {
+      return numPrimRefsInBudget(device,numPrimitives,size_t(splitFactor*numPrimitives));
+    }
+
+    /*! settings of the SAH builders, build settings specified at scene creation override the defaults of each builder */
+    struct SAHSettings
+    {
+      __forceinline SAHSettings (const Scene* scene, const size_t sahBlockSize, const float intCost, const size_t minLeafSize, const size_t maxLeafSize, const size_t maxLeafSizeLimit)
+        : sahBlockSize(sahBlockSize), travCost(isa::travCost), intCost(intCost), minLeafSize(minLeafSize), maxLeafSize(maxLeafSize)
+      {
+        if (scene && scene->hasBuildSettings)
+        {
+          const RTCBuildSettings& settings = scene->buildSettings;
+          this->sahBlockSize = settings.sahBlockSize;
+          this->travCost     = settings.travCost;
+          this->intCost      = settings.intCost;
+          this->minLeafSize  = settings.minLeafSize;
+          this->maxLeafSize  = settings.maxLeafSize;
+        }
+        this->maxLeafSize = min(this->maxLeafSize,maxLeafSizeLimit);
+        this->minLeafSize = min(this->minLeafSize,this->maxLeafSize);
+      }
+
+    public:
+      size_t sahBlockSize;
+      float travCost;
+      float intCost;
+      size_t minLeafSize;
+      size_t maxLeafSize;
+    };
+
+    /*! maximal number of primitives of a leaf with the specified number of primitive blocks */
+    template<typename Primitive>
+      __forceinline size_t maxLeafSizeLimit(const size_t maxLeafBlocks) { return Primitive::max_size()*maxLeafBlocks; }
+
     typedef FastAllocator::ThreadLocal2 Allocator;
 
     template<int N, typename Primitive>
@@ -71,6 +122,62 @@ namespace embree
       PrimRef* prims;
     };
 
+    /*! the number of triangles per compressed block depends on how many vertices they share, thus the blocks are counted before allocating the leaf */
+    template<int N>
+    struct CreateLeaf<N,Triangle4c>
+    {
+      typedef BVHN<N> BVH;
+      typedef typename BVH::Node Node;
+      typedef typename BVH::NodeRef NodeRef;
+
+      __forceinline CreateLeaf (BVH* bvh, PrimRef* prims) : bvh(bvh), prims(prims) {}
+      
+      __forceinline size_t operator() (const BVHBuilderBinnedSAH::BuildRecord& current, Allocator* alloc)
+      {
+        size_t n = current.prims.size();
+        size_t start = current.prims.begin();
+        size_t end = current.prims.end();
+        size_t items = Triangle4c::blocks(prims,start,end,bvh->scene);
+        if (likely(items <= BVH::maxLeafBlocks)) {
+          *current.parent = createLeaf(start,end,items,alloc);
+          return n;
+        }
+
+        /* triangles that share few vertices need more blocks than a leaf
+         * can reference, such leaves get distributed over the children of
+         * an additional node, which always suffices as each block holds at
+         * least one triangle and leaves have at most 4*maxLeafBlocks triangles */
+        assert(n <= N*BVH::maxLeafBlocks);
+        Node* node = (Node*) alloc->alloc0.malloc(sizeof(Node),BVH::byteNodeAlignment); node->clear();
+        for (size_t i=0; i<N && start<end; i++)
+        {
+          const size_t begin = start;
+          size_t blocks = 0;
+          for (; blocks<BVH::maxLeafBlocks && start<end; blocks++)
+            start += Triangle4c::group(prims,start,end,bvh->scene);
+
+          BBox3fa bounds = empty;
+          for (size_t j=begin; j<start; j++) bounds.extend(prims[j].bounds());
+          node->set(i,bounds,createLeaf(begin,start,blocks,alloc));
+        }
+        assert(start == end);
+        *current.parent = BVH::encodeNode(node);
+	return n;
+      }
+
+      __forceinline NodeRef createLeaf(size_t start, const size_t end, const size_t items, Allocator* alloc)
+      {
+        Triangle4c* accel = (Triangle4c*) alloc->alloc1.malloc(items*sizeof(Triangle4c),BVH::byteNodeAlignment);
+        for (size_t i=0; i<items; i++) {
+          accel[i].fill(prims,start,end,bvh->scene,false);
+        }
+        return BVH::encodeLeaf((char*)accel,items);
+      }
+
+      BVH* bvh;
+      PrimRef* prims;
+    };
+
 
     template<int N, typename Primitive>
     struct CreateLeafQuantized
@@ -155,19 +262,16 @@ namespace embree
       Scene* scene;
       Mesh* mesh;
       mvector<PrimRef> prims;
-      const size_t sahBlockSize;
-      const float intCost;
-      const size_t minLeafSize;
-      const size_t maxLeafSize;
+      const SAHSettings settings;
       const float presplitFactor;
 
       BVHNBuilderSAH (BVH* bvh, Scene* scene, const size_t sahBlockSize, const float intCost, const size_t minLeafSize, const size_t maxLeafSize, const size_t mode)
-        : bvh(bvh), scene(scene), mesh(nullptr), prims(scene->device), sahBlockSize(sahBlockSize), intCost(intCost), minLeafSize(minLeafSize), maxLeafSize(min(maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks)),
+        : bvh(bvh), scene(scene), mesh(nullptr), prims(scene->device), settings(scene,sahBlockSize,intCost,minLeafSize,maxLeafSize,maxLeafSizeLimit<Primitive>(BVH::maxLeafBlocks)),
           presplitFactor((mode & MODE_HIGH_QUALITY) ? defaultPresplitFactor : 1.0f) {}
 
 
       BVHNBuilderSAH (BVH* bvh, Mesh* mesh, const size_t sahBlockSize, const float intCost, const size_t minLeafSize, const size_t maxLeafSize, const size_t mode)
-        : bvh(bvh), scene(nullptr), mesh(mesh), prims(bvh->device), sahBlockSize(sahBlockSize), intCost(intCost), minLeafSize(minLeafSize), maxLeafSize(min(maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks)),
+        : bvh(bvh), scene(nullptr), mesh(mesh), prims(bvh->device), settings(mesh->parent,sahBlockSize,intCost,minLeafSize,maxLeafSize,maxLeafSizeLimit<Primitive>(BVH::maxLeafBlocks)),
           presplitFactor((mode & MODE_HIGH_QUALITY ) ? defaultPresplitFactor : 1.0f) {}
 
       // FIXME: shrink bvh->alloc in destructor here and in other builders too
@@ -189,19 +293,19 @@ namespace embree
 #endif
 
             /* create primref array */
-            const size_t numSplitPrimitives = max(numPrimitives,size_t(presplitFactor*numPrimitives));
+            const size_t numSplitPrimitives = numPrimRefsInBudget(bvh->device,numPrimitives,presplitFactor);
             prims.resize(numSplitPrimitives);
             PrimInfo pinfo = mesh ? 
               createPrimRefArray<Mesh>  (mesh ,prims,bvh->scene->progressInterface) : 
               createPrimRefArray<Mesh,1>(scene,prims,bvh->scene->progressInterface);
         
             /* perform pre-splitting */
-            if (presplitFactor > 1.0f) 
+            if (presplitFactor > 1.0f && numSplitPrimitives > numPrimitives) 
               pinfo = presplit<Mesh>(scene, pinfo, prims);
         
             /* call BVH builder */
             bvh->alloc.init_estimate(pinfo.size()*sizeof(PrimRef));
-            BVHNBuilder<N>::build(bvh,CreateLeaf<N,Primitive>(bvh,prims.data()),bvh->scene->progressInterface,prims.data(),pinfo,sahBlockSize,minLeafSize,maxLeafSize,travCost,intCost);
+            BVHNBuilder<N>::build(bvh,CreateLeaf<N,Primitive>(bvh,prims.data()),bvh->scene->progressInterface,prims.data(),pinfo,settings.sahBlockSize,settings.minLeafSize,settings.maxLeafSize,settings.travCost,settings.intCost);
 
 #if PROFILE
           }); 
@@ -235,18 +339,15 @@ namespace embree
       Scene* scene;
       Mesh* mesh;
       mvector<PrimRef> prims;
-      const size_t sahBlockSize;
-      const float intCost;
-      const size_t minLeafSize;
-      const size_t maxLeafSize;
+      const SAHSettings settings;
       const float presplitFactor;
 
       BVHNBuilderSAHQuantized (BVH* bvh, Scene* scene, const size_t sahBlockSize, const float intCost, const size_t minLeafSize, const size_t maxLeafSize, const size_t mode)
-        : bvh(bvh), scene(scene), mesh(nullptr), prims(scene->device), sahBlockSize(sahBlockSize), intCost(intCost), minLeafSize(minLeafSize), maxLeafSize(min(maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks)),
+        : bvh(bvh), scene(scene), mesh(nullptr), prims(scene->device), settings(scene,sahBlockSize,intCost,minLeafSize,maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks),
           presplitFactor((mode & MODE_HIGH_QUALITY) ? defaultPresplitFactor : 1.0f) {}
 
       BVHNBuilderSAHQuantized (BVH* bvh, Mesh* mesh, const size_t sahBlockSize, const float intCost, const size_t minLeafSize, const size_t maxLeafSize, const size_t mode)
-        : bvh(bvh), scene(nullptr), mesh(mesh), prims(bvh->device), sahBlockSize(sahBlockSize), intCost(intCost), minLeafSize(minLeafSize), maxLeafSize(min(maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks)),
+        : bvh(bvh), scene(nullptr), mesh(mesh), prims(bvh->device), settings(mesh->parent,sahBlockSize,intCost,minLeafSize,maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks),
           presplitFactor((mode & MODE_HIGH_QUALITY) ? defaultPresplitFactor : 1.0f) {}
 
       // FIXME: shrink bvh->alloc in destructor here and in other builders too
@@ -267,19 +368,19 @@ namespace embree
         profile(2,PROFILE_RUNS,numPrimitives,[&] (ProfileTimer& timer) {
 #endif
             /* create primref array */
-            const size_t numSplitPrimitives = max(numPrimitives,size_t(presplitFactor*numPrimitives));
+            const size_t numSplitPrimitives = numPrimRefsInBudget(bvh->device,numPrimitives,presplitFactor);
             prims.resize(numSplitPrimitives);
             PrimInfo pinfo = mesh ? 
               createPrimRefArray<Mesh>  (mesh ,prims,bvh->scene->progressInterface) : 
               createPrimRefArray<Mesh,1>(scene,prims,bvh->scene->progressInterface);
         
             /* perform pre-splitting */
-            if (presplitFactor > 1.0f) 
+            if (presplitFactor > 1.0f && numSplitPrimitives > numPrimitives) 
               pinfo = presplit<Mesh>(scene, pinfo, prims);
         
             /* call BVH builder */
             bvh->alloc.init_estimate(pinfo.size()*sizeof(PrimRef));
-            BVHNBuilderQuantized<N>::build(bvh,CreateLeafQuantized<N,Primitive>(bvh,prims.data()),bvh->scene->progressInterface,prims.data(),pinfo,sahBlockSize,minLeafSize,maxLeafSize,travCost,intCost);
+            BVHNBuilderQuantized<N>::build(bvh,CreateLeafQuantized<N,Primitive>(bvh,prims.data()),bvh->scene->progressInterface,prims.data(),pinfo,settings.sahBlockSize,settings.minLeafSize,settings.maxLeafSize,settings.travCost,settings.intCost);
 
 #if PROFILE
           }); 
@@ -347,15 +448,12 @@ namespace embree
       typedef BVHN<N> BVH;
       BVH* bvh;
       Scene* scene;
-      const size_t sahBlockSize;
-      const float intCost;
-      const size_t minLeafSize;
-      const size_t maxLeafSize;
+      const SAHSettings settings;
       const float presplitFactor;
 
       BVHNBuilderSpatialSAH (BVH* bvh, Scene* scene, const size_t sahBlockSize,
                              const float intCost, const size_t minLeafSize, const size_t maxLeafSize, const size_t mode)
-        : bvh(bvh), scene(scene), sahBlockSize(sahBlockSize), intCost(intCost), minLeafSize(minLeafSize), maxLeafSize(min(maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks)),
+        : bvh(bvh), scene(scene), settings(scene,sahBlockSize,intCost,minLeafSize,maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks),
           presplitFactor((mode & MODE_HIGH_QUALITY) ? defaultPresplitFactor : 1.0f) {}
 
       void build(size_t, size_t) 
@@ -367,6 +465,9 @@ namespace embree
           return;
         }
         double t0 = bvh->preBuild(TOSTRING(isa) "::BVH" + toString(N) + "BuilderSpatialSAH");
+
+        /* fail early if the plain primitive references exceed the build memory budget */
+        numPrimRefsInBudget(bvh->device,numPrimitives,numPrimitives);
         
         /* create primref list */
         PrimRefList prims;
@@ -388,7 +489,7 @@ namespace embree
         /* calculate maximal number of spatial splits per primitive */
         float f = 10.0f;
         iter = prims;
-        parallel_reduce(size_t(0),threadCount,size_t(0), [&] (const range<size_t>& r) -> size_t
+        const size_t numSplitPrimitives = parallel_reduce(size_t(0),threadCount,size_t(0), [&] (const range<size_t>& r) -> size_t
                         {
                           size_t num = 0;
                           while (PrimRefList::item* block = iter.next()) {
@@ -405,6 +506,30 @@ namespace embree
                           }
                           return num;
                         },std::plus<size_t>());
+
+        /* a primitive with n splits produces at most n references, thus
+         * the splits beyond the first get scaled down to fit the budget */
+        const size_t numBudgetPrimitives = numPrimRefsInBudget(bvh->device,numPrimitives,numSplitPrimitives);
+        if (numBudgetPrimitives < numSplitPrimitives)
+        {
+          const double scale = double(numBudgetPrimitives-numPrimitives)/double(numSplitPrimitives-numPrimitives);
+          iter = prims;
+          parallel_for(size_t(0),threadCount,[&] (const range<size_t>& r)
+                       {
+                         while (PrimRefList::item* block = iter.next()) {
+                           for (size_t i=0; i<block->size(); i++) {
+                             PrimRef& prim = block->at(i);
+                             const size_t n = 1+size_t(scale*double((prim.lower.a >> 24)-1));
+                             prim.lower.a = (prim.lower.a & 0x00FFFFFF) | (n << 24);
+                           }
+                         }
+                       });
+        }
+
+        /* the reference blocks of the list are not allocated through the
+         * device, thus the memory monitor gets the budget of the build */
+        const ssize_t bytesPrimRefs = numBudgetPrimitives*sizeof(PrimRef);
+        bvh->device->memoryMonitor(bytesPrimRefs,false);
         
         /* function that splits a primitive at some position and dimension */
         auto splitPrimitive = [&] (const PrimRef& prim, int dim, float pos, PrimRef& left_o, PrimRef& right_o) {
@@ -418,11 +543,18 @@ namespace embree
              
         /* call BVH builder */
         bvh->alloc.init_estimate(pinfo.size()*sizeof(PrimRef));
-        BVHNBuilderSpatial<N>::build(bvh,
-                                     splitPrimitive,
-                                     CreateListLeaf<N,Primitive>(bvh),
-                                     bvh->scene->progressInterface,prims,pinfo,
-                                     sahBlockSize,minLeafSize,maxLeafSize,travCost,intCost);
+        try {
+          BVHNBuilderSpatial<N>::build(bvh,
+                                       splitPrimitive,
+                                       CreateListLeaf<N,Primitive>(bvh),
+                                       bvh->scene->progressInterface,prims,pinfo,
+                                       settings.sahBlockSize,settings.minLeafSize,settings.maxLeafSize,settings.travCost,settings.intCost);
+        }
+        catch (...) {
+          bvh->device->memoryMonitor(-bytesPrimRefs,true);
+          throw;
+        }
+        bvh->device->memoryMonitor(-bytesPrimRefs,true);
         
         /* clear temporary data for static geometry */
 	if (scene->isStatic()) bvh->shrink();
@@ -475,16 +607,13 @@ namespace embree
       Scene* scene;
       Mesh* mesh;
       mvector<PrimRef> prims; 
-      const size_t sahBlockSize;
-      const float intCost;
-      const size_t minLeafSize;
-      const size_t maxLeafSize;
+      const SAHSettings settings;
 
       BVHNBuilderMblurSAH (BVH* bvh, Scene* scene, const size_t sahBlockSize, const float intCost, const size_t minLeafSize, const size_t maxLeafSize)
-        : bvh(bvh), scene(scene), mesh(nullptr), prims(scene->device), sahBlockSize(sahBlockSize), intCost(intCost), minLeafSize(minLeafSize), maxLeafSize(min(maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks)) {}
+        : bvh(bvh), scene(scene), mesh(nullptr), prims(scene->device), settings(scene,sahBlockSize,intCost,minLeafSize,maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks) {}
 
       BVHNBuilderMblurSAH (BVH* bvh, Mesh* mesh, const size_t sahBlockSize, const float intCost, const size_t minLeafSize, const size_t maxLeafSize)
-        : bvh(bvh), scene(nullptr), mesh(mesh), prims(mesh->parent->device), sahBlockSize(sahBlockSize), intCost(intCost), minLeafSize(minLeafSize), maxLeafSize(min(maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks)) {}
+        : bvh(bvh), scene(nullptr), mesh(mesh), prims(mesh->parent->device), settings(mesh->parent,sahBlockSize,intCost,minLeafSize,maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks) {}
 
       void build(size_t, size_t) 
       {
@@ -499,7 +628,7 @@ namespace embree
         double t0 = bvh->preBuild(mesh ? "" : TOSTRING(isa) "::BVH" + toString(N) + "BuilderMblurSAH");
 	    
         //bvh->alloc.init_estimate(numPrimitives*sizeof(PrimRef));
-        prims.resize(numPrimitives);
+        prims.resize(numPrimRefsInBudget(bvh->device,numPrimitives,1.0f));
         const PrimInfo pinfo = mesh ? 
           createPrimRefArray<Mesh>(mesh,prims,bvh->scene->progressInterface) : 
           createPrimRefArray<Mesh,2>(scene,prims,bvh->scene->progressInterface);
@@ -507,7 +636,7 @@ namespace embree
         /* call BVH builder */
         bvh->alloc.init_estimate(pinfo.size()*sizeof(PrimRef));
         BVHNBuilderMblur<N>::build(bvh,CreateLeafMB<N,Primitive>(bvh,prims.data()),bvh->scene->progressInterface,prims.data(),pinfo,
-                                   sahBlockSize,minLeafSize,maxLeafSize,travCost,intCost);
+                                   settings.sahBlockSize,settings.minLeafSize,settings.maxLeafSize,settings.travCost,settings.intCost);
 
 	/* clear temporary data for static geometry */
 	bool staticGeom = mesh ? mesh->isStatic() : scene->isStatic();
@@ -538,19 +667,16 @@ namespace embree
       Scene* scene;
       Mesh* mesh;
       mvector<PrimRef> prims0;
-      const size_t sahBlockSize;
-      const float intCost;
-      const size_t minLeafSize;
-      const size_t maxLeafSize;
+      const SAHSettings settings;
       const float splitFactor;
 
       BVHNBuilderFastSpatialSAH (BVH* bvh, Scene* scene, const size_t sahBlockSize, const float intCost, const size_t minLeafSize, const size_t maxLeafSize, const size_t mode)
-        : bvh(bvh), scene(scene), mesh(nullptr), prims0(scene->device), sahBlockSize(sahBlockSize), intCost(intCost), minLeafSize(minLeafSize), maxLeafSize(min(maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks)),
+        : bvh(bvh), scene(scene), mesh(nullptr), prims0(scene->device), settings(scene,sahBlockSize,intCost,minLeafSize,maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks),
           splitFactor(scene->device->tri_builder_replication_factor) {}
 
       BVHNBuilderFastSpatialSAH (BVH* bvh, Mesh* mesh, const size_t sahBlockSize, const float intCost, const size_t minLeafSize, const size_t maxLeafSize, const size_t mode)
-        : bvh(bvh), scene(nullptr), mesh(mesh), prims0(bvh->device), sahBlockSize(sahBlockSize), intCost(intCost), minLeafSize(minLeafSize), maxLeafSize(min(maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks)),
-          splitFactor(scene->device->tri_builder_replication_factor) {}
+        : bvh(bvh), scene(nullptr), mesh(mesh), prims0(bvh->device), settings(mesh->parent,sahBlockSize,intCost,minLeafSize,maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks),
+          splitFactor(mesh->parent->device->tri_builder_replication_factor) {}
 
       // FIXME: shrink bvh->alloc in destructor here and in other builders too
 
@@ -567,7 +693,7 @@ namespace embree
         double t0 = bvh->preBuild(mesh ? "" : TOSTRING(isa) "::BVH" + toString(N) + "BuilderFastSpatialSAH");
 
         /* create primref array */
-        const size_t numSplitPrimitives = max(numOriginalPrimitives,size_t(splitFactor*numOriginalPrimitives));
+        const size_t numSplitPrimitives = numPrimRefsInBudget(bvh->device,numOriginalPrimitives,splitFactor);
         prims0.resize(numSplitPrimitives);
         PrimInfo pinfo = mesh ? 
           createPrimRefArray<Mesh>  (mesh ,prims0,bvh->scene->progressInterface) : 
@@ -595,54 +721,19 @@ namespace embree
         
         /* function that splits a primitive at some position and dimension */
         auto splitPrimitive = [&] (const PrimRef& prim, int dim, float pos, PrimRef& left_o, PrimRef& right_o) {
-          TriangleMesh* mesh = (TriangleMesh*) scene->get(prim.geomID() & 0x00FFFFFF );  
-          TriangleMesh::Triangle tri = mesh->triangle(prim.primID());
-          const Vec3fa &v0 = mesh->vertex(tri.v[0]);
-          const Vec3fa &v1 = mesh->vertex(tri.v[1]);
-          const Vec3fa &v2 = mesh->vertex(tri.v[2]);
-
-          splitTriangle(prim,dim,pos,v0,v1,v2,left_o,right_o);
-#if 0
-          PrimRefBoundsN<8> left8,right8;
-          const vfloat8 pos8(pos);
-          splitTriangleN<8> (prim,dim,pos,v0,v1,v2,left8,right8);
-          BBox3fa lo = left8.extract(0);
-          BBox3fa ro = right8.extract(0);
-
-          //PrimRef lo,ro;
-          //splitTriangle2(prim,dim,pos,v0,v1,v2,lo,ro);
-          //if (left_o.bounds() != lo || right_o.bounds() != ro)
-          if ((movemask(abs(right_o.bounds().lower-ro.lower) >= Vec3fa(1E-4f)) & 0x7) != 0)
-          {
-#if 0
-            std::cout << std::setprecision(15);
-            PRINT(left_o.bounds());
-            PRINT(right_o.bounds());
-            PRINT(lo);
-            PRINT(ro);
-            PRINT(abs(left_o.bounds().lower-lo.lower));
-            PRINT(abs(left_o.bounds().upper-lo.upper));
-            PRINT(abs(right_o.bounds().lower-ro.lower));
-            PRINT(abs(right_o.bounds().upper-ro.upper));
-#endif
-            //assert((movemask(abs(left_o.bounds().lower-lo.lower) >= Vec3fa(1E-4f)) & 0x7) == 0);
-            //assert((movemask(abs(left_o.bounds().upper-lo.upper) >= Vec3fa(1E-4f)) & 0x7) == 0);
-            //assert((movemask(abs(right_o.bounds().lower-ro.lower) >= Vec3fa(1E-4f)) & 0x7) == 0);
-            //assert((movemask(abs(right_o.bounds().upper-ro.upper) >= Vec3fa(1E-4f)) & 0x7) == 0);
-
-          }
-          //assert(left_o.bounds() == lo);
-          //assert(right_o.bounds() == ro);
-#endif
+          splitPrimRef<Mesh>(bvh->scene,prim,dim,pos,left_o,right_o);
         };
 
         auto splitPrimitive2 = [&] (SpatialBinInfo<FAST_SPATIAL_BUILDER_NUM_SPATIAL_SPLITS,PrimRef> &binner, 
                                     const PrimRef* const source, const size_t begin, const size_t end, 
                                     const SpatialBinMapping<FAST_SPATIAL_BUILDER_NUM_SPATIAL_SPLITS> &mapping)
           {
-#if 0
-            binner.bin(splitPrimitive,source,begin,end,mapping);
-#else
+            /* only triangles have a specialized binning of split primitives */
+            if (!std::is_same<Mesh,TriangleMesh>::value) {
+              binner.bin(splitPrimitive,source,begin,end,mapping);
+              return;
+            }
+
             for (size_t i=begin; i<end; i++)
             {
               const PrimRef &prim = source[i];
@@ -674,8 +765,8 @@ namespace embree
                   const size_t bin_start = bin0[dim];
                   const size_t bin_end   = bin1[dim];
                   BBox3fa rest = prim.bounds();
-                  TriangleMesh* mesh = (TriangleMesh*) scene->get(prim.geomID() & 0x00FFFFFF );  
-                  TriangleMesh::Triangle tri = mesh->triangle(prim.primID());
+                  const TriangleMesh* mesh = bvh->scene->getTriangleMesh(prim.geomID() & 0x00FFFFFF);
+                  const TriangleMesh::Triangle& tri = mesh->triangle(prim.primID());
                   const Vec3fa v[4] = { mesh->vertex(tri.v[0]), 
                                         mesh->vertex(tri.v[1]), 
                                         mesh->vertex(tri.v[2]),
@@ -701,7 +792,6 @@ namespace embree
                 }
               }
             }              
-#endif
           };
 
 
@@ -716,8 +806,8 @@ namespace embree
                                                                                  prims0.data(),
                                                                                  numSplitPrimitives,
                                                                                  pinfo,
-                                                                                 sahBlockSize,minLeafSize,maxLeafSize,
-                                                                                 travCost,intCost);
+                                                                                 settings.sahBlockSize,settings.minLeafSize,settings.maxLeafSize,
+                                                                                 settings.travCost,settings.intCost);
         
 	/* clear temporary data for static geometry */
 	bool staticGeom = mesh ? mesh->isStatic() : scene->isStatic();
@@ -740,12 +830,23 @@ namespace embree
     Builder* BVH4Line4iSceneBuilderSAH     (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<4,LineSegments,Line4i>((BVH4*)bvh,scene,4,1.0f,4,inf,mode); }
     Builder* BVH4Line4iMBSceneBuilderSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderMblurSAH<4,LineSegments,Line4i>((BVH4*)bvh,scene ,4,1.0f,4,inf); }
     Builder* BVH4Line4iMBMeshBuilderSAH  (void* bvh, LineSegments* mesh, size_t mode) { return new BVHNBuilderMblurSAH<4,LineSegments,Line4i>((BVH4*)bvh,mesh ,4,1.0f,4,inf); }
+    Builder* BVH4Line4iSceneBuilderFastSpatialSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderFastSpatialSAH<4,LineSegments,Line4i>((BVH4*)bvh,scene,4,1.0f,4,inf,mode); }
 #if defined(__AVX__)
     Builder* BVH8Line4iSceneBuilderSAH     (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<8,LineSegments,Line4i>((BVH8*)bvh,scene,4,1.0f,4,inf,mode); }
+    Builder* BVH8Line4iSceneBuilderFastSpatialSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderFastSpatialSAH<8,LineSegments,Line4i>((BVH8*)bvh,scene,4,1.0f,4,inf,mode); }
     Builder* BVH8Line4iMBSceneBuilderSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderMblurSAH<8,LineSegments,Line4i>((BVH8*)bvh,scene,4,1.0f,4,inf); }
 #endif
 #endif
 
+#if defined(EMBREE_GEOMETRY_POINTS)
+    Builder* BVH4Point4iSceneBuilderSAH   (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<4,Points,Point4i>((BVH4*)bvh,scene,4,1.0f,4,inf,mode); }
+    Builder* BVH4Point4iMBSceneBuilderSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderMblurSAH<4,Points,Point4i>((BVH4*)bvh,scene,4,1.0f,4,inf); }
+#if defined(__AVX__)
+    Builder* BVH8Point4iSceneBuilderSAH   (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<8,Points,Point4i>((BVH8*)bvh,scene,4,1.0f,4,inf,mode); }
+    Builder* BVH8Point4iMBSceneBuilderSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderMblurSAH<8,Points,Point4i>((BVH8*)bvh,scene,4,1.0f,4,inf); }
+#endif
+#endif
+
 #if defined(EMBREE_GEOMETRY_HAIR)
     Builder* BVH4Bezier1vSceneBuilderSAH   (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<4,BezierCurves,Bezier1v>((BVH4*)bvh,scene,1,1.0f,1,1,mode); }
     Builder* BVH4Bezier1iSceneBuilderSAH   (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<4,BezierCurves,Bezier1i>((BVH4*)bvh,scene,1,1.0f,1,1,mode); }
@@ -759,6 +860,7 @@ namespace embree
     Builder* BVH4Triangle4SceneBuilderSAH  (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<4,TriangleMesh,Triangle4>((BVH4*)bvh,scene,4,1.0f,4,inf,mode); }
     Builder* BVH4Triangle4vSceneBuilderSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<4,TriangleMesh,Triangle4v>((BVH4*)bvh,scene,4,1.0f,4,inf,mode); }
     Builder* BVH4Triangle4iSceneBuilderSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<4,TriangleMesh,Triangle4i>((BVH4*)bvh,scene,4,1.0f,4,inf,mode); }
+    Builder* BVH4Triangle4cSceneBuilderSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<4,TriangleMesh,Triangle4c>((BVH4*)bvh,scene,4,1.0f,4,inf,mode); }
 
     Builder* BVH4Triangle4vMBMeshBuilderSAH  (void* bvh, TriangleMesh* mesh, size_t mode) { return new BVHNBuilderMblurSAH<4,TriangleMesh,Triangle4vMB>((BVH4*)bvh,mesh ,4,1.0f,4,inf); }
     Builder* BVH4Triangle4vMBSceneBuilderSAH (void* bvh, Scene* scene,       size_t mode) { return new BVHNBuilderMblurSAH<4,TriangleMesh,Triangle4vMB>((BVH4*)bvh,scene,4,1.0f,4,inf); }
@@ -797,12 +899,16 @@ namespace embree
     Builder* BVH4Quad4iMBMeshBuilderSAH  (void* bvh, QuadMesh* mesh, size_t mode) { return new BVHNBuilderMblurSAH<4,QuadMesh,Quad4iMB>((BVH4*)bvh,mesh ,4,1.0f,4,inf); }
     Builder* BVH4QuantizedQuad4vSceneBuilderSAH     (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAHQuantized<4,QuadMesh,Quad4v>((BVH4*)bvh,scene,4,1.0f,4,inf,mode); }
     Builder* BVH4QuantizedQuad4iSceneBuilderSAH     (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAHQuantized<4,QuadMesh,Quad4i>((BVH4*)bvh,scene,4,1.0f,4,inf,mode); }
+    Builder* BVH4Quad4vSceneBuilderFastSpatialSAH  (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderFastSpatialSAH<4,QuadMesh,Quad4v>((BVH4*)bvh,scene,4,1.0f,4,inf,mode); }
+    Builder* BVH4Quad4iSceneBuilderFastSpatialSAH  (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderFastSpatialSAH<4,QuadMesh,Quad4i>((BVH4*)bvh,scene,4,1.0f,4,inf,mode); }
 #if defined(__AVX__)
     Builder* BVH8Quad4vSceneBuilderSAH     (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<8,QuadMesh,Quad4v>((BVH8*)bvh,scene,4,1.0f,4,inf,mode); }
     Builder* BVH8Quad4iSceneBuilderSAH     (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<8,QuadMesh,Quad4i>((BVH8*)bvh,scene,4,1.0f,4,inf,mode); }
     Builder* BVH8Quad4iMBSceneBuilderSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderMblurSAH<8,QuadMesh,Quad4iMB>((BVH8*)bvh,scene,4,1.0f,4,inf); }
     Builder* BVH8QuantizedQuad4vSceneBuilderSAH     (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAHQuantized<8,QuadMesh,Quad4v>((BVH8*)bvh,scene,4,1.0f,4,inf,mode); }
     Builder* BVH8QuantizedQuad4iSceneBuilderSAH     (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAHQuantized<8,QuadMesh,Quad4i>((BVH8*)bvh,scene,4,1.0f,4,inf,mode); }
+    Builder* BVH8Quad4vSceneBuilderFastSpatialSAH  (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderFastSpatialSAH<8,QuadMesh,Quad4v>((BVH8*)bvh,scene,4,1.0f,4,inf,mode); }
+    Builder* BVH8Quad4iSceneBuilderFastSpatialSAH  (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderFastSpatialSAH<8,QuadMesh,Quad4i>((BVH8*)bvh,scene,4,1.0f,4,inf,mode); }
 #endif
 #endif
 
@@ -25,10 +25,13 @@
 #include "../geometry/intersector_iterators.h"
 #include "../geometry/bezier1v_intersector.h"
 #include "../geometry/bezier1i_intersector.h"
+#include "../geometry/bezierv_intersector.h"
 #include "../geometry/linei_intersector.h"
+#include "../geometry/pointi_intersector.h"
 #include "../geometry/triangle_intersector_moeller.h"
 #include "../geometry/triangle_intersector_pluecker.h"
 #include "../geometry/triangle4i_intersector_pluecker.h"
+#include "../geometry/triangle4c_intersector_pluecker.h"
 #include "../geometry/subdivpatch1cached_intersector1.h"
 #include "../geometry/grid_aos_intersector1.h"
 #include "../geometry/object_intersector1.h"
@@ -43,6 +46,18 @@ namespace embree
     int getISA() { 
       return VerifyMultiTargetLinking::getISA(); 
     }
+
+    template<> struct OcclusionCacheable<SubdivPatch1CachedIntersector1> { static const bool value = false; };
+    template<> struct OcclusionCacheable<GridAOSIntersector1> { static const bool value = false; };
+
+    /*! prefetches all primitive blocks of a leaf at once, such that their cache misses overlap */
+    template<typename Primitive>
+    __forceinline void prefetchLeaf(const Primitive* prim, size_t num)
+    {
+      const char* end = (const char*) (prim+num);
+      for (const char* ptr = (const char*) prim; ptr<end; ptr+=64)
+        prefetchL1(ptr);
+    }
   
     template<int N, int types, bool robust, typename PrimitiveIntersector1>
     void BVHNIntersector1<N,types,robust,PrimitiveIntersector1>::intersect(const BVH* __restrict__ bvh, Ray& __restrict__ ray, const RTCIntersectContext* context)
@@ -77,12 +92,27 @@ namespace embree
       /*! initialize the node traverser */
       BVHNNodeTraverser1<N,Nx,types> nodeTraverser(vray);
 
+      /*! large scenes are memory latency bound, thus we prefetch ahead */
+      const bool largeScene = bvh->scene->isLarge();
+
       /* pop loop */
       while (true) pop:
       {
         /*! pop next node */
         if (unlikely(stackPtr == stack)) break;
         stackPtr--;
+
+        /*! visit the closer of the two topmost nodes first and prefetch
+         *  the other one, the distances are positive floats and thus
+         *  compare like their unsigned bit patterns, the instance and
+         *  lazy node markers are stored as 0 and keep their order */
+        if (unlikely(largeScene) && stackPtr != stack)
+        {
+          const unsigned d0 = stackPtr[0].dist;
+          const unsigned d1 = stackPtr[-1].dist;
+          if (d1 < d0 && d1 != 0) StackItemT<NodeRef>::xchg(stackPtr[0],stackPtr[-1]);
+          NodeRef(stackPtr[-1].ptr).prefetch(types);
+        }
         NodeRef cur = NodeRef(stackPtr->ptr);
 
         /*! if popped node is too far, pop next one */
@@ -118,6 +148,7 @@ namespace embree
         assert(cur != BVH::emptyNode);
         STAT3(normal.trav_leaves,1,1,1);
         size_t num; Primitive* prim = (Primitive*) cur.leaf(num);
+        if (unlikely(largeScene)) prefetchLeaf(prim,num);
         size_t lazy_node = 0;
         PrimitiveIntersector1::intersect(pre,ray,context,leafType,prim,num,bvh->scene,geomID_to_instID,lazy_node);
         ray_far = ray.tfar;
@@ -167,6 +198,23 @@ namespace embree
       assert(ray.tnear >= 0.0f);
       assert(!(types & BVH_MB) || (ray.time >= 0.0f && ray.time <= 1.0f));
 
+      /*! first test the leaf that occluded the previous ray of the occlusion cache slot */
+      OcclusionCacheEntry* cache = OcclusionCacheable<PrimitiveIntersector1>::value ? getOcclusionCacheEntry(context) : nullptr;
+      const size_t build = bvh->scene->commitCounter;
+      if (unlikely(cache != nullptr))
+      {
+        const size_t leaf = cache->lookup(bvh,build);
+        if (leaf)
+        {
+          size_t num; Primitive* prim = (Primitive*) NodeRef(leaf).leaf(num);
+          size_t lazy_node = 0;
+          if (PrimitiveIntersector1::occluded(pre,ray,context,0,prim,num,bvh->scene,nullptr,lazy_node)) {
+            ray.geomID = 0;
+            return;
+          }
+        }
+      }
+
       /*! load the ray into SIMD registers */
       size_t leafType = 0;
       const unsigned int* geomID_to_instID = nullptr;
@@ -177,6 +225,9 @@ namespace embree
       /*! initialize the node traverser */
       BVHNNodeTraverser1<N,Nx,types> nodeTraverser(vray);
 
+      /*! large scenes are memory latency bound, thus we prefetch ahead */
+      const bool largeScene = bvh->scene->isLarge();
+
       /* pop loop */
       while (true) pop:
       {
@@ -184,6 +235,10 @@ namespace embree
         if (unlikely(stackPtr == stack)) break;
         stackPtr--;
         NodeRef cur = (NodeRef) *stackPtr;
+
+        /*! prefetch the node we visit after this one */
+        if (unlikely(largeScene) && stackPtr != stack)
+          stackPtr[-1].prefetch(types);
         
         /* downtraversal loop */
         while (true)
@@ -214,9 +269,12 @@ namespace embree
         assert(cur != BVH::emptyNode);
         STAT3(shadow.trav_leaves,1,1,1);
         size_t num; Primitive* prim = (Primitive*) cur.leaf(num);
+        if (unlikely(largeScene)) prefetchLeaf(prim,num);
         size_t lazy_node = 0;
         if (PrimitiveIntersector1::occluded(pre,ray,context,leafType,prim,num,bvh->scene,geomID_to_instID,lazy_node)) {
           ray.geomID = 0;
+          if (unlikely(cache != nullptr) && leafType == 0 && geomID_to_instID == nullptr)
+            cache->store(bvh,build,cur);
           break;
         }
         
@@ -235,12 +293,15 @@ namespace embree
 
     IF_ENABLED_LINES(DEFINE_INTERSECTOR1(BVH4Line4iIntersector1,BVHNIntersector1<4 COMMA BVH_AN1 COMMA false COMMA ArrayIntersector1<LineMiIntersector1<4 COMMA 4 COMMA true> > >));
     IF_ENABLED_LINES(DEFINE_INTERSECTOR1(BVH4Line4iMBIntersector1,BVHNIntersector1<4 COMMA BVH_AN2 COMMA false COMMA ArrayIntersector1<LineMiMBIntersector1<4 COMMA 4 COMMA true> > >));
+    IF_ENABLED_POINTS(DEFINE_INTERSECTOR1(BVH4Point4iIntersector1,BVHNIntersector1<4 COMMA BVH_AN1 COMMA false COMMA ArrayIntersector1<PointMiIntersector1<4 COMMA 4 COMMA true> > >));
+    IF_ENABLED_POINTS(DEFINE_INTERSECTOR1(BVH4Point4iMBIntersector1,BVHNIntersector1<4 COMMA BVH_AN2 COMMA false COMMA ArrayIntersector1<PointMiMBIntersector1<4 COMMA 4 COMMA true> > >));
 
     IF_ENABLED_HAIR(DEFINE_INTERSECTOR1(BVH4Bezier1vIntersector1,BVHNIntersector1<4 COMMA BVH_AN1 COMMA false COMMA ArrayIntersector1<Bezier1vIntersector1> >));
     IF_ENABLED_HAIR(DEFINE_INTERSECTOR1(BVH4Bezier1iIntersector1,BVHNIntersector1<4 COMMA BVH_AN1 COMMA false COMMA ArrayIntersector1<Bezier1iIntersector1> >));
     IF_ENABLED_HAIR(DEFINE_INTERSECTOR1(BVH4Bezier1vIntersector1_OBB,BVHNIntersector1<4 COMMA BVH_AN1_UN1 COMMA false COMMA ArrayIntersector1<Bezier1vIntersector1> >));
     IF_ENABLED_HAIR(DEFINE_INTERSECTOR1(BVH4Bezier1iIntersector1_OBB,BVHNIntersector1<4 COMMA BVH_AN1_UN1 COMMA false COMMA ArrayIntersector1<Bezier1iIntersector1> >));
     IF_ENABLED_HAIR(DEFINE_INTERSECTOR1(BVH4Bezier1iMBIntersector1_OBB,BVHNIntersector1<4 COMMA BVH_AN2_UN2 COMMA false COMMA ArrayIntersector1<Bezier1iIntersector1MB> >));
+    IF_ENABLED_HAIR(DEFINE_INTERSECTOR1(BVH4Bezier4vIntersector1_OBB,BVHNIntersector1<4 COMMA BVH_AN1_UN1 COMMA false COMMA ArrayIntersector1<BezierMvIntersector1<4 COMMA true> > >));
   
 #if 1
     typedef Select2Intersector1<
@@ -254,13 +315,14 @@ namespace embree
     IF_ENABLED_TRIS(DEFINE_INTERSECTOR1(BVH4Triangle4Intersector1Moeller,BVHNIntersector1<4 COMMA BVH_AN1 COMMA false COMMA ArrayIntersector1<TriangleMIntersector1MoellerTrumbore<4 COMMA 4 COMMA true> > >));
     IF_ENABLED_TRIS(DEFINE_INTERSECTOR1(BVH4Triangle4vIntersector1Pluecker,BVHNIntersector1<4 COMMA BVH_AN1 COMMA true COMMA ArrayIntersector1<TriangleMvIntersector1Pluecker<4 COMMA 4 COMMA true> > >));
     IF_ENABLED_TRIS(DEFINE_INTERSECTOR1(BVH4Triangle4iIntersector1Pluecker,BVHNIntersector1<4 COMMA BVH_AN1 COMMA true COMMA ArrayIntersector1<Triangle4iIntersector1Pluecker<4 COMMA 4 COMMA true> > >));
+    IF_ENABLED_TRIS(DEFINE_INTERSECTOR1(BVH4Triangle4cIntersector1Pluecker,BVHNIntersector1<4 COMMA BVH_AN1 COMMA true COMMA ArrayIntersector1<Triangle4cIntersector1Pluecker<4 COMMA 4 COMMA true> > >));
     IF_ENABLED_TRIS(DEFINE_INTERSECTOR1(BVH4Triangle4vMBIntersector1Moeller,BVHNIntersector1<4 COMMA BVH_AN2 COMMA false COMMA ArrayIntersector1<TriangleMvMBIntersector1MoellerTrumbore<4 COMMA 4 COMMA true> > >));
 
     IF_ENABLED_SUBDIV(DEFINE_INTERSECTOR1(BVH4Subdivpatch1CachedIntersector1,BVHNIntersector1<4 COMMA BVH_AN1 COMMA true COMMA SubdivPatch1CachedIntersector1>));
     IF_ENABLED_SUBDIV(DEFINE_INTERSECTOR1(BVH4GridAOSIntersector1,BVHNIntersector1<4 COMMA BVH_AN1 COMMA true COMMA GridAOSIntersector1>));
 
-    IF_ENABLED_USER(DEFINE_INTERSECTOR1(BVH4VirtualIntersector1,BVHNIntersector1<4 COMMA BVH_AN1 COMMA false COMMA ArrayIntersector1<ObjectIntersector1> >));
-    IF_ENABLED_USER(DEFINE_INTERSECTOR1(BVH4VirtualMBIntersector1,BVHNIntersector1<4 COMMA BVH_AN2 COMMA false COMMA ArrayIntersector1<ObjectIntersector1> >));
+    IF_ENABLED_USER(DEFINE_INTERSECTOR1(BVH4VirtualIntersector1,BVHNIntersector1<4 COMMA BVH_AN1 COMMA false COMMA ObjectArrayIntersector1>));
+    IF_ENABLED_USER(DEFINE_INTERSECTOR1(BVH4VirtualMBIntersector1,BVHNIntersector1<4 COMMA BVH_AN2 COMMA false COMMA ObjectArrayIntersector1>));
 
     IF_ENABLED_QUADS(DEFINE_INTERSECTOR1(BVH4Quad4vIntersector1Moeller,BVHNIntersector1<4 COMMA BVH_AN1 COMMA false COMMA ArrayIntersector1<QuadMvIntersector1MoellerTrumbore<4 COMMA true> > >));
     IF_ENABLED_QUADS(DEFINE_INTERSECTOR1(BVH4Quad4iIntersector1Pluecker,BVHNIntersector1<4 COMMA BVH_AN1 COMMA true COMMA ArrayIntersector1<QuadMiIntersector1Pluecker<4 COMMA true> > >));
@@ -287,8 +349,11 @@ namespace embree
     IF_ENABLED_HAIR(DEFINE_INTERSECTOR1(BVH8Bezier1vIntersector1_OBB,BVHNIntersector1<8 COMMA BVH_AN1_UN1 COMMA false COMMA ArrayIntersector1<Bezier1vIntersector1> >));
     IF_ENABLED_HAIR(DEFINE_INTERSECTOR1(BVH8Bezier1iIntersector1_OBB,BVHNIntersector1<8 COMMA BVH_AN1_UN1 COMMA false COMMA ArrayIntersector1<Bezier1iIntersector1> >));
     IF_ENABLED_HAIR(DEFINE_INTERSECTOR1(BVH8Bezier1iMBIntersector1_OBB,BVHNIntersector1<8 COMMA BVH_AN2_UN2 COMMA false COMMA ArrayIntersector1<Bezier1iIntersector1MB> >));
+    IF_ENABLED_HAIR(DEFINE_INTERSECTOR1(BVH8Bezier8vIntersector1_OBB,BVHNIntersector1<8 COMMA BVH_AN1_UN1 COMMA false COMMA ArrayIntersector1<BezierMvIntersector1<8 COMMA true> > >));
     IF_ENABLED_LINES(DEFINE_INTERSECTOR1(BVH8Line4iIntersector1,BVHNIntersector1<8 COMMA BVH_AN1 COMMA false COMMA ArrayIntersector1<LineMiIntersector1<4 COMMA 4 COMMA true> > >));
     IF_ENABLED_LINES(DEFINE_INTERSECTOR1(BVH8Line4iMBIntersector1,BVHNIntersector1<8 COMMA BVH_AN2 COMMA false COMMA ArrayIntersector1<LineMiMBIntersector1<4 COMMA 4 COMMA true> > >));
+    IF_ENABLED_POINTS(DEFINE_INTERSECTOR1(BVH8Point4iIntersector1,BVHNIntersector1<8 COMMA BVH_AN1 COMMA false COMMA ArrayIntersector1<PointMiIntersector1<4 COMMA 4 COMMA true> > >));
+    IF_ENABLED_POINTS(DEFINE_INTERSECTOR1(BVH8Point4iMBIntersector1,BVHNIntersector1<8 COMMA BVH_AN2 COMMA false COMMA ArrayIntersector1<PointMiMBIntersector1<4 COMMA 4 COMMA true> > >));
     IF_ENABLED_QUADS(DEFINE_INTERSECTOR1(BVH8Quad4iIntersector1Pluecker,BVHNIntersector1<8 COMMA BVH_AN1 COMMA true COMMA ArrayIntersector1<QuadMiIntersector1Pluecker<4 COMMA true> > >));
     IF_ENABLED_QUADS(DEFINE_INTERSECTOR1(BVH8Quad4iMBIntersector1Pluecker,BVHNIntersector1<8 COMMA BVH_AN2 COMMA false COMMA ArrayIntersector1<QuadMiMBIntersector1Pluecker<4 COMMA true> > >));
 
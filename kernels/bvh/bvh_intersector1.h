@@ -23,6 +23,12 @@ namespace embree
 {
   namespace isa
   {
+    /*! Specifies if leaves of the primitive intersector can get
+     *  remembered in an occlusion cache. Leaves of lazily tessellated
+     *  geometry can get evicted and are never cached. */
+    template<typename PrimitiveIntersector1>
+      struct OcclusionCacheable { static const bool value = true; };
+
     /*! BVH single ray intersector. */
     template<int N, int types, bool robust, typename PrimitiveIntersector1>
       class BVHNIntersector1
@@ -26,9 +26,11 @@
 #include "../geometry/bezier1v_intersector.h"
 #include "../geometry/bezier1i_intersector.h"
 #include "../geometry/linei_intersector.h"
+#include "../geometry/pointi_intersector.h"
 #include "../geometry/triangle_intersector_moeller.h"
 #include "../geometry/triangle_intersector_pluecker.h"
 #include "../geometry/triangle4i_intersector_pluecker.h"
+#include "../geometry/triangle4c_intersector_pluecker.h"
 #include "../geometry/subdivpatch1cached_intersector1.h"
 #include "../geometry/grid_aos_intersector1.h"
 #include "../geometry/object_intersector1.h"
@@ -685,6 +687,9 @@ namespace embree
       }
 #endif
 
+      OcclusionCacheEntry* cache = getOcclusionCacheEntry(context);
+      const size_t build = bvh->scene->commitCounter;
+
       for (size_t r=0;r<numTotalRays;r+=MAX_RAYS_PER_OCTANT)
       {
         Ray** rays = input_rays + r;
@@ -698,6 +703,19 @@ namespace embree
           new (&pre[i]) Precalculations(*rays[i],bvh);
         }
 
+        /* first test the leaf that occluded the previous rays of the occlusion cache slot */
+        if (unlikely(cache != nullptr))
+        {
+          const size_t leaf = cache->lookup(bvh,build);
+          if (leaf)
+          {
+            size_t num; Primitive* prim = (Primitive*) NodeRef(leaf).leaf(num);
+            size_t lazy_node = 0;
+            m_active &= ~PrimitiveIntersector::occluded(pre,m_active,rays,context,0,prim,num,bvh->scene,NULL,lazy_node);
+            if (unlikely(m_active == 0)) continue;
+          }
+        }
+
         stack[0].ptr  = BVH::invalidNode;
         stack[0].mask = (size_t)-1;
         stack[1].ptr  = bvh->root;
@@ -803,7 +821,9 @@ namespace embree
           size_t bits = m_trav_active & m_active;          
 
           assert(bits);
-          m_active &= ~PrimitiveIntersector::occluded(pre,bits,rays,context,0,prim,num,bvh->scene,NULL,lazy_node);
+          const size_t m_occluded = PrimitiveIntersector::occluded(pre,bits,rays,context,0,prim,num,bvh->scene,NULL,lazy_node);
+          if (unlikely(cache != nullptr) && m_occluded) cache->store(bvh,build,cur);
+          m_active &= ~m_occluded;
           if (unlikely(m_active == 0)) break;
 
         } // traversal + intersection        
@@ -813,6 +833,7 @@ namespace embree
 
 
     IF_ENABLED_LINES(DEFINE_INTERSECTORN(BVH4Line4iStreamIntersector,BVHNStreamIntersector<SIMD_MODE(4) COMMA BVH_AN1 COMMA false COMMA ArrayIntersector1<LineMiIntersector1<4 COMMA 4 COMMA true> > >));
+    IF_ENABLED_POINTS(DEFINE_INTERSECTORN(BVH4Point4iStreamIntersector,BVHNStreamIntersector<SIMD_MODE(4) COMMA BVH_AN1 COMMA false COMMA ArrayIntersector1<PointMiIntersector1<4 COMMA 4 COMMA true> > >));
     
     IF_ENABLED_HAIR(DEFINE_INTERSECTORN(BVH4Bezier1vStreamIntersector,BVHNStreamIntersector<SIMD_MODE(4) COMMA BVH_AN1 COMMA false COMMA ArrayIntersector1<Bezier1vIntersector1> >));
     IF_ENABLED_HAIR(DEFINE_INTERSECTORN(BVH4Bezier1iStreamIntersector,BVHNStreamIntersector<SIMD_MODE(4) COMMA BVH_AN1 COMMA false COMMA ArrayIntersector1<Bezier1iIntersector1> >));
@@ -821,6 +842,7 @@ namespace embree
     IF_ENABLED_TRIS(DEFINE_INTERSECTORN(BVH4Triangle4StreamIntersectorMoellerNoFilter, BVHNStreamIntersector<SIMD_MODE(4) COMMA BVH_AN1 COMMA false COMMA ArrayIntersector1<TriangleMIntersector1MoellerTrumbore<SIMD_MODE(4) COMMA false> > >));
     IF_ENABLED_TRIS(DEFINE_INTERSECTORN(BVH4Triangle4vStreamIntersectorPluecker,BVHNStreamIntersector<SIMD_MODE(4) COMMA BVH_AN1 COMMA true COMMA ArrayIntersector1<TriangleMvIntersector1Pluecker<SIMD_MODE(4) COMMA true> > >));
     IF_ENABLED_TRIS(DEFINE_INTERSECTORN(BVH4Triangle4iStreamIntersectorPluecker,BVHNStreamIntersector<SIMD_MODE(4) COMMA BVH_AN1 COMMA true COMMA ArrayIntersector1<Triangle4iIntersector1Pluecker<SIMD_MODE(4) COMMA true> > >));
+    IF_ENABLED_TRIS(DEFINE_INTERSECTORN(BVH4Triangle4cStreamIntersectorPluecker,BVHNStreamIntersector<SIMD_MODE(4) COMMA BVH_AN1 COMMA true COMMA ArrayIntersector1<Triangle4cIntersector1Pluecker<SIMD_MODE(4) COMMA true> > >));
     
     IF_ENABLED_QUADS(DEFINE_INTERSECTORN(BVH4Quad4vStreamIntersectorMoeller,        BVHNStreamIntersector<SIMD_MODE(4) COMMA BVH_AN1 COMMA false COMMA ArrayIntersector1<QuadMvIntersector1MoellerTrumbore<4 COMMA true> > >));
     IF_ENABLED_QUADS(DEFINE_INTERSECTORN(BVH4Quad4vStreamIntersectorMoellerNoFilter,BVHNStreamIntersector<SIMD_MODE(4) COMMA BVH_AN1 COMMA false COMMA ArrayIntersector1<QuadMvIntersector1MoellerTrumbore<4 COMMA false> > >));
@@ -16,6 +16,7 @@
 
 #include "bvh_intersector_stream_filters.h"
 #include "bvh_intersector_stream.h"
+#include "../../include/embree2/rtcore_ray.h"
 
 namespace embree
 {
@@ -81,13 +82,17 @@ namespace embree
         /* special codepath for very small number of rays per octant */
         if (numOctantRays == 1)
         {
-          if (intersect) scene->intersect((RTCRay&)*rays[0],context);
-          else           scene->occluded ((RTCRay&)*rays[0],context);
+          ClippedRay clipped(*rays[0],context,intersect);
+          if (clipped.valid) {
+            if (intersect) scene->intersect((RTCRay&)*rays[0],context);
+            else           scene->occluded ((RTCRay&)*rays[0],context);
+          }
         }        
         /* codepath for large number of rays per octant */
         else
         {
           /* incoherent ray stream code path */
+          ClippedRayStream clipped(rays,numOctantRays,context,intersect);
           if (intersect) scene->intersectN((RTCRay**)rays,numOctantRays,context);
           else           scene->occludedN ((RTCRay**)rays,numOctantRays,context);
         }
@@ -153,9 +158,9 @@ namespace embree
           {
             const size_t offset = s*stream_offset;
             RayK<VSIZEX> &ray = *(RayK<VSIZEX>*)(rayData + offset);
-            vboolx valid = ray.tnear <= ray.tfar;
-            if (intersect) scene->intersect(valid,ray,context);
-            else           scene->occluded (valid,ray,context);
+            ClippedRayK<VSIZEX> clipped(ray.tnear <= ray.tfar,ray,context,intersect);
+            if (intersect) scene->intersect(clipped.valid,ray,context);
+            else           scene->occluded (clipped.valid,ray,context);
           }
 #endif
         return;
@@ -200,13 +205,16 @@ namespace embree
               rays[j] = rayN.gather(octants[octantID][j]);
             }
 
-            if (intersect)
-              scene->intersectN((RTCRay**)rays_ptr,MAX_RAYS_PER_OCTANT,context);
-            else
-              scene->occludedN((RTCRay**)rays_ptr,MAX_RAYS_PER_OCTANT,context);
+            {
+              ClippedRayStream clipped(rays_ptr,MAX_RAYS_PER_OCTANT,context,intersect);
+              if (intersect)
+                scene->intersectN((RTCRay**)rays_ptr,MAX_RAYS_PER_OCTANT,context);
+              else
+                scene->occludedN((RTCRay**)rays_ptr,MAX_RAYS_PER_OCTANT,context);
+            }
 
             for (size_t j=0;j<MAX_RAYS_PER_OCTANT;j++)
-              rayN.scatter(octants[octantID][j],rays[j],intersect);
+              rayN.scatter(octants[octantID][j],rays[j],intersect,!isDistanceOnly(context));
             
             rays_in_octant[octantID] = 0;
           }
@@ -223,13 +231,16 @@ namespace embree
             rays[j] = rayN.gather(octants[i][j]);
           }
 
-          if (intersect)
-            scene->intersectN((RTCRay**)rays_ptr,rays_in_octant[i],context);
-          else
-            scene->occludedN((RTCRay**)rays_ptr,rays_in_octant[i],context);        
+          {
+            ClippedRayStream clipped(rays_ptr,rays_in_octant[i],context,intersect);
+            if (intersect)
+              scene->intersectN((RTCRay**)rays_ptr,rays_in_octant[i],context);
+            else
+              scene->occludedN((RTCRay**)rays_ptr,rays_in_octant[i],context);        
+          }
 
           for (size_t j=0;j<rays_in_octant[i];j++)
-            rayN.scatter(octants[i][j],rays[j],intersect);
+            rayN.scatter(octants[i][j],rays[j],intersect,!isDistanceOnly(context));
         }
     }
 
@@ -252,9 +263,12 @@ namespace embree
           const size_t offset = s*stream_offset + sizeof(float) * i;
           RayK<VSIZEX> ray = rayN.gather<VSIZEX>(valid,offset);
           valid &= ray.tnear <= ray.tfar;
-          if (intersect) scene->intersect(valid,ray,context);
-          else           scene->occluded (valid,ray,context);
-          rayN.scatter<VSIZEX>(valid,offset,ray,intersect);
+          {
+            ClippedRayK<VSIZEX> clipped(valid,ray,context,intersect);
+            if (intersect) scene->intersect(clipped.valid,ray,context);
+            else           scene->occluded (clipped.valid,ray,context);
+          }
+          rayN.scatter<VSIZEX>(valid,offset,ray,intersect,!isDistanceOnly(context));
         }
         return;
       }
@@ -295,13 +309,16 @@ namespace embree
               rays[j] = rayN.gatherByOffset(octants[octantID][j]);
             }
 
-            if (intersect)
-              scene->intersectN((RTCRay**)rays_ptr,MAX_RAYS_PER_OCTANT,context);
-            else
-              scene->occludedN((RTCRay**)rays_ptr,MAX_RAYS_PER_OCTANT,context);
+            {
+              ClippedRayStream clipped(rays_ptr,MAX_RAYS_PER_OCTANT,context,intersect);
+              if (intersect)
+                scene->intersectN((RTCRay**)rays_ptr,MAX_RAYS_PER_OCTANT,context);
+              else
+                scene->occludedN((RTCRay**)rays_ptr,MAX_RAYS_PER_OCTANT,context);
+            }
 
             for (size_t j=0;j<MAX_RAYS_PER_OCTANT;j++)
-              rayN.scatterByOffset(octants[octantID][j],rays[j],intersect);
+              rayN.scatterByOffset(octants[octantID][j],rays[j],intersect,!isDistanceOnly(context));
             
             rays_in_octant[octantID] = 0;
           }
@@ -318,16 +335,84 @@ namespace embree
             rays[j] = rayN.gatherByOffset(octants[i][j]);
           }
 
-          if (intersect)
-            scene->intersectN((RTCRay**)rays_ptr,rays_in_octant[i],context);
-          else
-            scene->occludedN((RTCRay**)rays_ptr,rays_in_octant[i],context);        
+          {
+            ClippedRayStream clipped(rays_ptr,rays_in_octant[i],context,intersect);
+            if (intersect)
+              scene->intersectN((RTCRay**)rays_ptr,rays_in_octant[i],context);
+            else
+              scene->occludedN((RTCRay**)rays_ptr,rays_in_octant[i],context);        
+          }
 
           for (size_t j=0;j<rays_in_octant[i];j++)
-            rayN.scatterByOffset(octants[i][j],rays[j],intersect);
+            rayN.scatterByOffset(octants[i][j],rays[j],intersect,!isDistanceOnly(context));
         }
     }
 
-    RayStreamFilterFuncs rayStreamFilters(RayStream::filterAOS,RayStream::filterSOA,RayStream::filterSOP);
+    void RayStream::intersectTile(Scene* scene, const RTCCamera& camera, const unsigned x0, const unsigned y0, const unsigned width, const unsigned height, RTCTileHit* hits, const size_t stride, const RTCIntersectContext* context)
+    {
+      /* rays of a packet cover a compact block of pixels */
+      static const int logBW = VSIZEX == 4 ? 1 : 2;
+      static const int BW = 1 << logBW;
+      static const int BH = VSIZEX/BW;
+      const vintx lane(step);
+      const vintx dx = lane & vintx(BW-1);
+      const vintx dy = lane >> logBW;
+
+      const Vec3fa dir00(camera.dir00[0],camera.dir00[1],camera.dir00[2]);
+      const Vec3fa dirdx(camera.dirdx[0],camera.dirdx[1],camera.dirdx[2]);
+      const Vec3fa dirdy(camera.dirdy[0],camera.dirdy[1],camera.dirdy[2]);
+      const bool details = !isDistanceOnly(context);
+
+      /* all rays start at the same lens sample */
+      Vec3fa org(camera.org[0],camera.org[1],camera.org[2]);
+      const bool lens = camera.lensRadius > 0.0f;
+      Vec3fa lensOffset(zero);
+      if (lens) {
+        lensOffset = camera.lensRadius*(camera.lensSample[0]*normalize(dirdx) + camera.lensSample[1]*normalize(dirdy));
+        org += lensOffset;
+      }
+      const Vec3vfx vorg(org);
+
+      for (unsigned y=y0; y<y0+height; y+=BH)
+      {
+        for (unsigned x=x0; x<x0+width; x+=BW)
+        {
+          const vintx px = vintx(int(x)) + dx;
+          const vintx py = vintx(int(y)) + dy;
+          vboolx valid = (px < vintx(int(x0+width))) & (py < vintx(int(y0+height)));
+
+          /* generate ray directions in registers */
+          const vfloatx fx = vfloatx(px) + 0.5f;
+          const vfloatx fy = vfloatx(py) + 0.5f;
+          Vec3vfx dir = Vec3vfx(dir00) + fx*Vec3vfx(dirdx) + fy*Vec3vfx(dirdy);
+          if (lens) dir = vfloatx(camera.focalDistance)*dir - Vec3vfx(lensOffset);
+
+          RayK<VSIZEX> ray(vorg,dir,camera.tnear,camera.tfar,camera.time,vintx(int(camera.mask)));
+          {
+            ClippedRayK<VSIZEX> clipped(valid,ray,context,true);
+            scene->intersect(clipped.valid,ray,context);
+          }
+
+          /* write hit records of the valid pixels */
+          for (size_t m=movemask(valid), i=__bsf(m); m!=0; m=__btc(m,i), i=__bsf(m))
+          {
+            RTCTileHit& hit = *(RTCTileHit*)((char*)hits + (py[i]-y0)*stride + (px[i]-x0)*sizeof(RTCTileHit));
+            hit.geomID = ray.geomID[i];
+            if (hit.geomID == RTC_INVALID_GEOMETRY_ID) continue;
+            hit.t = ray.tfar[i];
+            hit.primID = ray.primID[i];
+            hit.instID = ray.instID[i];
+            if (!details) continue;
+            hit.u = ray.u[i];
+            hit.v = ray.v[i];
+            hit.Ng[0] = ray.Ng.x[i];
+            hit.Ng[1] = ray.Ng.y[i];
+            hit.Ng[2] = ray.Ng.z[i];
+          }
+        }
+      }
+    }
+
+    RayStreamFilterFuncs rayStreamFilters(RayStream::filterAOS,RayStream::filterSOA,RayStream::filterSOP,RayStream::intersectTile);
   };
 };
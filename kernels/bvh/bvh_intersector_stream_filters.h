@@ -31,6 +31,7 @@ namespace embree
       static void filterAOS(Scene* scene, RTCRay*    rays, const size_t N, const size_t stride, const RTCIntersectContext* context, const bool intersect);
       static void filterSOA(Scene* scene, char*      rays, const size_t N, const size_t streams, const size_t stream_offset, const RTCIntersectContext* context, const bool intersect);
       static void filterSOP(Scene* scene, const RTCRayNp& rays, const size_t N, const RTCIntersectContext* context, const bool intersect);
+      static void intersectTile(Scene* scene, const RTCCamera& camera, const unsigned x0, const unsigned y0, const unsigned width, const unsigned height, RTCTileHit* hits, const size_t stride, const RTCIntersectContext* context);
     };
   }
 };
@@ -429,21 +429,23 @@ namespace embree
   typedef void (*filterAOS_func)(Scene *scene, RTCRay* _rayN, const size_t N, const size_t stride, const RTCIntersectContext* context, const bool intersect);
   typedef void (*filterSOA_func)(Scene *scene, char* rayN, const size_t N, const size_t streams, const size_t stream_offset, const RTCIntersectContext* context, const bool intersect);
   typedef void (*filterSOP_func)(Scene *scene, const RTCRayNp& rayN, const size_t N, const RTCIntersectContext* context, const bool intersect);
+  typedef void (*intersectTile_func)(Scene *scene, const RTCCamera& camera, const unsigned x0, const unsigned y0, const unsigned width, const unsigned height, RTCTileHit* hits, const size_t stride, const RTCIntersectContext* context);
 
   struct RayStreamFilterFuncs
   {
     __forceinline RayStreamFilterFuncs()
-      : filterAOS(nullptr), filterSOA(nullptr), filterSOP(nullptr) {}
+      : filterAOS(nullptr), filterSOA(nullptr), filterSOP(nullptr), intersectTile(nullptr) {}
     
     __forceinline RayStreamFilterFuncs(void (*ptr) ()) 
-      : filterAOS((filterAOS_func) ptr), filterSOA((filterSOA_func) ptr), filterSOP((filterSOP_func) ptr) {}
+      : filterAOS((filterAOS_func) ptr), filterSOA((filterSOA_func) ptr), filterSOP((filterSOP_func) ptr), intersectTile((intersectTile_func) ptr) {}
 
-    __forceinline RayStreamFilterFuncs(filterAOS_func aos, filterSOA_func soa, filterSOP_func sop) 
-      : filterAOS(aos), filterSOA(soa), filterSOP(sop) {}
+    __forceinline RayStreamFilterFuncs(filterAOS_func aos, filterSOA_func soa, filterSOP_func sop, intersectTile_func tile) 
+      : filterAOS(aos), filterSOA(soa), filterSOP(sop), intersectTile(tile) {}
 
   public:
     filterAOS_func filterAOS;
     filterSOA_func filterSOA;
     filterSOP_func filterSOP;
+    intersectTile_func intersectTile;
   }; 
 }
@@ -37,6 +37,7 @@ namespace embree
     typedef RTCIntersectFunc16 IntersectFunc16;
     typedef RTCIntersectFunc1Mp IntersectFunc1M;
     typedef RTCIntersectFuncN IntersectFuncN;
+    typedef RTCIntersectFuncLeaf IntersectFuncLeaf;
     
     typedef RTCOccludedFunc OccludedFunc;
     typedef RTCOccludedFunc4 OccludedFunc4;
@@ -44,6 +45,10 @@ namespace embree
     typedef RTCOccludedFunc16 OccludedFunc16;
     typedef RTCOccludedFunc1Mp OccludedFunc1M;
     typedef RTCOccludedFuncN OccludedFuncN;
+    typedef RTCOccludedFuncLeaf OccludedFuncLeaf;
+
+    /*! maximal number of items passed to a single call of the SoA bounds function */
+    static const size_t MAX_BOUNDS_BLOCK_SIZE = 64;
 
 #if defined(__SSE__)
     typedef void (*ISPCIntersectFunc4)(void* ptr, RTCRay4& ray, size_t item, __m128 valid);
@@ -166,6 +171,16 @@ namespace embree
         OccludedFuncN occluded; 
         const char* name;
       };
+
+      struct IntersectorLeaf
+      {
+        IntersectorLeaf () 
+        : intersect(nullptr), occluded(nullptr) {}
+
+      public:
+        IntersectFuncLeaf intersect;
+        OccludedFuncLeaf occluded; 
+      };
       
     public:
       
@@ -183,8 +198,9 @@ namespace embree
       {
         BBox3fa box[2]; // have to always use 2 boxes as the geometry might have motion blur
         assert(item < size());
-        if (boundsFunc2) boundsFunc2(boundsFunc2UserPtr,intersectors.ptr,item,(RTCBounds*)box);
-        else             boundsFunc(intersectors.ptr,item,(RTCBounds&)box[0]);
+        if      (boundsFuncSoA) boundsSoA(item,item+1,0,box);
+        else if (boundsFunc2  ) boundsFunc2(boundsFunc2UserPtr,intersectors.ptr,item,(RTCBounds*)box);
+        else                    boundsFunc(intersectors.ptr,item,(RTCBounds&)box[0]);
         return box[0];
       }
 
@@ -193,11 +209,48 @@ namespace embree
       {
         BBox3fa box[2]; 
         assert(item < size());
-        if (boundsFunc2) boundsFunc2(boundsFunc2UserPtr,intersectors.ptr,item,(RTCBounds*)box);
-        else             boundsFunc(intersectors.ptr,item,(RTCBounds&)box[0]);
+        if (boundsFuncSoA) {
+          boundsSoA(item,item+1,0,&box[0]);
+          boundsSoA(item,item+1,numTimeSteps-1,&box[1]);
+        }
+        else if (boundsFunc2) boundsFunc2(boundsFunc2UserPtr,intersectors.ptr,item,(RTCBounds*)box);
+        else                  boundsFunc(intersectors.ptr,item,(RTCBounds&)box[0]);
         return std::make_pair(box[0],box[1]);
       }
 
+      /*! Calculates the bounds of the items [begin,end) of a time step, falls back to the per item bounds function if no SoA bounds function is set */
+      __forceinline void bounds (size_t begin, size_t end, size_t timeStep, BBox3fa* bounds_o) const
+      {
+        assert(end <= size());
+        if (boundsFuncSoA) {
+          for (size_t i=begin; i<end; i+=MAX_BOUNDS_BLOCK_SIZE)
+            boundsSoA(i,min(i+MAX_BOUNDS_BLOCK_SIZE,end),timeStep,&bounds_o[i-begin]);
+        } 
+        else if (timeStep > 0 && boundsFunc2) {
+          for (size_t i=begin; i<end; i++) bounds_o[i-begin] = bounds_mblur(i).second;
+        }
+        else {
+          /* the plain bounds function only provides the bounds of the first time step */
+          for (size_t i=begin; i<end; i++) bounds_o[i-begin] = bounds(i);
+        }
+      }
+
+    private:
+
+      /*! invokes the SoA bounds function for at most MAX_BOUNDS_BLOCK_SIZE items and converts the result to boxes */
+      __forceinline void boundsSoA (size_t begin, size_t end, size_t timeStep, BBox3fa* bounds_o) const
+      {
+        assert(end-begin <= MAX_BOUNDS_BLOCK_SIZE);
+        float lower_x[MAX_BOUNDS_BLOCK_SIZE], lower_y[MAX_BOUNDS_BLOCK_SIZE], lower_z[MAX_BOUNDS_BLOCK_SIZE];
+        float upper_x[MAX_BOUNDS_BLOCK_SIZE], upper_y[MAX_BOUNDS_BLOCK_SIZE], upper_z[MAX_BOUNDS_BLOCK_SIZE];
+        const RTCBoundsSoA soa = { lower_x, lower_y, lower_z, upper_x, upper_y, upper_z };
+        boundsFuncSoA(boundsFuncSoAUserPtr,intersectors.ptr,begin,end,timeStep,&soa);
+        for (size_t i=0; i<end-begin; i++)
+          bounds_o[i] = BBox3fa(Vec3fa(lower_x[i],lower_y[i],lower_z[i]),Vec3fa(upper_x[i],upper_y[i],upper_z[i]));
+      }
+
+    public:
+
       /*! check if the i'th primitive is valid */
       __forceinline bool valid(size_t i, BBox3fa* bbox = nullptr) const 
       {
@@ -211,6 +264,20 @@ namespace embree
 
   public:
 
+      /*! Intersects a single ray with several items of a leaf. */
+      __forceinline void intersectLeaf (RTCRay& ray, const unsigned* items, size_t num, const RTCIntersectContext* context) 
+      {
+        assert(intersectors.intersectorLeaf.intersect);
+        intersectors.intersectorLeaf.intersect(intersectors.ptr,context,ray,items,num);
+      }
+
+      /*! Tests if a single ray is occluded by several items of a leaf. */
+      __forceinline void occludedLeaf (RTCRay& ray, const unsigned* items, size_t num, const RTCIntersectContext* context) 
+      {
+        assert(intersectors.intersectorLeaf.occluded);
+        intersectors.intersectorLeaf.occluded(intersectors.ptr,context,ray,items,num);
+      }
+
       /*! Intersects a single ray with the scene. */
       __forceinline void intersect (RTCRay& ray, size_t item, const RTCIntersectContext* context) 
       {
@@ -397,6 +464,8 @@ namespace embree
       RTCBoundsFunc  boundsFunc;
       RTCBoundsFunc2 boundsFunc2;
       void* boundsFunc2UserPtr;
+      RTCBoundsFuncSoA boundsFuncSoA;
+      void* boundsFuncSoAUserPtr;
 
       struct Intersectors 
       {
@@ -409,6 +478,7 @@ namespace embree
         Intersector16 intersector16;
         Intersector1M intersector1M;
         IntersectorN intersectorN;
+        IntersectorLeaf intersectorLeaf;
       } intersectors;
   };
 
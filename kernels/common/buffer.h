@@ -127,7 +127,7 @@ namespace embree
     }
   };
 
-  /*! Implements a data stream inside a data buffer. */
+  /*! Implements a vertex stream inside a data buffer, vertices stored in a half or fixed point format get decoded on access. */
   template<>
     class BufferT<Vec3fa> : public Buffer
   {
@@ -135,11 +135,44 @@ namespace embree
 
     typedef Vec3fa value_type;
 
-    /*! access to the ith element of the buffer stream */
-    __forceinline const Vec3fa operator[](size_t i) const
+    BufferT () 
+      : format(RTC_VERTEX_FORMAT_FLOAT3), scale(one), offset(zero) {}
+
+    /*! sets the storage format of the vertices */
+    __forceinline void setFormat(RTCVertexFormat format, const Vec3f& scale, const Vec3f& offset) 
+    {
+      this->format = format;
+      this->scale = scale;
+      this->offset = offset;
+    }
+
+    /*! returns the storage format of the vertices */
+    __forceinline RTCVertexFormat getFormat() const {
+      return format;
+    }
+
+    /*! returns the number of bytes of a vertex in the storage format */
+    __forceinline size_t getFormatBytes() const {
+      return format == RTC_VERTEX_FORMAT_FLOAT3 ? 3*sizeof(float) : 3*sizeof(unsigned short);
+    }
+
+    /*! loads the ith vertex, the 4th component is undefined */
+    __forceinline vfloat4 load(size_t i) const
     {
       assert(i<num);
-      return Vec3fa(vfloat4::loadu((float*)(ptr_ofs + i*stride)));
+      const char* p = ptr_ofs + i*stride;
+      if (likely(format == RTC_VERTEX_FORMAT_FLOAT3))
+        return vfloat4::loadu((float*)p);
+
+      const unsigned short* v = (const unsigned short*) p;
+      if (format == RTC_VERTEX_FORMAT_HALF3)
+        return vfloat4(half_to_float(v[0]),half_to_float(v[1]),half_to_float(v[2]),0.0f);
+      return vfloat4(offset.x+scale.x*float(v[0]),offset.y+scale.y*float(v[1]),offset.z+scale.z*float(v[2]),0.0f);
+    }
+
+    /*! access to the ith element of the buffer stream */
+    __forceinline const Vec3fa operator[](size_t i) const {
+      return Vec3fa(load(i));
     }
 
     __forceinline char* getPtr( size_t i = 0 ) const 
@@ -147,5 +180,17 @@ namespace embree
       assert(i<num);
       return ptr_ofs + i*stride;
     }
+
+    /*! checks padding to 16 byte for float vertices, decoded vertices are read component wise */
+    __forceinline void checkPadding16() const 
+    {
+      if (format == RTC_VERTEX_FORMAT_FLOAT3)
+        Buffer::checkPadding16();
+    }
+
+  protected:
+    RTCVertexFormat format; //!< storage format of the vertices
+    Vec3f scale;            //!< scale of fixed point vertices
+    Vec3f offset;           //!< offset of fixed point vertices
   };
 }
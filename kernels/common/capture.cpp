@@ -0,0 +1,202 @@
+// ======================================================================== //
+// Copyright 2009-2016 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#include "capture.h"
+#include "scene.h"
+
+namespace embree
+{
+  /*! extracts the i'th ray of a packet */
+  static __forceinline RTCRay getRay(RTCRayN* ptr, size_t N, size_t i)
+  {
+    RTCRay ray;
+    ray.org[0] = RTCRayN_org_x(ptr,N,i);
+    ray.org[1] = RTCRayN_org_y(ptr,N,i);
+    ray.org[2] = RTCRayN_org_z(ptr,N,i);
+    ray.align0 = 0;
+    ray.dir[0] = RTCRayN_dir_x(ptr,N,i);
+    ray.dir[1] = RTCRayN_dir_y(ptr,N,i);
+    ray.dir[2] = RTCRayN_dir_z(ptr,N,i);
+    ray.align1 = 0;
+    ray.tnear  = RTCRayN_tnear(ptr,N,i);
+    ray.tfar   = RTCRayN_tfar(ptr,N,i);
+    ray.time   = RTCRayN_time(ptr,N,i);
+    ray.mask   = RTCRayN_mask(ptr,N,i);
+    ray.Ng[0]  = RTCRayN_Ng_x(ptr,N,i);
+    ray.Ng[1]  = RTCRayN_Ng_y(ptr,N,i);
+    ray.Ng[2]  = RTCRayN_Ng_z(ptr,N,i);
+    ray.align2 = 0;
+    ray.u      = RTCRayN_u(ptr,N,i);
+    ray.v      = RTCRayN_v(ptr,N,i);
+    ray.geomID = RTCRayN_geomID(ptr,N,i);
+    ray.primID = RTCRayN_primID(ptr,N,i);
+    ray.instID = RTCRayN_instID(ptr,N,i);
+    return ray;
+  }
+
+  /*! extracts the i'th ray of a ray stream in structure of pointers layout */
+  static __forceinline RTCRay getRay(const RTCRayNp& rays, size_t i)
+  {
+    RTCRay ray;
+    ray.org[0] = rays.orgx[i]; ray.org[1] = rays.orgy[i]; ray.org[2] = rays.orgz[i]; ray.align0 = 0;
+    ray.dir[0] = rays.dirx[i]; ray.dir[1] = rays.diry[i]; ray.dir[2] = rays.dirz[i]; ray.align1 = 0;
+    ray.tnear  = rays.tnear ? rays.tnear[i] : 0.0f;
+    ray.tfar   = rays.tfar[i];
+    ray.time   = rays.time ? rays.time[i] : 0.0f;
+    ray.mask   = rays.mask ? rays.mask[i] : -1;
+    ray.Ng[0]  = rays.Ngx ? rays.Ngx[i] : 0.0f;
+    ray.Ng[1]  = rays.Ngy ? rays.Ngy[i] : 0.0f;
+    ray.Ng[2]  = rays.Ngz ? rays.Ngz[i] : 0.0f;
+    ray.align2 = 0;
+    ray.u      = rays.u[i];
+    ray.v      = rays.v[i];
+    ray.geomID = rays.geomID[i];
+    ray.primID = rays.primID[i];
+    ray.instID = rays.instID ? rays.instID[i] : RTC_INVALID_GEOMETRY_ID;
+    return ray;
+  }
+
+  const int CaptureLog::MAGICK;
+  const int CaptureLog::VERSION;
+
+  CaptureLog::CaptureLog (const std::string& fileName)
+    : nextSceneID(0)
+  {
+    file.open(fileName.c_str(),std::ios::out | std::ios::binary);
+    if (!file.is_open())
+      throw_RTCError(RTC_INVALID_ARGUMENT,"cannot open capture file " + fileName);
+
+    write(MAGICK);
+    write(VERSION);
+  }
+
+  unsigned CaptureLog::sceneID(Scene* scene)
+  {
+    auto i = sceneIDs.find(scene);
+    if (i != sceneIDs.end()) return i->second;
+    return sceneIDs[scene] = nextSceneID++;
+  }
+
+  void CaptureLog::commit(Scene* scene)
+  {
+    Lock<MutexSys> lock(mutex);
+    write(int(COMMIT));
+    write(sceneID(scene));
+    write(int(scene->flags));
+    write(int(scene->aflags));
+    write(unsigned(scene->size()));
+    for (size_t i=0; i<scene->size(); i++)
+    {
+      Geometry* geom = scene->get(i);
+      write(geom ? geom->mask : 0);
+
+      /* disabled geometries are stored like unsupported ones to keep the geometry IDs */
+      if (geom && geom->isEnabled()) geom->write(file);
+      else write(int(-1));
+    }
+    file.flush();
+  }
+
+  void CaptureLog::deleteScene(Scene* scene)
+  {
+    Lock<MutexSys> lock(mutex);
+    auto i = sceneIDs.find(scene);
+    if (i == sceneIDs.end()) return;
+    write(int(DELETE_SCENE));
+    write(i->second);
+    sceneIDs.erase(i);
+    file.flush();
+  }
+
+  void CaptureLog::writeRaysHeader(Scene* scene, Call call, bool occluded, const RTCIntersectContext* context, size_t N, size_t M)
+  {
+    write(int(RAYS));
+    write(sceneID(scene));
+    write(int(call));
+    write(int(occluded));
+    write(context ? int(context->flags) : int(-1));
+    if (hasClipVolume(context)) write(*context->clipVolume);
+    write(unsigned(N));
+    write(unsigned(M));
+  }
+
+  void CaptureLog::rays(Scene* scene, Call call, bool occluded, const RTCIntersectContext* context, const void* valid, const void* rays, size_t N, size_t M, size_t stride)
+  {
+    Lock<MutexSys> lock(mutex);
+    writeRaysHeader(scene,call,occluded,context,N,M);
+    for (size_t j=0; j<M; j++)
+    {
+      RTCRayN* packet = (RTCRayN*) ((char*)rays + j*stride);
+      for (size_t i=0; i<N; i++) {
+        write(valid ? ((const int*)valid)[i] : int(-1));
+        write(getRay(packet,N,i));
+      }
+    }
+  }
+
+  void CaptureLog::rays(Scene* scene, bool occluded, const RTCIntersectContext* context, const RTCRayNp& rays, size_t N)
+  {
+    Lock<MutexSys> lock(mutex);
+    writeRaysHeader(scene,CALL_NP,occluded,context,N,1);
+    for (size_t i=0; i<N; i++) {
+      write(int(-1));
+      write(getRay(rays,i));
+    }
+  }
+
+  void CaptureLog::tile(Scene* scene, const RTCIntersectContext* context, const RTCCamera& camera, unsigned x0, unsigned y0, unsigned width, unsigned height)
+  {
+    const Vec3fa dir00(camera.dir00[0],camera.dir00[1],camera.dir00[2]);
+    const Vec3fa dirdx(camera.dirdx[0],camera.dirdx[1],camera.dirdx[2]);
+    const Vec3fa dirdy(camera.dirdy[0],camera.dirdy[1],camera.dirdy[2]);
+
+    /* same ray generation as in rtcIntersectTile */
+    Vec3fa org(camera.org[0],camera.org[1],camera.org[2]);
+    const bool lens = camera.lensRadius > 0.0f;
+    Vec3fa lensOffset(zero);
+    if (lens) {
+      lensOffset = camera.lensRadius*(camera.lensSample[0]*normalize(dirdx) + camera.lensSample[1]*normalize(dirdy));
+      org += lensOffset;
+    }
+
+    Lock<MutexSys> lock(mutex);
+    writeRaysHeader(scene,CALL_1M,false,context,1,size_t(width)*size_t(height));
+    for (unsigned y=y0; y<y0+height; y++)
+    {
+      for (unsigned x=x0; x<x0+width; x++)
+      {
+        Vec3fa dir = dir00 + (float(x)+0.5f)*dirdx + (float(y)+0.5f)*dirdy;
+        if (lens) dir = camera.focalDistance*dir - lensOffset;
+
+        RTCRay ray;
+        ray.org[0] = org.x; ray.org[1] = org.y; ray.org[2] = org.z; ray.align0 = 0;
+        ray.dir[0] = dir.x; ray.dir[1] = dir.y; ray.dir[2] = dir.z; ray.align1 = 0;
+        ray.tnear  = camera.tnear;
+        ray.tfar   = camera.tfar;
+        ray.time   = camera.time;
+        ray.mask   = camera.mask;
+        ray.Ng[0]  = ray.Ng[1] = ray.Ng[2] = 0.0f;
+        ray.align2 = 0;
+        ray.u      = ray.v = 0.0f;
+        ray.geomID = RTC_INVALID_GEOMETRY_ID;
+        ray.primID = RTC_INVALID_GEOMETRY_ID;
+        ray.instID = RTC_INVALID_GEOMETRY_ID;
+        write(int(-1));
+        write(ray);
+      }
+    }
+  }
+}
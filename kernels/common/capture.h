@@ -0,0 +1,100 @@
+// ======================================================================== //
+// Copyright 2009-2016 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+#include "default.h"
+#include "../../include/embree2/rtcore_ray.h"
+
+namespace embree
+{
+  class Scene;
+
+  /*! Records scene commits and ray queries of a device into a binary
+   *  log that can be re-issued offline by the replay tool. The log
+   *  starts with a magic number and version, followed by a sequence of
+   *  records that each start with an int record type:
+   *
+   *    COMMIT:       sceneID, scene flags, algorithm flags, number of
+   *                  geometries, and for each geometry its mask followed
+   *                  by the data written by Geometry::write
+   *    DELETE_SCENE: sceneID
+   *    RAYS:         sceneID, call type, occluded flag, context flags
+   *                  (-1 if no context was passed), the RTCClipVolume
+   *                  if the context flags enable clipping, N, M, and
+   *                  N*M times a valid flag followed by an RTCRay
+   *
+   *  Scenes are identified by sequential IDs in the order they are
+   *  first seen. Tiles of camera rays are recorded as a stream of
+   *  their single rays in row major order. */
+  class CaptureLog
+  {
+  public:
+
+    static const int MAGICK = 0x43455243;
+    static const int VERSION = 2;
+
+    /*! record types */
+    enum Record { COMMIT = 1, DELETE_SCENE = 2, RAYS = 3 };
+
+    /*! API call a ray query got issued through */
+    enum Call
+    {
+      CALL_1   = 0,   //!< rtcIntersect/rtcOccluded
+      CALL_N   = 1,   //!< rtcIntersect4/8/16, N is the packet size
+      CALL_1M  = 2,   //!< stream of M single rays
+      CALL_NM  = 3,   //!< stream of M packets of size N
+      CALL_NP  = 4    //!< stream of N rays in structure of pointers layout
+    };
+
+  public:
+
+    /*! opens the capture file */
+    CaptureLog (const std::string& fileName);
+
+    /*! records the content of the scene when it gets committed */
+    void commit(Scene* scene);
+
+    /*! records the deletion of a scene */
+    void deleteScene(Scene* scene);
+
+    /*! records a ray query given in packet or stream layout */
+    void rays(Scene* scene, Call call, bool occluded, const RTCIntersectContext* context, const void* valid, const void* rays, size_t N, size_t M, size_t stride);
+
+    /*! records a ray query given in structure of pointers layout */
+    void rays(Scene* scene, bool occluded, const RTCIntersectContext* context, const RTCRayNp& rays, size_t N);
+
+    /*! records the camera rays of a tile */
+    void tile(Scene* scene, const RTCIntersectContext* context, const RTCCamera& camera, unsigned x0, unsigned y0, unsigned width, unsigned height);
+
+  private:
+
+    /*! returns the sequential ID of the scene, assigns a new one for unseen scenes */
+    unsigned sceneID(Scene* scene);
+
+    /*! writes the header of a ray record */
+    void writeRaysHeader(Scene* scene, Call call, bool occluded, const RTCIntersectContext* context, size_t N, size_t M);
+
+    template<typename T>
+      __forceinline void write(const T& v) { file.write((const char*)&v,sizeof(T)); }
+
+  private:
+    MutexSys mutex;                        //!< serializes records of concurrently issued calls
+    std::ofstream file;                    //!< capture file
+    std::map<Scene*,unsigned> sceneIDs;    //!< sequential IDs of live scenes
+    unsigned nextSceneID;                  //!< ID of the next unseen scene
+  };
+}
@@ -21,6 +21,7 @@
 #include "scene_instance.h"
 #include "scene_bezier_curves.h"
 #include "scene_subdiv_mesh.h"
+#include "capture.h"
 
 #include "../subdiv/tessellation_cache.h"
 
@@ -109,6 +110,11 @@ namespace embree
     /* setup tasking system */
     initTaskingSystem(numThreads);
 
+    /* open capture file */
+    capture = nullptr;
+    if (capture_file != "")
+      capture = new CaptureLog(capture_file);
+
     /* ray stream SOA to AOS conversion */
 #if defined(EMBREE_RAY_PACKETS)
     SELECT_SYMBOL_DEFAULT_SSE42_AVX_AVX2_AVX512KNL_AVX512SKX(enabled_cpu_features,rayStreamFilters);
@@ -117,6 +123,7 @@ namespace embree
 
   Device::~Device ()
   {
+    delete capture;
     delete instance_factory;
     delete bvh4_factory;
 #if defined(__TARGET_AVX__)
@@ -477,6 +484,12 @@ namespace embree
     case RTC_CONFIG_LINE_GEOMETRY: return 0;
 #endif
 
+#if defined(EMBREE_GEOMETRY_POINTS)
+    case RTC_CONFIG_POINT_GEOMETRY: return 1;
+#else
+    case RTC_CONFIG_POINT_GEOMETRY: return 0;
+#endif
+
 #if defined(EMBREE_GEOMETRY_HAIR)
     case RTC_CONFIG_HAIR_GEOMETRY: return 1;
 #else
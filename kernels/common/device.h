@@ -25,6 +25,7 @@ namespace embree
   class BVH4Factory;
   class BVH8Factory;
   class InstanceFactory;
+  class CaptureLog;
 
   class Device : public State, public MemoryMonitorInterface
   {
@@ -101,5 +102,8 @@ namespace embree
     
     /* ray streams filter */
     RayStreamFilterFuncs rayStreamFilters;
+
+    /* log of recorded API calls, nullptr if capturing is disabled */
+    CaptureLog* capture;
   };
 }
@@ -310,6 +310,120 @@ namespace embree
   typedef RayK<8>  Ray8;
   typedef RayK<16> Ray16;
 
+  /* Clips the ray segment [tnear,tfar] to the inside of a convex clip
+   * volume, the segment gets empty if the ray misses the volume */
+  template<typename T, typename V>
+  __forceinline void clipRaySegment(const RTCClipVolume& clip, const V& org, const V& dir, T& tnear, T& tfar)
+  {
+    assert(clip.numPlanes <= RTC_MAX_CLIP_PLANES);
+    for (size_t i=0; i<clip.numPlanes; i++)
+    {
+      const float* P = clip.planes[i];
+      const T a = madd(T(P[0]),org.x,madd(T(P[1]),org.y,madd(T(P[2]),org.z,T(P[3]))));
+      const T b = madd(T(P[0]),dir.x,madd(T(P[1]),dir.y,T(P[2])*dir.z));
+      const T t = -a/b;
+      tnear = select(b > T(zero),max(tnear,t),tnear);
+      tfar  = select(b < T(zero),min(tfar ,t),tfar);
+      tfar  = select(b == T(zero),select(a < T(zero),T(neg_inf),tfar),tfar);
+    }
+  }
+
+  /* Clips the segments of a ray packet to the clip volume of the
+   * context while the object lives. The destructor restores tnear and
+   * restores tfar of all rays that did not find a new hit. */
+  template<int K>
+  struct ClippedRayK
+  {
+    __forceinline ClippedRayK(const vbool<K>& valid_i, RayK<K>& ray, const RTCIntersectContext* context, const bool intersect)
+      : ray(ray), valid(valid_i), tnear(ray.tnear), tfar(ray.tfar), clip(hasClipVolume(context)), intersect(intersect)
+    {
+      if (likely(!clip)) return;
+      clipRaySegment(*context->clipVolume,ray.org,ray.dir,ray.tnear,ray.tfar);
+      valid &= ray.tnear <= ray.tfar;
+    }
+
+    __forceinline ~ClippedRayK()
+    {
+      if (likely(!clip)) return;
+      const vbool<K> hit = valid & (ray.geomID != vint<K>(-1));
+      ray.tnear = tnear;
+      ray.tfar = intersect ? select(hit,ray.tfar,tfar) : tfar;
+    }
+
+    RayK<K>& ray;
+    vbool<K> valid;      //!< valid rays with non-empty segment
+    vfloat<K> tnear, tfar;
+    const bool clip;
+    const bool intersect;
+  };
+
+  /* Clips the segment of a single ray to the clip volume of the context */
+  template<>
+  struct ClippedRayK<1>
+  {
+    __forceinline ClippedRayK(RayK<1>& ray, const RTCIntersectContext* context, const bool intersect)
+      : ray(ray), valid(true), tnear(ray.tnear), tfar(ray.tfar), clip(hasClipVolume(context)), intersect(intersect)
+    {
+      if (likely(!clip)) return;
+      clipRaySegment(*context->clipVolume,ray.org,ray.dir,ray.tnear,ray.tfar);
+      valid = ray.tnear <= ray.tfar;
+    }
+
+    __forceinline ~ClippedRayK()
+    {
+      if (likely(!clip)) return;
+      const bool hit = valid && ray.geomID != RTC_INVALID_GEOMETRY_ID;
+      ray.tnear = tnear;
+      if (!intersect || !hit) ray.tfar = tfar;
+    }
+
+    RayK<1>& ray;
+    bool valid;          //!< ray has non-empty segment
+    float tnear, tfar;
+    const bool clip;
+    const bool intersect;
+  };
+
+  typedef ClippedRayK<1> ClippedRay;
+
+  /* Clips the segments of a stream of single rays to the clip volume of
+   * the context while the object lives. The ray pointers are copied as
+   * occludedN reorders the stream. */
+  struct ClippedRayStream
+  {
+    __forceinline ClippedRayStream(Ray** rays_i, const size_t N, const RTCIntersectContext* context, const bool intersect)
+      : N(N), clip(hasClipVolume(context)), intersect(intersect)
+    {
+      if (likely(!clip)) return;
+      assert(N <= MAX_INTERNAL_STREAM_SIZE);
+      for (size_t i=0; i<N; i++)
+      {
+        Ray& ray = *(rays[i] = rays_i[i]);
+        tnear[i] = ray.tnear; tfar[i] = ray.tfar;
+        clipRaySegment(*context->clipVolume,ray.org,ray.dir,ray.tnear,ray.tfar);
+      }
+    }
+
+    __forceinline ~ClippedRayStream()
+    {
+      if (likely(!clip)) return;
+      for (size_t i=0; i<N; i++)
+      {
+        Ray& ray = *rays[i];
+        const bool hit = ray.tnear <= ray.tfar && ray.geomID != RTC_INVALID_GEOMETRY_ID;
+        ray.tnear = tnear[i];
+        if (!intersect || !hit) ray.tfar = tfar[i];
+      }
+    }
+
+    const size_t N;
+    const bool clip;
+    const bool intersect;
+    Ray* rays[MAX_INTERNAL_STREAM_SIZE];
+    float tnear[MAX_INTERNAL_STREAM_SIZE];
+    float tfar[MAX_INTERNAL_STREAM_SIZE];
+  };
+
   /* Outputs ray to stream */
   template<int K>
   inline std::ostream& operator<<(std::ostream& cout, const RayK<K>& ray)
@@ -443,19 +557,20 @@ namespace embree
       return ray;
     }
 
-    __forceinline void scatter(const size_t offset, const Ray& ray, const bool all)
+    __forceinline void scatter(const size_t offset, const Ray& ray, const bool all, const bool details = true)
     {
       geomID(offset)[0] = ray.geomID;
       if (all && ray.geomID !=  RTC_INVALID_GEOMETRY_ID)
       {
         tfar(offset)[0] = ray.tfar;
+        primID(offset)[0] = ray.primID;
+        instID(offset)[0] = ray.instID;
+        if (!details) return;
         u(offset)[0] = ray.u;
         v(offset)[0] = ray.v;
-        primID(offset)[0] = ray.primID;
         Ngx(offset)[0] = ray.Ng.x;
         Ngy(offset)[0] = ray.Ng.y;
         Ngz(offset)[0] = ray.Ng.z;
-        instID(offset)[0] = ray.instID;
       }
     }
 
@@ -606,25 +721,26 @@ namespace embree
       return ray;
     }
 
-    __forceinline void scatterByOffset(const size_t offset, const Ray& ray, const bool all=true)
+    __forceinline void scatterByOffset(const size_t offset, const Ray& ray, const bool all=true, const bool details=true)
     {
       *(unsigned * __restrict__ )((char*)geomID + offset) = ray.geomID;
       if (all)
         if (ray.geomID !=  RTC_INVALID_GEOMETRY_ID)
         {
           *(float* __restrict__ )((char*)tfar + offset) = ray.tfar;
+          *(unsigned * __restrict__ )((char*)primID + offset) = ray.primID;
+          if (likely(instID)) *(unsigned * __restrict__ )((char*)instID + offset) = ray.instID;
+          if (!details) return;
           *(float* __restrict__ )((char*)u + offset) = ray.u;
           *(float* __restrict__ )((char*)v + offset) = ray.v;
-          *(unsigned * __restrict__ )((char*)primID + offset) = ray.primID;
           if (likely(Ngx)) *(float* __restrict__ )((char*)Ngx + offset) = ray.Ng.x;
           if (likely(Ngy)) *(float* __restrict__ )((char*)Ngy + offset) = ray.Ng.y;
           if (likely(Ngz)) *(float* __restrict__ )((char*)Ngz + offset) = ray.Ng.z;
-          if (likely(instID)) *(unsigned * __restrict__ )((char*)instID + offset) = ray.instID;
         }
     }
 
     template<int K>
-    __forceinline void scatter(const vbool<K>& valid_i, const size_t offset, const RayK<K>& ray, const bool all=true)
+    __forceinline void scatter(const vbool<K>& valid_i, const size_t offset, const RayK<K>& ray, const bool all=true, const bool details=true)
     {
       vbool<K> valid = valid_i;
       vint<K>::storeu(valid,(int * __restrict__ )((char*)geomID + offset), ray.geomID);
@@ -634,13 +750,14 @@ namespace embree
       if (none(valid)) return;
       
       vfloat<K>::storeu(valid,(float* __restrict__ )((char*)tfar + offset), ray.tfar);
+      vint<K>::storeu(valid,(int * __restrict__ )((char*)primID + offset), ray.primID);
+      if (likely(instID)) vint<K>::storeu(valid,(int * __restrict__ )((char*)instID + offset), ray.instID);
+      if (!details) return;
       vfloat<K>::storeu(valid,(float* __restrict__ )((char*)u + offset), ray.u);
       vfloat<K>::storeu(valid,(float* __restrict__ )((char*)v + offset), ray.v);
-      vint<K>::storeu(valid,(int * __restrict__ )((char*)primID + offset), ray.primID);
       if (likely(Ngx)) vfloat<K>::storeu(valid,(float* __restrict__ )((char*)Ngx + offset), ray.Ng.x);
       if (likely(Ngy)) vfloat<K>::storeu(valid,(float* __restrict__ )((char*)Ngy + offset), ray.Ng.y);
       if (likely(Ngz)) vfloat<K>::storeu(valid,(float* __restrict__ )((char*)Ngz + offset), ray.Ng.z);
-      if (likely(instID)) vint<K>::storeu(valid,(int * __restrict__ )((char*)instID + offset), ray.instID);
     }
 
     __forceinline size_t getOctantByOffset(const size_t offset)
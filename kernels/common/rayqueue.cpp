@@ -0,0 +1,124 @@
+// ======================================================================== //
+// Copyright 2009-2016 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#include "rayqueue.h"
+#include "scene.h"
+#include "capture.h"
+
+namespace embree
+{
+  const size_t RayQueue::CHUNK_SIZE;
+
+  RayQueue::RayQueue (Scene* scene, const RTCIntersectContext* context_i, bool occluded, RTCRayQueueFunc func, void* userPtr)
+    : scene(scene), occluded(occluded), func(func), userPtr(userPtr), current(nullptr)
+  {
+    if (context_i) context = *context_i;
+    else {
+      context.flags = RTC_INTERSECT_INCOHERENT;
+      context.userRayExt = nullptr;
+    }
+
+    /* the occlusion cache must not be shared between the threads tracing chunks */
+    context.flags = (RTCIntersectFlags) (context.flags & ~RTC_INTERSECT_OCCLUSION_CACHE);
+    context.occlusionCache = nullptr;
+    if (!hasClipVolume(&context)) context.clipVolume = nullptr;
+
+    current = new Chunk;
+  }
+
+  RayQueue::~RayQueue ()
+  {
+    delete current;
+    for (size_t i=0; i<freeChunks.size(); i++)
+      delete freeChunks[i];
+  }
+
+  RayQueue::Chunk* RayQueue::allocChunk()
+  {
+    if (freeChunks.empty()) return new Chunk;
+    Chunk* chunk = freeChunks.back();
+    freeChunks.pop_back();
+    return chunk;
+  }
+
+  void RayQueue::append(const RTCRay* rays, const unsigned int* ids, size_t M, size_t stride)
+  {
+    /* count active rays, inactive rays get compacted away */
+    size_t numActive = 0;
+    for (size_t i=0; i<M; i++) {
+      const RTCRay& ray = *(const RTCRay*)((const char*)rays + i*stride);
+      numActive += ray.tnear <= ray.tfar;
+    }
+
+    size_t i = 0;
+    while (numActive)
+    {
+      /* reserve slots in the current chunk */
+      Chunk* chunk; size_t begin, n;
+      {
+        Lock<MutexSys> lock(mutex);
+        chunk = current;
+        begin = chunk->reserved;
+        n = min(numActive,CHUNK_SIZE-begin);
+        chunk->reserved += n;
+        if (chunk->reserved == CHUNK_SIZE) current = allocChunk();
+      }
+
+      /* copy active rays without holding the lock */
+      for (size_t j=begin; j<begin+n; i++)
+      {
+        const RTCRay& ray = *(const RTCRay*)((const char*)rays + i*stride);
+        if (!(ray.tnear <= ray.tfar)) continue;
+        chunk->rays[j] = ray;
+        chunk->ids[j] = ids[i];
+        j++;
+      }
+      numActive -= n;
+
+      /* the thread completing the chunk traces it */
+      if (chunk->filled.fetch_add(n)+n == CHUNK_SIZE)
+        trace(chunk,CHUNK_SIZE);
+    }
+  }
+
+  void RayQueue::flush()
+  {
+    /* the callback may append further rays, thus loop until the queue is empty */
+    while (true)
+    {
+      Chunk* chunk;
+      {
+        Lock<MutexSys> lock(mutex);
+        if (current->reserved == 0) return;
+        chunk = current;
+        current = allocChunk();
+      }
+      trace(chunk,chunk->reserved);
+    }
+  }
+
+  void RayQueue::trace(Chunk* chunk, size_t N)
+  {
+    RTCORE_CAPTURE(scene->device,rays(scene,CaptureLog::CALL_1M,occluded,&context,nullptr,chunk->rays,1,N,sizeof(RTCRay)));
+    scene->device->rayStreamFilters.filterAOS(scene,chunk->rays,N,sizeof(RTCRay),&context,!occluded);
+    func(userPtr,chunk->rays,chunk->ids,N);
+
+    chunk->reserved = 0;
+    chunk->filled = 0;
+    Lock<MutexSys> lock(mutex);
+    freeChunks.push_back(chunk);
+  }
+}
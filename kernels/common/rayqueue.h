@@ -0,0 +1,88 @@
+// ======================================================================== //
+// Copyright 2009-2016 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+#include "default.h"
+#include "../../include/embree2/rtcore_ray.h"
+
+namespace embree
+{
+  class Scene;
+
+  /*! Persistent queue of single rays. Rays of many append calls and
+   *  threads are collected into chunks of CHUNK_SIZE rays, and each
+   *  full chunk is traced as one ray stream, thus the stream
+   *  intersectors always see large streams even if paths terminate
+   *  and the application appends only few rays per call. Chunks are
+   *  recycled, thus no memory gets allocated once the queue is warm. */
+  class RayQueue : public RefCount
+  {
+  public:
+
+    static const size_t CHUNK_SIZE = 1024;
+
+  private:
+
+    /*! chunk of rays, rays are reserved under the queue mutex but
+     *  copied without holding it, the thread whose copy completes the
+     *  chunk traces it */
+    struct Chunk
+    {
+      ALIGNED_STRUCT;
+      Chunk () : reserved(0), filled(0) {}
+
+      RTCRay rays[CHUNK_SIZE];         //!< queued rays
+      unsigned int ids[CHUNK_SIZE];    //!< IDs of the queued rays
+      size_t reserved;                 //!< number of reserved slots, protected by the queue mutex
+      std::atomic<size_t> filled;      //!< number of slots already written
+    };
+
+  public:
+
+    /*! creates a ray queue for the scene */
+    RayQueue (Scene* scene, const RTCIntersectContext* context, bool occluded, RTCRayQueueFunc func, void* userPtr);
+
+    /*! destroys the queue, rays not flushed are discarded */
+    ~RayQueue ();
+
+    /*! appends all active rays of a stream to the queue */
+    void append(const RTCRay* rays, const unsigned int* ids, size_t M, size_t stride);
+
+    /*! traces partially filled chunks until the queue is empty */
+    void flush();
+
+  private:
+
+    /*! returns a recycled or new chunk, requires the mutex to be held */
+    Chunk* allocChunk();
+
+    /*! traces the first N rays of a chunk, invokes the callback, and recycles the chunk */
+    void trace(Chunk* chunk, size_t N);
+
+  public:
+    Scene* scene;                  //!< scene rays are traced against
+    RTCIntersectContext context;   //!< copy of the context passed at creation
+    bool occluded;                 //!< performs occlusion instead of intersection queries
+    RTCRayQueueFunc func;          //!< callback for traced rays
+    void* userPtr;                 //!< user pointer passed to the callback
+
+  private:
+    MutexSys mutex;                //!< protects the current chunk and the free list
+    Chunk* current;                //!< chunk new rays are appended to
+    std::vector<Chunk*> freeChunks; //!< chunks ready for reuse
+  };
+}
@@ -23,6 +23,8 @@
 #include "default.h"
 #include "device.h"
 #include "scene.h"
+#include "capture.h"
+#include "rayqueue.h"
 #include "../../include/embree2/rtcore_ray.h"
 
 namespace embree
@@ -214,6 +216,25 @@ namespace embree
     return nullptr;
   }
 
+  RTCORE_API RTCScene rtcDeviceNewScene2 (RTCDevice device, RTCSceneFlags flags, RTCAlgorithmFlags aflags, const RTCBuildSettings& settings) 
+  {
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcDeviceNewScene2);
+    RTCORE_VERIFY_HANDLE(device);
+    if (settings.size != sizeof(RTCBuildSettings))
+      throw_RTCError(RTC_INVALID_ARGUMENT,"invalid build settings size");
+    if (settings.sahBlockSize == 0 || (settings.sahBlockSize & (settings.sahBlockSize-1)))
+      throw_RTCError(RTC_INVALID_ARGUMENT,"SAH block size has to be a power of 2");
+    if (settings.minLeafSize == 0 || settings.minLeafSize > settings.maxLeafSize)
+      throw_RTCError(RTC_INVALID_ARGUMENT,"invalid leaf sizes");
+    if (!(settings.travCost > 0.0f) || !(settings.intCost > 0.0f))
+      throw_RTCError(RTC_INVALID_ARGUMENT,"SAH costs have to be positive");
+    if (!isCoherent(flags) && !isIncoherent(flags)) flags = RTCSceneFlags(flags | RTC_SCENE_INCOHERENT);
+    return (RTCScene) new Scene((Device*)device,flags,aflags,&settings);
+    RTCORE_CATCH_END((Device*)device);
+    return nullptr;
+  }
+
   RTCORE_API void rtcSetProgressMonitorFunction(RTCScene hscene, RTCProgressMonitorFunc func, void* ptr) 
   {
     Scene* scene = (Scene*) hscene;
@@ -223,6 +244,16 @@ namespace embree
     scene->setProgressMonitorFunction(func,ptr);
     RTCORE_CATCH_END(scene->device);
   }
+
+  RTCORE_API void rtcSetBuildPriority(RTCScene hscene, int priority) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcSetBuildPriority);
+    RTCORE_VERIFY_HANDLE(hscene);
+    scene->setBuildPriority(priority);
+    RTCORE_CATCH_END(scene->device);
+  }
   
   RTCORE_API void rtcCommit (RTCScene hscene) 
   {
@@ -230,6 +261,7 @@ namespace embree
     RTCORE_CATCH_BEGIN;
     RTCORE_TRACE(rtcCommit);
     RTCORE_VERIFY_HANDLE(hscene);
+    RTCORE_CAPTURE(scene->device,commit(scene));
     scene->build(0,0);
     RTCORE_CATCH_END(scene->device);
   }
@@ -248,6 +280,11 @@ namespace embree
     unsigned int mxcsr = _mm_getcsr();
     _mm_setcsr(mxcsr | /* FTZ */ (1<<15) | /* DAZ */ (1<<6));
     
+    /* the first thread records the scene content */
+    if (threadID == 0) {
+      RTCORE_CAPTURE(scene->device,commit(scene));
+    }
+
     /* perform scene build */
     scene->build(threadID,numThreads);
 
@@ -257,6 +294,23 @@ namespace embree
     RTCORE_CATCH_END(scene->device);
   }
 
+  RTCORE_API void rtcCommitMany(RTCScene* hscenes, size_t numScenes) 
+  {
+    Device* device = (hscenes && numScenes && hscenes[0]) ? ((Scene*)hscenes[0])->device : nullptr;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcCommitMany);
+    if (numScenes == 0) return;
+    RTCORE_VERIFY_HANDLE(hscenes);
+    for (size_t i=0; i<numScenes; i++) {
+      RTCORE_VERIFY_HANDLE(hscenes[i]);
+      if (((Scene*)hscenes[i])->device != device)
+        throw_RTCError(RTC_INVALID_ARGUMENT,"scenes belong to different devices");
+      RTCORE_CAPTURE(device,commit((Scene*)hscenes[i]));
+    }
+    Scene::buildMany((Scene**)hscenes,numScenes);
+    RTCORE_CATCH_END(device);
+  }
+
   RTCORE_API void rtcGetBounds(RTCScene hscene, RTCBounds& bounds_o)
   {
     Scene* scene = (Scene*) hscene;
@@ -286,6 +340,7 @@ namespace embree
     if (((size_t)&ray) & 0x0F        ) throw_RTCError(RTC_INVALID_ARGUMENT, "ray not aligned to 16 bytes");   
 #endif
     STAT3(normal.travs,1,1,1);
+    RTCORE_CAPTURE(scene->device,rays(scene,CaptureLog::CALL_1,false,nullptr,nullptr,&ray,1,1,0));
     scene->intersect(ray,nullptr);
     RTCORE_CATCH_END(scene->device);
   }
@@ -303,6 +358,7 @@ namespace embree
     if (((size_t)valid) & 0x0F       ) throw_RTCError(RTC_INVALID_ARGUMENT, "mask not aligned to 16 bytes");   
     if (((size_t)&ray ) & 0x0F       ) throw_RTCError(RTC_INVALID_ARGUMENT, "ray not aligned to 16 bytes");   
 #endif
+    RTCORE_CAPTURE(scene->device,rays(scene,CaptureLog::CALL_N,false,nullptr,valid,&ray,4,1,0));
     STAT(size_t cnt=0; for (size_t i=0; i<4; i++) cnt += ((int*)valid)[i] == -1;);
     STAT3(normal.travs,1,cnt,4);
     scene->intersect4(valid,ray,nullptr);
@@ -325,6 +381,7 @@ namespace embree
     if (((size_t)valid) & 0x1F       ) throw_RTCError(RTC_INVALID_ARGUMENT, "mask not aligned to 32 bytes");   
     if (((size_t)&ray ) & 0x1F       ) throw_RTCError(RTC_INVALID_ARGUMENT, "ray not aligned to 32 bytes");   
 #endif
+    RTCORE_CAPTURE(scene->device,rays(scene,CaptureLog::CALL_N,false,nullptr,valid,&ray,8,1,0));
     STAT(size_t cnt=0; for (size_t i=0; i<8; i++) cnt += ((int*)valid)[i] == -1;);
     STAT3(normal.travs,1,cnt,8);
     scene->intersect8(valid,ray,nullptr);
@@ -347,6 +404,7 @@ namespace embree
     if (((size_t)valid) & 0x3F       ) throw_RTCError(RTC_INVALID_ARGUMENT, "mask not aligned to 64 bytes");   
     if (((size_t)&ray ) & 0x3F       ) throw_RTCError(RTC_INVALID_ARGUMENT, "ray not aligned to 64 bytes");   
 #endif
+    RTCORE_CAPTURE(scene->device,rays(scene,CaptureLog::CALL_N,false,nullptr,valid,&ray,16,1,0));
     STAT(size_t cnt=0; for (size_t i=0; i<16; i++) cnt += ((int*)valid)[i] == -1;);
     STAT3(normal.travs,1,cnt,16);
     scene->intersect16(valid,ray,nullptr);
@@ -363,15 +421,18 @@ namespace embree
     RTCORE_TRACE(rtcIntersect1M);
 
 #if defined (EMBREE_RAY_PACKETS)
+    RTCORE_VERIFY_CONTEXT(context);
 #if defined(DEBUG)
     RTCORE_VERIFY_HANDLE(hscene);
     if (scene->isModified()) throw_RTCError(RTC_INVALID_OPERATION,"scene got not committed");
     if (((size_t)rays ) & 0x03) throw_RTCError(RTC_INVALID_ARGUMENT, "ray not aligned to 4 bytes");   
 #endif
+    RTCORE_CAPTURE(scene->device,rays(scene,CaptureLog::CALL_1M,false,context,nullptr,rays,1,M,stride));
     STAT3(normal.travs,M,M,M);
     /* fast codepath for single rays */
     if (likely(M == 1)) {
-      if (likely(rays->tnear <= rays->tfar)) 
+      ClippedRay clipped(*(Ray*)rays,context,true);
+      if (likely(clipped.valid && rays->tnear <= rays->tfar)) 
         scene->intersect(*rays,context);
     } 
 
@@ -392,18 +453,21 @@ namespace embree
     RTCORE_TRACE(rtcIntersectNM);
 
 #if defined (EMBREE_RAY_PACKETS)
+    RTCORE_VERIFY_CONTEXT(context);
 #if defined(DEBUG)
     RTCORE_VERIFY_HANDLE(hscene);
     if (scene->isModified()) throw_RTCError(RTC_INVALID_OPERATION,"scene got not committed");
     if (((size_t)rays ) & 0x03) throw_RTCError(RTC_INVALID_ARGUMENT, "ray not aligned to 4 bytes");   
 #endif
+    RTCORE_CAPTURE(scene->device,rays(scene,CaptureLog::CALL_NM,false,context,nullptr,rays,N,M,stride));
     STAT3(normal.travs,N*M,N*M,N*M);
     /* code path for single ray streams */
     if (likely(N == 1))
     {
       /* fast code path for streams of size 1 */
       if (likely(M == 1)) {
-        if (likely(((RTCRay*)rays)->tnear <= ((RTCRay*)rays)->tfar))
+        ClippedRay clipped(*(Ray*)rays,context,true);
+        if (likely(clipped.valid && ((RTCRay*)rays)->tnear <= ((RTCRay*)rays)->tfar))
           scene->intersect(*(RTCRay*)rays,context);
       } 
       /* normal codepath for single ray streams */
@@ -428,6 +492,7 @@ namespace embree
     RTCORE_TRACE(rtcIntersectNp);
 
 #if defined (EMBREE_RAY_PACKETS)
+    RTCORE_VERIFY_CONTEXT(context);
 #if defined(DEBUG)
     RTCORE_VERIFY_HANDLE(hscene);
     if (scene->isModified()) throw_RTCError(RTC_INVALID_OPERATION,"scene got not committed");
@@ -450,6 +515,7 @@ namespace embree
     if (((size_t)rays.primID ) & 0x03 ) throw_RTCError(RTC_INVALID_ARGUMENT, "rays.primID not aligned to 4 bytes");   
     if (((size_t)rays.instID ) & 0x03 ) throw_RTCError(RTC_INVALID_ARGUMENT, "rays.instID not aligned to 4 bytes");   
 #endif
+    RTCORE_CAPTURE(scene->device,rays(scene,false,context,rays,N));
     STAT3(normal.travs,N,N,N);
 
     scene->device->rayStreamFilters.filterSOP(scene,rays,N,context,true);
@@ -459,6 +525,32 @@ namespace embree
     RTCORE_CATCH_END(scene->device);
   }
   
+  RTCORE_API void rtcIntersectTile (RTCScene hscene, const RTCIntersectContext* context, const RTCCamera& camera,
+                                    const unsigned x0, const unsigned y0, const unsigned width, const unsigned height,
+                                    RTCTileHit* hits, const size_t stride) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcIntersectTile);
+
+#if defined (EMBREE_RAY_PACKETS)
+    RTCORE_VERIFY_CONTEXT(context);
+#if defined(DEBUG)
+    RTCORE_VERIFY_HANDLE(hscene);
+    if (scene->isModified()) throw_RTCError(RTC_INVALID_OPERATION,"scene got not committed");
+    if (((size_t)hits) & 0x03) throw_RTCError(RTC_INVALID_ARGUMENT, "hits not aligned to 4 bytes");   
+#endif
+    if (height > 1 && stride < width*sizeof(RTCTileHit)) throw_RTCError(RTC_INVALID_ARGUMENT, "stride smaller than tile row");
+    RTCORE_CAPTURE(scene->device,tile(scene,context,camera,x0,y0,width,height));
+    STAT3(normal.travs,width*height,width*height,width*height);
+
+    scene->device->rayStreamFilters.intersectTile(scene,camera,x0,y0,width,height,hits,stride,context);
+#else
+    throw_RTCError(RTC_INVALID_OPERATION,"rtcIntersectTile not supported");
+#endif
+    RTCORE_CATCH_END(scene->device);
+  }
+
   RTCORE_API void rtcOccluded (RTCScene hscene, RTCRay& ray) 
   {
     Scene* scene = (Scene*) hscene;
@@ -470,6 +562,7 @@ namespace embree
     if (scene->isModified()) throw_RTCError(RTC_INVALID_OPERATION,"scene got not committed");
     if (((size_t)&ray) & 0x0F        ) throw_RTCError(RTC_INVALID_ARGUMENT, "ray not aligned to 16 bytes");   
 #endif
+    RTCORE_CAPTURE(scene->device,rays(scene,CaptureLog::CALL_1,true,nullptr,nullptr,&ray,1,1,0));
     scene->occluded(ray,nullptr);
     RTCORE_CATCH_END(scene->device);
   }
@@ -487,6 +580,7 @@ namespace embree
     if (((size_t)valid) & 0x0F       ) throw_RTCError(RTC_INVALID_ARGUMENT, "mask not aligned to 16 bytes");   
     if (((size_t)&ray ) & 0x0F       ) throw_RTCError(RTC_INVALID_ARGUMENT, "ray not aligned to 16 bytes");   
 #endif
+    RTCORE_CAPTURE(scene->device,rays(scene,CaptureLog::CALL_N,true,nullptr,valid,&ray,4,1,0));
     STAT(size_t cnt=0; for (size_t i=0; i<4; i++) cnt += ((int*)valid)[i] == -1;);
     STAT3(shadow.travs,1,cnt,4);
     scene->occluded4(valid,ray,nullptr);
@@ -509,6 +603,7 @@ namespace embree
     if (((size_t)valid) & 0x1F       ) throw_RTCError(RTC_INVALID_ARGUMENT, "mask not aligned to 32 bytes");   
     if (((size_t)&ray ) & 0x1F       ) throw_RTCError(RTC_INVALID_ARGUMENT, "ray not aligned to 32 bytes");   
 #endif
+    RTCORE_CAPTURE(scene->device,rays(scene,CaptureLog::CALL_N,true,nullptr,valid,&ray,8,1,0));
     STAT(size_t cnt=0; for (size_t i=0; i<8; i++) cnt += ((int*)valid)[i] == -1;);
     STAT3(shadow.travs,1,cnt,8);
     scene->occluded8(valid,ray,nullptr);
@@ -531,6 +626,7 @@ namespace embree
     if (((size_t)valid) & 0x3F       ) throw_RTCError(RTC_INVALID_ARGUMENT, "mask not aligned to 64 bytes");   
     if (((size_t)&ray ) & 0x3F       ) throw_RTCError(RTC_INVALID_ARGUMENT, "ray not aligned to 64 bytes");   
 #endif
+    RTCORE_CAPTURE(scene->device,rays(scene,CaptureLog::CALL_N,true,nullptr,valid,&ray,16,1,0));
     STAT(size_t cnt=0; for (size_t i=0; i<16; i++) cnt += ((int*)valid)[i] == -1;);
     STAT3(shadow.travs,1,cnt,16);
     scene->occluded16(valid,ray,nullptr);
@@ -547,16 +643,19 @@ namespace embree
     RTCORE_TRACE(rtcOccluded1M);
 
 #if defined (EMBREE_RAY_PACKETS)
+    RTCORE_VERIFY_CONTEXT(context);
 #if defined(DEBUG)
     RTCORE_VERIFY_HANDLE(hscene);
     if (scene->isModified()) throw_RTCError(RTC_INVALID_OPERATION,"scene got not committed");
     if (((size_t)rays ) & 0x03) throw_RTCError(RTC_INVALID_ARGUMENT, "ray not aligned to 4 bytes");   
 #endif
+    RTCORE_CAPTURE(scene->device,rays(scene,CaptureLog::CALL_1M,true,context,nullptr,rays,1,M,stride));
     STAT3(shadow.travs,M,M,M);
 
     /* fast codepath for streams of size 1 */
     if (likely(M == 1)) {
-      if (likely(rays->tnear <= rays->tfar)) 
+      ClippedRay clipped(*(Ray*)rays,context,false);
+      if (likely(clipped.valid && rays->tnear <= rays->tfar)) 
         scene->occluded (*rays,context);
     } 
     /* codepath for normal streams */
@@ -576,12 +675,14 @@ namespace embree
     RTCORE_TRACE(rtcOccludedNM);
 
 #if defined (EMBREE_RAY_PACKETS)
+    RTCORE_VERIFY_CONTEXT(context);
 #if defined(DEBUG)
     RTCORE_VERIFY_HANDLE(hscene);
     if (stride < sizeof(RTCRay)) throw_RTCError(RTC_INVALID_OPERATION,"stride too small");
     if (scene->isModified()) throw_RTCError(RTC_INVALID_OPERATION,"scene got not committed");
     if (((size_t)rays ) & 0x03) throw_RTCError(RTC_INVALID_ARGUMENT, "ray not aligned to 4 bytes");   
 #endif
+    RTCORE_CAPTURE(scene->device,rays(scene,CaptureLog::CALL_NM,true,context,nullptr,rays,N,M,stride));
     STAT3(shadow.travs,N*M,N*N,N*N);
 
     /* codepath for single rays */
@@ -589,7 +690,8 @@ namespace embree
     {
       /* fast path for streams of size 1 */
       if (likely(M == 1)) {
-        if (likely(((RTCRay*)rays)->tnear <= ((RTCRay*)rays)->tfar))
+        ClippedRay clipped(*(Ray*)rays,context,false);
+        if (likely(clipped.valid && ((RTCRay*)rays)->tnear <= ((RTCRay*)rays)->tfar))
           scene->occluded (*(RTCRay*)rays,context);
       } 
       /* codepath for normal ray streams */
@@ -614,6 +716,7 @@ namespace embree
     RTCORE_TRACE(rtcOccludedNp);
 
 #if defined (EMBREE_RAY_PACKETS)
+    RTCORE_VERIFY_CONTEXT(context);
 #if defined(DEBUG)
     RTCORE_VERIFY_HANDLE(hscene);
     if (scene->isModified()) throw_RTCError(RTC_INVALID_OPERATION,"scene got not committed");
@@ -636,6 +739,7 @@ namespace embree
     if (((size_t)rays.primID ) & 0x03 ) throw_RTCError(RTC_INVALID_ARGUMENT, "rays.primID not aligned to 4 bytes");   
     if (((size_t)rays.instID ) & 0x03 ) throw_RTCError(RTC_INVALID_ARGUMENT, "rays.instID not aligned to 4 bytes");   
 #endif
+    RTCORE_CAPTURE(scene->device,rays(scene,true,context,rays,N));
     STAT3(shadow.travs,N,N,N);
 
     scene->device->rayStreamFilters.filterSOP(scene,rays,N,context,false);
@@ -644,6 +748,62 @@ namespace embree
 #endif
     RTCORE_CATCH_END(scene->device);
   }
+
+  RTCORE_API RTCRayQueue rtcNewRayQueue (RTCScene hscene, const RTCIntersectContext* context, RTCRayQueueType type, RTCRayQueueFunc func, void* userPtr)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcNewRayQueue);
+    RTCORE_VERIFY_HANDLE(hscene);
+    RTCORE_VERIFY_CONTEXT(context);
+    RTCORE_VERIFY_HANDLE(func);
+#if defined (EMBREE_RAY_PACKETS)
+    if (!scene->isStreamMode()) throw_RTCError(RTC_INVALID_OPERATION,"scene does not support ray streams");
+    if (type != RTC_RAY_QUEUE_INTERSECT && type != RTC_RAY_QUEUE_OCCLUDED) throw_RTCError(RTC_INVALID_ARGUMENT,"invalid ray queue type");
+    RayQueue* queue = new RayQueue(scene,context,type == RTC_RAY_QUEUE_OCCLUDED,func,userPtr);
+    queue->refInc();
+    return (RTCRayQueue) queue;
+#else
+    throw_RTCError(RTC_INVALID_OPERATION,"rtcNewRayQueue not supported");
+#endif
+    RTCORE_CATCH_END(scene->device);
+    return nullptr;
+  }
+
+  RTCORE_API void rtcRayQueueAppend (RTCRayQueue hqueue, const RTCRay* rays, const unsigned int* rayIDs, const size_t M, const size_t stride)
+  {
+    RayQueue* queue = (RayQueue*) hqueue;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcRayQueueAppend);
+#if defined(DEBUG)
+    RTCORE_VERIFY_HANDLE(hqueue);
+    if (queue->scene->isModified()) throw_RTCError(RTC_INVALID_OPERATION,"scene got not committed");
+    if (((size_t)rays ) & 0x03) throw_RTCError(RTC_INVALID_ARGUMENT, "ray not aligned to 4 bytes");   
+#endif
+    queue->append(rays,rayIDs,M,stride);
+    RTCORE_CATCH_END(queue->scene->device);
+  }
+
+  RTCORE_API void rtcRayQueueFlush (RTCRayQueue hqueue)
+  {
+    RayQueue* queue = (RayQueue*) hqueue;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcRayQueueFlush);
+    RTCORE_VERIFY_HANDLE(hqueue);
+    queue->flush();
+    RTCORE_CATCH_END(queue->scene->device);
+  }
+
+  RTCORE_API void rtcDeleteRayQueue (RTCRayQueue hqueue)
+  {
+    RayQueue* queue = (RayQueue*) hqueue;
+    Device* device = queue ? queue->scene->device : nullptr;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcDeleteRayQueue);
+    RTCORE_VERIFY_HANDLE(hqueue);
+    queue->refDec();
+    RTCORE_CATCH_END(device);
+  }
   
   RTCORE_API void rtcDeleteScene (RTCScene hscene) 
   {
@@ -652,6 +812,7 @@ namespace embree
     RTCORE_CATCH_BEGIN;
     RTCORE_TRACE(rtcDeleteScene);
     RTCORE_VERIFY_HANDLE(hscene);
+    RTCORE_CAPTURE(device,deleteScene(scene));
     delete scene;
     RTCORE_CATCH_END(device);
   }
@@ -821,6 +982,17 @@ namespace embree
     return -1;
   }
 
+  RTCORE_API unsigned rtcNewRibbonGeometry (RTCScene hscene, RTCGeometryFlags flags, size_t numCurves, size_t numVertices, size_t numTimeSteps) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcNewRibbonGeometry);
+    RTCORE_VERIFY_HANDLE(hscene);
+    return scene->newBezierCurves(BezierCurves::RIBBON,flags,numCurves,numVertices,numTimeSteps);
+    RTCORE_CATCH_END(scene->device);
+    return -1;
+  }
+
   RTCORE_API unsigned rtcNewLineSegments (RTCScene hscene, RTCGeometryFlags flags, size_t numSegments, size_t numVertices, size_t numTimeSteps)
   {
     Scene* scene = (Scene*) hscene;
@@ -832,6 +1004,28 @@ namespace embree
     return -1;
   }
 
+  RTCORE_API unsigned rtcNewPoints (RTCScene hscene, RTCGeometryFlags flags, size_t numPoints, size_t numTimeSteps)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcNewPoints);
+    RTCORE_VERIFY_HANDLE(hscene);
+    return scene->newPoints(Points::SPHERE,flags,numPoints,numTimeSteps);
+    RTCORE_CATCH_END(scene->device);
+    return -1;
+  }
+
+  RTCORE_API unsigned rtcNewDiscPoints (RTCScene hscene, RTCGeometryFlags flags, size_t numPoints, size_t numTimeSteps)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcNewDiscPoints);
+    RTCORE_VERIFY_HANDLE(hscene);
+    return scene->newPoints(Points::DISC,flags,numPoints,numTimeSteps);
+    RTCORE_CATCH_END(scene->device);
+    return -1;
+  }
+
   RTCORE_API unsigned rtcNewSubdivisionMesh (RTCScene hscene, RTCGeometryFlags flags, size_t numFaces, size_t numEdges, size_t numVertices, 
                                              size_t numEdgeCreases, size_t numVertexCreases, size_t numHoles, size_t numTimeSteps) 
   {
@@ -966,6 +1160,28 @@ namespace embree
     RTCORE_CATCH_END(scene->device);
   }
 
+  RTCORE_API void rtcSetCurveBasis (RTCScene hscene, unsigned geomID, RTCCurveBasis basis)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcSetCurveBasis);
+    RTCORE_VERIFY_HANDLE(hscene);
+    RTCORE_VERIFY_GEOMID(geomID);
+    scene->get_locked(geomID)->setCurveBasis(basis);
+    RTCORE_CATCH_END(scene->device);
+  }
+
+  RTCORE_API void rtcSetVertexFormat (RTCScene hscene, unsigned geomID, RTCVertexFormat format, const float* scale, const float* offset)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcSetVertexFormat);
+    RTCORE_VERIFY_HANDLE(hscene);
+    RTCORE_VERIFY_GEOMID(geomID);
+    scene->get_locked(geomID)->setVertexFormat(format,scale,offset);
+    RTCORE_CATCH_END(scene->device);
+  }
+
   RTCORE_API void rtcSetUserData (RTCScene hscene, unsigned geomID, void* ptr) 
   {
     Scene* scene = (Scene*) hscene;
@@ -1011,6 +1227,17 @@ namespace embree
     RTCORE_CATCH_END(scene->device);
   }
 
+  RTCORE_API void rtcSetBoundsFunctionSoA (RTCScene hscene, unsigned geomID, RTCBoundsFuncSoA bounds, void* userPtr)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcSetBoundsFunctionSoA);
+    RTCORE_VERIFY_HANDLE(hscene);
+    RTCORE_VERIFY_GEOMID(geomID);
+    scene->get_locked(geomID)->setBoundsFunctionSoA(bounds,userPtr);
+    RTCORE_CATCH_END(scene->device);
+  }
+
   RTCORE_API void rtcSetDisplacementFunction (RTCScene hscene, unsigned geomID, RTCDisplacementFunc func, RTCBounds* bounds)
   {
     Scene* scene = (Scene*) hscene;
@@ -1088,6 +1315,17 @@ namespace embree
     RTCORE_CATCH_END(scene->device);
   }
 
+  RTCORE_API void rtcSetIntersectFunctionLeaf (RTCScene hscene, unsigned geomID, RTCIntersectFuncLeaf intersect) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcSetIntersectFunctionLeaf);
+    RTCORE_VERIFY_HANDLE(hscene);
+    RTCORE_VERIFY_GEOMID(geomID);
+    scene->get_locked(geomID)->setIntersectFunctionLeaf(intersect);
+    RTCORE_CATCH_END(scene->device);
+  }
+
   RTCORE_API void rtcSetOccludedFunction (RTCScene hscene, unsigned geomID, RTCOccludedFunc occluded) 
   {
     Scene* scene = (Scene*) hscene;
@@ -1154,6 +1392,17 @@ namespace embree
     RTCORE_CATCH_END(scene->device);
   }
 
+  RTCORE_API void rtcSetOccludedFunctionLeaf (RTCScene hscene, unsigned geomID, RTCOccludedFuncLeaf occluded) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcSetOccludedFunctionLeaf);
+    RTCORE_VERIFY_HANDLE(hscene);
+    RTCORE_VERIFY_GEOMID(geomID);
+    scene->get_locked(geomID)->setOccludedFunctionLeaf(occluded);
+    RTCORE_CATCH_END(scene->device);
+  }
+
   RTCORE_API void rtcSetIntersectionFilterFunction (RTCScene hscene, unsigned geomID, RTCFilterFunc intersect) 
   {
     Scene* scene = (Scene*) hscene;
@@ -27,6 +27,7 @@ namespace embree
   __forceinline bool isCoherent  (RTCSceneFlags flags) { return (flags & RTC_SCENE_COHERENT) != 0; }
   __forceinline bool isIncoherent(RTCSceneFlags flags) { return (flags & RTC_SCENE_INCOHERENT) != 0; }
   __forceinline bool isHighQuality(RTCSceneFlags flags) { return (flags & RTC_SCENE_HIGH_QUALITY) != 0; }
+  __forceinline bool isLarge     (RTCSceneFlags flags) { return (flags & RTC_SCENE_LARGE) != 0; }
 
   /*! decoding of algorithm flags */
   __forceinline bool isInterpolatable(RTCAlgorithmFlags flags) { return (flags & RTC_INTERPOLATE) != 0; }
@@ -39,6 +40,34 @@ namespace embree
    /*! decoding of intersection flags */
   __forceinline bool isCoherent  (RTCIntersectFlags flags) { return (flags & RTC_INTERSECT_INCOHERENT) == 0; }
   __forceinline bool isIncoherent(RTCIntersectFlags flags) { return (flags & RTC_INTERSECT_INCOHERENT) != 0; }
+  __forceinline bool isDistanceOnly(RTCIntersectFlags flags) { return (flags & RTC_INTERSECT_DISTANCE_ONLY) != 0; }
+  __forceinline bool isDistanceOnly(const RTCIntersectContext* context) { return context && isDistanceOnly(context->flags); }
+  __forceinline bool hasClipVolume(const RTCIntersectContext* context) { return context && (context->flags & RTC_INTERSECT_CLIP_VOLUME) != 0; }
+
+  /*! leaf that occluded the previous ray of an occlusion cache slot */
+  struct OcclusionCacheEntry
+  {
+    /*! returns the cached leaf if it belongs to the specified build of the acceleration structure, otherwise 0 */
+    __forceinline size_t lookup(const void* accel, size_t build) const {
+      return (this->accel == (size_t)accel && this->build == build) ? leaf : 0;
+    }
+
+    __forceinline void store(const void* accel, size_t build, size_t leaf) {
+      this->accel = (size_t)accel; this->build = build; this->leaf = leaf;
+    }
+
+    size_t accel;  //!< acceleration structure the leaf belongs to
+    size_t build;  //!< commit counter of the scene when the leaf got cached
+    size_t leaf;   //!< reference to the occluding leaf
+  };
+
+  /*! returns the occlusion cache entry selected by the context, or nullptr if caching is disabled */
+  __forceinline OcclusionCacheEntry* getOcclusionCacheEntry(const RTCIntersectContext* context)
+  {
+    if (likely(!context || (context->flags & RTC_INTERSECT_OCCLUSION_CACHE) == 0)) return nullptr;
+    RTCOcclusionCache* cache = context->occlusionCache;
+    return (OcclusionCacheEntry*) cache->entries[cache->slot % RTC_OCCLUSION_CACHE_SLOTS];
+  }
 
 #if TBB_INTERFACE_VERSION_MAJOR < 8    
 #  define USE_TASK_ARENA 0
@@ -69,12 +98,25 @@ namespace embree
     throw_RTCError(RTC_INVALID_ARGUMENT,"invalid argument");       \
   }
 
+/*! rejects contexts that enable clipping without a valid clip volume */
+#define RTCORE_VERIFY_CONTEXT(context)                                  \
+  if (hasClipVolume(context)) {                                         \
+    if (context->clipVolume == nullptr)                                 \
+      throw_RTCError(RTC_INVALID_ARGUMENT,"clip volume not set");       \
+    if (context->clipVolume->numPlanes > RTC_MAX_CLIP_PLANES)           \
+      throw_RTCError(RTC_INVALID_ARGUMENT,"too many clip planes");      \
+  }
+
 #if 0 // enable to debug print all API calls
 #define RTCORE_TRACE(x) std::cout << #x << std::endl;
 #else
 #define RTCORE_TRACE(x) 
 #endif
 
+/*! records the API call in the capture log of the device if capturing is enabled */
+#define RTCORE_CAPTURE(device,x)                                        \
+  do { if (unlikely((device)->capture != nullptr)) (device)->capture->x; } while (false)
+
   /*! used to throw embree API errors */
   struct rtcore_error : public std::exception
   {
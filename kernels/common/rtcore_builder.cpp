@@ -0,0 +1,402 @@
+// ======================================================================== //
+// Copyright 2009-2016 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#ifdef _WIN32
+#  define RTCORE_API extern "C" __declspec(dllexport)
+#else
+#  define RTCORE_API extern "C" __attribute__ ((visibility ("default")))
+#endif
+
+#include "default.h"
+#include "device.h"
+#include "alloc.h"
+#include "../builders/bvh_builder_sah.h"
+#include "../builders/bvh_builder_morton.h"
+
+namespace embree
+{
+  namespace isa
+  {
+    static const size_t MAX_BRANCHING_FACTOR = 16;
+
+    /*! BVH object of the builder API, owns all memory of the nodes and leaves */
+    struct BVH : public RefCount
+    {
+      BVH (Device* device)
+        : device(device), allocator(device), morton_src(device), morton_tmp(device) {}
+
+    public:
+      Device* device;
+      FastAllocator allocator;
+      mvector<MortonID32Bit> morton_src;
+      mvector<MortonID32Bit> morton_tmp;
+    };
+
+    void* rtcBuildBVHMorton(BVH* bvh,
+                            const RTCBuildSettings& settings,
+                            RTCBuildPrimitive* prims_i,
+                            size_t numPrimitives,
+                            RTCCreateNodeFunc createNode,
+                            RTCSetNodeChildrenFunc setNodeChildren,
+                            RTCSetNodeBoundsFunc setNodeBounds,
+                            RTCCreateLeafFunc createLeaf,
+                            RTCBuildProgressFunc buildProgress,
+                            void* userPtr)
+    {
+      typedef MortonBuildRecord<void*> BuildRecord;
+      PrimRef* prims = (PrimRef*) prims_i;
+
+      /* array for morton builder */
+      bvh->morton_src.resize(numPrimitives);
+      bvh->morton_tmp.resize(numPrimitives);
+      parallel_for(size_t(0), numPrimitives, size_t(1024), [&] (const range<size_t>& r) {
+          for (size_t i=r.begin(); i<r.end(); i++)
+            bvh->morton_src[i].index = unsigned(i);
+        });
+
+      /* thread local allocator for fast allocations */
+      auto createAllocator = [&] () -> FastAllocator::ThreadLocal* {
+        return bvh->allocator.threadLocal();
+      };
+
+      /* lambda function that allocates BVH nodes, each child record
+       * stores the node created for it in its own parent field, thus
+       * setBounds can collect the children after the recursion */
+      auto allocNode = [&] (BuildRecord& current, BuildRecord* children, size_t N, FastAllocator::ThreadLocal* alloc) -> std::pair<void*,BuildRecord*>
+      {
+        void* node = createNode((RTCThreadLocalAllocator)alloc,N,userPtr);
+        *current.parent = node;
+        for (size_t i=0; i<N; i++)
+          children[i].parent = (void**) &children[i].parent;
+        return std::make_pair(node,children);
+      };
+
+      /* lambda function that sets the children and bounds of a node */
+      auto setBounds = [&] (const std::pair<void*,BuildRecord*>& node, const BBox3fa* bounds, size_t N) -> BBox3fa
+      {
+        void* children[MAX_BRANCHING_FACTOR];
+        const RTCBounds* cbounds[MAX_BRANCHING_FACTOR];
+        BBox3fa res = empty;
+        for (size_t i=0; i<N; i++) {
+          children[i] = (void*) node.second[i].parent;
+          cbounds[i] = (const RTCBounds*) &bounds[i];
+          res.extend(bounds[i]);
+        }
+        setNodeChildren(node.first,children,N,userPtr);
+        setNodeBounds(node.first,cbounds,N,userPtr);
+        return res;
+      };
+
+      /* lambda function that creates BVH leaves */
+      auto createLeafMorton = [&] (BuildRecord& current, FastAllocator::ThreadLocal* alloc, BBox3fa& box_o)
+      {
+        RTCBuildPrimitive localPrims[RTC_BUILD_MAX_PRIMITIVES_PER_LEAF];
+        BBox3fa bounds = empty;
+        for (size_t i=0; i<current.size(); i++) {
+          const size_t id = bvh->morton_src[current.begin+i].index;
+          bounds.extend(prims[id].bounds());
+          localPrims[i] = prims_i[id];
+        }
+        *current.parent = createLeaf((RTCThreadLocalAllocator)alloc,localPrims,current.size(),userPtr);
+        box_o = bounds;
+      };
+
+      /* lambda that calculates the bounds for some primitive */
+      auto calculateBounds = [&] (const MortonID32Bit& morton) -> BBox3fa {
+        return prims[morton.index].bounds();
+      };
+
+      /* progress monitor function */
+      auto progress = [&] (size_t dn) {
+        if (buildProgress) buildProgress(dn,userPtr);
+      };
+
+      std::pair<void*,BBox3fa> root = bvh_builder_morton<void*>(
+        createAllocator,BBox3fa(empty),allocNode,setBounds,createLeafMorton,calculateBounds,progress,
+        bvh->morton_src.data(),bvh->morton_tmp.data(),numPrimitives,
+        settings.maxBranchingFactor,settings.maxDepth,settings.minLeafSize,settings.maxLeafSize);
+
+      return root.first;
+    }
+
+    void* rtcBuildBVHBinnedSAH(BVH* bvh,
+                               const RTCBuildSettings& settings,
+                               RTCBuildPrimitive* prims_i,
+                               size_t numPrimitives,
+                               RTCCreateNodeFunc createNode,
+                               RTCSetNodeChildrenFunc setNodeChildren,
+                               RTCSetNodeBoundsFunc setNodeBounds,
+                               RTCCreateLeafFunc createLeaf,
+                               RTCBuildProgressFunc buildProgress,
+                               void* userPtr)
+    {
+      typedef BVHBuilderBinnedSAH::BuildRecord BuildRecord;
+      PrimRef* prims = (PrimRef*) prims_i;
+
+      /* calculate priminfo */
+      const PrimInfo pinfo = parallel_reduce(size_t(0), numPrimitives, size_t(1024), PrimInfo(empty), [&] (const range<size_t>& r) -> PrimInfo {
+          PrimInfo pinfo(empty);
+          for (size_t i=r.begin(); i<r.end(); i++)
+            pinfo.add(prims[i].bounds());
+          return pinfo;
+        }, [] (const PrimInfo& a, const PrimInfo& b) { return PrimInfo::merge(a,b); });
+
+      /* thread local allocator for fast allocations */
+      auto createAllocator = [&] () -> FastAllocator::ThreadLocal* {
+        return bvh->allocator.threadLocal();
+      };
+
+      /* lambda function that creates BVH nodes, the bounds of the children are already known here */
+      auto createNodeSAH = [&] (const BuildRecord& current, BuildRecord* children, const size_t N, FastAllocator::ThreadLocal* alloc) -> void*
+      {
+        void* node = createNode((RTCThreadLocalAllocator)alloc,N,userPtr);
+        const RTCBounds* cbounds[MAX_BRANCHING_FACTOR];
+        for (size_t i=0; i<N; i++)
+          cbounds[i] = (const RTCBounds*) &children[i].pinfo.geomBounds;
+        setNodeBounds(node,cbounds,N,userPtr);
+        return node;
+      };
+
+      /* lambda function that links the children into the node */
+      auto updateNode = [&] (void* node, void** children, const size_t N) -> void* {
+        setNodeChildren(node,children,N,userPtr);
+        return node;
+      };
+
+      /* lambda function that creates BVH leaves */
+      auto createLeafSAH = [&] (const BuildRecord& current, FastAllocator::ThreadLocal* alloc) -> void* {
+        return createLeaf((RTCThreadLocalAllocator)alloc,prims_i+current.prims.begin(),current.prims.size(),userPtr);
+      };
+
+      /* progress monitor function */
+      auto progress = [&] (size_t dn) {
+        if (buildProgress) buildProgress(dn,userPtr);
+      };
+
+      void* root = nullptr;
+      return BVHBuilderBinnedSAH::build_reduce<void*>(
+        root,createAllocator,(void*)nullptr,createNodeSAH,updateNode,createLeafSAH,progress,
+        prims,pinfo,settings.maxBranchingFactor,settings.maxDepth,settings.sahBlockSize,
+        settings.minLeafSize,settings.maxLeafSize,settings.travCost,settings.intCost);
+    }
+
+    void* rtcBuildBVHSpatialSAH(BVH* bvh,
+                                const RTCBuildSettings& settings,
+                                RTCBuildPrimitive* prims_i,
+                                size_t numPrimitives,
+                                RTCCreateNodeFunc createNode,
+                                RTCSetNodeChildrenFunc setNodeChildren,
+                                RTCSetNodeBoundsFunc setNodeBounds,
+                                RTCCreateLeafFunc createLeaf,
+                                RTCSplitPrimitiveFunc splitPrimitive,
+                                RTCBuildProgressFunc buildProgress,
+                                void* userPtr)
+    {
+      typedef BVHBuilderBinnedFastSpatialSAH::BuildRecord BuildRecord;
+      PrimRef* prims = (PrimRef*) prims_i;
+
+      /* calculate priminfo */
+      const PrimInfo pinfo = parallel_reduce(size_t(0), numPrimitives, size_t(1024), PrimInfo(empty), [&] (const range<size_t>& r) -> PrimInfo {
+          PrimInfo pinfo(empty);
+          for (size_t i=r.begin(); i<r.end(); i++)
+            pinfo.add(prims[i].bounds());
+          return pinfo;
+        }, [] (const PrimInfo& a, const PrimInfo& b) { return PrimInfo::merge(a,b); });
+
+      /* calculate maximal number of spatial splits per primitive, encoded in the upper 8 bits of the geomID */
+      const float A = area(pinfo.geomBounds);
+      const float f = 10.0f;
+      parallel_for(size_t(0), numPrimitives, size_t(1024), [&] (const range<size_t>& r) {
+          for (size_t i=r.begin(); i<r.end(); i++)
+          {
+            PrimRef& prim = prims[i];
+            assert((prim.lower.a & 0xFF000000) == 0);
+            const float nf = A > 0.0f ? ceilf(f*pinfo.size()*area(prim.bounds())/A) : 1.0f;
+            size_t n = 4+min(ssize_t(127-4), max(ssize_t(1), ssize_t(nf)));
+            prim.lower.a |= n << 24;
+          }
+        });
+
+      /* function that splits a primitive at some position and dimension */
+      auto splitPrimitiveFunc = [&] (const PrimRef& prim, int dim, float pos, PrimRef& left_o, PrimRef& right_o)
+      {
+        PrimRef prim0 = prim;
+        prim0.lower.a &= 0x00FFFFFF;
+        BBox3fa lbounds, rbounds;
+        splitPrimitive((const RTCBuildPrimitive*)&prim0,unsigned(dim),pos,(RTCBounds*)&lbounds,(RTCBounds*)&rbounds,userPtr);
+        left_o  = PrimRef(lbounds,prim.geomID(),prim.primID());
+        right_o = PrimRef(rbounds,prim.geomID(),prim.primID());
+      };
+
+      /* generic binning that calls the split function for each straddled bin border */
+      auto binnerSplitPrimitiveFunc = [&] (SpatialBinInfo<FAST_SPATIAL_BUILDER_NUM_SPATIAL_SPLITS,PrimRef>& binner,
+                                           const PrimRef* const source, const size_t begin, const size_t end,
+                                           const SpatialBinMapping<FAST_SPATIAL_BUILDER_NUM_SPATIAL_SPLITS>& mapping)
+      {
+        binner.bin(splitPrimitiveFunc,source,begin,end,mapping);
+      };
+
+      /* thread local allocator for fast allocations */
+      auto createAllocator = [&] () -> FastAllocator::ThreadLocal* {
+        return bvh->allocator.threadLocal();
+      };
+
+      /* lambda function that creates BVH nodes, the bounds of the children are already known here */
+      auto createNodeSAH = [&] (const BuildRecord& current, BuildRecord* children, const size_t N, FastAllocator::ThreadLocal* alloc) -> void*
+      {
+        void* node = createNode((RTCThreadLocalAllocator)alloc,N,userPtr);
+        const RTCBounds* cbounds[MAX_BRANCHING_FACTOR];
+        for (size_t i=0; i<N; i++)
+          cbounds[i] = (const RTCBounds*) &children[i].pinfo.geomBounds;
+        setNodeBounds(node,cbounds,N,userPtr);
+        return node;
+      };
+
+      /* lambda function that links the children into the node */
+      auto updateNode = [&] (void* node, void** children, const size_t N) -> void* {
+        setNodeChildren(node,children,N,userPtr);
+        return node;
+      };
+
+      /* lambda function that creates BVH leaves, removes the split count encoding first */
+      auto createLeafSAH = [&] (const BuildRecord& current, FastAllocator::ThreadLocal* alloc) -> void*
+      {
+        for (size_t i=current.prims.begin(); i<current.prims.end(); i++)
+          prims[i].lower.a &= 0x00FFFFFF;
+        return createLeaf((RTCThreadLocalAllocator)alloc,prims_i+current.prims.begin(),current.prims.size(),userPtr);
+      };
+
+      /* progress monitor function */
+      auto progress = [&] (size_t dn) {
+        if (buildProgress) buildProgress(dn,userPtr);
+      };
+
+      void* root = nullptr;
+      return BVHBuilderBinnedFastSpatialSAH::build_reduce<void*>(
+        root,createAllocator,(void*)nullptr,createNodeSAH,updateNode,createLeafSAH,splitPrimitiveFunc,binnerSplitPrimitiveFunc,progress,
+        prims,numPrimitives+settings.extraSpace,pinfo,settings.maxBranchingFactor,settings.maxDepth,settings.sahBlockSize,
+        settings.minLeafSize,settings.maxLeafSize,settings.travCost,settings.intCost);
+    }
+  }
+
+  using namespace isa;
+
+  RTCORE_API RTCBVH rtcNewBVH(RTCDevice device)
+  {
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcNewBVH);
+    RTCORE_VERIFY_HANDLE(device);
+    BVH* bvh = new BVH((Device*)device);
+    bvh->refInc();
+    return (RTCBVH) bvh;
+    RTCORE_CATCH_END((Device*)device);
+    return nullptr;
+  }
+
+  RTCORE_API void* rtcBuildBVH(RTCBVH hbvh,
+                               const RTCBuildSettings& settings,
+                               RTCBuildPrimitive* prims,
+                               size_t numPrimitives,
+                               RTCCreateNodeFunc createNode,
+                               RTCSetNodeChildrenFunc setNodeChildren,
+                               RTCSetNodeBoundsFunc setNodeBounds,
+                               RTCCreateLeafFunc createLeaf,
+                               RTCSplitPrimitiveFunc splitPrimitive,
+                               RTCBuildProgressFunc buildProgress,
+                               void* userPtr)
+  {
+    BVH* bvh = (BVH*) hbvh;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcBuildBVH);
+    RTCORE_VERIFY_HANDLE(hbvh);
+    RTCORE_VERIFY_HANDLE(createNode);
+    RTCORE_VERIFY_HANDLE(setNodeChildren);
+    RTCORE_VERIFY_HANDLE(setNodeBounds);
+    RTCORE_VERIFY_HANDLE(createLeaf);
+
+    if (settings.size < sizeof(RTCBuildSettings))
+      throw_RTCError(RTC_INVALID_ARGUMENT,"invalid build settings size");
+    if (settings.maxBranchingFactor < 2 || settings.maxBranchingFactor > MAX_BRANCHING_FACTOR)
+      throw_RTCError(RTC_INVALID_ARGUMENT,"invalid branching factor");
+    if (settings.sahBlockSize == 0 || (settings.sahBlockSize & (settings.sahBlockSize-1)))
+      throw_RTCError(RTC_INVALID_ARGUMENT,"SAH block size has to be a power of 2");
+    if (settings.minLeafSize > settings.maxLeafSize || settings.maxLeafSize > RTC_BUILD_MAX_PRIMITIVES_PER_LEAF)
+      throw_RTCError(RTC_INVALID_ARGUMENT,"invalid leaf size");
+    if (settings.quality == RTC_BUILD_QUALITY_HIGH && splitPrimitive == nullptr)
+      throw_RTCError(RTC_INVALID_ARGUMENT,"spatial split builds require a split primitive function");
+
+    /* spatial split builds encode the split count in the upper 8 bits of the geomID */
+    if (settings.quality == RTC_BUILD_QUALITY_HIGH) {
+      for (size_t i=0; i<numPrimitives; i++)
+        if (unsigned(prims[i].geomID) >= (1u << 24))
+          throw_RTCError(RTC_INVALID_ARGUMENT,"geomID of spatial split builds has to be smaller than 2^24");
+    }
+
+    /* nodes of a previous build get released */
+    bvh->allocator.reset();
+    if (numPrimitives == 0)
+      return nullptr;
+
+    bvh->allocator.init_estimate(numPrimitives*sizeof(BBox3fa));
+
+    void* root = nullptr;
+    switch (settings.quality) {
+    case RTC_BUILD_QUALITY_LOW   : root = rtcBuildBVHMorton    (bvh,settings,prims,numPrimitives,createNode,setNodeChildren,setNodeBounds,createLeaf,buildProgress,userPtr); break;
+    case RTC_BUILD_QUALITY_MEDIUM: root = rtcBuildBVHBinnedSAH (bvh,settings,prims,numPrimitives,createNode,setNodeChildren,setNodeBounds,createLeaf,buildProgress,userPtr); break;
+    case RTC_BUILD_QUALITY_HIGH  : root = rtcBuildBVHSpatialSAH(bvh,settings,prims,numPrimitives,createNode,setNodeChildren,setNodeBounds,createLeaf,splitPrimitive,buildProgress,userPtr); break;
+    default: throw_RTCError(RTC_INVALID_ARGUMENT,"invalid build quality");
+    }
+
+    bvh->allocator.cleanup();
+    return root;
+    RTCORE_CATCH_END(bvh->device);
+    return nullptr;
+  }
+
+  RTCORE_API void* rtcThreadLocalAlloc(RTCThreadLocalAllocator allocator, size_t bytes, size_t align)
+  {
+    FastAllocator::ThreadLocal* alloc = (FastAllocator::ThreadLocal*) allocator;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcThreadLocalAlloc);
+    if (align > 64)
+      throw_RTCError(RTC_INVALID_ARGUMENT,"alignment too large");
+    return alloc->malloc(bytes,align);
+    RTCORE_CATCH_END(nullptr);
+    return nullptr;
+  }
+
+  RTCORE_API void rtcMakeStaticBVH(RTCBVH hbvh)
+  {
+    BVH* bvh = (BVH*) hbvh;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcMakeStaticBVH);
+    RTCORE_VERIFY_HANDLE(hbvh);
+    bvh->morton_src.clear();
+    bvh->morton_tmp.clear();
+    bvh->allocator.shrink();
+    RTCORE_CATCH_END(bvh->device);
+  }
+
+  RTCORE_API void rtcDeleteBVH(RTCBVH hbvh)
+  {
+    BVH* bvh = (BVH*) hbvh;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcDeleteBVH);
+    RTCORE_VERIFY_HANDLE(hbvh);
+    bvh->refDec();
+    RTCORE_CATCH_END(bvh->device);
+  }
+}
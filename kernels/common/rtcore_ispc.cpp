@@ -143,6 +143,11 @@ namespace embree
   extern "C" void ispcIntersectNp (RTCScene scene, const RTCIntersectContext* context, const RTCRayNp& rays, const  size_t N) {
     rtcIntersectNp(scene,context,rays,N);
   }
+
+  extern "C" void ispcIntersectTile (RTCScene scene, const RTCIntersectContext* context, const RTCCamera& camera,
+                                     unsigned x0, unsigned y0, unsigned width, unsigned height, RTCTileHit* hits, size_t stride) {
+    rtcIntersectTile(scene,context,camera,x0,y0,width,height,hits,stride);
+  }
   
   extern "C" void ispcOccluded1 (RTCScene scene, RTCRay& ray) {
     rtcOccluded(scene,ray);
@@ -212,6 +217,14 @@ namespace embree
     return rtcNewLineSegments(scene,flags,numSegments,numVertices,numTimeSteps);
   }
 
+  extern "C" unsigned ispcNewPoints (RTCScene scene, RTCGeometryFlags flags, size_t numPoints, size_t numTimeSteps) {
+    return rtcNewPoints(scene,flags,numPoints,numTimeSteps);
+  }
+
+  extern "C" unsigned ispcNewDiscPoints (RTCScene scene, RTCGeometryFlags flags, size_t numPoints, size_t numTimeSteps) {
+    return rtcNewDiscPoints(scene,flags,numPoints,numTimeSteps);
+  }
+
   extern "C" unsigned ispcNewHairGeometry (RTCScene scene, RTCGeometryFlags flags, size_t numCurves, size_t numVertices, size_t numTimeSteps) {
     return rtcNewHairGeometry(scene,flags,numCurves,numVertices,numTimeSteps);
   }
@@ -220,6 +233,10 @@ namespace embree
     return rtcNewCurveGeometry(scene,flags,numCurves,numVertices,numTimeSteps);
   }
 
+  extern "C" unsigned ispcNewRibbonGeometry (RTCScene scene, RTCGeometryFlags flags, size_t numCurves, size_t numVertices, size_t numTimeSteps) {
+    return rtcNewRibbonGeometry(scene,flags,numCurves,numVertices,numTimeSteps);
+  }
+
   extern "C" unsigned ispcNewSubdivisionMesh (RTCScene scene, RTCGeometryFlags flags, size_t numFaces, size_t numEdges, 
                                               size_t numVertices, size_t numEdgeCreases, size_t numVertexCreases, size_t numHoles, size_t numTimeSteps) 
   {
@@ -269,6 +286,14 @@ namespace embree
   extern "C" void ispcSetTessellationRate (RTCScene hscene, unsigned geomID, float tessellationRate) {
     rtcSetTessellationRate(hscene,geomID,tessellationRate);
   }
+
+  extern "C" void ispcSetCurveBasis (RTCScene hscene, unsigned geomID, RTCCurveBasis basis) {
+    rtcSetCurveBasis(hscene,geomID,basis);
+  }
+
+  extern "C" void ispcSetVertexFormat (RTCScene hscene, unsigned geomID, RTCVertexFormat format, const float* scale, const float* offset) {
+    rtcSetVertexFormat(hscene,geomID,format,scale,offset);
+  }
     
   extern "C" void ispcSetUserData (RTCScene hscene, unsigned geomID, void* ptr) 
   {
@@ -301,6 +326,10 @@ namespace embree
     rtcSetBoundsFunction2(scene,geomID,bounds,userPtr);
   }
 
+  extern "C" void ispcSetBoundsFunctionSoA (RTCScene scene, unsigned geomID, RTCBoundsFuncSoA bounds, void* userPtr) {
+    rtcSetBoundsFunctionSoA(scene,geomID,bounds,userPtr);
+  }
+
   extern "C" void ispcSetIntersectFunction1 (RTCScene hscene, unsigned geomID, RTCIntersectFunc intersect) 
   {
     Scene* scene = (Scene*) hscene;
@@ -367,6 +396,10 @@ namespace embree
     RTCORE_CATCH_END(scene->device);
   }
 
+  extern "C" void ispcSetIntersectFunctionLeaf (RTCScene scene, unsigned geomID, RTCIntersectFuncLeaf intersect) {
+    rtcSetIntersectFunctionLeaf(scene,geomID,intersect);
+  }
+
   extern "C" void ispcSetOccludedFunction1 (RTCScene hscene, unsigned geomID, RTCOccludedFunc occluded) 
   {
     Scene* scene = (Scene*) hscene;
@@ -433,6 +466,10 @@ namespace embree
     RTCORE_CATCH_END(scene->device);
   }
 
+  extern "C" void ispcSetOccludedFunctionLeaf (RTCScene scene, unsigned geomID, RTCOccludedFuncLeaf occluded) {
+    rtcSetOccludedFunctionLeaf(scene,geomID,occluded);
+  }
+
   extern "C" void ispcSetIntersectionFilterFunction1 (RTCScene hscene, unsigned geomID, RTCFilterFunc filter) 
   {
     Scene* scene = (Scene*) hscene;
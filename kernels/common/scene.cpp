@@ -18,6 +18,7 @@
 
 #include "../bvh/bvh4_factory.h"
 #include "../bvh/bvh8_factory.h"
+#include "../algorithms/parallel_for.h"
  
 namespace embree
 {
@@ -29,19 +30,20 @@ namespace embree
   void invalid_rtcIntersect16() { throw_RTCError(RTC_INVALID_OPERATION,"rtcIntersect16 and rtcOccluded16 not enabled"); }
   void invalid_rtcIntersectN()  { throw_RTCError(RTC_INVALID_OPERATION,"rtcIntersectN and rtcOccludedN not enabled"); }
 
-  Scene::Scene (Device* device, RTCSceneFlags sflags, RTCAlgorithmFlags aflags)
+  Scene::Scene (Device* device, RTCSceneFlags sflags, RTCAlgorithmFlags aflags, const RTCBuildSettings* settings)
     : Accel(AccelData::TY_UNKNOWN),
       device(device), 
       commitCounter(0), 
       commitCounterSubdiv(0), 
       numMappedBuffers(0),
-      flags(sflags), aflags(aflags), 
+      flags(sflags), aflags(aflags), hasBuildSettings(settings != nullptr),
       needTriangleIndices(false), needTriangleVertices(false), 
       needQuadIndices(false), needQuadVertices(false), 
       needBezierIndices(false), needBezierVertices(false),
       needLineIndices(false), needLineVertices(false),
+      needPointVertices(false),
       needSubdivIndices(false), needSubdivVertices(false),
-      is_build(false), modified(true),
+      is_build(false), modified(true), buildPriority(0),
       progressInterface(this), progress_monitor_function(nullptr), progress_monitor_ptr(nullptr), progress_monitor_counter(0), 
       numIntersectionFilters1(0), numIntersectionFilters4(0), numIntersectionFilters8(0), numIntersectionFilters16(0), numIntersectionFiltersN(0)
   {
@@ -56,6 +58,14 @@ namespace embree
     if (device->scene_flags != -1)
       flags = (RTCSceneFlags) device->scene_flags;
 
+    /* the build quality selects between the standard and the spatial split builders */
+    if (settings) 
+    {
+      buildSettings = *settings;
+      if (settings->quality == RTC_BUILD_QUALITY_HIGH) flags = RTCSceneFlags(flags | RTC_SCENE_HIGH_QUALITY);
+      else                                             flags = RTCSceneFlags(flags & ~RTC_SCENE_HIGH_QUALITY);
+    }
+
     if (aflags & RTC_INTERPOLATE) {
       needTriangleIndices = true;
       needQuadIndices = true;
@@ -66,6 +76,7 @@ namespace embree
       needQuadVertices = true;      
       needBezierVertices = true;
       needLineVertices = true;
+      needPointVertices = true;
       needSubdivVertices = true;
     }
 
@@ -78,6 +89,8 @@ namespace embree
     createHairMBAccel();
     createLineAccel();
     createLineMBAccel();
+    createPointAccel();
+    createPointMBAccel();
 
 #if defined(EMBREE_GEOMETRY_TRIANGLES)
     accels.add(device->bvh4_factory->BVH4InstancedBVH4Triangle4ObjectSplit(this));
@@ -123,8 +136,8 @@ namespace embree
           break;
 
         case /*0b01*/ 1: accels.add(device->bvh4_factory->BVH4Triangle4vObjectSplit(this)); break;
-        case /*0b10*/ 2: accels.add(device->bvh4_factory->BVH4Triangle4iObjectSplit(this)); break;
-        case /*0b11*/ 3: accels.add(device->bvh4_factory->BVH4Triangle4iObjectSplit(this)); break;
+        case /*0b10*/ 2: accels.add(device->bvh4_factory->BVH4Triangle4cObjectSplit(this)); break;
+        case /*0b11*/ 3: accels.add(device->bvh4_factory->BVH4Triangle4cObjectSplit(this)); break;
         }
       }
       else 
@@ -141,6 +154,7 @@ namespace embree
     else if (device->tri_accel == "bvh4.triangle4")       accels.add(device->bvh4_factory->BVH4Triangle4(this));
     else if (device->tri_accel == "bvh4.triangle4v")      accels.add(device->bvh4_factory->BVH4Triangle4v(this));
     else if (device->tri_accel == "bvh4.triangle4i")      accels.add(device->bvh4_factory->BVH4Triangle4i(this));
+    else if (device->tri_accel == "bvh4.triangle4c")      accels.add(device->bvh4_factory->BVH4Triangle4c(this));
 
 #if defined (__TARGET_AVX__)
     else if (device->tri_accel == "bvh8.triangle4")       accels.add(device->bvh8_factory->BVH8Triangle4(this));
@@ -270,7 +284,7 @@ namespace embree
         if (device->hasISA(AVX2)) // only enable on HSW machines, for SNB this codepath is slower
         {
           switch (mode) {
-          case /*0b00*/ 0: accels.add(device->bvh8_factory->BVH8OBBBezier1v(this,isHighQuality())); break;
+          case /*0b00*/ 0: accels.add(device->bvh8_factory->BVH8OBBBezier8v(this,isHighQuality())); break;
           case /*0b01*/ 1: accels.add(device->bvh8_factory->BVH8OBBBezier1v(this,isHighQuality())); break;
           case /*0b10*/ 2: accels.add(device->bvh8_factory->BVH8OBBBezier1i(this,isHighQuality())); break;
           case /*0b11*/ 3: accels.add(device->bvh8_factory->BVH8OBBBezier1i(this,isHighQuality())); break;
@@ -280,7 +294,7 @@ namespace embree
 #endif
         {
           switch (mode) {
-          case /*0b00*/ 0: accels.add(device->bvh4_factory->BVH4OBBBezier1v(this,isHighQuality())); break;
+          case /*0b00*/ 0: accels.add(device->bvh4_factory->BVH4OBBBezier4v(this,isHighQuality())); break;
           case /*0b01*/ 1: accels.add(device->bvh4_factory->BVH4OBBBezier1v(this,isHighQuality())); break;
           case /*0b10*/ 2: accels.add(device->bvh4_factory->BVH4OBBBezier1i(this,isHighQuality())); break;
           case /*0b11*/ 3: accels.add(device->bvh4_factory->BVH4OBBBezier1i(this,isHighQuality())); break;
@@ -301,9 +315,11 @@ namespace embree
     else if (device->hair_accel == "bvh4.bezier1i"    ) accels.add(device->bvh4_factory->BVH4Bezier1i(this));
     else if (device->hair_accel == "bvh4obb.bezier1v" ) accels.add(device->bvh4_factory->BVH4OBBBezier1v(this,false));
     else if (device->hair_accel == "bvh4obb.bezier1i" ) accels.add(device->bvh4_factory->BVH4OBBBezier1i(this,false));
+    else if (device->hair_accel == "bvh4obb.bezier4v" ) accels.add(device->bvh4_factory->BVH4OBBBezier4v(this,false));
 #if defined (__TARGET_AVX__)
     else if (device->hair_accel == "bvh8obb.bezier1v" ) accels.add(device->bvh8_factory->BVH8OBBBezier1v(this,false));
     else if (device->hair_accel == "bvh8obb.bezier1i" ) accels.add(device->bvh8_factory->BVH8OBBBezier1i(this,false));
+    else if (device->hair_accel == "bvh8obb.bezier8v" ) accels.add(device->bvh8_factory->BVH8OBBBezier8v(this,false));
 #endif
     else throw_RTCError(RTC_INVALID_ARGUMENT,"unknown hair acceleration structure "+device->hair_accel);
 #endif
@@ -380,6 +396,46 @@ namespace embree
 #endif
   }
 
+  void Scene::createPointAccel()
+  {
+#if defined(EMBREE_GEOMETRY_POINTS)
+    if (device->point_accel == "default")
+    {
+#if defined (__TARGET_AVX__)
+      if (device->hasISA(AVX) && !isCompact())
+        accels.add(device->bvh8_factory->BVH8Point4i(this));
+      else
+#endif
+        accels.add(device->bvh4_factory->BVH4Point4i(this));
+    }
+    else if (device->point_accel == "bvh4.point4i") accels.add(device->bvh4_factory->BVH4Point4i(this));
+#if defined (__TARGET_AVX__)
+    else if (device->point_accel == "bvh8.point4i") accels.add(device->bvh8_factory->BVH8Point4i(this));
+#endif
+    else throw_RTCError(RTC_INVALID_ARGUMENT,"unknown point acceleration structure "+device->point_accel);
+#endif
+  }
+
+  void Scene::createPointMBAccel()
+  {
+#if defined(EMBREE_GEOMETRY_POINTS)
+    if (device->point_accel_mb == "default")
+    {
+#if defined (__TARGET_AVX__)
+      if (device->hasISA(AVX) && !isCompact())
+        accels.add(device->bvh8_factory->BVH8Point4iMB(this));
+      else
+#endif
+        accels.add(device->bvh4_factory->BVH4Point4iMB(this));
+    }
+    else if (device->point_accel_mb == "bvh4.point4imb") accels.add(device->bvh4_factory->BVH4Point4iMB(this));
+#if defined (__TARGET_AVX__)
+    else if (device->point_accel_mb == "bvh8.point4imb") accels.add(device->bvh8_factory->BVH8Point4iMB(this));
+#endif
+    else throw_RTCError(RTC_INVALID_ARGUMENT,"unknown motion blur point acceleration structure "+device->point_accel_mb);
+#endif
+  }
+
   void Scene::createSubdivAccel()
   {
 #if defined(EMBREE_GEOMETRY_SUBDIV)
@@ -523,6 +579,22 @@ namespace embree
     return geom->id;
   }
 
+  unsigned Scene::newPoints (Points::SubType subtype, RTCGeometryFlags gflags, size_t numPoints, size_t numTimeSteps)
+  {
+    if (isStatic() && (gflags != RTC_GEOMETRY_STATIC)) {
+      throw_RTCError(RTC_INVALID_OPERATION,"static scenes can only contain static geometries");
+      return -1;
+    }
+
+    if (numTimeSteps == 0 || numTimeSteps > 2) {
+      throw_RTCError(RTC_INVALID_OPERATION,"only 1 or 2 time steps supported");
+      return -1;
+    }
+
+    Geometry* geom = new Points(this,subtype,gflags,numPoints,numTimeSteps);
+    return geom->id;
+  }
+
   unsigned Scene::add(Geometry* geometry) 
   {
     Lock<SpinLock> lock(geometriesMutex);
@@ -634,6 +706,7 @@ namespace embree
       if (scheduler == null) {
         buildLock.lock();
         this->scheduler = scheduler = new TaskScheduler;
+        scheduler->setPriority(buildPriority);
       }
     }
 
@@ -759,6 +832,89 @@ namespace embree
   }
 #endif
 
+  void Scene::buildMany (Scene** scenes_in, size_t numScenes)
+  {
+    /* build each scene only once, even if it is passed multiple times */
+    std::vector<Scene*> scenes(scenes_in,scenes_in+numScenes);
+    std::sort(scenes.begin(),scenes.end());
+    scenes.erase(std::unique(scenes.begin(),scenes.end()),scenes.end());
+
+    /* lock all scenes, other commits of these scenes wait for the batch to finish */
+    for (size_t i=0; i<scenes.size(); i++)
+      scenes[i]->buildMutex.lock();
+    auto unlockAll = [&] () {
+      for (size_t i=0; i<scenes.size(); i++)
+        scenes[i]->buildMutex.unlock();
+    };
+
+    /* report error if some scene is not ready */
+    for (size_t i=0; i<scenes.size(); i++) {
+      if (!scenes[i]->ready()) {
+        unlockAll();
+        throw_RTCError(RTC_INVALID_OPERATION,"not all buffers are unmapped");
+      }
+    }
+
+    /* every scene is one task, a failing build only clears its own scene */
+    MutexSys exceptMutex;
+    std::exception_ptr except = nullptr;
+    auto buildScene = [&] (size_t i)
+    {
+      Scene* scene = scenes[i];
+      if (!scene->isModified()) return;
+      try {
+        scene->build_task();
+      }
+      catch (...) {
+        scene->accels.clear();
+        scene->updateInterface();
+        Lock<MutexSys> lock(exceptMutex);
+        if (except == nullptr) except = std::current_exception();
+      }
+    };
+
+    /* for best performance set FTZ and DAZ flags in the MXCSR control and status register */
+    unsigned int mxcsr = _mm_getcsr();
+    _mm_setcsr(mxcsr | /* FTZ */ (1<<15) | /* DAZ */ (1<<6));
+
+    try {
+#if defined(TASKING_TBB)
+
+      /* same isolated task context as for single scene builds */
+#if TBB_INTERFACE_VERSION_MAJOR < 8
+      tbb::task_group_context ctx( tbb::task_group_context::isolated, tbb::task_group_context::default_traits);
+#else
+      tbb::task_group_context ctx( tbb::task_group_context::isolated, tbb::task_group_context::default_traits | tbb::task_group_context::fp_settings );
+#endif
+
+#if USE_TASK_ARENA
+      scenes[0]->device->arena->execute([&]{
+#endif
+          tbb::parallel_for (size_t(0), scenes.size(), size_t(1), buildScene, ctx);
+#if USE_TASK_ARENA
+        });
+#endif
+#else
+      parallel_for(scenes.size(), buildScene);
+#endif
+
+      /* reset MXCSR register again */
+      _mm_setcsr(mxcsr);
+    }
+    catch (...) {
+
+      /* reset MXCSR register again */
+      _mm_setcsr(mxcsr);
+
+      unlockAll();
+      throw;
+    }
+    unlockAll();
+
+    if (except != nullptr)
+      std::rethrow_exception(except);
+  }
+
   void Scene::write(std::ofstream& file)
   {
     int magick = 0x35238765LL;
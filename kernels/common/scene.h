@@ -25,6 +25,7 @@
 #include "scene_geometry_instance.h"
 #include "scene_bezier_curves.h"
 #include "scene_line_segments.h"
+#include "scene_points.h"
 #include "scene_subdiv_mesh.h"
 
 #include "../subdiv/tessellation_cache.h"
@@ -90,7 +91,7 @@ namespace embree
   public:
     
     /*! Scene construction */
-    Scene (Device* device, RTCSceneFlags flags, RTCAlgorithmFlags aflags);
+    Scene (Device* device, RTCSceneFlags flags, RTCAlgorithmFlags aflags, const RTCBuildSettings* settings = nullptr);
 
     void createTriangleAccel();
     void createQuadAccel();
@@ -100,6 +101,8 @@ namespace embree
     void createHairMBAccel();
     void createLineAccel();
     void createLineMBAccel();
+    void createPointAccel();
+    void createPointMBAccel();
     void createSubdivAccel();
 
     /*! Scene destruction */
@@ -129,6 +132,9 @@ namespace embree
     /*! Creates a new collection of line segments. */
     unsigned int newLineSegments (RTCGeometryFlags flags, size_t maxSegments, size_t maxVertices, size_t numTimeSteps);
 
+    /*! Creates a new collection of points. */
+    unsigned int newPoints (Points::SubType subtype, RTCGeometryFlags flags, size_t numPoints, size_t numTimeSteps);
+
     /*! Creates a new subdivision mesh. */
     unsigned int newSubdivisionMesh (RTCGeometryFlags flags, size_t numFaces, size_t numEdges, size_t numVertices, size_t numEdgeCreases, size_t numVertexCreases, size_t numHoles, size_t numTimeSteps);
 
@@ -139,6 +145,9 @@ namespace embree
     void build (size_t threadIndex, size_t threadCount);
     void build_task ();
 
+    /*! Builds the acceleration structures of many scenes in one parallel job. */
+    static void buildMany (Scene** scenes, size_t numScenes);
+
     /*! stores scene into binary file */
     void write(std::ofstream& file);
 
@@ -256,6 +265,19 @@ namespace embree
       return (LineSegments*) geometries[i];
     }
 
+    __forceinline Points* getPoints(size_t i) {
+      assert(i < geometries.size());
+      assert(geometries[i]);
+      assert(geometries[i]->getType() == Geometry::POINTS);
+      return (Points*) geometries[i];
+    }
+    __forceinline const Points* getPoints(size_t i) const {
+      assert(i < geometries.size());
+      assert(geometries[i]);
+      assert(geometries[i]->getType() == Geometry::POINTS);
+      return (Points*) geometries[i];
+    }
+
     /* test if this is a static scene */
     __forceinline bool isStatic() const { return embree::isStatic(flags); }
 
@@ -266,6 +288,7 @@ namespace embree
     __forceinline bool isCoherent() const { return embree::isCoherent(flags); }
     __forceinline bool isRobust() const { return embree::isRobust(flags); }
     __forceinline bool isHighQuality() const { return embree::isHighQuality(flags); }
+    __forceinline bool isLarge() const { return embree::isLarge(flags); }
     __forceinline bool isInterpolatable() const { return embree::isInterpolatable(aflags); }
     __forceinline bool isStreamMode() const { return embree::isStreamMode(aflags); }
 
@@ -292,6 +315,8 @@ namespace embree
     std::atomic<size_t> numMappedBuffers;         //!< number of mapped buffers
     RTCSceneFlags flags;
     RTCAlgorithmFlags aflags;
+    bool hasBuildSettings;           //!< true if SAH builder settings got specified at scene creation
+    RTCBuildSettings buildSettings;  //!< SAH builder settings of the scene
     bool needTriangleIndices; 
     bool needTriangleVertices; 
     bool needQuadIndices; 
@@ -300,12 +325,14 @@ namespace embree
     bool needBezierVertices;
     bool needLineIndices;
     bool needLineVertices;
+    bool needPointVertices;
     bool needSubdivIndices;
     bool needSubdivVertices;
     MutexSys buildMutex;
     SpinLock geometriesMutex;
     bool is_build;
     bool modified;                   //!< true if scene got modified
+    int buildPriority;               //!< priority of the build of this scene over builds of other scenes
     
     /*! global lock step task scheduler */
 #if defined(TASKING_INTERNAL)
@@ -331,20 +358,24 @@ namespace embree
     void progressMonitor(double nprims);
     void setProgressMonitorFunction(RTCProgressMonitorFunc func, void* ptr);
 
+    /*! sets the priority of the build of this scene */
+    void setBuildPriority(int priority) { buildPriority = priority; }
+
   public:
     struct GeometryCounts 
     {
       __forceinline GeometryCounts()
-        : numTriangles(0), numQuads(0), numBezierCurves(0), numLineSegments(0), numSubdivPatches(0), numUserGeometries(0) {}
+        : numTriangles(0), numQuads(0), numBezierCurves(0), numLineSegments(0), numPoints(0), numSubdivPatches(0), numUserGeometries(0) {}
 
       __forceinline size_t size() const {
-        return numTriangles + numQuads + numBezierCurves + numLineSegments + numSubdivPatches + numUserGeometries;
+        return numTriangles + numQuads + numBezierCurves + numLineSegments + numPoints + numSubdivPatches + numUserGeometries;
       }
 
       std::atomic<size_t> numTriangles;             //!< number of enabled triangles
       std::atomic<size_t> numQuads;                 //!< number of enabled quads
       std::atomic<size_t> numBezierCurves;          //!< number of enabled curves
       std::atomic<size_t> numLineSegments;          //!< number of enabled line segments
+      std::atomic<size_t> numPoints;                //!< number of enabled points
       std::atomic<size_t> numSubdivPatches;         //!< number of enabled subdivision patches
       std::atomic<size_t> numUserGeometries;        //!< number of enabled user geometries
     };
@@ -377,6 +408,8 @@ namespace embree
   template<> __forceinline size_t Scene::getNumPrimitives<BezierCurves,2>() const { return world2.numBezierCurves; } 
   template<> __forceinline size_t Scene::getNumPrimitives<LineSegments,1>() const { return world1.numLineSegments; }
   template<> __forceinline size_t Scene::getNumPrimitives<LineSegments,2>() const { return world2.numLineSegments; }
+  template<> __forceinline size_t Scene::getNumPrimitives<Points,1>() const { return world1.numPoints; }
+  template<> __forceinline size_t Scene::getNumPrimitives<Points,2>() const { return world2.numPoints; }
   template<> __forceinline size_t Scene::getNumPrimitives<SubdivMesh,1>() const { return world1.numSubdivPatches; } 
   template<> __forceinline size_t Scene::getNumPrimitives<SubdivMesh,2>() const { return world2.numSubdivPatches; } 
   template<> __forceinline size_t Scene::getNumPrimitives<AccelSet,1>() const { return world1.numUserGeometries; } 
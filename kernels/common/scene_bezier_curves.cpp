@@ -21,11 +21,12 @@
 namespace embree
 {
   BezierCurves::BezierCurves (Scene* parent, SubType subtype, RTCGeometryFlags flags, size_t numPrimitives, size_t numVertices, size_t numTimeSteps) 
-    : Geometry(parent,BEZIER_CURVES,numPrimitives,numTimeSteps,flags), subtype(subtype), tessellationRate(4)
+    : Geometry(parent,BEZIER_CURVES,numPrimitives,numTimeSteps,flags), subtype(subtype), basis(BEZIER_BASIS), tessellationRate(4)
   {
     curves.init(parent->device,numPrimitives,sizeof(int));
     for (size_t i=0; i<numTimeSteps; i++) {
       vertices[i].init(parent->device,numVertices,sizeof(Vec3fa));
+      if (subtype == RIBBON) normals[i].init(parent->device,numVertices,sizeof(Vec3fa));
     }
     enabling();
   }
@@ -72,6 +73,16 @@ namespace embree
       vertices[1].set(ptr,offset,stride); 
       vertices[1].checkPadding16();
       break;
+    case RTC_NORMAL_BUFFER0: 
+      if (subtype != RIBBON) throw_RTCError(RTC_INVALID_ARGUMENT,"normal buffer only supported for ribbon geometry");
+      normals[0].set(ptr,offset,stride); 
+      normals[0].checkPadding16();
+      break;
+    case RTC_NORMAL_BUFFER1: 
+      if (subtype != RIBBON) throw_RTCError(RTC_INVALID_ARGUMENT,"normal buffer only supported for ribbon geometry");
+      normals[1].set(ptr,offset,stride); 
+      normals[1].checkPadding16();
+      break;
     case RTC_USER_VERTEX_BUFFER0  : 
       if (userbuffers[0] == nullptr) userbuffers[0].reset(new Buffer(parent->device,numVertices(),stride)); 
       userbuffers[0]->set(ptr,offset,stride);  
@@ -99,6 +110,12 @@ namespace embree
     case RTC_INDEX_BUFFER  : return curves.map(parent->numMappedBuffers);
     case RTC_VERTEX_BUFFER0: return vertices[0].map(parent->numMappedBuffers);
     case RTC_VERTEX_BUFFER1: return vertices[1].map(parent->numMappedBuffers);
+    case RTC_NORMAL_BUFFER0: 
+      if (subtype != RIBBON) throw_RTCError(RTC_INVALID_ARGUMENT,"normal buffer only supported for ribbon geometry");
+      return normals[0].map(parent->numMappedBuffers);
+    case RTC_NORMAL_BUFFER1: 
+      if (subtype != RIBBON) throw_RTCError(RTC_INVALID_ARGUMENT,"normal buffer only supported for ribbon geometry");
+      return normals[1].map(parent->numMappedBuffers);
     default: throw_RTCError(RTC_INVALID_ARGUMENT,"unknown buffer type"); return nullptr;
     }
   }
@@ -112,6 +129,14 @@ namespace embree
     case RTC_INDEX_BUFFER  : curves.unmap(parent->numMappedBuffers); break;
     case RTC_VERTEX_BUFFER0: vertices[0].unmap(parent->numMappedBuffers); break;
     case RTC_VERTEX_BUFFER1: vertices[1].unmap(parent->numMappedBuffers); break;
+    case RTC_NORMAL_BUFFER0: 
+      if (subtype != RIBBON) throw_RTCError(RTC_INVALID_ARGUMENT,"normal buffer only supported for ribbon geometry");
+      normals[0].unmap(parent->numMappedBuffers); 
+      break;
+    case RTC_NORMAL_BUFFER1: 
+      if (subtype != RIBBON) throw_RTCError(RTC_INVALID_ARGUMENT,"normal buffer only supported for ribbon geometry");
+      normals[1].unmap(parent->numMappedBuffers); 
+      break;
     default: throw_RTCError(RTC_INVALID_ARGUMENT,"unknown buffer type"); break;
     }
   }
@@ -124,9 +149,23 @@ namespace embree
     tessellationRate = clamp((int)N,1,16);
   }
 
+  void BezierCurves::setCurveBasis(RTCCurveBasis basis)
+  {
+    if (parent->isStatic() && parent->isBuild()) 
+      throw_RTCError(RTC_INVALID_OPERATION,"static geometries cannot get modified");
+
+    switch (basis) {
+    case RTC_BASIS_BEZIER     : this->basis = BEZIER_BASIS; break;
+    case RTC_BASIS_BSPLINE    : this->basis = BSPLINE_BASIS; break;
+    case RTC_BASIS_CATMULL_ROM: this->basis = CATMULL_ROM_BASIS; break;
+    default: throw_RTCError(RTC_INVALID_ARGUMENT,"unknown curve basis"); break;
+    }
+    Geometry::update();
+  }
+
   void BezierCurves::immutable () 
   {
-    const bool freeIndices = !parent->needBezierIndices;
+    const bool freeIndices = !parent->needBezierIndices && subtype != RIBBON; // ribbons look up their normals through the index buffer
     const bool freeVertices  = !parent->needBezierVertices;
     if (freeIndices) curves.free();
     if (freeVertices ) vertices[0].free();
@@ -138,6 +177,15 @@ namespace embree
     if (numTimeSteps == 2 && vertices[0].size() != vertices[1].size())
         return false;
 
+    if (subtype == RIBBON) 
+    {
+      for (size_t j=0; j<numTimeSteps; j++) {
+        if (!normals[j] || normals[j].size() != vertices[j].size()) return false;
+        for (size_t i=0; i<normals[j].size(); i++)
+          if (!isvalid(normals[j][i].x) || !isvalid(normals[j][i].y) || !isvalid(normals[j][i].z)) return false;
+      }
+    }
+
     for (size_t i=0; i<numPrimitives; i++) {
       if (curves[i]+3 >= numVertices()) return false;
     }
@@ -180,10 +228,11 @@ namespace embree
       size_t ofs = i*sizeof(float);
       const size_t curve = curves[primID];
       const vboolx valid = vintx(i)+vintx(step) < vintx(numFloats);
-      const vfloatx p0 = vfloatx::loadu(valid,(float*)&src[(curve+0)*stride+ofs]);
-      const vfloatx p1 = vfloatx::loadu(valid,(float*)&src[(curve+1)*stride+ofs]);
-      const vfloatx p2 = vfloatx::loadu(valid,(float*)&src[(curve+2)*stride+ofs]);
-      const vfloatx p3 = vfloatx::loadu(valid,(float*)&src[(curve+3)*stride+ofs]);
+      vfloatx p0 = vfloatx::loadu(valid,(float*)&src[(curve+0)*stride+ofs]);
+      vfloatx p1 = vfloatx::loadu(valid,(float*)&src[(curve+1)*stride+ofs]);
+      vfloatx p2 = vfloatx::loadu(valid,(float*)&src[(curve+2)*stride+ofs]);
+      vfloatx p3 = vfloatx::loadu(valid,(float*)&src[(curve+3)*stride+ofs]);
+      convertToBezier(basis,p0,p1,p2,p3);
       
       const BezierCurveT<vfloatx> bezier(p0,p1,p2,p3,0.0f,1.0f,0);
       if (P      ) vfloatx::storeu(valid,P+i,      bezier.eval(u));
@@ -200,6 +249,10 @@ namespace embree
     size_t numVerts = numVertices();
     file.write((char*)&numVerts,sizeof(int));
     file.write((char*)&numPrimitives,sizeof(int));
+    int stype = subtype;
+    file.write((char*)&stype,sizeof(int));
+    int cbasis = basis;
+    file.write((char*)&cbasis,sizeof(int));
 
     for (size_t j=0; j<numTimeSteps; j++) {
       while ((file.tellp() % 16) != 0) { char c = 0; file.write(&c,1); }
@@ -209,6 +262,16 @@ namespace embree
       }
     }
 
+    if (subtype == RIBBON) {
+      for (size_t j=0; j<numTimeSteps; j++) {
+        while ((file.tellp() % 16) != 0) { char c = 0; file.write(&c,1); }
+        for (size_t i=0; i<normals[j].size(); i++) {
+          Vec3fa n = normals[j][i];
+          file.write((char*)&n,sizeof(Vec3fa));
+        }
+      }
+    }
+
     while ((file.tellp() % 16) != 0) { char c = 0; file.write(&c,1); }
     for (size_t i=0; i<numPrimitives; i++) file.write((char*)&curve(i),sizeof(int));  
   }
@@ -29,8 +29,11 @@ namespace embree
     /*! type of this geometry */
     static const Geometry::Type geom_type = Geometry::BEZIER_CURVES;
 
-    /*! this geometry represents approximate hair geometry and real bezier surface geometry */
-    enum SubType { HAIR = 1, SURFACE = 0 };
+    /*! this geometry represents approximate hair geometry, real bezier surface geometry, or flat ribbons oriented by per vertex normals */
+    enum SubType { HAIR = 1, SURFACE = 0, RIBBON = 2 };
+
+    /*! basis of the stored control points, converted to bezier form on the fly */
+    enum Basis { BEZIER_BASIS = RTC_BASIS_BEZIER, BSPLINE_BASIS = RTC_BASIS_BSPLINE, CATMULL_ROM_BASIS = RTC_BASIS_CATMULL_ROM };
 
   public:
     
@@ -51,6 +54,7 @@ namespace embree
     bool verify ();
     void interpolate(unsigned primID, float u, float v, RTCBufferType buffer, float* P, float* dPdu, float* dPdv, float* ddPdudu, float* ddPdvdv, float* ddPdudv, size_t numFloats);
     void setTessellationRate(float N);
+    void setCurveBasis(RTCCurveBasis basis);
     // FIXME: implement interpolateN
 
   public:
@@ -75,10 +79,60 @@ namespace embree
       return vertices[j][i];
     }
     
+    /*! returns i'th normal of j'th timestep */
+    __forceinline Vec3fa normal(size_t i, size_t j = 0) const {
+      return normals[j][i];
+    }
+
     /*! returns i'th radius of j'th timestep */
     __forceinline float radius(size_t i, size_t j = 0) const {
       return vertices[j][i].w;
     }
+
+    /*! converts 4 control points of the specified basis into bezier control points */
+    template<typename T>
+    static __forceinline void convertToBezier(const Basis basis, T& p0, T& p1, T& p2, T& p3)
+    {
+      if (likely(basis == BEZIER_BASIS)) 
+        return;
+
+      if (basis == BSPLINE_BASIS)
+      {
+        const T q0 = (1.0f/6.0f)*p0 + (4.0f/6.0f)*p1 + (1.0f/6.0f)*p2;
+        const T q1 = (2.0f/3.0f)*p1 + (1.0f/3.0f)*p2;
+        const T q2 = (1.0f/3.0f)*p1 + (2.0f/3.0f)*p2;
+        const T q3 = (1.0f/6.0f)*p1 + (4.0f/6.0f)*p2 + (1.0f/6.0f)*p3;
+        p0 = q0; p1 = q1; p2 = q2; p3 = q3;
+      }
+      else
+      {
+        const T q0 = p1;
+        const T q1 = p1 + (1.0f/6.0f)*(p2-p0);
+        const T q2 = p2 - (1.0f/6.0f)*(p3-p1);
+        const T q3 = p2;
+        p0 = q0; p1 = q1; p2 = q2; p3 = q3;
+      }
+    }
+
+    /*! gathers the bezier control points of the curve starting at vertex i of j'th timestep */
+    __forceinline void gather(Vec3fa& p0, Vec3fa& p1, Vec3fa& p2, Vec3fa& p3, size_t i, size_t j = 0) const 
+    {
+      p0 = vertex(i+0,j);
+      p1 = vertex(i+1,j);
+      p2 = vertex(i+2,j);
+      p3 = vertex(i+3,j);
+      convertToBezier(basis,p0,p1,p2,p3);
+    }
+
+    /*! gathers the bezier normal control points of the ribbon starting at vertex i of j'th timestep */
+    __forceinline void gatherNormals(Vec3fa& n0, Vec3fa& n1, Vec3fa& n2, Vec3fa& n3, size_t i, size_t j = 0) const 
+    {
+      n0 = normal(i+0,j);
+      n1 = normal(i+1,j);
+      n2 = normal(i+2,j);
+      n3 = normal(i+3,j);
+      convertToBezier(basis,n0,n1,n2,n3);
+    }
     
     /*! check if the i'th primitive is valid */
     __forceinline bool valid(size_t i, BBox3fa* bbox = nullptr) const 
@@ -112,40 +166,31 @@ namespace embree
     /*! calculates bounding box of i'th bezier curve */
     __forceinline BBox3fa bounds(size_t i, size_t j = 0) const 
     {
-      const unsigned int index = curve(i);
-      const float r0 = radius(index+0,j);
-      const float r1 = radius(index+1,j);
-      const float r2 = radius(index+2,j);
-      const float r3 = radius(index+3,j);
-      const Vec3fa v0 = vertex(index+0,j);
-      const Vec3fa v1 = vertex(index+1,j);
-      const Vec3fa v2 = vertex(index+2,j);
-      const Vec3fa v3 = vertex(index+3,j);
+      Vec3fa v0,v1,v2,v3; gather(v0,v1,v2,v3,curve(i),j);
       const BBox3fa b = merge(BBox3fa(v0),BBox3fa(v1),BBox3fa(v2),BBox3fa(v3));
-      return enlarge(b,Vec3fa(max(r0,r1,r2,r3)));
+      return enlarge(b,Vec3fa(max(v0.w,v1.w,v2.w,v3.w)));
     }
     
     /*! calculates bounding box of i'th bezier curve */
     __forceinline BBox3fa bounds(const AffineSpace3fa& space, size_t i, size_t j = 0) const 
     {
-      const unsigned int index = curve(i);
-      const float r0 = radius(index+0,j);
-      const float r1 = radius(index+1,j);
-      const float r2 = radius(index+2,j);
-      const float r3 = radius(index+3,j);
-      const Vec3fa v0 = xfmPoint(space,vertex(index+0,j));
-      const Vec3fa v1 = xfmPoint(space,vertex(index+1,j));
-      const Vec3fa v2 = xfmPoint(space,vertex(index+2,j));
-      const Vec3fa v3 = xfmPoint(space,vertex(index+3,j));
+      Vec3fa v0,v1,v2,v3; gather(v0,v1,v2,v3,curve(i),j);
+      const float r = max(v0.w,v1.w,v2.w,v3.w);
+      v0 = xfmPoint(space,v0);
+      v1 = xfmPoint(space,v1);
+      v2 = xfmPoint(space,v2);
+      v3 = xfmPoint(space,v3);
       const BBox3fa b = merge(BBox3fa(v0),BBox3fa(v1),BBox3fa(v2),BBox3fa(v3));
-      return enlarge(b,Vec3fa(max(r0,r1,r2,r3)));
+      return enlarge(b,Vec3fa(r));
     }
 
   public:
     BufferT<unsigned int> curves;                   //!< array of curve indices
     array_t<BufferT<Vec3fa>,2> vertices;            //!< vertex array
+    array_t<BufferT<Vec3fa>,2> normals;             //!< normal array, only used for ribbons
     array_t<std::unique_ptr<Buffer>,2> userbuffers; //!< user buffers
-    SubType subtype;                                //!< hair or surface geometry
+    SubType subtype;                                //!< hair, surface, or ribbon geometry
+    Basis basis;                                    //!< basis of the control points
     int tessellationRate;                           //!< tessellation rate for bezier curve
   };
 }
@@ -0,0 +1,189 @@
+// ======================================================================== //
+// Copyright 2009-2016 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#include "scene_points.h"
+#include "scene.h"
+
+namespace embree
+{
+  Points::Points (Scene* parent, SubType subtype, RTCGeometryFlags flags, size_t numPoints, size_t numTimeSteps)
+    : Geometry(parent,POINTS,numPoints,numTimeSteps,flags), subtype(subtype)
+  {
+    for (size_t i=0; i<numTimeSteps; i++) {
+      vertices[i].init(parent->device,numPoints,sizeof(Vec3fa));
+    }
+    enabling();
+  }
+
+  void Points::enabling()
+  {
+    if (numTimeSteps == 1) parent->world1.numPoints += numPrimitives;
+    else                   parent->world2.numPoints += numPrimitives;
+  }
+
+  void Points::disabling()
+  {
+    if (numTimeSteps == 1) parent->world1.numPoints -= numPrimitives;
+    else                   parent->world2.numPoints -= numPrimitives;
+  }
+
+  void Points::setMask (unsigned mask)
+  {
+    if (parent->isStatic() && parent->isBuild())
+      throw_RTCError(RTC_INVALID_OPERATION,"static geometries cannot get modified");
+
+    this->mask = mask;
+    Geometry::update();
+  }
+
+  void Points::setBuffer(RTCBufferType type, void* ptr, size_t offset, size_t stride)
+  {
+    if (parent->isStatic() && parent->isBuild())
+      throw_RTCError(RTC_INVALID_OPERATION,"static geometries cannot get modified");
+
+    /* verify that all accesses are 4 bytes aligned */
+    if (((size_t(ptr) + offset) & 0x3) || (stride & 0x3))
+      throw_RTCError(RTC_INVALID_OPERATION,"data must be 4 bytes aligned");
+
+    switch (type) {
+    case RTC_VERTEX_BUFFER0:
+      vertices[0].set(ptr,offset,stride);
+      vertices[0].checkPadding16();
+      break;
+    case RTC_VERTEX_BUFFER1:
+      vertices[1].set(ptr,offset,stride);
+      vertices[1].checkPadding16();
+      break;
+    case RTC_USER_VERTEX_BUFFER0  :
+      if (userbuffers[0] == nullptr) userbuffers[0].reset(new Buffer(parent->device,numVertices(),stride));
+      userbuffers[0]->set(ptr,offset,stride);
+      userbuffers[0]->checkPadding16();
+      break;
+    case RTC_USER_VERTEX_BUFFER1  :
+      if (userbuffers[1] == nullptr) userbuffers[1].reset(new Buffer(parent->device,numVertices(),stride));
+      userbuffers[1]->set(ptr,offset,stride);
+      userbuffers[1]->checkPadding16();
+      break;
+    default:
+      throw_RTCError(RTC_INVALID_ARGUMENT,"unknown buffer type");
+      break;
+    }
+  }
+
+  void* Points::map(RTCBufferType type)
+  {
+    if (parent->isStatic() && parent->isBuild()) {
+      throw_RTCError(RTC_INVALID_OPERATION,"static geometries cannot get modified");
+      return nullptr;
+    }
+
+    switch (type) {
+    case RTC_VERTEX_BUFFER0: return vertices[0].map(parent->numMappedBuffers);
+    case RTC_VERTEX_BUFFER1: return vertices[1].map(parent->numMappedBuffers);
+    default: throw_RTCError(RTC_INVALID_ARGUMENT,"unknown buffer type"); return nullptr;
+    }
+  }
+
+  void Points::unmap(RTCBufferType type)
+  {
+    if (parent->isStatic() && parent->isBuild())
+      throw_RTCError(RTC_INVALID_OPERATION,"static geometries cannot get modified");
+
+    switch (type) {
+    case RTC_VERTEX_BUFFER0: vertices[0].unmap(parent->numMappedBuffers); break;
+    case RTC_VERTEX_BUFFER1: vertices[1].unmap(parent->numMappedBuffers); break;
+    default: throw_RTCError(RTC_INVALID_ARGUMENT,"unknown buffer type"); break;
+    }
+  }
+
+  void Points::immutable ()
+  {
+    const bool freeVertices = !parent->needPointVertices;
+    if (freeVertices) vertices[0].free();
+    if (freeVertices) vertices[1].free();
+  }
+
+  bool Points::verify ()
+  {
+    if (numTimeSteps == 2 && vertices[0].size() != vertices[1].size())
+        return false;
+
+    for (size_t j=0; j<numTimeSteps; j++) {
+      BufferT<Vec3fa>& verts = vertices[j];
+      for (size_t i=0; i<verts.size(); i++) {
+        if (!isvalid(verts[i].x)) return false;
+        if (!isvalid(verts[i].y)) return false;
+        if (!isvalid(verts[i].z)) return false;
+        if (!isvalid(verts[i].w)) return false;
+      }
+    }
+    return true;
+  }
+
+  void Points::interpolate(unsigned primID, float u, float v, RTCBufferType buffer, float* P, float* dPdu, float* dPdv, float* ddPdudu, float* ddPdvdv, float* ddPdudv, size_t numFloats)
+  {
+    /* test if interpolation is enabled */
+#if defined(DEBUG)
+    if ((parent->aflags & RTC_INTERPOLATE) == 0)
+      throw_RTCError(RTC_INVALID_OPERATION,"rtcInterpolate can only get called when RTC_INTERPOLATE is enabled for the scene");
+#endif
+
+    /* calculate base pointer and stride */
+    assert((buffer >= RTC_VERTEX_BUFFER0 && buffer <= RTC_VERTEX_BUFFER1) ||
+           (buffer >= RTC_USER_VERTEX_BUFFER0 && buffer <= RTC_USER_VERTEX_BUFFER1));
+    const char* src = nullptr;
+    size_t stride = 0;
+    if (buffer >= RTC_USER_VERTEX_BUFFER0) {
+      src    = userbuffers[buffer&0xFFFF]->getPtr();
+      stride = userbuffers[buffer&0xFFFF]->getStride();
+    } else {
+      src    = vertices[buffer&0xFFFF].getPtr();
+      stride = vertices[buffer&0xFFFF].getStride();
+    }
+
+    /* a point carries a constant value, thus all derivatives are zero */
+    for (size_t i=0; i<numFloats; i+=VSIZEX)
+    {
+      const size_t ofs = i*sizeof(float);
+      const vboolx valid = vintx(i)+vintx(step) < vintx(numFloats);
+      const vfloatx p = vfloatx::loadu(valid,(float*)&src[primID*stride+ofs]);
+      if (P      ) vfloatx::storeu(valid,P+i,p);
+      if (dPdu   ) vfloatx::storeu(valid,dPdu+i,vfloatx(zero));
+      if (dPdv   ) vfloatx::storeu(valid,dPdv+i,vfloatx(zero));
+      if (ddPdudu) vfloatx::storeu(valid,ddPdudu+i,vfloatx(zero));
+      if (ddPdvdv) vfloatx::storeu(valid,ddPdvdv+i,vfloatx(zero));
+      if (ddPdudv) vfloatx::storeu(valid,ddPdudv+i,vfloatx(zero));
+    }
+  }
+
+  void Points::write(std::ofstream& file)
+  {
+    int type = POINTS;
+    file.write((char*)&type,sizeof(int));
+    file.write((char*)&numTimeSteps,sizeof(int));
+    int stype = subtype;
+    file.write((char*)&stype,sizeof(int));
+    file.write((char*)&numPrimitives,sizeof(int));
+
+    for (size_t j=0; j<numTimeSteps; j++) {
+      while ((file.tellp() % 16) != 0) { char c = 0; file.write(&c,1); }
+      for (size_t i=0; i<vertices[j].size(); i++) {
+        Vec3fa v = vertex(i,j);
+        file.write((char*)&v,sizeof(Vec3fa));
+      }
+    }
+  }
+}
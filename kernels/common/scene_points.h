@@ -0,0 +1,120 @@
+// ======================================================================== //
+// Copyright 2009-2016 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+#include "default.h"
+#include "geometry.h"
+#include "primref.h"
+#include "buffer.h"
+
+namespace embree
+{
+  /*! represents an array of points with radius */
+  struct Points : public Geometry
+  {
+    /*! type of this geometry */
+    static const Geometry::Type geom_type = Geometry::POINTS;
+
+    /*! specifies the shape each point is rendered as */
+    enum SubType { SPHERE = 0, DISC = 1 };
+
+  public:
+
+    /*! points construction */
+    Points (Scene* parent, SubType subtype, RTCGeometryFlags flags, size_t numPoints, size_t numTimeSteps);
+
+    /*! writes the point geometry to disk */
+    void write(std::ofstream& file);
+
+  public:
+    void enabling();
+    void disabling();
+    void setMask (unsigned mask);
+    void setBuffer(RTCBufferType type, void* ptr, size_t offset, size_t stride);
+    void* map(RTCBufferType type);
+    void unmap(RTCBufferType type);
+    void immutable ();
+    bool verify ();
+    void interpolate(unsigned primID, float u, float v, RTCBufferType buffer, float* P, float* dPdu, float* dPdv, float* ddPdudu, float* ddPdvdv, float* ddPdudv, size_t numFloats);
+
+  public:
+
+    /*! returns number of points */
+    __forceinline size_t size() const {
+      return numPrimitives;
+    }
+
+    /*! returns the number of vertices */
+    __forceinline size_t numVertices() const {
+      return vertices[0].size();
+    }
+
+    /*! returns i'th vertex of j'th timestep */
+    __forceinline Vec3fa vertex(size_t i, size_t j = 0) const {
+      return vertices[j][i];
+    }
+
+    /*! returns i'th vertex of j'th timestep */
+    __forceinline const char* vertexPtr(size_t i, size_t j = 0) const {
+      return vertices[j].getPtr(i);
+    }
+
+    /*! returns i'th radius of j'th timestep */
+    __forceinline float radius(size_t i, size_t j = 0) const {
+      return vertices[j][i].w;
+    }
+
+    /*! check if the i'th primitive is valid */
+    __forceinline bool valid(size_t i, BBox3fa* bbox = nullptr) const
+    {
+      if (i >= numVertices()) return false;
+
+      for (size_t j=0; j<numTimeSteps; j++)
+      {
+        const float r = radius(i,j);
+        if (!isvalid(r) || r < 0.0f)
+          return false;
+
+        const Vec3fa v = vertex(i,j);
+        if (!isvalid(v))
+          return false;
+      }
+
+      if (bbox) *bbox = bounds(i);
+      return true;
+    }
+
+    /*! calculates bounding box of i'th point */
+    __forceinline BBox3fa bounds(size_t i, size_t j = 0) const
+    {
+      const Vec3fa v = vertex(i,j);
+      return enlarge(BBox3fa(v),Vec3fa(v.w));
+    }
+
+    /*! calculates bounding box of i'th point */
+    __forceinline BBox3fa bounds(const AffineSpace3fa& space, size_t i, size_t j = 0) const
+    {
+      const Vec3fa v = vertex(i,j);
+      return enlarge(BBox3fa(xfmPoint(space,v)),Vec3fa(v.w));
+    }
+
+  public:
+    SubType subtype;                                //!< sphere or disc points
+    array_t<BufferT<Vec3fa>,2> vertices;            //!< vertex array
+    array_t<std::unique_ptr<Buffer>,2> userbuffers; //!< user buffers
+  };
+}
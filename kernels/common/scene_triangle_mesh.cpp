@@ -56,8 +56,13 @@ namespace embree
     if (parent->isStatic() && parent->isBuild()) 
       throw_RTCError(RTC_INVALID_OPERATION,"static scenes cannot get modified");
 
-    /* verify that all accesses are 4 bytes aligned */
-    if (((size_t(ptr) + offset) & 0x3) || (stride & 0x3)) 
+    /* verify that all accesses are 4 bytes aligned, half and fixed point vertices only have to be 2 bytes aligned */
+    const bool isVertexBuffer = type == RTC_VERTEX_BUFFER0 || type == RTC_VERTEX_BUFFER1;
+    if (isVertexBuffer && vertices[0].getFormat() != RTC_VERTEX_FORMAT_FLOAT3) {
+      if (((size_t(ptr) + offset) & 0x1) || (stride & 0x1)) 
+        throw_RTCError(RTC_INVALID_OPERATION,"data must be 2 bytes aligned");
+    }
+    else if (((size_t(ptr) + offset) & 0x3) || (stride & 0x3)) 
       throw_RTCError(RTC_INVALID_OPERATION,"data must be 4 bytes aligned");
 
     switch (type) {
@@ -148,6 +153,29 @@ namespace embree
     return true;
   }
 
+  void TriangleMesh::setVertexFormat(RTCVertexFormat format, const float* scale, const float* offset)
+  {
+    if (parent->isStatic() && parent->isBuild()) 
+      throw_RTCError(RTC_INVALID_OPERATION,"static scenes cannot get modified");
+
+    if (format != RTC_VERTEX_FORMAT_FLOAT3 && format != RTC_VERTEX_FORMAT_HALF3 && format != RTC_VERTEX_FORMAT_FIXED16)
+      throw_RTCError(RTC_INVALID_ARGUMENT,"unknown vertex format");
+
+    /* vertex buffers that are already set have to fulfill the alignment of the new format */
+    const size_t alignMask = format == RTC_VERTEX_FORMAT_FLOAT3 ? 0x3 : 0x1;
+    for (size_t i=0; i<numTimeSteps; i++) {
+      if (vertices[i] && ((size_t(vertices[i].Buffer::getPtr()) & alignMask) || (vertices[i].getStride() & alignMask)))
+        throw_RTCError(RTC_INVALID_OPERATION,"vertex buffer not aligned for vertex format");
+    }
+
+    const Vec3f s = scale  ? Vec3f(scale[0],scale[1],scale[2])   : Vec3f(one);
+    const Vec3f o = offset ? Vec3f(offset[0],offset[1],offset[2]) : Vec3f(zero);
+    for (size_t i=0; i<numTimeSteps; i++) 
+      vertices[i].setFormat(format,s,o);
+
+    Geometry::update();
+  }
+
   void TriangleMesh::interpolate(unsigned primID, float u, float v, RTCBufferType buffer, float* P, float* dPdu, float* dPdv, float* ddPdudu, float* ddPdvdv, float* ddPdudv, size_t numFloats) 
   {
     /* test if interpolation is enabled */
@@ -169,15 +197,28 @@ namespace embree
       stride = vertices[buffer&0xFFFF].getStride();
     }
 
+    /* half and fixed point vertices get decoded first */
+    const Triangle& tri = triangle(primID);
+    const char* src0 = &src[tri.v[0]*stride];
+    const char* src1 = &src[tri.v[1]*stride];
+    const char* src2 = &src[tri.v[2]*stride];
+    Vec3fa decoded[3];
+    if (buffer < RTC_USER_VERTEX_BUFFER0 && vertices[buffer&0xFFFF].getFormat() != RTC_VERTEX_FORMAT_FLOAT3) 
+    {
+      for (size_t k=0; k<3; k++) decoded[k] = vertices[buffer&0xFFFF][tri.v[k]];
+      src0 = (const char*)&decoded[0];
+      src1 = (const char*)&decoded[1];
+      src2 = (const char*)&decoded[2];
+    }
+
     for (size_t i=0; i<numFloats; i+=VSIZEX)
     {
       size_t ofs = i*sizeof(float);
       const float w = 1.0f-u-v;
-      const Triangle& tri = triangle(primID);
       const vboolx valid = vintx(i)+vintx(step) < vintx(numFloats);
-      const vfloatx p0 = vfloatx::loadu(valid,(float*)&src[tri.v[0]*stride+ofs]);
-      const vfloatx p1 = vfloatx::loadu(valid,(float*)&src[tri.v[1]*stride+ofs]);
-      const vfloatx p2 = vfloatx::loadu(valid,(float*)&src[tri.v[2]*stride+ofs]);
+      const vfloatx p0 = vfloatx::loadu(valid,(float*)&src0[ofs]);
+      const vfloatx p1 = vfloatx::loadu(valid,(float*)&src1[ofs]);
+      const vfloatx p2 = vfloatx::loadu(valid,(float*)&src2[ofs]);
       
       if (P) {
         vfloatx::storeu(valid,P+i,w*p0 + u*p1 + v*p2);
@@ -194,6 +235,92 @@ namespace embree
     }
   }
 
+  void TriangleMesh::interpolateN(const void* valid_i, const unsigned* primIDs, const float* u, const float* v, size_t numUVs, 
+                                  RTCBufferType buffer, float* P, float* dPdu, float* dPdv, float* ddPdudu, float* ddPdvdv, float* ddPdudv, size_t numFloats)
+  {
+    /* test if interpolation is enabled */
+#if defined(DEBUG)
+    if ((parent->aflags & RTC_INTERPOLATE) == 0) 
+      throw_RTCError(RTC_INVALID_OPERATION,"rtcInterpolate can only get called when RTC_INTERPOLATE is enabled for the scene");
+#endif
+
+    /* calculate base pointer and stride */
+    assert((buffer >= RTC_VERTEX_BUFFER0 && buffer <= RTC_VERTEX_BUFFER1) ||
+           (buffer >= RTC_USER_VERTEX_BUFFER0 && buffer <= RTC_USER_VERTEX_BUFFER1));
+    const char* src = nullptr; 
+    size_t stride = 0;
+    if (buffer >= RTC_USER_VERTEX_BUFFER0) {
+      src    = userbuffers[buffer&0xFFFF]->getPtr();
+      stride = userbuffers[buffer&0xFFFF]->getStride();
+    } else {
+      /* half and fixed point vertices get decoded by the generic implementation */
+      if (vertices[buffer&0xFFFF].getFormat() != RTC_VERTEX_FORMAT_FLOAT3) {
+        Geometry::interpolateN(valid_i,primIDs,u,v,numUVs,buffer,P,dPdu,dPdv,ddPdudu,ddPdvdv,ddPdudv,numFloats);
+        return;
+      }
+      src    = vertices[buffer&0xFFFF].getPtr();
+      stride = vertices[buffer&0xFFFF].getStride();
+    }
+
+    const int* valid = (const int*) valid_i;
+
+    /* interpolates VSIZEX hits at once, the outputs are stored in SOA layout */
+    for (size_t i=0; i<numUVs; i+=VSIZEX)
+    {
+      const size_t n = min(size_t(VSIZEX),numUVs-i);
+      vintx vmask = zero;
+      vfloatx uu = zero, vv = zero;
+      const float* p0[VSIZEX], *p1[VSIZEX], *p2[VSIZEX];
+      size_t first = VSIZEX;
+      for (size_t k=0; k<n; k++)
+      {
+        if (valid && !valid[i+k]) continue;
+        const Triangle& tri = triangle(primIDs[i+k]);
+        p0[k] = (const float*) &src[tri.v[0]*stride];
+        p1[k] = (const float*) &src[tri.v[1]*stride];
+        p2[k] = (const float*) &src[tri.v[2]*stride];
+        uu[k] = u[i+k]; vv[k] = v[i+k];
+        vmask[k] = -1;
+        if (first == VSIZEX) first = k;
+      }
+      if (first == VSIZEX) continue;
+
+      /* inactive lanes read the vertices of the first active lane */
+      for (size_t k=0; k<VSIZEX; k++) {
+        if (vmask[k]) continue;
+        p0[k] = p0[first]; p1[k] = p1[first]; p2[k] = p2[first];
+      }
+
+      const vboolx valid1 = vmask != vintx(zero);
+      auto store = [&] (float* dst, const vfloatx& f) {
+        if (likely(n == VSIZEX)) vfloatx::storeu(valid1,dst,f);
+        else for (size_t k=0; k<n; k++) if (vmask[k]) dst[k] = f[k];
+      };
+
+      const vfloatx w = 1.0f-uu-vv;
+      for (size_t j=0; j<numFloats; j++)
+      {
+        vfloatx q0, q1, q2;
+        for (size_t k=0; k<VSIZEX; k++) {
+          q0[k] = p0[k][j]; q1[k] = p1[k][j]; q2[k] = p2[k][j];
+        }
+        const size_t ofs = j*numUVs+i;
+        if (P) {
+          store(P+ofs,w*q0 + uu*q1 + vv*q2);
+        }
+        if (dPdu) {
+          assert(dPdu); store(dPdu+ofs,q1-q0);
+          assert(dPdv); store(dPdv+ofs,q2-q0);
+        }
+        if (ddPdudu) {
+          assert(ddPdudu); store(ddPdudu+ofs,vfloatx(zero));
+          assert(ddPdvdv); store(ddPdvdv+ofs,vfloatx(zero));
+          assert(ddPdudv); store(ddPdudv+ofs,vfloatx(zero));
+        }
+      }
+    }
+  }
+
   void TriangleMesh::write(std::ofstream& file)
   {
     int type = TRIANGLE_MESH;
@@ -206,7 +333,7 @@ namespace embree
 
     for (size_t j=0; j<numTimeSteps; j++) {
       while ((file.tellp() % 16) != 0) { char c = 0; file.write(&c,1); }
-      for (size_t i=0; i<numVerts; i++) file.write((char*)vertexPtr(i,j),sizeof(Vec3fa));  
+      for (size_t i=0; i<numVerts; i++) { const Vec3fa v = vertex(i,j); file.write((char*)&v,sizeof(Vec3fa)); }  
     }
 
     while ((file.tellp() % 16) != 0) { char c = 0; file.write(&c,1); }
@@ -116,12 +116,14 @@ namespace embree
     void disabling();
     void setMask (unsigned mask);
     void setBuffer(RTCBufferType type, void* ptr, size_t offset, size_t stride);
+    void setVertexFormat(RTCVertexFormat format, const float* scale, const float* offset);
     void* map(RTCBufferType type);
     void unmap(RTCBufferType type);
     void immutable ();
     bool verify ();
     void interpolate(unsigned primID, float u, float v, RTCBufferType buffer, float* P, float* dPdu, float* dPdv, float* ddPdudu, float* ddPdvdv, float* ddPdudv, size_t numFloats);
-    // FIXME: implement interpolateN
+    void interpolateN(const void* valid_i, const unsigned* primIDs, const float* u, const float* v, size_t numUVs, 
+                      RTCBufferType buffer, float* P, float* dPdu, float* dPdv, float* ddPdudu, float* ddPdvdv, float* ddPdudv, size_t numFloats);
 
   public:
 
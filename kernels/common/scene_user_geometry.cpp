@@ -53,6 +53,15 @@ namespace embree
     this->boundsFunc2UserPtr = userPtr;
   }
 
+  void UserGeometry::setBoundsFunctionSoA (RTCBoundsFuncSoA bounds, void* userPtr) 
+  {
+    if (parent->isStatic() && parent->isBuild())
+      throw_RTCError(RTC_INVALID_OPERATION,"static scenes cannot get modified");
+
+    this->boundsFuncSoA = bounds;
+    this->boundsFuncSoAUserPtr = userPtr;
+  }
+
   void UserGeometry::setIntersectFunction (RTCIntersectFunc intersect1, bool ispc) 
   {
     if (parent->isStreamMode())
@@ -122,6 +131,14 @@ namespace embree
     intersectors.intersectorN.intersect = intersect;
   }
 
+  void UserGeometry::setIntersectFunctionLeaf (RTCIntersectFuncLeaf intersect) 
+  {
+    if (parent->isStatic() && parent->isBuild())
+      throw_RTCError(RTC_INVALID_OPERATION,"static scenes cannot get modified");
+
+    intersectors.intersectorLeaf.intersect = intersect;
+  }
+
   void UserGeometry::setOccludedFunction (RTCOccludedFunc occluded1, bool ispc) 
   {
     if (parent->isStreamMode())
@@ -190,4 +207,12 @@ namespace embree
 
     intersectors.intersectorN.occluded = occluded;
   }
+
+  void UserGeometry::setOccludedFunctionLeaf (RTCOccludedFuncLeaf occluded) 
+  {
+    if (parent->isStatic() && parent->isBuild())
+      throw_RTCError(RTC_INVALID_OPERATION,"static scenes cannot get modified");
+
+    intersectors.intersectorLeaf.occluded = occluded;
+  }
 }
@@ -72,6 +72,14 @@ namespace embree
     line_accel_mb = "default";
     line_builder_mb = "default";
     line_traverser_mb = "default";
+
+    point_accel = "default";
+    point_builder = "default";
+    point_traverser = "default";
+
+    point_accel_mb = "default";
+    point_builder_mb = "default";
+    point_traverser_mb = "default";
     
     hair_accel = "default";
     hair_builder = "default";
@@ -97,10 +105,13 @@ namespace embree
 
     subdiv_accel = "default";
 
+    build_memory_budget = 0;
+
     float_exceptions = false;
     scene_flags = -1;
     verbose = 0;
     benchmark = 0;
+    capture_file = "";
 
     numThreads = 0;
 #if TASKING_INTERNAL
@@ -278,6 +289,20 @@ namespace embree
         line_builder_mb = cin->get().Identifier();
       else if ((tok == Token::Id("line_traverser_mb")) && cin->trySymbol("="))
         line_traverser_mb = cin->get().Identifier();
+
+      else if ((tok == Token::Id("point_accel")) && cin->trySymbol("="))
+        point_accel = cin->get().Identifier();
+      else if ((tok == Token::Id("point_builder")) && cin->trySymbol("="))
+        point_builder = cin->get().Identifier();
+      else if ((tok == Token::Id("point_traverser")) && cin->trySymbol("="))
+        point_traverser = cin->get().Identifier();
+
+      else if ((tok == Token::Id("point_accel_mb")) && cin->trySymbol("="))
+        point_accel_mb = cin->get().Identifier();
+      else if ((tok == Token::Id("point_builder_mb")) && cin->trySymbol("="))
+        point_builder_mb = cin->get().Identifier();
+      else if ((tok == Token::Id("point_traverser_mb")) && cin->trySymbol("="))
+        point_traverser_mb = cin->get().Identifier();
       
       else if (tok == Token::Id("hair_accel") && cin->trySymbol("="))
         hair_accel = cin->get().Identifier();
@@ -308,6 +333,9 @@ namespace embree
         verbose = cin->get().Int();
       else if (tok == Token::Id("benchmark") && cin->trySymbol("="))
         benchmark = cin->get().Int();
+
+      else if (tok == Token::Id("capture") && cin->trySymbol("="))
+        capture_file = cin->get().String();
       
       else if (tok == Token::Id("flags")) {
         scene_flags = 0;
@@ -321,6 +349,7 @@ namespace embree
             else if (flag == Token::Id("incoherent")) scene_flags |= RTC_SCENE_INCOHERENT;
             else if (flag == Token::Id("high_quality")) scene_flags |= RTC_SCENE_HIGH_QUALITY;
             else if (flag == Token::Id("robust")) scene_flags |= RTC_SCENE_ROBUST;
+            else if (flag == Token::Id("large")) scene_flags |= RTC_SCENE_LARGE;
           } while (cin->trySymbol("|"));
         }
       }
@@ -328,6 +357,9 @@ namespace embree
       else if (tok == Token::Id("tessellation_cache_size") && cin->trySymbol("="))
         tessellation_cache_size = size_t(cin->get().Float()*1024.0f*1024.0f);
 
+      else if (tok == Token::Id("build_memory_budget") && cin->trySymbol("="))
+        build_memory_budget = size_t(double(cin->get().Float())*1024.0*1024.0);
+
       cin->trySymbol(","); // optional , separator
     }
   }
@@ -342,6 +374,8 @@ namespace embree
     std::cout << "  build threads = " << numThreads   << std::endl;
     std::cout << "  affinity      = " << set_affinity << std::endl;
     std::cout << "  verbosity     = " << verbose << std::endl;
+    std::cout << "  build budget  = " << build_memory_budget << std::endl;
+    std::cout << "  capture       = " << capture_file << std::endl;
     
     std::cout << "triangles:" << std::endl;
     std::cout << "  accel         = " << tri_accel << std::endl;
@@ -373,6 +407,16 @@ namespace embree
     std::cout << "  accel         = " << line_accel_mb << std::endl;
     std::cout << "  builder       = " << line_builder_mb << std::endl;
     std::cout << "  traverser     = " << line_traverser_mb << std::endl;
+
+    std::cout << "points:" << std::endl;
+    std::cout << "  accel         = " << point_accel << std::endl;
+    std::cout << "  builder       = " << point_builder << std::endl;
+    std::cout << "  traverser     = " << point_traverser << std::endl;
+
+    std::cout << "motion blur points:" << std::endl;
+    std::cout << "  accel         = " << point_accel_mb << std::endl;
+    std::cout << "  builder       = " << point_builder_mb << std::endl;
+    std::cout << "  traverser     = " << point_traverser_mb << std::endl;
     
     std::cout << "hair:" << std::endl;
     std::cout << "  accel         = " << hair_accel << std::endl;
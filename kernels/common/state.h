@@ -81,6 +81,16 @@ namespace embree
     std::string line_builder_mb;           //!< builder to use for motion blur line segments
     std::string line_traverser_mb;         //!< traverser to use for motion blur line segments
 
+  public:
+    std::string point_accel;                //!< acceleration structure to use for points
+    std::string point_builder;              //!< builder to use for points
+    std::string point_traverser;            //!< traverser to use for points
+
+  public:
+    std::string point_accel_mb;             //!< acceleration structure to use for motion blur points
+    std::string point_builder_mb;           //!< builder to use for motion blur points
+    std::string point_traverser_mb;         //!< traverser to use for motion blur points
+
   public:
     std::string hair_accel;                //!< hair acceleration structure to use
     std::string hair_builder;              //!< builder to use for hair
@@ -100,6 +110,7 @@ namespace embree
 
   public:
     size_t      tessellation_cache_size;   //!< size of the shared tessellation cache 
+    size_t      build_memory_budget;       //!< maximal size of temporary primitive references of a build, 0 for unlimited
     std::string subdiv_accel;              //!< acceleration structure to use for subdivision surfaces
 
   public:
@@ -107,6 +118,7 @@ namespace embree
     int scene_flags;                       //!< scene flags to use
     size_t verbose;                        //!< verbosity of output
     size_t benchmark;                      //!< true
+    std::string capture_file;              //!< file to record API calls into for offline replay, empty to disable
 
   public:
     size_t numThreads;                     //!< number of threads to use in builders
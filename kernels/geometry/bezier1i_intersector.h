@@ -18,6 +18,7 @@
 
 #include "bezier1i.h"
 #include "bezier_intersector.h"
+#include "ribbon_intersector.h"
 
 namespace embree
 {
@@ -37,12 +38,13 @@ namespace embree
       {
         STAT3(normal.trav_prims,1,1,1);
         const BezierCurves* geom = (BezierCurves*) scene->get(prim.geomID());
-        const Vec3fa a0 = geom->vertex(prim.vertexID+0,0);
-        const Vec3fa a1 = geom->vertex(prim.vertexID+1,0);
-        const Vec3fa a2 = geom->vertex(prim.vertexID+2,0);
-        const Vec3fa a3 = geom->vertex(prim.vertexID+3,0);
+        Vec3fa a0,a1,a2,a3; geom->gather(a0,a1,a2,a3,prim.vertexID,0);
         if (likely(geom->subtype == BezierCurves::HAIR))
           pre.intersectorHair.intersect(ray,a0,a1,a2,a3,geom->tessellationRate,Intersect1EpilogMU<VSIZEX,true>(ray,context,prim.geomID(),prim.primID(),scene,geomID_to_instID));
+        else if (geom->subtype == BezierCurves::RIBBON) {
+          Vec3fa n0,n1,n2,n3; geom->gatherNormals(n0,n1,n2,n3,prim.vertexID,0);
+          RibbonIntersector::intersect(pre.intersectorHair,ray,a0,a1,a2,a3,n0,n1,n2,n3,geom->tessellationRate,Intersect1EpilogMU<VSIZEX,true>(ray,context,prim.geomID(),prim.primID(),scene,geomID_to_instID));
+        }
         else 
           pre.intersectorCurve.intersect(ray,a0,a1,a2,a3,Intersect1Epilog1<true>(ray,context,prim.geomID(),prim.primID(),scene,geomID_to_instID));
       }
@@ -51,12 +53,13 @@ namespace embree
       {
         STAT3(shadow.trav_prims,1,1,1);
         const BezierCurves* geom = (BezierCurves*) scene->get(prim.geomID());
-        const Vec3fa a0 = geom->vertex(prim.vertexID+0,0);
-        const Vec3fa a1 = geom->vertex(prim.vertexID+1,0);
-        const Vec3fa a2 = geom->vertex(prim.vertexID+2,0);
-        const Vec3fa a3 = geom->vertex(prim.vertexID+3,0);
+        Vec3fa a0,a1,a2,a3; geom->gather(a0,a1,a2,a3,prim.vertexID,0);
         if (likely(geom->subtype == BezierCurves::HAIR))
           return pre.intersectorHair.intersect(ray,a0,a1,a2,a3,geom->tessellationRate,Occluded1EpilogMU<VSIZEX,true>(ray,context,prim.geomID(),prim.primID(),scene,geomID_to_instID));
+        else if (geom->subtype == BezierCurves::RIBBON) {
+          Vec3fa n0,n1,n2,n3; geom->gatherNormals(n0,n1,n2,n3,prim.vertexID,0);
+          return RibbonIntersector::intersect(pre.intersectorHair,ray,a0,a1,a2,a3,n0,n1,n2,n3,geom->tessellationRate,Occluded1EpilogMU<VSIZEX,true>(ray,context,prim.geomID(),prim.primID(),scene,geomID_to_instID));
+        }
         else
           return pre.intersectorCurve.intersect(ray,a0,a1,a2,a3,Occluded1Epilog1<true>(ray,context,prim.geomID(),prim.primID(),scene,geomID_to_instID));
       }
@@ -97,12 +100,13 @@ namespace embree
       {
         STAT3(normal.trav_prims,1,1,1);
         const BezierCurves* geom = (BezierCurves*) scene->get(prim.geomID());
-        const Vec3fa a0 = geom->vertex(prim.vertexID+0,0);
-        const Vec3fa a1 = geom->vertex(prim.vertexID+1,0);
-        const Vec3fa a2 = geom->vertex(prim.vertexID+2,0);
-        const Vec3fa a3 = geom->vertex(prim.vertexID+3,0);
+        Vec3fa a0,a1,a2,a3; geom->gather(a0,a1,a2,a3,prim.vertexID,0);
         if (likely(geom->subtype == BezierCurves::HAIR))
           pre.intersectorHair.intersect(ray,k,a0,a1,a2,a3,geom->tessellationRate,Intersect1KEpilogMU<VSIZEX,K,true>(ray,k,context,prim.geomID(),prim.primID(),scene));
+        else if (geom->subtype == BezierCurves::RIBBON) {
+          Vec3fa n0,n1,n2,n3; geom->gatherNormals(n0,n1,n2,n3,prim.vertexID,0);
+          RibbonIntersector::intersect(pre.intersectorHair,ray,k,a0,a1,a2,a3,n0,n1,n2,n3,geom->tessellationRate,Intersect1KEpilogMU<VSIZEX,K,true>(ray,k,context,prim.geomID(),prim.primID(),scene));
+        }
         else 
           pre.intersectorCurve.intersect(ray,k,a0,a1,a2,a3,Intersect1KEpilog1<K,true>(ray,k,context,prim.geomID(),prim.primID(),scene));
       }
@@ -117,12 +121,13 @@ namespace embree
       {
         STAT3(shadow.trav_prims,1,1,1);
         const BezierCurves* geom = (BezierCurves*) scene->get(prim.geomID());
-        const Vec3fa a0 = geom->vertex(prim.vertexID+0,0);
-        const Vec3fa a1 = geom->vertex(prim.vertexID+1,0);
-        const Vec3fa a2 = geom->vertex(prim.vertexID+2,0);
-        const Vec3fa a3 = geom->vertex(prim.vertexID+3,0);
+        Vec3fa a0,a1,a2,a3; geom->gather(a0,a1,a2,a3,prim.vertexID,0);
         if (likely(geom->subtype == BezierCurves::HAIR))
           return pre.intersectorHair.intersect(ray,k,a0,a1,a2,a3,geom->tessellationRate,Occluded1KEpilogMU<VSIZEX,K,true>(ray,k,context,prim.geomID(),prim.primID(),scene));
+        else if (geom->subtype == BezierCurves::RIBBON) {
+          Vec3fa n0,n1,n2,n3; geom->gatherNormals(n0,n1,n2,n3,prim.vertexID,0);
+          return RibbonIntersector::intersect(pre.intersectorHair,ray,k,a0,a1,a2,a3,n0,n1,n2,n3,geom->tessellationRate,Occluded1KEpilogMU<VSIZEX,K,true>(ray,k,context,prim.geomID(),prim.primID(),scene));
+        }
         else
           return pre.intersectorCurve.intersect(ray,k,a0,a1,a2,a3,Occluded1KEpilog1<K,true>(ray,k,context,prim.geomID(),prim.primID(),scene));
       }
@@ -158,14 +163,8 @@ namespace embree
       {
         STAT3(normal.trav_prims,1,1,1);
         const BezierCurves* geom = (BezierCurves*) scene->get(prim.geomID());
-        const Vec3fa a0 = geom->vertex(prim.vertexID+0,0);
-        const Vec3fa a1 = geom->vertex(prim.vertexID+1,0);
-        const Vec3fa a2 = geom->vertex(prim.vertexID+2,0);
-        const Vec3fa a3 = geom->vertex(prim.vertexID+3,0);
-        const Vec3fa b0 = geom->vertex(prim.vertexID+0,1);
-        const Vec3fa b1 = geom->vertex(prim.vertexID+1,1);
-        const Vec3fa b2 = geom->vertex(prim.vertexID+2,1);
-        const Vec3fa b3 = geom->vertex(prim.vertexID+3,1);
+        Vec3fa a0,a1,a2,a3; geom->gather(a0,a1,a2,a3,prim.vertexID,0);
+        Vec3fa b0,b1,b2,b3; geom->gather(b0,b1,b2,b3,prim.vertexID,1);
         const float t0 = 1.0f-ray.time, t1 = ray.time;
         const Vec3fa p0 = t0*a0 + t1*b0;
         const Vec3fa p1 = t0*a1 + t1*b1;
@@ -173,6 +172,11 @@ namespace embree
         const Vec3fa p3 = t0*a3 + t1*b3;
         if (likely(geom->subtype == BezierCurves::HAIR))
           pre.intersectorHair.intersect(ray,p0,p1,p2,p3,geom->tessellationRate,Intersect1EpilogMU<VSIZEX,true>(ray,context,prim.geomID(),prim.primID(),scene,geomID_to_instID));
+        else if (geom->subtype == BezierCurves::RIBBON) {
+          Vec3fa c0,c1,c2,c3; geom->gatherNormals(c0,c1,c2,c3,prim.vertexID,0);
+          Vec3fa d0,d1,d2,d3; geom->gatherNormals(d0,d1,d2,d3,prim.vertexID,1);
+          RibbonIntersector::intersect(pre.intersectorHair,ray,p0,p1,p2,p3,t0*c0+t1*d0,t0*c1+t1*d1,t0*c2+t1*d2,t0*c3+t1*d3,geom->tessellationRate,Intersect1EpilogMU<VSIZEX,true>(ray,context,prim.geomID(),prim.primID(),scene,geomID_to_instID));
+        }
         else 
           pre.intersectorCurve.intersect(ray,p0,p1,p2,p3,Intersect1Epilog1<true>(ray,context,prim.geomID(),prim.primID(),scene,geomID_to_instID));
       }
@@ -181,14 +185,8 @@ namespace embree
       {
         STAT3(shadow.trav_prims,1,1,1);
         const BezierCurves* geom = (BezierCurves*) scene->get(prim.geomID());
-        const Vec3fa a0 = geom->vertex(prim.vertexID+0,0);
-        const Vec3fa a1 = geom->vertex(prim.vertexID+1,0);
-        const Vec3fa a2 = geom->vertex(prim.vertexID+2,0);
-        const Vec3fa a3 = geom->vertex(prim.vertexID+3,0);
-        const Vec3fa b0 = geom->vertex(prim.vertexID+0,1);
-        const Vec3fa b1 = geom->vertex(prim.vertexID+1,1);
-        const Vec3fa b2 = geom->vertex(prim.vertexID+2,1);
-        const Vec3fa b3 = geom->vertex(prim.vertexID+3,1);
+        Vec3fa a0,a1,a2,a3; geom->gather(a0,a1,a2,a3,prim.vertexID,0);
+        Vec3fa b0,b1,b2,b3; geom->gather(b0,b1,b2,b3,prim.vertexID,1);
         const float t0 = 1.0f-ray.time, t1 = ray.time;
         const Vec3fa p0 = t0*a0 + t1*b0;
         const Vec3fa p1 = t0*a1 + t1*b1;
@@ -196,6 +194,11 @@ namespace embree
         const Vec3fa p3 = t0*a3 + t1*b3;
         if (likely(geom->subtype == BezierCurves::HAIR))
           return pre.intersectorHair.intersect(ray,p0,p1,p2,p3,geom->tessellationRate,Occluded1EpilogMU<VSIZEX,true>(ray,context,prim.geomID(),prim.primID(),scene,geomID_to_instID));
+        else if (geom->subtype == BezierCurves::RIBBON) {
+          Vec3fa c0,c1,c2,c3; geom->gatherNormals(c0,c1,c2,c3,prim.vertexID,0);
+          Vec3fa d0,d1,d2,d3; geom->gatherNormals(d0,d1,d2,d3,prim.vertexID,1);
+          return RibbonIntersector::intersect(pre.intersectorHair,ray,p0,p1,p2,p3,t0*c0+t1*d0,t0*c1+t1*d1,t0*c2+t1*d2,t0*c3+t1*d3,geom->tessellationRate,Occluded1EpilogMU<VSIZEX,true>(ray,context,prim.geomID(),prim.primID(),scene,geomID_to_instID));
+        }
         else
           return pre.intersectorCurve.intersect(ray,p0,p1,p2,p3,Occluded1Epilog1<true>(ray,context,prim.geomID(),prim.primID(),scene,geomID_to_instID));
       }
@@ -221,14 +224,8 @@ namespace embree
       {
         STAT3(normal.trav_prims,1,1,1);
         const BezierCurves* geom = (BezierCurves*) scene->get(prim.geomID());
-        const Vec3fa a0 = geom->vertex(prim.vertexID+0,0);
-        const Vec3fa a1 = geom->vertex(prim.vertexID+1,0);
-        const Vec3fa a2 = geom->vertex(prim.vertexID+2,0);
-        const Vec3fa a3 = geom->vertex(prim.vertexID+3,0);
-        const Vec3fa b0 = geom->vertex(prim.vertexID+0,1);
-        const Vec3fa b1 = geom->vertex(prim.vertexID+1,1);
-        const Vec3fa b2 = geom->vertex(prim.vertexID+2,1);
-        const Vec3fa b3 = geom->vertex(prim.vertexID+3,1);
+        Vec3fa a0,a1,a2,a3; geom->gather(a0,a1,a2,a3,prim.vertexID,0);
+        Vec3fa b0,b1,b2,b3; geom->gather(b0,b1,b2,b3,prim.vertexID,1);
         const float t0 = 1.0f-ray.time[k], t1 = ray.time[k];
         const Vec3fa p0 = t0*a0 + t1*b0;
         const Vec3fa p1 = t0*a1 + t1*b1;
@@ -236,6 +233,11 @@ namespace embree
         const Vec3fa p3 = t0*a3 + t1*b3;
         if (likely(geom->subtype == BezierCurves::HAIR))
           pre.intersectorHair.intersect(ray,k,p0,p1,p2,p3,geom->tessellationRate,Intersect1KEpilogMU<VSIZEX,K,true>(ray,k,context,prim.geomID(),prim.primID(),scene));
+        else if (geom->subtype == BezierCurves::RIBBON) {
+          Vec3fa c0,c1,c2,c3; geom->gatherNormals(c0,c1,c2,c3,prim.vertexID,0);
+          Vec3fa d0,d1,d2,d3; geom->gatherNormals(d0,d1,d2,d3,prim.vertexID,1);
+          RibbonIntersector::intersect(pre.intersectorHair,ray,k,p0,p1,p2,p3,t0*c0+t1*d0,t0*c1+t1*d1,t0*c2+t1*d2,t0*c3+t1*d3,geom->tessellationRate,Intersect1KEpilogMU<VSIZEX,K,true>(ray,k,context,prim.geomID(),prim.primID(),scene));
+        }
         else 
           pre.intersectorCurve.intersect(ray,k,p0,p1,p2,p3,Intersect1KEpilog1<K,true>(ray,k,context,prim.geomID(),prim.primID(),scene));
       }
@@ -244,14 +246,8 @@ namespace embree
       {
         STAT3(shadow.trav_prims,1,1,1);
         const BezierCurves* geom = (BezierCurves*) scene->get(prim.geomID());
-        const Vec3fa a0 = geom->vertex(prim.vertexID+0,0);
-        const Vec3fa a1 = geom->vertex(prim.vertexID+1,0);
-        const Vec3fa a2 = geom->vertex(prim.vertexID+2,0);
-        const Vec3fa a3 = geom->vertex(prim.vertexID+3,0);
-        const Vec3fa b0 = geom->vertex(prim.vertexID+0,1);
-        const Vec3fa b1 = geom->vertex(prim.vertexID+1,1);
-        const Vec3fa b2 = geom->vertex(prim.vertexID+2,1);
-        const Vec3fa b3 = geom->vertex(prim.vertexID+3,1);
+        Vec3fa a0,a1,a2,a3; geom->gather(a0,a1,a2,a3,prim.vertexID,0);
+        Vec3fa b0,b1,b2,b3; geom->gather(b0,b1,b2,b3,prim.vertexID,1);
         const float t0 = 1.0f-ray.time[k], t1 = ray.time[k];
         const Vec3fa p0 = t0*a0 + t1*b0;
         const Vec3fa p1 = t0*a1 + t1*b1;
@@ -259,6 +255,11 @@ namespace embree
         const Vec3fa p3 = t0*a3 + t1*b3;
         if (likely(geom->subtype == BezierCurves::HAIR))
           return pre.intersectorHair.intersect(ray,k,p0,p1,p2,p3,geom->tessellationRate,Occluded1KEpilogMU<VSIZEX,K,true>(ray,k,context,prim.geomID(),prim.primID(),scene));
+        else if (geom->subtype == BezierCurves::RIBBON) {
+          Vec3fa c0,c1,c2,c3; geom->gatherNormals(c0,c1,c2,c3,prim.vertexID,0);
+          Vec3fa d0,d1,d2,d3; geom->gatherNormals(d0,d1,d2,d3,prim.vertexID,1);
+          return RibbonIntersector::intersect(pre.intersectorHair,ray,k,p0,p1,p2,p3,t0*c0+t1*d0,t0*c1+t1*d1,t0*c2+t1*d2,t0*c3+t1*d3,geom->tessellationRate,Occluded1KEpilogMU<VSIZEX,K,true>(ray,k,context,prim.geomID(),prim.primID(),scene));
+        }
         else
           return pre.intersectorCurve.intersect(ray,k,a0,a1,a2,a3,Occluded1KEpilog1<K,true>(ray,k,context,prim.geomID(),prim.primID(),scene));
       }
@@ -29,7 +29,7 @@ namespace embree
     __forceinline BezierPrim () {}
 
     /*! Construction from vertices and IDs. */
-    __forceinline BezierPrim (bool hair,
+    __forceinline BezierPrim (int hair,
                               const Vec3fa& p0, const Vec3fa& p1, const Vec3fa& p2, const Vec3fa& p3, const int N,
                               const unsigned int geomID, const unsigned int primID)
       : p0(p0), p1(p1), p2(p2), p3(p3), N(N), geom(geomID), prim(primID), hair(hair) {}
@@ -100,7 +100,7 @@ namespace embree
     int N;                //!< tessellation rate
     unsigned geom;        //!< geometry ID
     unsigned prim;        //!< primitive ID
-    int hair;             //!< 0=surface, 1=hair
+    int hair;             //!< 0=surface, 1=hair, 2=ribbon
   };
 
   struct Bezier1v
@@ -153,10 +153,7 @@ namespace embree
       const unsigned primID = prim.primID();
       const BezierCurves* curves = scene->getBezierCurves(geomID);
       const unsigned id = curves->curve(primID);
-      const Vec3fa& p0 = curves->vertex(id+0);
-      const Vec3fa& p1 = curves->vertex(id+1);
-      const Vec3fa& p2 = curves->vertex(id+2);
-      const Vec3fa& p3 = curves->vertex(id+3);
+      Vec3fa p0,p1,p2,p3; curves->gather(p0,p1,p2,p3,id);
       new (this) Bezier1v(p0,p1,p2,p3,geomID,primID);
     }
 
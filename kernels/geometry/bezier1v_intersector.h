@@ -19,6 +19,7 @@
 #include "bezier1v.h"
 #include "bezier_intersector.h"
 #include "bezier_geometry_intersector.h"
+#include "ribbon_intersector.h"
 #include "intersector_epilog.h"
 
 namespace embree
@@ -42,6 +43,10 @@ namespace embree
         const BezierCurves* geom = (BezierCurves*)scene->get(prim.geomID());
         if (likely(geom->subtype == BezierCurves::HAIR))
           pre.intersectorHair.intersect(ray,prim.p0,prim.p1,prim.p2,prim.p3,geom->tessellationRate,Intersect1EpilogMU<VSIZEX,true>(ray,context,prim.geomID(),prim.primID(),scene,geomID_to_instID));
+        else if (geom->subtype == BezierCurves::RIBBON) {
+          Vec3fa n0,n1,n2,n3; geom->gatherNormals(n0,n1,n2,n3,geom->curve(prim.primID()));
+          RibbonIntersector::intersect(pre.intersectorHair,ray,prim.p0,prim.p1,prim.p2,prim.p3,n0,n1,n2,n3,geom->tessellationRate,Intersect1EpilogMU<VSIZEX,true>(ray,context,prim.geomID(),prim.primID(),scene,geomID_to_instID));
+        }
         else 
           pre.intersectorCurve.intersect(ray,prim.p0,prim.p1,prim.p2,prim.p3,Intersect1Epilog1<true>(ray,context,prim.geomID(),prim.primID(),scene,geomID_to_instID));
       }
@@ -52,6 +57,10 @@ namespace embree
         const BezierCurves* geom = (BezierCurves*)scene->get(prim.geomID());
         if (likely(geom->subtype == BezierCurves::HAIR))
           return pre.intersectorHair.intersect(ray,prim.p0,prim.p1,prim.p2,prim.p3,geom->tessellationRate,Occluded1EpilogMU<VSIZEX,true>(ray,context,prim.geomID(),prim.primID(),scene,geomID_to_instID));
+        else if (geom->subtype == BezierCurves::RIBBON) {
+          Vec3fa n0,n1,n2,n3; geom->gatherNormals(n0,n1,n2,n3,geom->curve(prim.primID()));
+          return RibbonIntersector::intersect(pre.intersectorHair,ray,prim.p0,prim.p1,prim.p2,prim.p3,n0,n1,n2,n3,geom->tessellationRate,Occluded1EpilogMU<VSIZEX,true>(ray,context,prim.geomID(),prim.primID(),scene,geomID_to_instID));
+        }
         else
           return pre.intersectorCurve.intersect(ray,prim.p0,prim.p1,prim.p2,prim.p3,Occluded1Epilog1<true>(ray,context,prim.geomID(),prim.primID(),scene,geomID_to_instID));
       }
@@ -94,6 +103,10 @@ namespace embree
         const BezierCurves* geom = (BezierCurves*)scene->get(prim.geomID());
         if (likely(geom->subtype == BezierCurves::HAIR))
           pre.intersectorHair.intersect(ray,k,prim.p0,prim.p1,prim.p2,prim.p3,geom->tessellationRate,Intersect1KEpilogMU<VSIZEX,K,true>(ray,k,context,prim.geomID(),prim.primID(),scene));
+        else if (geom->subtype == BezierCurves::RIBBON) {
+          Vec3fa n0,n1,n2,n3; geom->gatherNormals(n0,n1,n2,n3,geom->curve(prim.primID()));
+          RibbonIntersector::intersect(pre.intersectorHair,ray,k,prim.p0,prim.p1,prim.p2,prim.p3,n0,n1,n2,n3,geom->tessellationRate,Intersect1KEpilogMU<VSIZEX,K,true>(ray,k,context,prim.geomID(),prim.primID(),scene));
+        }
         else
           pre.intersectorCurve.intersect(ray,k,prim.p0,prim.p1,prim.p2,prim.p3,Intersect1KEpilog1<K,true>(ray,k,context,prim.geomID(),prim.primID(),scene));
       }
@@ -110,6 +123,10 @@ namespace embree
         const BezierCurves* geom = (BezierCurves*)scene->get(prim.geomID());
          if (likely(geom->subtype == BezierCurves::HAIR))
            return pre.intersectorHair.intersect(ray,k,prim.p0,prim.p1,prim.p2,prim.p3,geom->tessellationRate,Occluded1KEpilogMU<VSIZEX,K,true>(ray,k,context,prim.geomID(),prim.primID(),scene));
+         else if (geom->subtype == BezierCurves::RIBBON) {
+           Vec3fa n0,n1,n2,n3; geom->gatherNormals(n0,n1,n2,n3,geom->curve(prim.primID()));
+           return RibbonIntersector::intersect(pre.intersectorHair,ray,k,prim.p0,prim.p1,prim.p2,prim.p3,n0,n1,n2,n3,geom->tessellationRate,Occluded1KEpilogMU<VSIZEX,K,true>(ray,k,context,prim.geomID(),prim.primID(),scene));
+         }
          else
            return pre.intersectorCurve.intersect(ray,k,prim.p0,prim.p1,prim.p2,prim.p3,Occluded1KEpilog1<K,true>(ray,k,context,prim.geomID(),prim.primID(),scene));
       }
@@ -0,0 +1,112 @@
+// ======================================================================== //
+// Copyright 2009-2016 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+#include "bezier1v.h"
+
+namespace embree
+{
+  /* Stores M bezier curves in SoA layout. The storage uses plain
+   * arrays such that the type can also be used from code that is
+   * compiled for an ISA without M-wide SIMD types. */
+  template <int M>
+  struct BezierMv
+  {
+    /* Virtual interface to query information about the curve type */
+    struct Type : public PrimitiveType
+    {
+      Type();
+      size_t size(const char* This) const;
+    };
+    static Type type;
+
+  public:
+
+    /* Returns maximal number of stored curves */
+    static __forceinline size_t max_size() { return M; }
+
+    /* Returns required number of primitive blocks for N curves */
+    static __forceinline size_t blocks(size_t N) { return (N+max_size()-1)/max_size(); }
+
+  public:
+
+    /* Returns if the specified curve is valid */
+    __forceinline bool valid(const size_t i) const { assert(i<M); return primIDs[i] != -1; }
+
+    /* Returns the number of stored curves */
+    __forceinline size_t size() const
+    {
+      size_t n = 0;
+      while (n<M && valid(n)) n++;
+      return n;
+    }
+
+    /* Returns the geometry IDs */
+    __forceinline int geomID(const size_t i) const { assert(i<M); return geomIDs[i]; }
+
+    /* Returns the primitive IDs */
+    __forceinline int primID(const size_t i) const { assert(i<M); return primIDs[i]; }
+
+    /* Returns the k'th control point of the i'th curve */
+    __forceinline Vec3fa vertex(const size_t k, const size_t i) const {
+      assert(k<4 && i<M); return Vec3fa(x[k][i],y[k][i],z[k][i],r[k][i]);
+    }
+
+    /* Fill curves from curve list */
+    __forceinline void fill(const BezierPrim* prims, size_t& begin, size_t end, Scene* scene, const bool list)
+    {
+      for (size_t i=0; i<M; i++)
+      {
+        /* fill unused lanes with a copy of the previous curve */
+        const bool used = begin<end;
+        const BezierPrim& prim = used ? prims[begin++] : prims[begin-1];
+        const Vec3fa p[4] = { prim.p0, prim.p1, prim.p2, prim.p3 };
+        for (size_t k=0; k<4; k++) {
+          x[k][i] = p[k].x; y[k][i] = p[k].y; z[k][i] = p[k].z; r[k][i] = p[k].w;
+        }
+        N[i]       = used && prim.hair == BezierCurves::HAIR ? prim.N : 0;
+        geomIDs[i] = prim.geomID();
+        primIDs[i] = used ? prim.primID() : -1;
+      }
+    }
+
+    friend std::ostream& operator<<(std::ostream& cout, const BezierMv& b)
+    {
+      cout << "Bezier" << M << "v { " << std::endl;
+      for (size_t i=0; i<M; i++) {
+        cout << "  p0 = " << b.vertex(0,i) << ", p1 = " << b.vertex(1,i) << ", p2 = " << b.vertex(2,i) << ", p3 = " << b.vertex(3,i) << ", "
+             << "N = " << b.N[i] << ", geomID = " << b.geomIDs[i] << ", primID = " << b.primIDs[i] << std::endl;
+      }
+      return cout << "}";
+    }
+
+  public:
+    float x[4][M];        //!< x coordinates of the control points
+    float y[4][M];        //!< y coordinates of the control points
+    float z[4][M];        //!< z coordinates of the control points
+    float r[4][M];        //!< radii of the control points
+    int N[M];             //!< tessellation rate of hair curves, 0 for surface curves, ribbons, and unused lanes
+    int geomIDs[M];       //!< geometry IDs
+    int primIDs[M];       //!< primitive IDs, -1 for unused lanes
+  };
+
+  template<int M>
+  typename BezierMv<M>::Type BezierMv<M>::type;
+
+  typedef BezierMv<4> Bezier4v;
+  typedef BezierMv<8> Bezier8v;
+}
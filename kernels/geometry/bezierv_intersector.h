@@ -0,0 +1,332 @@
+// ======================================================================== //
+// Copyright 2009-2016 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+#include "bezierv.h"
+#include "bezier_geometry_intersector.h"
+#include "ribbon_intersector.h"
+#include "intersector_epilog.h"
+
+namespace embree
+{
+  namespace isa
+  {
+    template<int M>
+      struct BezierMvHit
+      {
+        typedef Vec4<vfloat<M>> Vec4vfM;
+
+        __forceinline BezierMvHit(const vfloat<M>& u, const vfloat<M>& t,
+                                  const Vec4vfM& p0, const Vec4vfM& p1, const Vec4vfM& p2, const Vec4vfM& p3)
+          : vu(u), vv(zero), vt(t), p0(p0), p1(p1), p2(p2), p3(p3) {}
+
+        /* the geometry normal is the tangent of the curve at the hit location */
+        __forceinline void finalize()
+        {
+          const vfloat<M> t1 = vu, t0 = 1.0f-t1;
+          const vfloat<M> B0 = 3.0f*t0*t0, B1 = 6.0f*t0*t1, B2 = 3.0f*t1*t1;
+          const Vec4vfM T = B0*(p1-p0) + B1*(p2-p1) + B2*(p3-p2);
+          const vbool<M> degenerate = (T.x == vfloat<M>(zero)) & (T.y == vfloat<M>(zero)) & (T.z == vfloat<M>(zero));
+          vNg.x = select(degenerate,vfloat<M>(one),T.x);
+          vNg.y = select(degenerate,vfloat<M>(one),T.y);
+          vNg.z = select(degenerate,vfloat<M>(one),T.z);
+        }
+
+        __forceinline Vec2f uv (const size_t i) const { return Vec2f(vu[i],vv[i]); }
+        __forceinline float t  (const size_t i) const { return vt[i]; }
+        __forceinline Vec3fa Ng(const size_t i) const { return Vec3fa(vNg.x[i],vNg.y[i],vNg.z[i]); }
+
+      public:
+        vfloat<M> vu;
+        vfloat<M> vv;
+        vfloat<M> vt;
+        Vec3<vfloat<M>> vNg;
+
+      private:
+        const Vec4vfM& p0;
+        const Vec4vfM& p1;
+        const Vec4vfM& p2;
+        const Vec4vfM& p3;
+      };
+
+    /*! Intersects a ray with M bezier curves at once. Hair curves are
+     *  tessellated into line segments and each tessellation step tests
+     *  the segments of all M curves in parallel. */
+    template<int M>
+      struct BezierMvIntersector
+      {
+        typedef Vec3<vfloat<M>> Vec3vfM;
+        typedef Vec4<vfloat<M>> Vec4vfM;
+
+        /* evaluates the curves at the curve parameters t */
+        static __forceinline Vec4vfM eval(const Vec4vfM& p0, const Vec4vfM& p1, const Vec4vfM& p2, const Vec4vfM& p3, const vfloat<M>& t)
+        {
+          const vfloat<M> t1 = t, t0 = 1.0f-t;
+          const vfloat<M> B0 = t0*t0*t0;
+          const vfloat<M> B1 = 3.0f*t1*t0*t0;
+          const vfloat<M> B2 = 3.0f*t1*t1*t0;
+          const vfloat<M> B3 = t1*t1*t1;
+          return B0*p0 + B1*p1 + B2*p2 + B3*p3;
+        }
+
+        /* gathers the k'th control point of all curves */
+        static __forceinline Vec4vfM vertex(const BezierMv<M>& prim, const size_t k) {
+          return Vec4vfM(vfloat<M>::loadu(prim.x[k]),vfloat<M>::loadu(prim.y[k]),vfloat<M>::loadu(prim.z[k]),vfloat<M>::loadu(prim.r[k]));
+        }
+
+        template<bool occlusion, typename Epilog>
+        static __forceinline bool intersect(const Vec3fa& ray_org, const float ray_tnear, const float& ray_tfar,
+                                            const LinearSpace3<Vec3vfM>& ray_space, const float depth_scale,
+                                            const BezierMv<M>& prim, const Epilog& epilog)
+        {
+          const vint<M> N = vint<M>::loadu(prim.N);
+          const vbool<M> valid0 = N > vint<M>(zero);
+          if (unlikely(none(valid0))) return false;
+          const int maxN = reduce_max(select(valid0,N,vint<M>(zero)));
+          const vfloat<M> rcpN = rcp(vfloat<M>(N));
+
+          /* transform control points into ray space */
+          const Vec4vfM v0 = vertex(prim,0), v1 = vertex(prim,1), v2 = vertex(prim,2), v3 = vertex(prim,3);
+          const Vec3vfM org(ray_org);
+          const Vec4vfM w0(xfmVector(ray_space,v0.xyz()-org),v0.w);
+          const Vec4vfM w1(xfmVector(ray_space,v1.xyz()-org),v1.w);
+          const Vec4vfM w2(xfmVector(ray_space,v2.xyz()-org),v2.w);
+          const Vec4vfM w3(xfmVector(ray_space,v3.xyz()-org),v3.w);
+
+          /* process one tessellation segment of all curves per iteration */
+          bool ishit = false;
+          Vec4vfM p0 = w0;
+          for (int i=0; i<maxN; i++)
+          {
+            const vbool<M> valid1 = valid0 & (vint<M>(i) < N);
+            const vfloat<M> u1 = min(vfloat<M>(float(i+1))*rcpN,vfloat<M>(one));
+            const Vec4vfM p1 = eval(w0,w1,w2,w3,u1);
+
+            /* approximative intersection with cone */
+            const Vec4vfM v = p1-p0;
+            const Vec4vfM w = -p0;
+            const vfloat<M> d0 = w.x*v.x + w.y*v.y;
+            const vfloat<M> d1 = v.x*v.x + v.y*v.y;
+            const vfloat<M> u = clamp(d0*rcp(d1),vfloat<M>(zero),vfloat<M>(one));
+            const Vec4vfM p = p0 + u*v;
+            const vfloat<M> t = p.z*depth_scale;
+            const vfloat<M> d2 = p.x*p.x + p.y*p.y;
+            const vfloat<M> r = p.w;
+            const vfloat<M> r2 = r*r;
+            const vbool<M> valid = valid1 & (d2 <= r2) & (vfloat<M>(ray_tnear) < t) & (t < vfloat<M>(ray_tfar));
+            p0 = p1;
+
+            /* update hit information */
+            if (unlikely(any(valid))) {
+              BezierMvHit<M> hit((vfloat<M>(float(i))+u)*rcpN,t,v0,v1,v2,v3);
+              ishit |= epilog(valid,hit);
+              if (occlusion && ishit) break;
+            }
+          }
+          return ishit;
+        }
+      };
+
+    /*! Intersector for a single ray with M bezier curves. */
+    template<int M, bool filter>
+      struct BezierMvIntersector1
+      {
+        typedef BezierMv<M> Primitive;
+        typedef Vec3<vfloat<M>> Vec3vfM;
+
+        struct Precalculations
+        {
+          __forceinline Precalculations () {}
+
+          __forceinline Precalculations (const Ray& ray, const void* ptr)
+          {
+            depth_scale = rsqrt(dot(ray.dir,ray.dir));
+            ray_space = frame(depth_scale*ray.dir).transposed();
+          }
+
+          float depth_scale;
+          LinearSpace3<Vec3vfM> ray_space;
+        };
+
+        /* surface curves and ribbons are intersected one after the other */
+        template<bool occlusion>
+        static __forceinline bool intersectSurfaces(Ray& ray, const RTCIntersectContext* context, const Primitive& prim, Scene* scene, const unsigned* geomID_to_instID)
+        {
+          bool ishit = false;
+          BezierGeometry1Intersector1 intersectorCurve(ray,nullptr);
+          for (size_t i=0; i<M && prim.valid(i); i++)
+          {
+            if (likely(prim.N[i] != 0)) continue;
+            const Vec3fa p0 = prim.vertex(0,i), p1 = prim.vertex(1,i), p2 = prim.vertex(2,i), p3 = prim.vertex(3,i);
+            const BezierCurves* geom = scene->getBezierCurves(prim.geomID(i));
+            if (geom->subtype == BezierCurves::RIBBON)
+            {
+              const Bezier1Intersector1 intersectorHair(ray,nullptr);
+              Vec3fa n0,n1,n2,n3; geom->gatherNormals(n0,n1,n2,n3,geom->curve(prim.primID(i)));
+              if (occlusion) {
+                if (RibbonIntersector::intersect(intersectorHair,ray,p0,p1,p2,p3,n0,n1,n2,n3,geom->tessellationRate,Occluded1EpilogMU<VSIZEX,filter>(ray,context,prim.geomID(i),prim.primID(i),scene,geomID_to_instID)))
+                  return true;
+              } else {
+                ishit |= RibbonIntersector::intersect(intersectorHair,ray,p0,p1,p2,p3,n0,n1,n2,n3,geom->tessellationRate,Intersect1EpilogMU<VSIZEX,filter>(ray,context,prim.geomID(i),prim.primID(i),scene,geomID_to_instID));
+              }
+              continue;
+            }
+            if (occlusion) {
+              if (intersectorCurve.intersect(ray,p0,p1,p2,p3,Occluded1Epilog1<filter>(ray,context,prim.geomID(i),prim.primID(i),scene,geomID_to_instID)))
+                return true;
+            } else {
+              ishit |= intersectorCurve.intersect(ray,p0,p1,p2,p3,Intersect1Epilog1<filter>(ray,context,prim.geomID(i),prim.primID(i),scene,geomID_to_instID));
+            }
+          }
+          return ishit;
+        }
+
+        static __forceinline void intersect(const Precalculations& pre, Ray& ray, const RTCIntersectContext* context, const Primitive& prim, Scene* scene, const unsigned* geomID_to_instID)
+        {
+          STAT3(normal.trav_prims,1,1,1);
+          const vint<M> geomIDs = vint<M>::loadu(prim.geomIDs);
+          const vint<M> primIDs = vint<M>::loadu(prim.primIDs);
+          BezierMvIntersector<M>::template intersect<false>(ray.org,ray.tnear,ray.tfar,pre.ray_space,pre.depth_scale,prim,
+                                            Intersect1EpilogM<M,M,filter>(ray,context,geomIDs,primIDs,scene,geomID_to_instID));
+          intersectSurfaces<false>(ray,context,prim,scene,geomID_to_instID);
+        }
+
+        static __forceinline bool occluded(const Precalculations& pre, Ray& ray, const RTCIntersectContext* context, const Primitive& prim, Scene* scene, const unsigned* geomID_to_instID)
+        {
+          STAT3(shadow.trav_prims,1,1,1);
+          const vint<M> geomIDs = vint<M>::loadu(prim.geomIDs);
+          const vint<M> primIDs = vint<M>::loadu(prim.primIDs);
+          if (BezierMvIntersector<M>::template intersect<true>(ray.org,ray.tnear,ray.tfar,pre.ray_space,pre.depth_scale,prim,
+                                                Occluded1EpilogM<M,M,filter>(ray,context,geomIDs,primIDs,scene,geomID_to_instID)))
+            return true;
+          return intersectSurfaces<true>(ray,context,prim,scene,geomID_to_instID);
+        }
+
+        /*! Intersect an array of rays with an array of M primitives. */
+        static __forceinline size_t intersect(Precalculations* pre, size_t valid, Ray** rays, const RTCIntersectContext* context,  size_t ty, const Primitive* prim, size_t num, Scene* scene, const unsigned* geomID_to_instID)
+        {
+          size_t valid_isec = 0;
+          do {
+            const size_t i = __bscf(valid);
+            const float old_far = rays[i]->tfar;
+            for (size_t n=0; n<num; n++)
+              intersect(pre[i],*rays[i],context,prim[n],scene,geomID_to_instID);
+            valid_isec |= (rays[i]->tfar < old_far) ? ((size_t)1 << i) : 0;
+          } while(unlikely(valid));
+          return valid_isec;
+        }
+      };
+
+    /*! Intersector for a single ray from a ray packet with M bezier curves. */
+    template<int M, int K, bool filter>
+      struct BezierMvIntersectorK
+      {
+        typedef BezierMv<M> Primitive;
+        typedef Vec3<vfloat<M>> Vec3vfM;
+
+        struct Precalculations
+        {
+          __forceinline Precalculations (const vbool<K>& valid, const RayK<K>& ray)
+          {
+            size_t mask = movemask(valid);
+            depth_scale = rsqrt(dot(ray.dir,ray.dir));
+            while (mask) {
+              size_t k = __bscf(mask);
+              ray_space[k] = frame(depth_scale[k]*Vec3fa(ray.dir.x[k],ray.dir.y[k],ray.dir.z[k])).transposed();
+            }
+          }
+
+          vfloat<K> depth_scale;
+          LinearSpace3<Vec3vfM> ray_space[K];
+        };
+
+        /* surface curves and ribbons are intersected one after the other */
+        template<bool occlusion>
+        static __forceinline bool intersectSurfaces(RayK<K>& ray, size_t k, const RTCIntersectContext* context, const Primitive& prim, Scene* scene)
+        {
+          bool ishit = false;
+          BezierGeometry1IntersectorK<K> intersectorCurve(ray,k);
+          for (size_t i=0; i<M && prim.valid(i); i++)
+          {
+            if (likely(prim.N[i] != 0)) continue;
+            const Vec3fa p0 = prim.vertex(0,i), p1 = prim.vertex(1,i), p2 = prim.vertex(2,i), p3 = prim.vertex(3,i);
+            const BezierCurves* geom = scene->getBezierCurves(prim.geomID(i));
+            if (geom->subtype == BezierCurves::RIBBON)
+            {
+              const Bezier1IntersectorK<K> intersectorHair(ray,k);
+              Vec3fa n0,n1,n2,n3; geom->gatherNormals(n0,n1,n2,n3,geom->curve(prim.primID(i)));
+              if (occlusion) {
+                if (RibbonIntersector::intersect(intersectorHair,ray,k,p0,p1,p2,p3,n0,n1,n2,n3,geom->tessellationRate,Occluded1KEpilogMU<VSIZEX,K,filter>(ray,k,context,prim.geomID(i),prim.primID(i),scene)))
+                  return true;
+              } else {
+                ishit |= RibbonIntersector::intersect(intersectorHair,ray,k,p0,p1,p2,p3,n0,n1,n2,n3,geom->tessellationRate,Intersect1KEpilogMU<VSIZEX,K,filter>(ray,k,context,prim.geomID(i),prim.primID(i),scene));
+              }
+              continue;
+            }
+            if (occlusion) {
+              if (intersectorCurve.intersect(ray,k,p0,p1,p2,p3,Occluded1KEpilog1<K,filter>(ray,k,context,prim.geomID(i),prim.primID(i),scene)))
+                return true;
+            } else {
+              ishit |= intersectorCurve.intersect(ray,k,p0,p1,p2,p3,Intersect1KEpilog1<K,filter>(ray,k,context,prim.geomID(i),prim.primID(i),scene));
+            }
+          }
+          return ishit;
+        }
+
+        static __forceinline void intersect(Precalculations& pre, RayK<K>& ray, const size_t k, const RTCIntersectContext* context, const Primitive& prim, Scene* scene)
+        {
+          STAT3(normal.trav_prims,1,1,1);
+          const vint<M> geomIDs = vint<M>::loadu(prim.geomIDs);
+          const vint<M> primIDs = vint<M>::loadu(prim.primIDs);
+          const Vec3fa ray_org(ray.org.x[k],ray.org.y[k],ray.org.z[k]);
+          BezierMvIntersector<M>::template intersect<false>(ray_org,ray.tnear[k],ray.tfar[k],pre.ray_space[k],pre.depth_scale[k],prim,
+                                            Intersect1KEpilogM<M,M,K,filter>(ray,k,context,geomIDs,primIDs,scene));
+          intersectSurfaces<false>(ray,k,context,prim,scene);
+        }
+
+        static __forceinline void intersect(const vbool<K>& valid_i, Precalculations& pre, RayK<K>& ray, const RTCIntersectContext* context, const Primitive& prim, Scene* scene)
+        {
+          int mask = movemask(valid_i);
+          while (mask) intersect(pre,ray,__bscf(mask),context,prim,scene);
+        }
+
+        static __forceinline bool occluded(Precalculations& pre, RayK<K>& ray, const size_t k, const RTCIntersectContext* context, const Primitive& prim, Scene* scene)
+        {
+          STAT3(shadow.trav_prims,1,1,1);
+          const vint<M> geomIDs = vint<M>::loadu(prim.geomIDs);
+          const vint<M> primIDs = vint<M>::loadu(prim.primIDs);
+          const Vec3fa ray_org(ray.org.x[k],ray.org.y[k],ray.org.z[k]);
+          if (BezierMvIntersector<M>::template intersect<true>(ray_org,ray.tnear[k],ray.tfar[k],pre.ray_space[k],pre.depth_scale[k],prim,
+                                                Occluded1KEpilogM<M,M,K,filter>(ray,k,context,geomIDs,primIDs,scene)))
+            return true;
+          return intersectSurfaces<true>(ray,k,context,prim,scene);
+        }
+
+        static __forceinline vbool<K> occluded(const vbool<K>& valid_i, Precalculations& pre, RayK<K>& ray, const RTCIntersectContext* context, const Primitive& prim, Scene* scene)
+        {
+          vbool<K> valid_o = false;
+          int mask = movemask(valid_i);
+          while (mask) {
+            size_t k = __bscf(mask);
+            if (occluded(pre,ray,k,context,prim,scene))
+              set(valid_o, k);
+          }
+          return valid_o;
+        }
+      };
+  }
+}
@@ -96,16 +96,18 @@ namespace embree
             return;
           }
 #endif
-          ray.u[k]      = u;
-          ray.v[k]      = v;
-          //ray.u[k]    = uvw[0] * rcpDet;
-          //ray.v[k]    = uvw[1] * rcpDet;
           ray.tfar[k]   = t;
-          ray.Ng.x[k]   = Ng.x;
-          ray.Ng.y[k]   = Ng.y;
-          ray.Ng.z[k]   = Ng.z;
           ray.geomID[k] = prim.grid.geomID;
           ray.primID[k] = prim.grid.primID;
+          if (likely(!isDistanceOnly(context))) {
+            ray.u[k]      = u;
+            ray.v[k]      = v;
+            //ray.u[k]    = uvw[0] * rcpDet;
+            //ray.v[k]    = uvw[1] * rcpDet;
+            ray.Ng.x[k]   = Ng.x;
+            ray.Ng.y[k]   = Ng.y;
+            ray.Ng.z[k]   = Ng.z;
+          }
         }
       }
 
@@ -86,14 +86,16 @@ namespace embree
             return;
           }
 #endif
-          ray.u    = u;
-          ray.v    = v;
-          //ray.u    = uvw[0] * rcpDet;
-          //ray.v    = uvw[1] * rcpDet;
           ray.tfar = t;
-          ray.Ng   = Ng;
           ray.geomID  = prim.grid.geomID;
           ray.primID  = prim.grid.primID;
+          if (likely(!isDistanceOnly(context))) {
+            ray.u    = u;
+            ray.v    = v;
+            //ray.u    = uvw[0] * rcpDet;
+            //ray.v    = uvw[1] * rcpDet;
+            ray.Ng   = Ng;
+          }
         }
       }
       
@@ -64,12 +64,14 @@ namespace embree
 #endif
           
           /* update hit information */
-          ray.u = hit.u;
-          ray.v = hit.v;
           ray.tfar = hit.t;
-          ray.Ng = hit.Ng;
           ray.geomID = instID;
           ray.primID = primID;
+          if (likely(!isDistanceOnly(context))) {
+            ray.u = hit.u;
+            ray.v = hit.v;
+            ray.Ng = hit.Ng;
+          }
           return true;
         }
       };
@@ -147,14 +149,16 @@ namespace embree
 #endif
           
           /* update hit information */
-          ray.u[k] = hit.u;
-          ray.v[k] = hit.v;
           ray.tfar[k] = hit.t;
-          ray.Ng.x[k] = hit.Ng.x;
-          ray.Ng.y[k] = hit.Ng.y;
-          ray.Ng.z[k] = hit.Ng.z;
           ray.geomID[k] = geomID;
           ray.primID[k] = primID;
+          if (likely(!isDistanceOnly(context))) {
+            ray.u[k] = hit.u;
+            ray.v[k] = hit.v;
+            ray.Ng.x[k] = hit.Ng.x;
+            ray.Ng.y[k] = hit.Ng.y;
+            ray.Ng.z[k] = hit.Ng.z;
+          }
           return true;
         }
       };
@@ -264,15 +268,17 @@ namespace embree
 #endif
 
           /* update hit information */
-          const Vec2f uv = hit.uv(i);
-          ray.u = uv.x;
-          ray.v = uv.y;
           ray.tfar = hit.vt[i];
-          ray.Ng.x = hit.vNg.x[i];
-          ray.Ng.y = hit.vNg.y[i];
-          ray.Ng.z = hit.vNg.z[i];
           ray.geomID = instID;
           ray.primID = primIDs[i];
+          if (likely(!isDistanceOnly(context))) {
+            const Vec2f uv = hit.uv(i);
+            ray.u = uv.x;
+            ray.v = uv.y;
+            ray.Ng.x = hit.vNg.x[i];
+            ray.Ng.y = hit.vNg.y[i];
+            ray.Ng.z = hit.vNg.z[i];
+          }
           return true;
 
         }
@@ -346,6 +352,12 @@ namespace embree
           }
 #endif
 
+          if (unlikely(isDistanceOnly(context))) {
+            ray.tfar = hit.vt[i];
+            ray.geomID = instID;
+            ray.primID = primIDs[i];
+            return true;
+          }
           vbool<Mx> finalMask(((unsigned int)1 << i));
           ray.update(finalMask,hit.vt,hit.vu,hit.vv,hit.vNg.x,hit.vNg.y,hit.vNg.z,instID,primIDs);
           return true;
@@ -474,16 +486,18 @@ namespace embree
 #endif
           
           /* update hit information */
-          const Vec2f uv = hit.uv(i);
-          ray.u = uv.x;
-          ray.v = uv.y;
           ray.tfar = hit.vt[i];
-          const Vec3fa Ng = hit.Ng(i);
-          ray.Ng.x = Ng.x;
-          ray.Ng.y = Ng.y;
-          ray.Ng.z = Ng.z;
           ray.geomID = geomID;
           ray.primID = primID;
+          if (likely(!isDistanceOnly(context))) {
+            const Vec2f uv = hit.uv(i);
+            ray.u = uv.x;
+            ray.v = uv.y;
+            const Vec3fa Ng = hit.Ng(i);
+            ray.Ng.x = Ng.x;
+            ray.Ng.y = Ng.y;
+            ray.Ng.z = Ng.z;
+          }
           return true;
         }
       };
@@ -579,14 +593,16 @@ namespace embree
 #endif
           
           /* update hit information */
-          vfloat<K>::store(valid,&ray.u,u);
-          vfloat<K>::store(valid,&ray.v,v);
           vfloat<K>::store(valid,&ray.tfar,t);
           vint<K>::store(valid,&ray.geomID,geomID);
           vint<K>::store(valid,&ray.primID,primID);
-          vfloat<K>::store(valid,&ray.Ng.x,Ng.x);
-          vfloat<K>::store(valid,&ray.Ng.y,Ng.y);
-          vfloat<K>::store(valid,&ray.Ng.z,Ng.z);
+          if (likely(!isDistanceOnly(context))) {
+            vfloat<K>::store(valid,&ray.u,u);
+            vfloat<K>::store(valid,&ray.v,v);
+            vfloat<K>::store(valid,&ray.Ng.x,Ng.x);
+            vfloat<K>::store(valid,&ray.Ng.y,Ng.y);
+            vfloat<K>::store(valid,&ray.Ng.z,Ng.z);
+          }
           return valid;
         }
       };
@@ -686,14 +702,16 @@ namespace embree
 #endif
           
           /* update hit information */
-          vfloat<K>::store(valid,&ray.u,u);
-          vfloat<K>::store(valid,&ray.v,v);
           vfloat<K>::store(valid,&ray.tfar,t);
           vint<K>::store(valid,&ray.geomID,geomID);
           vint<K>::store(valid,&ray.primID,primID);
-          vfloat<K>::store(valid,&ray.Ng.x,Ng.x);
-          vfloat<K>::store(valid,&ray.Ng.y,Ng.y);
-          vfloat<K>::store(valid,&ray.Ng.z,Ng.z);
+          if (likely(!isDistanceOnly(context))) {
+            vfloat<K>::store(valid,&ray.u,u);
+            vfloat<K>::store(valid,&ray.v,v);
+            vfloat<K>::store(valid,&ray.Ng.x,Ng.x);
+            vfloat<K>::store(valid,&ray.Ng.y,Ng.y);
+            vfloat<K>::store(valid,&ray.Ng.z,Ng.z);
+          }
           return valid;
         }
       };
@@ -815,17 +833,25 @@ namespace embree
           assert(i<M);
           /* update hit information */
 #if defined(__AVX512F__)
+          if (unlikely(isDistanceOnly(context))) {
+            ray.tfar[k] = hit.vt[i];
+            ray.geomID[k] = geomID;
+            ray.primID[k] = primIDs[i];
+            return true;
+          }
           ray.updateK(i,k,hit.vt,hit.vu,hit.vv,vfloat<Mx>(hit.vNg.x),vfloat<Mx>(hit.vNg.y),vfloat<Mx>(hit.vNg.z),geomID,vint<Mx>(primIDs));
 #else
-          const Vec2f uv = hit.uv(i);
-          ray.u[k] = uv.x;
-          ray.v[k] = uv.y;
           ray.tfar[k] = hit.vt[i];
-          ray.Ng.x[k] = hit.vNg.x[i];
-          ray.Ng.y[k] = hit.vNg.y[i];
-          ray.Ng.z[k] = hit.vNg.z[i];
           ray.geomID[k] = geomID;
           ray.primID[k] = primIDs[i];
+          if (likely(!isDistanceOnly(context))) {
+            const Vec2f uv = hit.uv(i);
+            ray.u[k] = uv.x;
+            ray.v[k] = uv.y;
+            ray.Ng.x[k] = hit.vNg.x[i];
+            ray.Ng.y[k] = hit.vNg.y[i];
+            ray.Ng.z[k] = hit.vNg.z[i];
+          }
 #endif
           return true;
         }
@@ -950,19 +976,27 @@ namespace embree
           
           /* update hit information */
 #if defined(__AVX512F__)
+          if (unlikely(isDistanceOnly(context))) {
+            ray.tfar[k] = hit.vt[i];
+            ray.geomID[k] = geomID;
+            ray.primID[k] = primID;
+            return true;
+          }
           const Vec3fa Ng = hit.Ng(i);
           ray.updateK(i,k,hit.vt,hit.vu,hit.vv,vfloat<M>(Ng.x),vfloat<M>(Ng.y),vfloat<M>(Ng.z),geomID,vint<M>(primID));
 #else
-          const Vec2f uv = hit.uv(i);
-          ray.u[k] = uv.x;
-          ray.v[k] = uv.y;
           ray.tfar[k] = hit.vt[i];
-          const Vec3fa Ng = hit.Ng(i);
-          ray.Ng.x[k] = Ng.x;
-          ray.Ng.y[k] = Ng.y;
-          ray.Ng.z[k] = Ng.z;
           ray.geomID[k] = geomID;
           ray.primID[k] = primID;
+          if (likely(!isDistanceOnly(context))) {
+            const Vec2f uv = hit.uv(i);
+            ray.u[k] = uv.x;
+            ray.v[k] = uv.y;
+            const Vec3fa Ng = hit.Ng(i);
+            ray.Ng.x[k] = Ng.x;
+            ray.Ng.y[k] = Ng.y;
+            ray.Ng.z[k] = Ng.z;
+          }
 #endif
           return true;
         }
@@ -40,14 +40,16 @@ namespace embree
   public:
 
     /*! constructs a virtual object */
-    Object (unsigned geomID, unsigned primID) 
-    : geomID(geomID), primID(primID) {}
+    Object (unsigned geomID, unsigned primID, unsigned mask) 
+    : geomID(geomID), primID(primID), mask(mask) {}
 
     /*! fill triangle from triangle list */
     __forceinline void fill(const PrimRef* prims, size_t& i, size_t end, Scene* scene, const bool list)
     {
       const PrimRef& prim = prims[i]; i++;
-      new (this) Object(prim.geomID(), prim.primID());
+      const unsigned geomID = prim.geomID();
+      AccelSet* accel = (AccelSet*) scene->get(geomID);
+      new (this) Object(geomID, prim.primID(), accel->mask);
     }
 
     /*! fill triangle from triangle list */
@@ -56,13 +58,14 @@ namespace embree
       const PrimRef& prim = prims[i]; i++;
       const unsigned geomID = prim.geomID();
       const unsigned primID = prim.primID();
-      new (this) Object(geomID, primID);
       AccelSet* accel = (AccelSet*) scene->get(geomID);
+      new (this) Object(geomID, primID, accel->mask);
       return accel->bounds_mblur(primID);
     }
 
   public:
     unsigned geomID;  //!< geometry ID
     unsigned primID;  //!< primitive ID
+    unsigned mask;    //!< copy of the geometry mask, allows culling masked out instances without touching the geometry
   };
 }
@@ -45,13 +45,13 @@ namespace embree
     {
       AVX_ZERO_UPPER();
       vbool4 valid = valid_i;
-      AccelSet* accel = (AccelSet*) scene->get(prim.geomID);
 
-      /* perform ray mask test */
+      /* perform ray mask test before touching the geometry */
 #if defined(EMBREE_RAY_MASK)
-      valid &= (ray.mask & accel->mask) != 0;
+      valid &= (ray.mask & prim.mask) != 0;
       if (none(valid)) return;
 #endif
+      AccelSet* accel = (AccelSet*) scene->get(prim.geomID);
       accel->intersect4(valid,(RTCRay4&)ray,prim.primID,context);
     }
 
@@ -60,13 +60,13 @@ namespace embree
     {
       AVX_ZERO_UPPER();
       vbool4 valid = valid_i;
-      AccelSet* accel = (AccelSet*) scene->get(prim.geomID);
 
-      /* perform ray mask test */
+      /* perform ray mask test before touching the geometry */
 #if defined(EMBREE_RAY_MASK)
-      valid &= (ray.mask & accel->mask) != 0;
+      valid &= (ray.mask & prim.mask) != 0;
       if (none(valid)) return false;
 #endif
+      AccelSet* accel = (AccelSet*) scene->get(prim.geomID);
       accel->occluded4(valid,(RTCRay4&)ray,prim.primID,context);
       return ray.geomID == 0;
     }
@@ -76,13 +76,13 @@ namespace embree
     __forceinline void ObjectIntersector8::intersect(const vbool8& valid_i, const Precalculations& pre, Ray8& ray, const RTCIntersectContext* context, const Primitive& prim, Scene* scene)
     {
       vbool8 valid = valid_i;
-      AccelSet* accel = (AccelSet*) scene->get(prim.geomID);
 
-      /* perform ray mask test */
+      /* perform ray mask test before touching the geometry */
 #if defined(EMBREE_RAY_MASK)
-      valid &= (ray.mask & accel->mask) != 0;
+      valid &= (ray.mask & prim.mask) != 0;
       if (none(valid)) return;
 #endif
+      AccelSet* accel = (AccelSet*) scene->get(prim.geomID);
       accel->intersect8(valid,(RTCRay8&)ray,prim.primID,context);
     }
 
@@ -90,13 +90,13 @@ namespace embree
     __forceinline vbool8 ObjectIntersector8::occluded(const vbool8& valid_i, const Precalculations& pre, const Ray8& ray, const RTCIntersectContext* context, const Primitive& prim, Scene* scene)
     {
       vbool8 valid = valid_i;
-      AccelSet* accel = (AccelSet*) scene->get(prim.geomID);
 
-      /* perform ray mask test */
+      /* perform ray mask test before touching the geometry */
 #if defined(EMBREE_RAY_MASK)
-      valid &= (ray.mask & accel->mask) != 0;
+      valid &= (ray.mask & prim.mask) != 0;
       if (none(valid)) return false;
 #endif
+      AccelSet* accel = (AccelSet*) scene->get(prim.geomID);
       accel->occluded8(valid,(RTCRay8&)ray,prim.primID,context);
       return ray.geomID == 0;
     }
@@ -107,13 +107,13 @@ namespace embree
     __forceinline void ObjectIntersector16::intersect(const vbool16& valid_i, const Precalculations& pre, Ray16& ray, const RTCIntersectContext* context, const Primitive& prim, Scene* scene)
     {
       vbool16 valid = valid_i;
-      AccelSet* accel = (AccelSet*) scene->get(prim.geomID);
 
-      /* perform ray mask test */
+      /* perform ray mask test before touching the geometry */
 #if defined(EMBREE_RAY_MASK)
-      valid &= (ray.mask & accel->mask) != 0;
+      valid &= (ray.mask & prim.mask) != 0;
       if (none(valid)) return;
 #endif
+      AccelSet* accel = (AccelSet*) scene->get(prim.geomID);
       accel->intersect16(valid,(RTCRay16&)ray,prim.primID,context);
     }
 
@@ -121,13 +121,13 @@ namespace embree
     __forceinline vbool16 ObjectIntersector16::occluded(const vbool16& valid_i, const Precalculations& pre, const Ray16& ray, const RTCIntersectContext* context, const Primitive& prim, Scene* scene)
     {
       vbool16 valid = valid_i;
-      AccelSet* accel = (AccelSet*) scene->get(prim.geomID);
 
-      /* perform ray mask test */
+      /* perform ray mask test before touching the geometry */
 #if defined(EMBREE_RAY_MASK)
-      valid &= (ray.mask & accel->mask) != 0;
+      valid &= (ray.mask & prim.mask) != 0;
       if (none(valid)) return false;
 #endif
+      AccelSet* accel = (AccelSet*) scene->get(prim.geomID);
       accel->occluded16(valid,(RTCRay16&)ray,prim.primID,context);
       return ray.geomID == 0;
     }
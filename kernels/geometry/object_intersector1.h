@@ -37,13 +37,13 @@ namespace embree
       static __forceinline void intersect(const Precalculations& pre, Ray& ray, const RTCIntersectContext* context, const Primitive& prim, Scene* scene, const unsigned* geomID_to_instID) 
       {
         AVX_ZERO_UPPER();
-        AccelSet* accel = (AccelSet*) scene->get(prim.geomID);
 
-        /* perform ray mask test */
+        /* perform ray mask test before touching the geometry */
 #if defined(EMBREE_RAY_MASK)
-        if ((ray.mask & accel->mask) == 0) 
+        if ((ray.mask & prim.mask) == 0) 
           return;
 #endif
+        AccelSet* accel = (AccelSet*) scene->get(prim.geomID);
 
         accel->intersect((RTCRay&)ray,prim.primID,context);
       }
@@ -51,13 +51,13 @@ namespace embree
       static __forceinline bool occluded(const Precalculations& pre, Ray& ray, const RTCIntersectContext* context, const Primitive& prim, Scene* scene, const unsigned* geomID_to_instID) 
       {
         AVX_ZERO_UPPER();
-        AccelSet* accel = (AccelSet*) scene->get(prim.geomID);
 
-        /* perform ray mask test */
+        /* perform ray mask test before touching the geometry */
 #if defined(EMBREE_RAY_MASK)
-        if ((ray.mask & accel->mask) == 0) 
+        if ((ray.mask & prim.mask) == 0) 
           return false;
 #endif
+        AccelSet* accel = (AccelSet*) scene->get(prim.geomID);
 
         accel->occluded((RTCRay&)ray,prim.primID,context);
         return ray.geomID == 0;
@@ -83,7 +83,7 @@ namespace embree
 
             /* perform ray mask test */
 #if defined(EMBREE_RAY_MASK)
-            if ((ray->mask & accel->mask) == 0) 
+            if ((ray->mask & prim.mask) == 0) 
               continue;
 #endif
             rays_filtered[N++] = ray;
@@ -124,7 +124,7 @@ namespace embree
 
             /* perform ray mask test */
 #if defined(EMBREE_RAY_MASK)
-            if ((ray->mask & accel->mask) == 0) 
+            if ((ray->mask & prim.mask) == 0) 
               continue;
 #endif
             rays_filtered[N] = ray;
@@ -160,5 +160,73 @@ namespace embree
         }
 
     };
+
+    /*! Intersects a single ray with all objects of a leaf. Consecutive
+     *  items of a user geometry with a leaf intersect function are
+     *  passed to that function at once, all other items are
+     *  intersected one by one. */
+    struct ObjectArrayIntersector1
+    {
+      typedef Object Primitive;
+      typedef ObjectIntersector1::Precalculations Precalculations;
+
+      static const bool validChunkIntersector = false;
+
+      /* maximal number of items passed to a single leaf function call */
+      static const size_t MAX_LEAF_ITEMS = 32;
+
+      static __forceinline void intersect(Precalculations& pre, Ray& ray, const RTCIntersectContext* context, size_t ty, const Primitive* prim, size_t num, Scene* scene, const unsigned* geomID_to_instID, size_t& lazy_node)
+      {
+        for (size_t i=0; i<num; )
+        {
+          /* skip masked out objects without touching the geometry */
+#if defined(EMBREE_RAY_MASK)
+          if ((ray.mask & prim[i].mask) == 0) {
+            i++; continue;
+          }
+#endif
+          AccelSet* accel = (AccelSet*) scene->get(prim[i].geomID);
+          if (likely(!accel->intersectors.intersectorLeaf.intersect)) {
+            ObjectIntersector1::intersect(pre,ray,context,prim[i++],scene,geomID_to_instID);
+            continue;
+          }
+
+          unsigned items[MAX_LEAF_ITEMS]; size_t N = 0;
+          for (; i<num && N<MAX_LEAF_ITEMS && prim[i].geomID == accel->id; i++)
+            items[N++] = prim[i].primID;
+
+          AVX_ZERO_UPPER();
+          accel->intersectLeaf((RTCRay&)ray,items,N,context);
+        }
+      }
+
+      static __forceinline bool occluded(Precalculations& pre, Ray& ray, const RTCIntersectContext* context, size_t ty, const Primitive* prim, size_t num, Scene* scene, const unsigned* geomID_to_instID, size_t& lazy_node) 
+      {
+        for (size_t i=0; i<num; )
+        {
+          /* skip masked out objects without touching the geometry */
+#if defined(EMBREE_RAY_MASK)
+          if ((ray.mask & prim[i].mask) == 0) {
+            i++; continue;
+          }
+#endif
+          AccelSet* accel = (AccelSet*) scene->get(prim[i].geomID);
+          if (likely(!accel->intersectors.intersectorLeaf.occluded)) {
+            if (ObjectIntersector1::occluded(pre,ray,context,prim[i++],scene,geomID_to_instID))
+              return true;
+            continue;
+          }
+
+          unsigned items[MAX_LEAF_ITEMS]; size_t N = 0;
+          for (; i<num && N<MAX_LEAF_ITEMS && prim[i].geomID == accel->id; i++)
+            items[N++] = prim[i].primID;
+
+          AVX_ZERO_UPPER();
+          accel->occludedLeaf((RTCRay&)ray,items,N,context);
+          if (ray.geomID == 0) return true;
+        }
+        return false;
+      }
+    };
   }
 }
@@ -0,0 +1,171 @@
+// ======================================================================== //
+// Copyright 2009-2016 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+#include "../common/ray.h"
+#include "filter.h"
+
+namespace embree
+{
+  namespace isa
+  {
+    template<int M>
+      struct PointIntersectorHitM
+      {
+        __forceinline PointIntersectorHitM() {}
+
+        __forceinline PointIntersectorHitM(const vfloat<M>& t, const Vec3<vfloat<M>>& Ng)
+          : vu(zero), vv(zero), vt(t), vNg(Ng) {}
+
+        __forceinline void finalize() {}
+
+        __forceinline Vec2f uv (const size_t i) const { return Vec2f(vu[i],vv[i]); }
+        __forceinline float t  (const size_t i) const { return vt[i]; }
+        __forceinline Vec3fa Ng(const size_t i) const { return Vec3fa(vNg.x[i],vNg.y[i],vNg.z[i]); }
+
+      public:
+        vfloat<M> vu;
+        vfloat<M> vv;
+        vfloat<M> vt;
+        Vec3<vfloat<M>> vNg;
+      };
+
+    /*! Intersects M spheres and M ray facing discs with a ray. Both
+     *  shapes start from the point of closest approach of the ray to
+     *  the center, which keeps the quadratic of the sphere test well
+     *  conditioned for small radii far away from the ray origin. */
+    template<int M>
+      struct PointIntersector
+      {
+        typedef Vec3<vfloat<M>> Vec3vfM;
+        typedef Vec4<vfloat<M>> Vec4vfM;
+
+        /* returns the hit distance of the closest approach and the squared distance of the center to the ray */
+        static __forceinline void closest(const Vec3vfM& ray_org, const Vec3vfM& ray_dir, const vfloat<M>& rcp_dir2, const Vec4vfM& v,
+                                          vfloat<M>& tc, vfloat<M>& dist2)
+        {
+          const Vec3vfM o = v.xyz()-ray_org;
+          tc = dot(o,ray_dir)*rcp_dir2;
+          const Vec3vfM l = o-tc*ray_dir;
+          dist2 = dot(l,l);
+        }
+
+        template<typename Epilog>
+        static __forceinline bool intersectSpheres(const Vec3vfM& ray_org, const Vec3vfM& ray_dir, const vfloat<M>& ray_tnear, const vfloat<M>& ray_tfar,
+                                                   const vfloat<M>& rcp_dir2, const vbool<M>& valid_i, const Vec4vfM& v, const Epilog& epilog)
+        {
+          vfloat<M> tc, dist2; closest(ray_org,ray_dir,rcp_dir2,v,tc,dist2);
+          const vfloat<M> r2 = v.w*v.w;
+          vbool<M> valid = valid_i & (dist2 <= r2);
+          if (unlikely(none(valid))) return false;
+
+          /* take the entry point if it lies inside the ray segment, the exit point otherwise */
+          const vfloat<M> th = sqrt(max(r2-dist2,vfloat<M>(zero))*rcp_dir2);
+          const vfloat<M> t0 = tc-th;
+          const vfloat<M> t1 = tc+th;
+          const vbool<M> valid0 = (ray_tnear < t0) & (t0 < ray_tfar);
+          const vbool<M> valid1 = (ray_tnear < t1) & (t1 < ray_tfar);
+          valid &= valid0 | valid1;
+          if (unlikely(none(valid))) return false;
+
+          const vfloat<M> t = select(valid0,t0,t1);
+          const Vec3vfM Ng = ray_org+t*ray_dir-v.xyz();
+          PointIntersectorHitM<M> hit(t,Ng);
+          return epilog(valid,hit);
+        }
+
+        template<typename Epilog>
+        static __forceinline bool intersectDiscs(const Vec3vfM& ray_org, const Vec3vfM& ray_dir, const vfloat<M>& ray_tnear, const vfloat<M>& ray_tfar,
+                                                 const vfloat<M>& rcp_dir2, const vbool<M>& valid_i, const Vec4vfM& v, const Epilog& epilog)
+        {
+          vfloat<M> tc, dist2; closest(ray_org,ray_dir,rcp_dir2,v,tc,dist2);
+          const vbool<M> valid = valid_i & (dist2 <= v.w*v.w) & (ray_tnear < tc) & (tc < ray_tfar);
+          if (unlikely(none(valid))) return false;
+
+          /* the disc always faces the ray */
+          PointIntersectorHitM<M> hit(tc,-ray_dir);
+          return epilog(valid,hit);
+        }
+      };
+
+    template<int M>
+      struct PointIntersector1
+      {
+        typedef Vec3<vfloat<M>> Vec3vfM;
+        typedef Vec4<vfloat<M>> Vec4vfM;
+
+        struct Precalculations
+        {
+          __forceinline Precalculations () {}
+
+          __forceinline Precalculations (const Ray& ray, const void* ptr)
+            : rcp_dir2(rcp(dot(ray.dir,ray.dir))) {}
+
+          float rcp_dir2;
+        };
+
+        template<typename Epilog>
+        static __forceinline bool intersect(Ray& ray, const Precalculations& pre,
+                                            const vbool<M>& valid, const Vec4vfM& v, const vbool<M>& discs,
+                                            const Epilog& epilog)
+        {
+          const Vec3vfM ray_org(ray.org);
+          const Vec3vfM ray_dir(ray.dir);
+          bool ishit = false;
+          const vbool<M> valid_spheres = valid & !discs;
+          if (any(valid_spheres))
+            ishit |= PointIntersector<M>::intersectSpheres(ray_org,ray_dir,vfloat<M>(ray.tnear),vfloat<M>(ray.tfar),vfloat<M>(pre.rcp_dir2),valid_spheres,v,epilog);
+          const vbool<M> valid_discs = valid & discs;
+          if (any(valid_discs))
+            ishit |= PointIntersector<M>::intersectDiscs(ray_org,ray_dir,vfloat<M>(ray.tnear),vfloat<M>(ray.tfar),vfloat<M>(pre.rcp_dir2),valid_discs,v,epilog);
+          return ishit;
+        }
+      };
+
+    template<int M, int K>
+      struct PointIntersectorK
+      {
+        typedef Vec3<vfloat<M>> Vec3vfM;
+        typedef Vec4<vfloat<M>> Vec4vfM;
+
+        struct Precalculations
+        {
+          __forceinline Precalculations (const vbool<K>& valid, const RayK<K>& ray)
+            : rcp_dir2(rcp(dot(ray.dir,ray.dir))) {}
+
+          vfloat<K> rcp_dir2;
+        };
+
+        template<typename Epilog>
+        static __forceinline bool intersect(RayK<K>& ray, size_t k, const Precalculations& pre,
+                                            const vbool<M>& valid, const Vec4vfM& v, const vbool<M>& discs,
+                                            const Epilog& epilog)
+        {
+          const Vec3vfM ray_org(ray.org.x[k],ray.org.y[k],ray.org.z[k]);
+          const Vec3vfM ray_dir(ray.dir.x[k],ray.dir.y[k],ray.dir.z[k]);
+          bool ishit = false;
+          const vbool<M> valid_spheres = valid & !discs;
+          if (any(valid_spheres))
+            ishit |= PointIntersector<M>::intersectSpheres(ray_org,ray_dir,vfloat<M>(ray.tnear[k]),vfloat<M>(ray.tfar[k]),vfloat<M>(pre.rcp_dir2[k]),valid_spheres,v,epilog);
+          const vbool<M> valid_discs = valid & discs;
+          if (any(valid_discs))
+            ishit |= PointIntersector<M>::intersectDiscs(ray_org,ray_dir,vfloat<M>(ray.tnear[k]),vfloat<M>(ray.tfar[k]),vfloat<M>(pre.rcp_dir2[k]),valid_discs,v,epilog);
+          return ishit;
+        }
+      };
+  }
+}
@@ -0,0 +1,217 @@
+// ======================================================================== //
+// Copyright 2009-2016 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+#include "primitive.h"
+
+namespace embree
+{
+  /* Stores M points by reference, the primitive ID is the index of
+   * the point's vertex. Spheres and discs share this leaf type, the
+   * shape of each lane is determined by the geometry subtype. */
+  template <int M>
+  struct PointMi
+  {
+    /* Virtual interface to query information about the point type */
+    struct Type : public PrimitiveType
+    {
+      Type();
+      size_t size(const char* This) const;
+    };
+    static Type type;
+
+  public:
+
+    /* Returns maximal number of stored points */
+    static __forceinline size_t max_size() { return M; }
+
+    /* Returns required number of primitive blocks for N points */
+    static __forceinline size_t blocks(size_t N) { return (N+max_size()-1)/max_size(); }
+
+  public:
+
+    /* Default constructor */
+    __forceinline PointMi() {  }
+
+    /* Construction from IDs */
+    __forceinline PointMi(const vint<M>& geomIDs, const vint<M>& primIDs)
+      : geomIDs(geomIDs), primIDs(primIDs) {}
+
+    /* Returns a mask that tells which points are valid */
+    __forceinline vbool<M> valid() const { return primIDs != vint<M>(-1); }
+
+    /* Returns if the specified point is valid */
+    __forceinline bool valid(const size_t i) const { assert(i<M); return primIDs[i] != -1; }
+
+    /* Returns the number of stored points */
+    __forceinline size_t size() const { return __bsf(~movemask(valid())); }
+
+    /* Returns the geometry IDs */
+    __forceinline vint<M> geomID() const { return geomIDs; }
+    __forceinline int geomID(const size_t i) const { assert(i<M); return geomIDs[i]; }
+
+    /* Returns the primitive IDs */
+    __forceinline vint<M> primID() const { return primIDs; }
+    __forceinline int primID(const size_t i) const { assert(i<M); return primIDs[i]; }
+
+    /* gather the points and the mask of lanes that are discs */
+    __forceinline void gather(Vec4<vfloat<M>>& p, vbool<M>& discs, const Scene* scene, size_t j = 0) const;
+    __forceinline void gather(Vec4<vfloat<M>>& p, vbool<M>& discs, const Scene* scene, float t) const;
+
+    /* Calculate the bounds of the points */
+    __forceinline const BBox3fa bounds(const Scene* scene, size_t j = 0) const
+    {
+      BBox3fa bounds = empty;
+      for (size_t i=0; i<M && valid(i); i++)
+      {
+        const Points* geom = scene->getPoints(geomID(i));
+        bounds.extend(geom->bounds(primID(i),j));
+      }
+      return bounds;
+    }
+
+    /* Calculate the bounds of the points at t0 */
+    __forceinline BBox3fa bounds0(const Scene* scene) const
+    {
+      return bounds(scene,0);
+    }
+
+    /* Calculate the bounds of the points at t1 */
+    __forceinline BBox3fa bounds1(const Scene* scene) const
+    {
+      return bounds(scene,1);
+    }
+
+    /* Calculate primitive bounds */
+    __forceinline std::pair<BBox3fa,BBox3fa> bounds(const Scene* scene)
+    {
+      return std::make_pair(bounds0(scene), bounds1(scene));
+    }
+
+    /* Fill points from point list */
+    __forceinline void fill(atomic_set<PrimRefBlock>::block_iterator_unsafe& prims, Scene* scene, const bool list)
+    {
+      vint<M> geomID = -1, primID = -1;
+      PrimRef& prim = *prims;
+
+      for (size_t i=0; i<M; i++)
+      {
+        if (prims) {
+          geomID[i] = prim.geomID();
+          primID[i] = prim.primID();
+          prims++;
+        } else {
+          assert(i);
+          if (i>0) {
+            geomID[i] = geomID[i-1];
+            primID[i] = -1;
+          }
+        }
+        if (prims) prim = *prims;
+      }
+
+      new (this) PointMi(geomID,primID); // FIXME: use non temporal store
+    }
+
+    /* Fill points from point list */
+    __forceinline void fill(const PrimRef* prims, size_t& begin, size_t end, Scene* scene, const bool list)
+    {
+      vint<M> geomID = -1, primID = -1;
+      const PrimRef* prim = &prims[begin];
+
+      for (size_t i=0; i<M; i++)
+      {
+        if (begin<end) {
+          geomID[i] = prim->geomID();
+          primID[i] = prim->primID();
+          begin++;
+        } else {
+          assert(i);
+          if (i>0) {
+            geomID[i] = geomID[i-1];
+            primID[i] = -1;
+          }
+        }
+        if (begin<end) prim = &prims[begin];
+      }
+
+      new (this) PointMi(geomID,primID); // FIXME: use non temporal store
+    }
+
+    /* Fill points from point list */
+    __forceinline std::pair<BBox3fa,BBox3fa> fill_mblur(const PrimRef* prims, size_t& begin, size_t end, Scene* scene, const bool list)
+    {
+      fill(prims,begin,end,scene,list);
+      return bounds(scene);
+    }
+
+    /* Updates the primitive */
+    __forceinline BBox3fa update(Points* geom)
+    {
+      BBox3fa bounds = empty;
+      for (size_t i=0; i<M && valid(i); i++)
+        bounds.extend(geom->bounds(primID(i)));
+      return bounds;
+    }
+
+    /*! output operator */
+    friend __forceinline std::ostream& operator<<(std::ostream& cout, const PointMi& point) {
+      return cout << "Point" << M << "i {" << point.geomIDs << ", " << point.primIDs << "}";
+    }
+
+  public:
+    vint<M> geomIDs; // geometry ID
+    vint<M> primIDs; // primitive ID, which is also the vertex index
+  };
+
+  template<>
+  __forceinline void PointMi<4>::gather(Vec4vf4& p, vbool4& discs, const Scene* scene, size_t j) const
+  {
+    const Points* geom0 = scene->getPoints(geomIDs[0]);
+    const Points* geom1 = scene->getPoints(geomIDs[1]);
+    const Points* geom2 = scene->getPoints(geomIDs[2]);
+    const Points* geom3 = scene->getPoints(geomIDs[3]);
+
+    /* invalid lanes replicate the geometry of the last valid lane, thus they also use its vertex index */
+    const vbool4 vld = valid();
+    const vint4 v = select(vld,primIDs,vint4(primIDs[__bsr(movemask(vld))]));
+    const vfloat4 a0 = vfloat4::loadu(geom0->vertexPtr(v[0],j));
+    const vfloat4 a1 = vfloat4::loadu(geom1->vertexPtr(v[1],j));
+    const vfloat4 a2 = vfloat4::loadu(geom2->vertexPtr(v[2],j));
+    const vfloat4 a3 = vfloat4::loadu(geom3->vertexPtr(v[3],j));
+
+    transpose(a0,a1,a2,a3,p.x,p.y,p.z,p.w);
+
+    discs = vbool4(geom0->subtype == Points::DISC,geom1->subtype == Points::DISC,
+                   geom2->subtype == Points::DISC,geom3->subtype == Points::DISC);
+  }
+
+  template<>
+  __forceinline void PointMi<4>::gather(Vec4vf4& p, vbool4& discs, const Scene* scene, float t) const
+  {
+    const vfloat4 t0 = 1.0f - t;
+    const vfloat4 t1 = t;
+    Vec4vf4 a; gather(a,discs,scene,(size_t)0);
+    Vec4vf4 b; gather(b,discs,scene,(size_t)1);
+    p = t0 * a + t1 * b;
+  }
+
+  template<int M>
+  typename PointMi<M>::Type PointMi<M>::type;
+
+  typedef PointMi<4> Point4i;
+}
@@ -17,10 +17,13 @@
 #include "primitive.h"
 #include "bezier1v.h"
 #include "bezier1i.h"
+#include "bezierv.h"
 #include "linei.h"
+#include "pointi.h"
 #include "triangle.h"
 #include "trianglev.h"
 #include "trianglei.h"
+#include "trianglec.h"
 #include "trianglev_mb.h"
 #include "quadv.h"
 #include "quadi.h"
@@ -52,6 +55,28 @@ namespace embree
 
   Bezier1i::Type Bezier1i::type;
 
+  /********************** Bezier4v **************************/
+
+  template<>
+  Bezier4v::Type::Type ()
+    : PrimitiveType("bezier4v",sizeof(Bezier4v),4) {}
+
+  template<>
+  size_t Bezier4v::Type::size(const char* This) const {
+    return ((Bezier4v*)This)->size();
+  }
+
+  /********************** Bezier8v **************************/
+
+  template<>
+  Bezier8v::Type::Type ()
+    : PrimitiveType("bezier8v",sizeof(Bezier8v),8) {}
+
+  template<>
+  size_t Bezier8v::Type::size(const char* This) const {
+    return ((Bezier8v*)This)->size();
+  }
+
   /********************** Line4i **************************/
 
   template<>
@@ -62,6 +87,17 @@ namespace embree
   size_t Line4i::Type::size(const char* This) const {
     return ((Line4i*)This)->size();
   }
+
+  /********************** Point4i **************************/
+
+  template<>
+  Point4i::Type::Type ()
+    : PrimitiveType("point4i",sizeof(Point4i),4) {}
+
+  template<>
+  size_t Point4i::Type::size(const char* This) const {
+    return ((Point4i*)This)->size();
+  }
   
   /********************** Triangle4 **************************/
 
@@ -96,6 +132,17 @@ namespace embree
     return ((Triangle4i*)This)->size();
   }
 
+  /********************** Triangle4c **************************/
+
+  template<>
+  Triangle4c::Type::Type () 
+    : PrimitiveType("triangle4c",sizeof(Triangle4c),4) {} 
+
+  template<>
+  size_t Triangle4c::Type::size(const char* This) const {
+    return ((Triangle4c*)This)->size();
+  }
+
   /********************** Triangle4vMB **************************/
 
   template<>
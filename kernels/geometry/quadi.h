@@ -71,10 +71,20 @@ namespace embree
     __forceinline vint<M> primID() const { return primIDs; }
     __forceinline int primID(const size_t i) const { assert(i<M); return primIDs[i]; }
 
-    __forceinline Vec3fa& getVertex(const vint<M> &v, const size_t index, const Scene *const scene) const
+    /* float vertices get loaded directly, half and fixed point vertices get decoded through the mesh */
+    __forceinline Vec3fa getVertex(const vint<M> &v, const size_t index, const Scene *const scene) const
     {
       const QuadMesh* mesh = scene->getQuadMesh(geomID(index));
-      return *(Vec3fa*)mesh->vertexPtr(v[index]);
+      if (likely(mesh->vertices[0].getFormat() == RTC_VERTEX_FORMAT_FLOAT3))
+        return Vec3fa(vfloat4::loadu(mesh->vertexPtr(v[index])));
+      return mesh->vertex(v[index]);
+    }
+
+    /* tests if all stored quads have float vertices */
+    static __forceinline bool hasFloatVertices(const QuadMesh* mesh0, const QuadMesh* mesh1, const QuadMesh* mesh2, const QuadMesh* mesh3)
+    {
+      return mesh0->vertices[0].getFormat() == RTC_VERTEX_FORMAT_FLOAT3 && mesh1->vertices[0].getFormat() == RTC_VERTEX_FORMAT_FLOAT3 &&
+             mesh2->vertices[0].getFormat() == RTC_VERTEX_FORMAT_FLOAT3 && mesh3->vertices[0].getFormat() == RTC_VERTEX_FORMAT_FLOAT3;
     }
 
     /* gather the quads */
@@ -169,6 +179,20 @@ namespace embree
     const QuadMesh* mesh2 = scene->getQuadMesh(geomIDs[2]);
     const QuadMesh* mesh3 = scene->getQuadMesh(geomIDs[3]);
 
+    /* half and fixed point vertices get decoded through the mesh */
+    if (unlikely(!hasFloatVertices(mesh0,mesh1,mesh2,mesh3)))
+    {
+      const vfloat4 a0 = vfloat4(mesh0->vertex(v0[0])), a1 = vfloat4(mesh1->vertex(v0[1])), a2 = vfloat4(mesh2->vertex(v0[2])), a3 = vfloat4(mesh3->vertex(v0[3]));
+      const vfloat4 b0 = vfloat4(mesh0->vertex(v1[0])), b1 = vfloat4(mesh1->vertex(v1[1])), b2 = vfloat4(mesh2->vertex(v1[2])), b3 = vfloat4(mesh3->vertex(v1[3]));
+      const vfloat4 c0 = vfloat4(mesh0->vertex(v2[0])), c1 = vfloat4(mesh1->vertex(v2[1])), c2 = vfloat4(mesh2->vertex(v2[2])), c3 = vfloat4(mesh3->vertex(v2[3]));
+      const vfloat4 d0 = vfloat4(mesh0->vertex(v3[0])), d1 = vfloat4(mesh1->vertex(v3[1])), d2 = vfloat4(mesh2->vertex(v3[2])), d3 = vfloat4(mesh3->vertex(v3[3]));
+      transpose(a0,a1,a2,a3,p0.x,p0.y,p0.z);
+      transpose(b0,b1,b2,b3,p1.x,p1.y,p1.z);
+      transpose(c0,c1,c2,c3,p2.x,p2.y,p2.z);
+      transpose(d0,d1,d2,d3,p3.x,p3.y,p3.z);
+      return;
+    }
+
     const vfloat4 a0 = vfloat4::loadu(mesh0->vertexPtr(v0[0]));
     const vfloat4 a1 = vfloat4::loadu(mesh1->vertexPtr(v0[1]));
     const vfloat4 a2 = vfloat4::loadu(mesh2->vertexPtr(v0[2]));
@@ -214,31 +238,35 @@ namespace embree
     const QuadMesh* mesh3 = scene->getQuadMesh(geomIDs[3]);
 
     static const vint16 perm(0,4,8,12,1,5,9,13,2,6,10,14,3,7,11,15);
-    const vfloat4 &a0 = *(vfloat4*)(mesh0->vertexPtr(v0[0]));
-    const vfloat4 &a1 = *(vfloat4*)(mesh1->vertexPtr(v0[1]));
-    const vfloat4 &a2 = *(vfloat4*)(mesh2->vertexPtr(v0[2]));
-    const vfloat4 &a3 = *(vfloat4*)(mesh3->vertexPtr(v0[3]));
+    const bool fast = hasFloatVertices(mesh0,mesh1,mesh2,mesh3);
+    auto load = [&] (const QuadMesh* mesh, int i) -> vfloat4 { 
+      return likely(fast) ? vfloat4::loadu(mesh->vertexPtr(i)) : vfloat4(mesh->vertex(i)); 
+    };
+    const vfloat4 a0 = load(mesh0,v0[0]);
+    const vfloat4 a1 = load(mesh1,v0[1]);
+    const vfloat4 a2 = load(mesh2,v0[2]);
+    const vfloat4 a3 = load(mesh3,v0[3]);
 
     const vfloat16 _p0(permute(vfloat16(a0,a1,a2,a3),perm));
 
-    const vfloat4 &b0 = *(vfloat4*)(mesh0->vertexPtr(v1[0]));
-    const vfloat4 &b1 = *(vfloat4*)(mesh1->vertexPtr(v1[1]));
-    const vfloat4 &b2 = *(vfloat4*)(mesh2->vertexPtr(v1[2]));
-    const vfloat4 &b3 = *(vfloat4*)(mesh3->vertexPtr(v1[3]));
+    const vfloat4 b0 = load(mesh0,v1[0]);
+    const vfloat4 b1 = load(mesh1,v1[1]);
+    const vfloat4 b2 = load(mesh2,v1[2]);
+    const vfloat4 b3 = load(mesh3,v1[3]);
 
     const vfloat16 _p1(permute(vfloat16(b0,b1,b2,b3),perm));
 
-    const vfloat4 &c0 = *(vfloat4*)(mesh0->vertexPtr(v2[0]));
-    const vfloat4 &c1 = *(vfloat4*)(mesh1->vertexPtr(v2[1]));
-    const vfloat4 &c2 = *(vfloat4*)(mesh2->vertexPtr(v2[2]));
-    const vfloat4 &c3 = *(vfloat4*)(mesh3->vertexPtr(v2[3]));
+    const vfloat4 c0 = load(mesh0,v2[0]);
+    const vfloat4 c1 = load(mesh1,v2[1]);
+    const vfloat4 c2 = load(mesh2,v2[2]);
+    const vfloat4 c3 = load(mesh3,v2[3]);
 
     const vfloat16 _p2(permute(vfloat16(c0,c1,c2,c3),perm));
 
-    const vfloat4 &d0 = *(vfloat4*)(mesh0->vertexPtr(v3[0]));
-    const vfloat4 &d1 = *(vfloat4*)(mesh1->vertexPtr(v3[1]));
-    const vfloat4 &d2 = *(vfloat4*)(mesh2->vertexPtr(v3[2]));
-    const vfloat4 &d3 = *(vfloat4*)(mesh3->vertexPtr(v3[3]));
+    const vfloat4 d0 = load(mesh0,v3[0]);
+    const vfloat4 d1 = load(mesh1,v3[1]);
+    const vfloat4 d2 = load(mesh2,v3[2]);
+    const vfloat4 d3 = load(mesh3,v3[3]);
 
     const vfloat16 _p3(permute(vfloat16(d0,d1,d2,d3),perm));
 
@@ -76,18 +76,22 @@ namespace embree
     __forceinline vint<M> primID() const { return primIDs; }
     __forceinline int primID(const size_t i) const { assert(i<M); return primIDs[i]; }
 
-     __forceinline Vec3fa& getVertex(const vint<M> &v, const size_t index, const Scene *const scene) const
+     /* float vertices get loaded directly, half and fixed point vertices get decoded through the mesh */
+     __forceinline Vec3fa getVertex(const vint<M> &v, const size_t index, const Scene *const scene) const
     {
       const QuadMesh* mesh = scene->getQuadMesh(geomID(index));
-      return *(Vec3fa*)mesh->vertexPtr(v[index]);
+      if (likely(mesh->vertices[0].getFormat() == RTC_VERTEX_FORMAT_FLOAT3))
+        return Vec3fa(vfloat4::loadu(mesh->vertexPtr(v[index])));
+      return mesh->vertex(v[index]);
     }
 
      template<typename T>
      __forceinline Vec3<T> getVertex(const vint<M> &v, const size_t index, const Scene *const scene, const T& time) const
     {
       const QuadMesh* mesh = scene->getQuadMesh(geomID(index));
-      const Vec3fa v0  = *(Vec3fa*)mesh->vertexPtr(v[index],0);
-      const Vec3fa v1  = *(Vec3fa*)mesh->vertexPtr(v[index],1);
+      const bool fast = mesh->vertices[0].getFormat() == RTC_VERTEX_FORMAT_FLOAT3;
+      const Vec3fa v0  = likely(fast) ? Vec3fa(vfloat4::loadu(mesh->vertexPtr(v[index],0))) : mesh->vertex(v[index],0);
+      const Vec3fa v1  = likely(fast) ? Vec3fa(vfloat4::loadu(mesh->vertexPtr(v[index],1))) : mesh->vertex(v[index],1);
       const Vec3<T> p0(v0.x,v0.y,v0.z);
       const Vec3<T> p1(v1.x,v1.y,v1.z);
       return (T(one)-time)*p0 + time*p1;
@@ -221,31 +225,38 @@ namespace embree
     const QuadMesh* mesh2 = scene->getQuadMesh(geomIDs[2]);
     const QuadMesh* mesh3 = scene->getQuadMesh(geomIDs[3]);
 
-    const vfloat4 a0 = vfloat4::loadu(mesh0->vertexPtr(v0[0],j));
-    const vfloat4 a1 = vfloat4::loadu(mesh1->vertexPtr(v0[1],j));
-    const vfloat4 a2 = vfloat4::loadu(mesh2->vertexPtr(v0[2],j));
-    const vfloat4 a3 = vfloat4::loadu(mesh3->vertexPtr(v0[3],j));
+    /* half and fixed point vertices get decoded through the mesh */
+    const bool fast = mesh0->vertices[0].getFormat() == RTC_VERTEX_FORMAT_FLOAT3 && mesh1->vertices[0].getFormat() == RTC_VERTEX_FORMAT_FLOAT3 &&
+                      mesh2->vertices[0].getFormat() == RTC_VERTEX_FORMAT_FLOAT3 && mesh3->vertices[0].getFormat() == RTC_VERTEX_FORMAT_FLOAT3;
+    auto load = [&] (const QuadMesh* mesh, int i) -> vfloat4 { 
+      return likely(fast) ? vfloat4::loadu(mesh->vertexPtr(i,j)) : vfloat4(mesh->vertex(i,j)); 
+    };
+
+    const vfloat4 a0 = load(mesh0,v0[0]);
+    const vfloat4 a1 = load(mesh1,v0[1]);
+    const vfloat4 a2 = load(mesh2,v0[2]);
+    const vfloat4 a3 = load(mesh3,v0[3]);
 
     transpose(a0,a1,a2,a3,p0.x,p0.y,p0.z);
 
-    const vfloat4 b0 = vfloat4::loadu(mesh0->vertexPtr(v1[0],j));
-    const vfloat4 b1 = vfloat4::loadu(mesh1->vertexPtr(v1[1],j));
-    const vfloat4 b2 = vfloat4::loadu(mesh2->vertexPtr(v1[2],j));
-    const vfloat4 b3 = vfloat4::loadu(mesh3->vertexPtr(v1[3],j));
+    const vfloat4 b0 = load(mesh0,v1[0]);
+    const vfloat4 b1 = load(mesh1,v1[1]);
+    const vfloat4 b2 = load(mesh2,v1[2]);
+    const vfloat4 b3 = load(mesh3,v1[3]);
 
     transpose(b0,b1,b2,b3,p1.x,p1.y,p1.z);
 
-    const vfloat4 c0 = vfloat4::loadu(mesh0->vertexPtr(v2[0],j));
-    const vfloat4 c1 = vfloat4::loadu(mesh1->vertexPtr(v2[1],j));
-    const vfloat4 c2 = vfloat4::loadu(mesh2->vertexPtr(v2[2],j));
-    const vfloat4 c3 = vfloat4::loadu(mesh3->vertexPtr(v2[3],j));
+    const vfloat4 c0 = load(mesh0,v2[0]);
+    const vfloat4 c1 = load(mesh1,v2[1]);
+    const vfloat4 c2 = load(mesh2,v2[2]);
+    const vfloat4 c3 = load(mesh3,v2[3]);
 
     transpose(c0,c1,c2,c3,p2.x,p2.y,p2.z);
 
-    const vfloat4 d0 = vfloat4::loadu(mesh0->vertexPtr(v3[0],j));
-    const vfloat4 d1 = vfloat4::loadu(mesh1->vertexPtr(v3[1],j));
-    const vfloat4 d2 = vfloat4::loadu(mesh2->vertexPtr(v3[2],j));
-    const vfloat4 d3 = vfloat4::loadu(mesh3->vertexPtr(v3[3],j));
+    const vfloat4 d0 = load(mesh0,v3[0]);
+    const vfloat4 d1 = load(mesh1,v3[1]);
+    const vfloat4 d2 = load(mesh2,v3[2]);
+    const vfloat4 d3 = load(mesh3,v3[3]);
 
     transpose(d0,d1,d2,d3,p3.x,p3.y,p3.z);
   }
@@ -0,0 +1,177 @@
+// ======================================================================== //
+// Copyright 2009-2016 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+#include "../common/ray.h"
+#include "filter.h"
+#include "bezier_intersector.h"
+
+namespace embree
+{
+  namespace isa
+  {
+    template<int M>
+      struct RibbonHit
+    {
+      __forceinline RibbonHit() {}
+
+      __forceinline RibbonHit(const vbool<M>& valid, const vfloat<M>& U, const vfloat<M>& V, const vfloat<M>& T, const int i, const int N,
+                              const Vec3fa& p0, const Vec3fa& p1, const Vec3fa& p2, const Vec3fa& p3,
+                              const Vec3fa& n0, const Vec3fa& n1, const Vec3fa& n2, const Vec3fa& n3)
+        : U(U), V(V), T(T), i(i), N(N), p0(p0), p1(p1), p2(p2), p3(p3), n0(n0), n1(n1), n2(n2), n3(n3), valid(valid) {}
+
+      __forceinline void finalize()
+      {
+        vu = (vfloat<M>(step)+U+vfloat<M>(float(i)))*(1.0f/float(N));
+        vv = V;
+        vt = T;
+      }
+
+      __forceinline Vec2f uv (const size_t i) const { return Vec2f(vu[i],vv[i]); }
+      __forceinline float t  (const size_t i) const { return vt[i]; }
+
+      /* the geometry normal is the interpolated normal made perpendicular to the curve tangent */
+      __forceinline Vec3fa Ng(const size_t i) const
+      {
+        const Vec3fa T = BezierCurve3fa(p0,p1,p2,p3,0.0f,1.0f,0).eval_du(vu[i]);
+        const Vec3fa n = BezierCurve3fa(n0,n1,n2,n3,0.0f,1.0f,0).eval(vu[i]);
+        const Vec3fa Ng = dot(T,T)*n - dot(T,n)*T;
+        return Ng == Vec3fa(zero) ? n : Ng;
+      }
+
+    public:
+      vfloat<M> U;
+      vfloat<M> V;
+      vfloat<M> T;
+      int i, N;
+      Vec3fa p0,p1,p2,p3;
+      Vec3fa n0,n1,n2,n3;
+
+    public:
+      vbool<M> valid;
+      vfloat<M> vu;
+      vfloat<M> vv;
+      vfloat<M> vt;
+    };
+
+    /*! Intersects a ray with a ribbon, a bezier curve tessellated into N
+     *  segments that are extended to both sides by the radius, along the
+     *  direction perpendicular to the curve tangent and the interpolated
+     *  normal. The ray space transformation and depth scale are the
+     *  precalculations of the hair intersector. */
+    struct RibbonIntersector
+    {
+      /* intersects the ray along the z-axis with the triangle (a,b,c) in ray space */
+      static __forceinline vboolx intersect_triangle(const Vec3vfx& a, const Vec3vfx& b, const Vec3vfx& c, vfloatx& t, vfloatx& ub, vfloatx& uc)
+      {
+        const vfloatx wa = b.x*c.y - b.y*c.x;
+        const vfloatx wb = c.x*a.y - c.y*a.x;
+        const vfloatx wc = a.x*b.y - a.y*b.x;
+        const vfloatx den = wa+wb+wc;
+        const vboolx valid = ((min(wa,wb,wc) >= 0.0f) | (max(wa,wb,wc) <= 0.0f)) & (den != vfloatx(zero));
+        const vfloatx rcpDen = rcp(den);
+        t  = (wa*a.z + wb*b.z + wc*c.z)*rcpDen;
+        ub = wb*rcpDen;
+        uc = wc*rcpDen;
+        return valid;
+      }
+
+      /* calculates the direction the ribbon extends to, scaled by the radius */
+      static __forceinline Vec3vfx extent(const Vec4vfx& p, const Vec4vfx& dp, const Vec4vfx& n)
+      {
+        const Vec3vfx b = cross(Vec3vfx(n.x,n.y,n.z),Vec3vfx(dp.x,dp.y,dp.z));
+        const vfloatx l2 = dot(b,b);
+        return b*select(l2 > vfloatx(zero),p.w*rsqrt(l2),vfloatx(zero));
+      }
+
+      template<typename Epilog>
+      static __forceinline bool intersect(const Vec3fa& ray_org, const float ray_tnear, const float& ray_tfar,
+                                          const LinearSpace3fa& ray_space, const float depth_scale,
+                                          const Vec3fa& v0, const Vec3fa& v1, const Vec3fa& v2, const Vec3fa& v3,
+                                          const Vec3fa& n0, const Vec3fa& n1, const Vec3fa& n2, const Vec3fa& n3, const int N,
+                                          const Epilog& epilog)
+      {
+        /* transform control points and normals into ray space */
+        Vec3fa w0 = xfmVector(ray_space,v0-ray_org); w0.w = v0.w;
+        Vec3fa w1 = xfmVector(ray_space,v1-ray_org); w1.w = v1.w;
+        Vec3fa w2 = xfmVector(ray_space,v2-ray_org); w2.w = v2.w;
+        Vec3fa w3 = xfmVector(ray_space,v3-ray_org); w3.w = v3.w;
+        const BezierCurve3fa curve2D(w0,w1,w2,w3,0.0f,1.0f,4);
+        const BezierCurve3fa normal2D(xfmVector(ray_space,n0),xfmVector(ray_space,n1),xfmVector(ray_space,n2),xfmVector(ray_space,n3),0.0f,1.0f,4);
+
+        /* process SIMD-size many segments per iteration */
+        bool ishit = false;
+        for (int i=0; i<N; i+=VSIZEX)
+        {
+          /* evaluate curve, tangent, and normal at both ends of each segment */
+          vboolx valid = vintx(i)+vintx(step) < vintx(N);
+          const Vec4vfx p0 = curve2D.eval0(valid,i,N);
+          const Vec4vfx p1 = curve2D.eval1(valid,i,N);
+          const Vec3vfx b0 = extent(p0,curve2D.derivative (valid,i,N),normal2D.eval0(valid,i,N));
+          const Vec3vfx b1 = extent(p1,curve2D.derivative1(valid,i,N),normal2D.eval1(valid,i,N));
+
+          /* corners of the ribbon segment */
+          const Vec3vfx q00 = Vec3vfx(p0.x,p0.y,p0.z)-b0;
+          const Vec3vfx q01 = Vec3vfx(p0.x,p0.y,p0.z)+b0;
+          const Vec3vfx q10 = Vec3vfx(p1.x,p1.y,p1.z)-b1;
+          const Vec3vfx q11 = Vec3vfx(p1.x,p1.y,p1.z)+b1;
+
+          /* intersect both triangles of the segment */
+          vfloatx tA, bA1, bA2; vboolx validA = intersect_triangle(q00,q10,q11,tA,bA1,bA2);
+          vfloatx tB, bB1, bB2; vboolx validB = intersect_triangle(q00,q11,q01,tB,bB1,bB2);
+          tA *= depth_scale; tB *= depth_scale;
+          validA &= valid & (vfloatx(ray_tnear) < tA) & (tA < vfloatx(ray_tfar));
+          validB &= valid & (vfloatx(ray_tnear) < tB) & (tB < vfloatx(ray_tfar));
+          valid = validA | validB;
+          if (likely(none(valid))) continue;
+
+          /* select closer hit per segment */
+          const vboolx useB = validB & (!validA | (tB < tA));
+          const vfloatx t = select(useB,tB,tA);
+          const vfloatx u = select(useB,bB1,bA1+bA2);
+          const vfloatx v = select(useB,bB1+bB2,bA2);
+
+          /* update hit information */
+          RibbonHit<VSIZEX> hit(valid,u,v,t,i,N,v0,v1,v2,v3,n0,n1,n2,n3);
+          ishit |= epilog(valid,hit);
+        }
+        return ishit;
+      }
+
+      template<typename Epilog>
+      static __forceinline bool intersect(const Bezier1Intersector1& pre, Ray& ray,
+                                          const Vec3fa& v0, const Vec3fa& v1, const Vec3fa& v2, const Vec3fa& v3,
+                                          const Vec3fa& n0, const Vec3fa& n1, const Vec3fa& n2, const Vec3fa& n3, const int N,
+                                          const Epilog& epilog)
+      {
+        STAT3(normal.trav_prims,1,1,1);
+        return intersect(ray.org,ray.tnear,ray.tfar,pre.ray_space,pre.depth_scale,v0,v1,v2,v3,n0,n1,n2,n3,N,epilog);
+      }
+
+      template<int K, typename Epilog>
+      static __forceinline bool intersect(const Bezier1IntersectorK<K>& pre, RayK<K>& ray, size_t k,
+                                          const Vec3fa& v0, const Vec3fa& v1, const Vec3fa& v2, const Vec3fa& v3,
+                                          const Vec3fa& n0, const Vec3fa& n1, const Vec3fa& n2, const Vec3fa& n3, const int N,
+                                          const Epilog& epilog)
+      {
+        STAT3(normal.trav_prims,1,1,1);
+        const Vec3fa ray_org(ray.org.x[k],ray.org.y[k],ray.org.z[k]);
+        return intersect(ray_org,ray.tnear[k],ray.tfar[k],pre.ray_space[k],pre.depth_scale[k],v0,v1,v2,v3,n0,n1,n2,n3,N,epilog);
+      }
+    };
+  }
+}
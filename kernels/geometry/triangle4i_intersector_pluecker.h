@@ -36,14 +36,14 @@ namespace embree
       static __forceinline void intersect(const Precalculations& pre, Ray& ray, const RTCIntersectContext* context, const Primitive& tri, Scene* scene, const unsigned* geomID_to_instID)
       {
         STAT3(normal.trav_prims,1,1,1);
-        Vec3vf4 v0, v1, v2; tri.gather(v0,v1,v2);
+        Vec3vf4 v0, v1, v2; tri.gather(v0,v1,v2,scene);
         pre.intersect(ray,v0,v1,v2,UVIdentity<Mx>(),Intersect1EpilogM<M,Mx,filter>(ray,context,tri.geomIDs,tri.primIDs,scene,geomID_to_instID)); 
       }
       
       static __forceinline bool occluded(const Precalculations& pre, Ray& ray, const RTCIntersectContext* context, const Primitive& tri, Scene* scene, const unsigned* geomID_to_instID)
       {
         STAT3(shadow.trav_prims,1,1,1);
-        Vec3vf4 v0, v1, v2; tri.gather(v0,v1,v2);
+        Vec3vf4 v0, v1, v2; tri.gather(v0,v1,v2,scene);
         return pre.intersect(ray,v0,v1,v2,UVIdentity<Mx>(),Occluded1EpilogM<M,Mx,filter>(ray,context,tri.geomIDs,tri.primIDs,scene,geomID_to_instID)); 
       }
 
@@ -76,9 +76,9 @@ namespace embree
           {
             if (!tri.valid(i)) break;
             STAT3(normal.trav_prims,1,popcnt(valid_i),RayK<K>::size());
-            const Vec3f& p0 = *tri.v0[i];
-            const Vec3f& p1 = *(Vec3f*)((int*)&p0 + tri.v1[i]);
-            const Vec3f& p2 = *(Vec3f*)((int*)&p0 + tri.v2[i]);
+            const Vec3fa p0 = tri.getVertex(0,i,scene);
+            const Vec3fa p1 = tri.getVertex(1,i,scene);
+            const Vec3fa p2 = tri.getVertex(2,i,scene);
             const Vec3<vfloat<K>> v0 = Vec3<vfloat<K>>(p0);
             const Vec3<vfloat<K>> v1 = Vec3<vfloat<K>>(p1);
             const Vec3<vfloat<K>> v2 = Vec3<vfloat<K>>(p2);
@@ -94,9 +94,9 @@ namespace embree
           {
             if (!tri.valid(i)) break;
             STAT3(shadow.trav_prims,1,popcnt(valid_i),RayK<K>::size());
-            const Vec3f& p0 = *tri.v0[i];
-            const Vec3f& p1 = *(Vec3f*)((int*)&p0 + tri.v1[i]);
-            const Vec3f& p2 = *(Vec3f*)((int*)&p0 + tri.v2[i]);
+            const Vec3fa p0 = tri.getVertex(0,i,scene);
+            const Vec3fa p1 = tri.getVertex(1,i,scene);
+            const Vec3fa p2 = tri.getVertex(2,i,scene);
             const Vec3<vfloat<K>> v0 = Vec3<vfloat<K>>(p0);
             const Vec3<vfloat<K>> v1 = Vec3<vfloat<K>>(p1);
             const Vec3<vfloat<K>> v2 = Vec3<vfloat<K>>(p2);
@@ -109,14 +109,14 @@ namespace embree
         static __forceinline void intersect(Precalculations& pre, RayK<K>& ray, size_t k, const RTCIntersectContext* context, const Primitive& tri, Scene* scene)
         {
           STAT3(normal.trav_prims,1,1,1);
-          Vec3vf4 v0, v1, v2; tri.gather(v0,v1,v2);
+          Vec3vf4 v0, v1, v2; tri.gather(v0,v1,v2,scene);
           pre.intersect(ray,k,v0,v1,v2,UVIdentity<Mx>(),Intersect1KEpilogM<M,Mx,K,filter>(ray,k,context,tri.geomIDs,tri.primIDs,scene)); 
         }
         
         static __forceinline bool occluded(Precalculations& pre, RayK<K>& ray, size_t k, const RTCIntersectContext* context, const Primitive& tri, Scene* scene)
         {
           STAT3(shadow.trav_prims,1,1,1);
-          Vec3vf4 v0, v1, v2; tri.gather(v0,v1,v2);
+          Vec3vf4 v0, v1, v2; tri.gather(v0,v1,v2,scene);
           return pre.intersect(ray,k,v0,v1,v2,UVIdentity<Mx>(),Occluded1KEpilogM<M,Mx,K,filter>(ray,k,context,tri.geomIDs,tri.primIDs,scene)); 
         }
       };
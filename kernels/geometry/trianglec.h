@@ -0,0 +1,265 @@
+// ======================================================================== //
+// Copyright 2009-2016 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+#include "primitive.h"
+
+namespace embree
+{
+  /* Stores up to M triangles of one indexed face set in compressed
+   * form. The triangles share a small local table of vertex indices
+   * that is addressed through 8 bit local indices, and the primitive
+   * IDs are stored as 8 bit deltas to the smallest primitive ID of the
+   * block. The number of triangles per block thus depends on how many
+   * vertices the triangles share. */
+  template <int M>
+  struct TriangleMc
+  {
+    /* maximal number of vertices in the local vertex table */
+    static const size_t maxVertices = 2*M+2;
+
+    /* maximal difference of primitive IDs inside a block */
+    static const unsigned maxPrimIDDelta = 255;
+
+    /* Virtual interface to query information about the triangle type */
+    struct Type : public PrimitiveType
+    {
+      Type();
+      size_t size(const char* This) const;
+    };
+    static Type type;
+
+  public:
+
+    /* Returns maximal number of stored triangles */
+    static __forceinline size_t max_size() { return M; }
+
+    /* Returns required number of primitive blocks for the primitives in the range [begin,end) */
+    static __forceinline size_t blocks(const PrimRef* prims, size_t begin, size_t end, const Scene* scene)
+    {
+      size_t N = 0;
+      for (; begin<end; N++)
+        begin += group(prims,begin,end,scene);
+      return N;
+    }
+
+  public:
+
+    /* Returns if the specified triangle is valid, the deltas of all but the first triangle are non-zero */
+    __forceinline bool valid(const size_t i) const { assert(i<M); return i == 0 || primIDdelta[i] != 0; }
+
+    /* Returns the number of stored triangles */
+    __forceinline size_t size() const
+    {
+      size_t n = 1;
+      while (n<M && primIDdelta[n] != 0) n++;
+      return n;
+    }
+
+    /* Returns the geometry IDs */
+    __forceinline vint<M> geomID() const { return vint<M>(geomID_); }
+    __forceinline int geomID(const size_t i) const { assert(i<M); return geomID_; }
+
+    /* Returns the primitive IDs */
+    __forceinline vint<M> primID() const
+    {
+      vint<M> primIDs;
+      for (size_t i=0; i<M; i++)
+        primIDs[i] = valid(i) ? int(primID_+primIDdelta[i]) : -1;
+      return primIDs;
+    }
+    __forceinline int primID(const size_t i) const { assert(i<M); return primID_+primIDdelta[i]; }
+
+    /* Returns the vertices of the i'th triangle */
+    __forceinline const Vec3fa vertex0(const TriangleMesh* mesh, const size_t i) const { return mesh->vertex(vertices[v0[i]]); }
+    __forceinline const Vec3fa vertex1(const TriangleMesh* mesh, const size_t i) const { return mesh->vertex(vertices[v1[i]]); }
+    __forceinline const Vec3fa vertex2(const TriangleMesh* mesh, const size_t i) const { return mesh->vertex(vertices[v2[i]]); }
+
+    /* gather the triangles */
+    __forceinline void gather(Vec3<vfloat<M>>& p0, Vec3<vfloat<M>>& p1, Vec3<vfloat<M>>& p2, const Scene* scene) const;
+
+    /* Calculate the bounds of the triangles */
+    __forceinline const BBox3fa bounds(const Scene* scene) const
+    {
+      const TriangleMesh* mesh = scene->getTriangleMesh(geomID_);
+      BBox3fa bounds = empty;
+      for (size_t i=0; i<M && valid(i); i++)
+      {
+        bounds.extend(vertex0(mesh,i));
+        bounds.extend(vertex1(mesh,i));
+        bounds.extend(vertex2(mesh,i));
+      }
+      return bounds;
+    }
+
+    /* Returns the number of triangles starting at begin that fit into one block */
+    static __forceinline size_t group(const PrimRef* prims, size_t begin, size_t end, const Scene* scene)
+    {
+      const unsigned geomID = prims[begin].geomID();
+      const TriangleMesh* mesh = scene->getTriangleMesh(geomID);
+      unsigned minPrimID = prims[begin].primID();
+      unsigned maxPrimID = minPrimID;
+      unsigned table[maxVertices]; size_t numVertices = 0;
+
+      size_t n = 0;
+      for (; n<M && begin+n<end; n++)
+      {
+        const PrimRef& prim = prims[begin+n];
+        if (prim.geomID() != geomID) break;
+        const unsigned lower = min(minPrimID,(unsigned)prim.primID());
+        const unsigned upper = max(maxPrimID,(unsigned)prim.primID());
+        if (upper-lower > maxPrimIDDelta) break;
+        if (contains(prims+begin,n,prim.primID())) break; // pre-splitting may duplicate triangles
+
+        const TriangleMesh::Triangle& tri = mesh->triangle(prim.primID());
+        size_t num = numVertices;
+        for (size_t k=0; k<3 && num <= maxVertices; k++)
+          if (find(table,num,tri.v[k]) == num) {
+            if (num < maxVertices) table[num] = tri.v[k];
+            num++;
+          }
+        if (num > maxVertices) break;
+
+        numVertices = num;
+        minPrimID = lower;
+        maxPrimID = upper;
+      }
+      return n;
+    }
+
+    /* Fill block from triangle list */
+    __forceinline void fill(const PrimRef* prims, size_t& begin, size_t end, Scene* scene, const bool list)
+    {
+      /* sort the triangles by primitive ID to encode the IDs as deltas to the first one */
+      const size_t n = group(prims,begin,end,scene);
+      assert(n >= 1 && n <= M);
+      PrimRef refs[M];
+      for (size_t i=0; i<n; i++)
+      {
+        size_t j = i;
+        for (; j>0 && refs[j-1].primID() > prims[begin+i].primID(); j--)
+          refs[j] = refs[j-1];
+        refs[j] = prims[begin+i];
+      }
+      begin += n;
+
+      const TriangleMesh* mesh = scene->getTriangleMesh(refs[0].geomID());
+      geomID_ = refs[0].geomID();
+      primID_ = refs[0].primID();
+
+      size_t numVertices = 0;
+      for (size_t i=0; i<M; i++)
+      {
+        if (i<n) {
+          const TriangleMesh::Triangle& tri = mesh->triangle(refs[i].primID());
+          primIDdelta[i] = (unsigned char) (refs[i].primID()-primID_);
+          v0[i] = (unsigned char) insert(numVertices,tri.v[0]);
+          v1[i] = (unsigned char) insert(numVertices,tri.v[1]);
+          v2[i] = (unsigned char) insert(numVertices,tri.v[2]);
+        } else {
+          primIDdelta[i] = 0;
+          v0[i] = v1[i] = v2[i] = 0;
+        }
+      }
+      for (size_t i=numVertices; i<maxVertices; i++)
+        vertices[i] = vertices[0];
+    }
+
+  private:
+
+    /* Looks up the vertex indices of the 4 local indices in the local vertex table */
+    __forceinline vint4 decode(const unsigned char* local) const
+    {
+#if defined(__AVX2__)
+      const vint4 index = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(*(const int*)local));
+      return _mm_i32gather_epi32((const int*)vertices,index,4);
+#else
+      return vint4(vertices[local[0]],vertices[local[1]],vertices[local[2]],vertices[local[3]]);
+#endif
+    }
+
+    /* Returns the slot of vertex v in the first num entries of the table, or num if not found */
+    static __forceinline size_t find(const unsigned* table, const size_t num, const unsigned v)
+    {
+      for (size_t i=0; i<num; i++)
+        if (table[i] == v) return i;
+      return num;
+    }
+
+    /* Returns if one of the first num primitives has the specified primitive ID */
+    static __forceinline bool contains(const PrimRef* prims, const size_t num, const unsigned primID)
+    {
+      for (size_t i=0; i<num; i++)
+        if (prims[i].primID() == primID) return true;
+      return false;
+    }
+
+    /* Returns the local index of vertex v, adds v to the local vertex table if not present */
+    __forceinline size_t insert(size_t& numVertices, const unsigned v)
+    {
+      const size_t i = find(vertices,numVertices,v);
+      if (i == numVertices) {
+        assert(numVertices < maxVertices);
+        vertices[numVertices++] = v;
+      }
+      return i;
+    }
+
+  public:
+    unsigned geomID_;                 // geometry ID of mesh
+    unsigned primID_;                 // smallest primitive ID of the block
+    unsigned char primIDdelta[M];     // primitive ID offsets of triangles
+    unsigned char v0[M];              // local index of 1st vertex
+    unsigned char v1[M];              // local index of 2nd vertex
+    unsigned char v2[M];              // local index of 3rd vertex
+    unsigned vertices[maxVertices];   // local vertex table of indices into the vertex buffer of the mesh
+  };
+
+  template<>
+    __forceinline void TriangleMc<4>::gather(Vec3vf4& p0, Vec3vf4& p1, Vec3vf4& p2, const Scene* scene) const
+  {
+    const TriangleMesh* mesh = scene->getTriangleMesh(geomID_);
+    const vint4 i0 = decode(v0), i1 = decode(v1), i2 = decode(v2);
+    vfloat4 a0,a1,a2,a3,b0,b1,b2,b3,c0,c1,c2,c3;
+
+    /* float vertices are loaded directly from the vertex buffer, other formats get decoded per vertex */
+    if (likely(mesh->vertices[0].getFormat() == RTC_VERTEX_FORMAT_FLOAT3))
+    {
+      const char* ptr = mesh->vertexPtr(0);
+      const size_t stride = mesh->vertices[0].getStride();
+      auto load = [&] (const int i) { return vfloat4::loadu((const float*)(ptr+size_t(unsigned(i))*stride)); };
+      a0 = load(i0[0]); a1 = load(i0[1]); a2 = load(i0[2]); a3 = load(i0[3]);
+      b0 = load(i1[0]); b1 = load(i1[1]); b2 = load(i1[2]); b3 = load(i1[3]);
+      c0 = load(i2[0]); c1 = load(i2[1]); c2 = load(i2[2]); c3 = load(i2[3]);
+    }
+    else
+    {
+      auto load = [&] (const int i) { return vfloat4(mesh->vertex(unsigned(i))); };
+      a0 = load(i0[0]); a1 = load(i0[1]); a2 = load(i0[2]); a3 = load(i0[3]);
+      b0 = load(i1[0]); b1 = load(i1[1]); b2 = load(i1[2]); b3 = load(i1[3]);
+      c0 = load(i2[0]); c1 = load(i2[1]); c2 = load(i2[2]); c3 = load(i2[3]);
+    }
+    transpose(a0,a1,a2,a3,p0.x,p0.y,p0.z);
+    transpose(b0,b1,b2,b3,p1.x,p1.y,p1.z);
+    transpose(c0,c1,c2,c3,p2.x,p2.y,p2.z);
+  }
+
+  template<int M>
+  typename TriangleMc<M>::Type TriangleMc<M>::type;
+
+  typedef TriangleMc<4> Triangle4c;
+}
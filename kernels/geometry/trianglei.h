@@ -17,6 +17,7 @@
 #pragma once
 
 #include "primitive.h"
+#include "../common/scene.h"
 
 namespace embree
 {
@@ -48,18 +49,32 @@ namespace embree
     __forceinline TriangleMi() {  }
 
     /* Construction from vertices and IDs */
-    __forceinline TriangleMi(Vec3f* base[M], const vint<M>& v1, const vint<M>& v2, const vint<M>& geomIDs, const vint<M>& primIDs)
+    __forceinline TriangleMi(const Vec3f* base[M], const vint<M>& v1, const vint<M>& v2, const vint<M>& geomIDs, const vint<M>& primIDs)
       : v1(v1), v2(v2), geomIDs(geomIDs), primIDs(primIDs) 
     {
       for (size_t i=0; i<M; i++)
         v0[i] = base[i];
     }
 
+    /* Stores the vertex pointer and offsets of a triangle, meshes with
+     * half or fixed point vertices store no pointer and get decoded
+     * through the mesh */
+    static __forceinline void encode(const TriangleMesh* mesh, const TriangleMesh::Triangle& tri, const Vec3f*& v0, int& v1, int& v2)
+    {
+      if (unlikely(mesh->vertices[0].getFormat() != RTC_VERTEX_FORMAT_FLOAT3)) {
+        v0 = nullptr; v1 = 0; v2 = 0;
+        return;
+      }
+      v0 = (const Vec3f*) mesh->vertexPtr(tri.v[0]); 
+      v1 = int(size_t((int*) mesh->vertexPtr(tri.v[1])-(int*)v0)); 
+      v2 = int(size_t((int*) mesh->vertexPtr(tri.v[2])-(int*)v0)); 
+    }
+
     /* Returns a mask that tells which triangles are valid */
     __forceinline vbool<M> valid() const { return primIDs != vint<M>(-1); }
     
     /* Returns if the specified triangle is valid */
-    __forceinline bool valid(const size_t i) const { assert(i<M); return geomIDs[i] != -1; }
+    __forceinline bool valid(const size_t i) const { assert(i<M); return primIDs[i] != -1; }
     
     /* Returns the number of stored triangles */
     __forceinline size_t size() const { return __bsf(~movemask(valid())); }
@@ -72,22 +87,30 @@ namespace embree
     __forceinline vint<M> primID() const { return primIDs; }
     __forceinline int primID(const size_t i) const { assert(i<M); return primIDs[i]; }
 
+    /* Returns the k'th vertex of the i'th triangle, invalid triangles return the vertex of the first triangle */
+    __forceinline Vec3fa getVertex(const size_t k, const size_t i, const Scene* const scene) const
+    {
+      if (likely(v0[i] != nullptr)) {
+        const int* base = (const int*) v0[i];
+        return Vec3fa(vfloat4::loadu(base + (k == 0 ? 0 : k == 1 ? v1[i] : v2[i])));
+      }
+      const size_t j = valid(i) ? i : 0;
+      const TriangleMesh* mesh = scene->getTriangleMesh(geomID(j));
+      return mesh->vertex(mesh->triangle(primID(j)).v[k]);
+    }
+
     /* gather the triangles */
-    __forceinline void gather(Vec3<vfloat<M>>& p0, Vec3<vfloat<M>>& p1, Vec3<vfloat<M>>& p2) const;
+    __forceinline void gather(Vec3<vfloat<M>>& p0, Vec3<vfloat<M>>& p1, Vec3<vfloat<M>>& p2, const Scene* const scene) const;
     
     /* Calculate the bounds of the triangles */
-    __forceinline const BBox3fa bounds() const 
+    __forceinline const BBox3fa bounds(const Scene* const scene) const 
     {
       BBox3fa bounds = empty;
-      for (size_t i=0; i<M && geomIDs[i] != -1; i++)
+      for (size_t i=0; i<M && valid(i); i++)
       {
-	const int* base = (int*) v0[i];
-	const Vec3fa p0 = *(Vec3fa*)(base);
-	const Vec3fa p1 = *(Vec3fa*)(base+v1[i]);
-	const Vec3fa p2 = *(Vec3fa*)(base+v2[i]);
-	bounds.extend(p0);
-	bounds.extend(p1);
-	bounds.extend(p2);
+	bounds.extend(getVertex(0,i,scene));
+	bounds.extend(getVertex(1,i,scene));
+	bounds.extend(getVertex(2,i,scene));
       }
       return bounds;
     }
@@ -96,7 +119,7 @@ namespace embree
     __forceinline void fill(atomic_set<PrimRefBlock>::block_iterator_unsafe& prims, Scene* scene, const bool list)
     {
       vint<M> geomID = -1, primID = -1;
-      Vec3f* v0[M];
+      const Vec3f* v0[M];
       vint<M> v1 = zero, v2 = zero;
       PrimRef& prim = *prims;
       
@@ -107,19 +130,15 @@ namespace embree
 	if (prims) {
 	  geomID[i] = prim.geomID();
 	  primID[i] = prim.primID();
-	  v0[i] = (Vec3f*) mesh->vertexPtr(tri.v[0]); 
-	  v1[i] = int(size_t((int*)   mesh->vertexPtr(tri.v[1])-(int*)v0[i])); 
-	  v2[i] = int(size_t((int*)   mesh->vertexPtr(tri.v[2])-(int*)v0[i])); 
+	  encode(mesh,tri,v0[i],v1[i],v2[i]);
 	  prims++;
 	} else {
 	  assert(i);
-          if (i>0) {
-            geomID[i] = -1;
-            primID[i] = -1;
-            v0[i] = v0[i-1];
-            v1[i] = 0; 
-            v2[i] = 0;
-          }
+	  geomID[i] = geomID[0]; // always valid geomIDs
+	  primID[i] = -1;        // indicates invalid data
+	  v0[i] = v0[0];
+	  v1[i] = 0; 
+	  v2[i] = 0;
 	}
 	if (prims) prim = *prims; 
       }
@@ -131,7 +150,7 @@ namespace embree
     __forceinline void fill(const PrimRef* prims, size_t& begin, size_t end, Scene* scene, const bool list)
     {
       vint<M> geomID = -1, primID = -1;
-      Vec3f* v0[M];
+      const Vec3f* v0[M];
       vint<M> v1 = zero, v2 = zero;
       const PrimRef* prim = &prims[begin];
       
@@ -142,19 +161,15 @@ namespace embree
 	if (begin<end) {
 	  geomID[i] = prim->geomID();
 	  primID[i] = prim->primID();
-	  v0[i] = (Vec3f*) mesh->vertexPtr(tri.v[0]); 
-	  v1[i] = int(size_t((int*)   mesh->vertexPtr(tri.v[1])-(int*)v0[i])); 
-	  v2[i] = int(size_t((int*)   mesh->vertexPtr(tri.v[2])-(int*)v0[i])); 
+	  encode(mesh,tri,v0[i],v1[i],v2[i]);
 	  begin++;
 	} else {
 	  assert(i);
-          if (i > 0) {
-            geomID[i] = -1;
-            primID[i] = -1;
-            v0[i] = v0[i-1];
-            v1[i] = 0; 
-            v2[i] = 0;
-          }
+	  geomID[i] = geomID[0]; // always valid geomIDs
+	  primID[i] = -1;        // indicates invalid data
+	  v0[i] = v0[0];
+	  v1[i] = 0; 
+	  v2[i] = 0;
 	}
 	if (begin<end) prim = &prims[begin];
       }
@@ -180,7 +195,7 @@ namespace embree
     }
     
   public:
-    const Vec3f* v0[M]; // pointer to 1st vertex
+    const Vec3f* v0[M]; // pointer to 1st vertex, null for half and fixed point vertices
     vint<M> v1;         // offset to 2nd vertex
     vint<M> v2;         // offset to 3rd vertex
     vint<M> geomIDs;    // geometry ID of mesh
@@ -188,12 +203,25 @@ namespace embree
   };
 
   template<>
-    __forceinline void TriangleMi<4>::gather(Vec3vf4& p0, Vec3vf4& p1, Vec3vf4& p2) const
+    __forceinline void TriangleMi<4>::gather(Vec3vf4& p0, Vec3vf4& p1, Vec3vf4& p2, const Scene* const scene) const
   {
     const int* base0 = (const int*) v0[0];
     const int* base1 = (const int*) v0[1];
     const int* base2 = (const int*) v0[2];
     const int* base3 = (const int*) v0[3];
+
+    /* half and fixed point vertices get decoded through the mesh */
+    if (unlikely(!base0 || !base1 || !base2 || !base3))
+    {
+      const vfloat4 a0 = vfloat4(getVertex(0,0,scene)), a1 = vfloat4(getVertex(0,1,scene)), a2 = vfloat4(getVertex(0,2,scene)), a3 = vfloat4(getVertex(0,3,scene));
+      const vfloat4 b0 = vfloat4(getVertex(1,0,scene)), b1 = vfloat4(getVertex(1,1,scene)), b2 = vfloat4(getVertex(1,2,scene)), b3 = vfloat4(getVertex(1,3,scene));
+      const vfloat4 c0 = vfloat4(getVertex(2,0,scene)), c1 = vfloat4(getVertex(2,1,scene)), c2 = vfloat4(getVertex(2,2,scene)), c3 = vfloat4(getVertex(2,3,scene));
+      transpose(a0,a1,a2,a3,p0.x,p0.y,p0.z);
+      transpose(b0,b1,b2,b3,p1.x,p1.y,p1.z);
+      transpose(c0,c1,c2,c3,p2.x,p2.y,p2.z);
+      return;
+    }
+
     const vfloat4 a0 = vfloat4::loadu(base0      ), a1 = vfloat4::loadu(base1      ), a2 = vfloat4::loadu(base2      ), a3 = vfloat4::loadu(base3      );
     const vfloat4 b0 = vfloat4::loadu(base0+v1[0]), b1 = vfloat4::loadu(base1+v1[1]), b2 = vfloat4::loadu(base2+v1[2]), b3 = vfloat4::loadu(base3+v1[3]);
     const vfloat4 c0 = vfloat4::loadu(base0+v2[0]), c1 = vfloat4::loadu(base1+v2[1]), c2 = vfloat4::loadu(base2+v2[2]), c3 = vfloat4::loadu(base3+v2[3]);
@@ -282,6 +282,21 @@ namespace embree
     }
 #endif
 
+#if defined(__SSE__)
+    template<int M>
+      __forceinline Vec4<vfloat<M>> derivative1(const vbool<M>& valid, const int ofs, const int size) const
+    {
+      assert(size <= BezierCoefficients::N);
+      assert(ofs <= size);
+      Vec4<vfloat<M>> r;
+      r  = Vec4<vfloat<M>>(v0) * vfloat<M>::loadu(&bezier_coeff1.d0[size][ofs]);
+      r += Vec4<vfloat<M>>(v1) * vfloat<M>::loadu(&bezier_coeff1.d1[size][ofs]); // FIXME: use fmadd
+      r += Vec4<vfloat<M>>(v2) * vfloat<M>::loadu(&bezier_coeff1.d2[size][ofs]);
+      r += Vec4<vfloat<M>>(v3) * vfloat<M>::loadu(&bezier_coeff1.d3[size][ofs]);
+      return r;
+    }
+#endif
+
     /* calculates bounds of bezier curve geometry */
 #if defined(__SSE__)
     __forceinline BBox3fa bounds() const
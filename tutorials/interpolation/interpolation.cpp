@@ -21,7 +21,7 @@ namespace embree
   struct Tutorial : public TutorialApplication 
   {
     Tutorial()
-      : TutorialApplication("interpolation",FEATURE_RTCORE) 
+      : TutorialApplication("interpolation",FEATURE_RTCORE | FEATURE_STREAM)
     {
       /* set default camera */
       camera.from = Vec3fa(9.0f,4.0f,1.0f);
@@ -26,6 +26,14 @@ namespace embree {
 #define MIN_EDGE_LEVEL  4.0f
 #define LEVEL_FACTOR  128.0f
 
+void renderTileStream(int taskIndex,
+                      int* pixels,
+                      const unsigned int width,
+                      const unsigned int height,
+                      const float time,
+                      const ISPCCamera& camera,
+                      const int numTilesX,
+                      const int numTilesY);
 
 /* scene data */
 RTCDevice g_device = nullptr;
@@ -317,8 +325,12 @@ extern "C" void device_init (char* cfg)
   /* set error handler */
   rtcDeviceSetErrorFunction(g_device,error_handler);
 
+  RTCAlgorithmFlags aflags;
+  if (g_mode == MODE_NORMAL) aflags = RTC_INTERSECT1 | RTC_INTERPOLATE;
+  else                       aflags = RTC_INTERSECT1 | RTC_INTERSECT_STREAM | RTC_INTERPOLATE;
+
   /* create scene */
-  g_scene = rtcDeviceNewScene(g_device, RTC_SCENE_DYNAMIC,RTC_INTERSECT1 | RTC_INTERPOLATE);
+  g_scene = rtcDeviceNewScene(g_device, RTC_SCENE_DYNAMIC,aflags);
 
   /* add ground plane */
   addGroundPlane(g_scene);
@@ -336,7 +348,8 @@ extern "C" void device_init (char* cfg)
   rtcCommit (g_scene);
 
   /* set start render mode */
-  renderTile = renderTileStandard;
+  if (g_mode == MODE_NORMAL) renderTile = renderTileStandard;
+  else                       renderTile = renderTileStream;
   key_pressed_handler = device_key_pressed_default;
 }
 
@@ -443,6 +456,215 @@ void renderTileStandard(int taskIndex,
   }
 }
 
+/* renders a single screen tile using ray streams, the vertex data of
+ * all hits of a geometry gets interpolated with a single call */
+void renderTileStream(int taskIndex,
+                      int* pixels,
+                      const unsigned int width,
+                      const unsigned int height,
+                      const float time,
+                      const ISPCCamera& camera,
+                      const int numTilesX,
+                      const int numTilesY)
+{
+  const unsigned int tileY = taskIndex / numTilesX;
+  const unsigned int tileX = taskIndex - tileY * numTilesX;
+  const unsigned int x0 = tileX * TILE_SIZE_X;
+  const unsigned int x1 = min(x0+TILE_SIZE_X,width);
+  const unsigned int y0 = tileY * TILE_SIZE_Y;
+  const unsigned int y1 = min(y0+TILE_SIZE_Y,height);
+
+  RTCRay primary_stream[TILE_SIZE_X*TILE_SIZE_Y];
+  RTCRay shadow_stream[TILE_SIZE_X*TILE_SIZE_Y];
+  Vec3fa color_stream[TILE_SIZE_X*TILE_SIZE_Y];
+  Vec3fa Ng_stream[TILE_SIZE_X*TILE_SIZE_Y];
+  bool valid_stream[TILE_SIZE_X*TILE_SIZE_Y];
+
+  /* hits of the stream and interpolated data in SoA layout */
+  unsigned int hit_geomID[TILE_SIZE_X*TILE_SIZE_Y*1];
+  unsigned int hit_primID[TILE_SIZE_X*TILE_SIZE_Y*1];
+  float hit_u[TILE_SIZE_X*TILE_SIZE_Y*1];
+  float hit_v[TILE_SIZE_X*TILE_SIZE_Y*1];
+  int hit_valid[TILE_SIZE_X*TILE_SIZE_Y*1];
+  float diffuse_stream[3*TILE_SIZE_X*TILE_SIZE_Y*1];
+  float dPdu_stream[3*TILE_SIZE_X*TILE_SIZE_Y*1];
+  float dPdv_stream[3*TILE_SIZE_X*TILE_SIZE_Y*1];
+
+  /* select stream mode */
+  RTCIntersectFlags iflags = g_mode == MODE_STREAM_COHERENT ?  RTC_INTERSECT_COHERENT : RTC_INTERSECT_INCOHERENT;
+
+  /* generate stream of primary rays */
+  int N = 0;
+  for (unsigned int y=y0; y<y1; y++) for (unsigned int x=x0; x<x1; x++)
+  {
+    /* ISPC workaround for mask == 0 */
+    if (all(1 == 0)) continue;
+
+    /* initialize variables */
+    color_stream[N] = Vec3fa(0.0f);
+    bool mask = 1; { valid_stream[N] = mask; }
+
+    /* initialize ray */
+    RTCRay& primary = primary_stream[N];
+    primary.org = Vec3fa(camera.xfm.p);
+    primary.dir = Vec3fa(normalize((float)x*camera.xfm.l.vx + (float)y*camera.xfm.l.vy + camera.xfm.l.vz));
+    mask = 1; { // invalidates inactive rays
+      primary.tnear = mask ? 0.0f         : (float)(pos_inf);
+      primary.tfar  = mask ? (float)(inf) : (float)(neg_inf);
+    }
+    primary.geomID = RTC_INVALID_GEOMETRY_ID;
+    primary.primID = RTC_INVALID_GEOMETRY_ID;
+    primary.mask = -1;
+    primary.time = 0.0f;
+    N++;
+  }
+
+  /* trace rays */
+  RTCIntersectContext primary_context;
+  primary_context.flags = iflags;
+  primary_context.userRayExt = &primary_stream;
+  rtcIntersect1M(g_scene,&primary_context,(RTCRay*)&primary_stream,N,sizeof(RTCRay));
+
+  /* copy hits into SoA layout */
+  const size_t M = N*1;
+  unsigned int maxGeomID = 0;
+  for (int n=0; n<N; n++)
+  {
+    RTCRay& primary = primary_stream[n];
+    const int i = n*1+0;
+    hit_geomID[i] = valid_stream[n] ? primary.geomID : RTC_INVALID_GEOMETRY_ID;
+    hit_primID[i] = primary.primID;
+    hit_u[i] = primary.u;
+    hit_v[i] = primary.v;
+  }
+  for (size_t i=0; i<M; i++)
+    if (hit_geomID[i] != RTC_INVALID_GEOMETRY_ID) maxGeomID = max(maxGeomID,hit_geomID[i]);
+
+  /* interpolate diffuse color and vertex derivatives of all hits of a geometry */
+  for (unsigned int geomID=1; geomID<=maxGeomID; geomID++)
+  {
+    bool hit = false;
+    for (size_t i=0; i<M; i++) {
+      hit_valid[i] = hit_geomID[i] == geomID ? -1 : 0;
+      if (hit_geomID[i] == geomID) hit = true;
+    }
+    if (!hit) continue;
+
+    unsigned int geom = geomID == quadCubeID ? quadCubeID2 : geomID; // use special interpolation mesh
+    rtcInterpolateN(g_scene,geom,hit_valid,hit_primID,hit_u,hit_v,M,RTC_USER_VERTEX_BUFFER0,diffuse_stream,nullptr,nullptr,3);
+    if (geomID >= 3)
+      rtcInterpolateN(g_scene,geomID,hit_valid,hit_primID,hit_u,hit_v,M,RTC_VERTEX_BUFFER0,nullptr,dPdu_stream,dPdv_stream,3);
+  }
+
+  Vec3fa lightDir = normalize(Vec3fa(-1,-1,-1));
+
+  /* terminate rays and update color */
+  N = -1;
+  for (unsigned int y=y0; y<y1; y++) for (unsigned int x=x0; x<x1; x++)
+  {
+    N++;
+    /* ISPC workaround for mask == 0 */
+    if (all(1 == 0)) continue;
+
+    /* invalidate shadow rays by default */
+    RTCRay& shadow = shadow_stream[N];
+    {
+      shadow.tnear = (float)(pos_inf);
+      shadow.tfar  = (float)(neg_inf);
+    }
+
+    /* ignore invalid rays */
+    if (valid_stream[N] == false) continue;
+
+    /* terminate rays that hit nothing */
+    if (primary_stream[N].geomID == RTC_INVALID_GEOMETRY_ID) {
+      valid_stream[N] = false;
+      continue;
+    }
+
+    /* fetch interpolated diffuse color */
+    RTCRay& primary = primary_stream[N];
+    const int i = N*1+0;
+    Vec3fa diffuse = Vec3fa(1.0f,0.0f,0.0f);
+    if (primary.geomID > 0)
+      diffuse = 0.5f*Vec3fa(diffuse_stream[0*M+i],diffuse_stream[1*M+i],diffuse_stream[2*M+i]);
+
+    /* calculate smooth shading normal */
+    Vec3fa Ng = primary.Ng;
+    if (primary.geomID >= 3) {
+      Vec3fa dPdu = Vec3fa(dPdu_stream[0*M+i],dPdu_stream[1*M+i],dPdu_stream[2*M+i]);
+      Vec3fa dPdv = Vec3fa(dPdv_stream[0*M+i],dPdv_stream[1*M+i],dPdv_stream[2*M+i]);
+      Ng = cross(dPdv,dPdu);
+    }
+    Ng_stream[N] = normalize(Ng);
+    color_stream[N] = color_stream[N] + diffuse*0.5f;
+
+    /* initialize shadow ray */
+    shadow.org = primary.org + primary.tfar*primary.dir;
+    shadow.dir = neg(lightDir);
+    bool mask = 1; {
+      shadow.tnear = mask ? 0.001f       : (float)(pos_inf);
+      shadow.tfar  = mask ? (float)(inf) : (float)(neg_inf);
+    }
+    shadow.geomID = RTC_INVALID_GEOMETRY_ID;
+    shadow.primID = RTC_INVALID_GEOMETRY_ID;
+    shadow.mask = -1;
+    shadow.time = 0;
+  }
+  N++;
+
+  /* trace shadow rays */
+  RTCIntersectContext shadow_context;
+  shadow_context.flags = iflags;
+  shadow_context.userRayExt = &shadow_stream;
+  rtcOccluded1M(g_scene,&shadow_context,(RTCRay*)&shadow_stream,N,sizeof(RTCRay));
+
+  /* add light contribution */
+  N = -1;
+  for (unsigned int y=y0; y<y1; y++) for (unsigned int x=x0; x<x1; x++)
+  {
+    N++;
+    /* ISPC workaround for mask == 0 */
+    if (all(1 == 0)) continue;
+
+    /* ignore invalid rays */
+    if (valid_stream[N] == false) continue;
+
+    /* fetch interpolated diffuse color */
+    RTCRay& primary = primary_stream[N];
+    const int i = N*1+0;
+    Vec3fa diffuse = Vec3fa(1.0f,0.0f,0.0f);
+    if (primary.geomID > 0)
+      diffuse = 0.5f*Vec3fa(diffuse_stream[0*M+i],diffuse_stream[1*M+i],diffuse_stream[2*M+i]);
+
+    /* add light contribution */
+    RTCRay& shadow = shadow_stream[N];
+    if (shadow.geomID) {
+      Vec3fa Ng = Ng_stream[N];
+      Vec3fa r = normalize(reflect(primary.dir,Ng));
+      float s = pow(clamp(dot(r,lightDir),0.0f,1.0f),10.0f);
+      float d = clamp(-dot(lightDir,Ng),0.0f,1.0f);
+      color_stream[N] = color_stream[N] + diffuse*d + 0.5f*Vec3fa(s);
+    }
+  }
+  N++;
+
+  /* framebuffer writeback */
+  N = 0;
+  for (unsigned int y=y0; y<y1; y++) for (unsigned int x=x0; x<x1; x++)
+  {
+    /* ISPC workaround for mask == 0 */
+    if (all(1 == 0)) continue;
+
+    /* write color to framebuffer */
+    Vec3fa color = color_stream[N++];
+    unsigned int r = (unsigned int) (255.0f * clamp(color.x,0.0f,1.0f));
+    unsigned int g = (unsigned int) (255.0f * clamp(color.y,0.0f,1.0f));
+    unsigned int b = (unsigned int) (255.0f * clamp(color.z,0.0f,1.0f));
+    pixels[y*width+x] = (b << 16) + (g << 8) + r;
+  }
+}
+
 /* task that renders a single screen tile */
 void renderTileTask (int taskIndex, int* pixels,
                          const unsigned int width,
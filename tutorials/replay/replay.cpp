@@ -0,0 +1,460 @@
+// ======================================================================== //
+// Copyright 2009-2016 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#include "../../common/sys/platform.h"
+#include "../../common/sys/sysinfo.h"
+#include "../../common/sys/alloc.h"
+#include "../../common/sys/vector.h"
+#include "../../common/sys/filename.h"
+#include "../../common/lexers/parsestream.h"
+#include "../../common/lexers/streamfilters.h"
+#include "../../include/embree2/rtcore.h"
+#include "../../include/embree2/rtcore_ray.h"
+
+#include <map>
+
+namespace embree
+{
+  /* layout of the capture file, has to match kernels/common/capture.h */
+  static const int CAPTURE_MAGICK = 0x43455243;
+  static const int CAPTURE_VERSION = 2;
+  enum Record { COMMIT = 1, DELETE_SCENE = 2, RAYS = 3 };
+  enum Call { CALL_1 = 0, CALL_N = 1, CALL_1M = 2, CALL_NM = 3, CALL_NP = 4, NUM_CALLS = 5 };
+
+  /* geometry types as written by Geometry::write */
+  enum GeometryType { TRIANGLE_MESH = 1, BEZIER_CURVES = 4, QUAD_MESH = 32, LINE_SEGMENTS = 64, POINTS = 128 };
+
+  static const char* callNames[2][NUM_CALLS] = {
+    { "rtcIntersect", "rtcIntersectN", "rtcIntersect1M", "rtcIntersectNM", "rtcIntersectNp" },
+    { "rtcOccluded",  "rtcOccludedN",  "rtcOccluded1M",  "rtcOccludedNM",  "rtcOccludedNp"  }
+  };
+
+  /* command line configuration */
+  static std::string g_rtcore = "";
+  static FileName g_capture_file = "";
+  static size_t g_repeat = 1;
+
+  /* replay statistics */
+  struct CallStats
+  {
+    CallStats () : calls(0), rays(0), time(0.0) {}
+    size_t calls;
+    size_t rays;
+    double time;
+  };
+  static CallStats g_call_stats[2][NUM_CALLS];
+  static size_t g_num_commits = 0;
+  static double g_build_time = 0.0;
+
+  static void error_handler(const RTCError code, const char* str)
+  {
+    std::string descr = str ? ": " + std::string(str) : "";
+    THROW_RUNTIME_ERROR("Embree: error " + toString(code) + descr);
+  }
+
+  /* reads binary data in the layout written by the capture log */
+  class CaptureReader
+  {
+  public:
+    CaptureReader (const FileName& fileName)
+    {
+      file.open(fileName.c_str(),std::ios::in | std::ios::binary);
+      if (!file.is_open()) THROW_RUNTIME_ERROR("cannot open capture file " + fileName.str());
+    }
+
+    template<typename T>
+      T read()
+    {
+      T v; file.read((char*)&v,sizeof(T));
+      if (!file) THROW_RUNTIME_ERROR("unexpected end of capture file");
+      return v;
+    }
+
+    void read(void* ptr, size_t bytes)
+    {
+      file.read((char*)ptr,bytes);
+      if (!file) THROW_RUNTIME_ERROR("unexpected end of capture file");
+    }
+
+    /* tries to read the next record type, returns false at the end of the file */
+    bool next(int& record)
+    {
+      file.read((char*)&record,sizeof(int));
+      return file.gcount() == sizeof(int);
+    }
+
+    /* skips the padding the writer inserts before vertex and index arrays */
+    void align16() {
+      while ((size_t(file.tellg()) % 16) != 0) read<char>();
+    }
+
+    /* reads an array into a mapped buffer of a geometry */
+    void readBuffer(RTCScene scene, unsigned geomID, RTCBufferType type, size_t bytes)
+    {
+      align16();
+      void* ptr = rtcMapBuffer(scene,geomID,type);
+      read(ptr,bytes);
+      rtcUnmapBuffer(scene,geomID,type);
+    }
+
+  private:
+    std::ifstream file;
+  };
+
+  /* recreates the next geometry of a commit record */
+  static void replayGeometry(CaptureReader& in, RTCScene scene)
+  {
+    const unsigned mask = in.read<unsigned>();
+    const int type = in.read<int>();
+    unsigned geomID = RTC_INVALID_GEOMETRY_ID;
+
+    switch (type)
+    {
+    case TRIANGLE_MESH:
+    case QUAD_MESH:
+    {
+      const int numTimeSteps = in.read<int>();
+      const int numVertices = in.read<int>();
+      const int numPrimitives = in.read<int>();
+      if (type == TRIANGLE_MESH) geomID = rtcNewTriangleMesh(scene,RTC_GEOMETRY_STATIC,numPrimitives,numVertices,numTimeSteps);
+      else                       geomID = rtcNewQuadMesh    (scene,RTC_GEOMETRY_STATIC,numPrimitives,numVertices,numTimeSteps);
+      for (int j=0; j<numTimeSteps; j++)
+        in.readBuffer(scene,geomID,RTCBufferType(RTC_VERTEX_BUFFER0+j),numVertices*4*sizeof(float));
+      in.readBuffer(scene,geomID,RTC_INDEX_BUFFER,numPrimitives*(type == TRIANGLE_MESH ? 3 : 4)*sizeof(int));
+      break;
+    }
+    case BEZIER_CURVES:
+    {
+      const int numTimeSteps = in.read<int>();
+      const int numVertices = in.read<int>();
+      const int numPrimitives = in.read<int>();
+      const int subtype = in.read<int>();
+      const int basis = in.read<int>();
+      if      (subtype == 0) geomID = rtcNewCurveGeometry (scene,RTC_GEOMETRY_STATIC,numPrimitives,numVertices,numTimeSteps);
+      else if (subtype == 1) geomID = rtcNewHairGeometry  (scene,RTC_GEOMETRY_STATIC,numPrimitives,numVertices,numTimeSteps);
+      else                   geomID = rtcNewRibbonGeometry(scene,RTC_GEOMETRY_STATIC,numPrimitives,numVertices,numTimeSteps);
+      if (basis != RTC_BASIS_BEZIER) rtcSetCurveBasis(scene,geomID,RTCCurveBasis(basis));
+      for (int j=0; j<numTimeSteps; j++)
+        in.readBuffer(scene,geomID,RTCBufferType(RTC_VERTEX_BUFFER0+j),numVertices*4*sizeof(float));
+      if (subtype == 2) {
+        for (int j=0; j<numTimeSteps; j++)
+          in.readBuffer(scene,geomID,RTCBufferType(RTC_NORMAL_BUFFER0+j),numVertices*4*sizeof(float));
+      }
+      in.readBuffer(scene,geomID,RTC_INDEX_BUFFER,numPrimitives*sizeof(int));
+      break;
+    }
+    case LINE_SEGMENTS:
+    {
+      const int numTimeSteps = in.read<int>();
+      const int numVertices = in.read<int>();
+      const int numPrimitives = in.read<int>();
+      geomID = rtcNewLineSegments(scene,RTC_GEOMETRY_STATIC,numPrimitives,numVertices,numTimeSteps);
+      for (int j=0; j<numTimeSteps; j++)
+        in.readBuffer(scene,geomID,RTCBufferType(RTC_VERTEX_BUFFER0+j),numVertices*4*sizeof(float));
+      in.readBuffer(scene,geomID,RTC_INDEX_BUFFER,numPrimitives*sizeof(int));
+      break;
+    }
+    case POINTS:
+    {
+      const int numTimeSteps = in.read<int>();
+      const int subtype = in.read<int>();
+      const int numPoints = in.read<int>();
+      if (subtype == 0) geomID = rtcNewPoints    (scene,RTC_GEOMETRY_STATIC,numPoints,numTimeSteps);
+      else              geomID = rtcNewDiscPoints(scene,RTC_GEOMETRY_STATIC,numPoints,numTimeSteps);
+      for (int j=0; j<numTimeSteps; j++)
+        in.readBuffer(scene,geomID,RTCBufferType(RTC_VERTEX_BUFFER0+j),numPoints*4*sizeof(float));
+      break;
+    }
+
+    /* geometries that cannot get captured are replaced by disabled placeholders to keep the geometry IDs */
+    default:
+      geomID = rtcNewTriangleMesh(scene,RTC_GEOMETRY_STATIC,0,0);
+      rtcDisable(scene,geomID);
+      return;
+    }
+    rtcSetMask(scene,geomID,mask);
+  }
+
+  /* recreates the captured scene and measures its build time */
+  static void replayCommit(CaptureReader& in, RTCDevice device, std::map<unsigned,RTCScene>& scenes)
+  {
+    const unsigned sceneID = in.read<unsigned>();
+    const RTCSceneFlags sflags = (RTCSceneFlags) in.read<int>();
+    const RTCAlgorithmFlags aflags = (RTCAlgorithmFlags) in.read<int>();
+    const unsigned numGeometries = in.read<unsigned>();
+
+    if (scenes.find(sceneID) != scenes.end())
+      rtcDeleteScene(scenes[sceneID]);
+
+    RTCScene scene = scenes[sceneID] = rtcDeviceNewScene(device,sflags,aflags);
+    for (unsigned i=0; i<numGeometries; i++)
+      replayGeometry(in,scene);
+
+    const double t0 = getSeconds();
+    rtcCommit(scene);
+    const double t1 = getSeconds();
+    g_build_time += t1-t0;
+    g_num_commits++;
+  }
+
+  /* stores a ray into the i'th lane of a packet */
+  static void setRay(RTCRayN* ptr, size_t N, size_t i, const RTCRay& ray)
+  {
+    RTCRayN_org_x(ptr,N,i) = ray.org[0];
+    RTCRayN_org_y(ptr,N,i) = ray.org[1];
+    RTCRayN_org_z(ptr,N,i) = ray.org[2];
+    RTCRayN_dir_x(ptr,N,i) = ray.dir[0];
+    RTCRayN_dir_y(ptr,N,i) = ray.dir[1];
+    RTCRayN_dir_z(ptr,N,i) = ray.dir[2];
+    RTCRayN_tnear(ptr,N,i) = ray.tnear;
+    RTCRayN_tfar (ptr,N,i) = ray.tfar;
+    RTCRayN_time (ptr,N,i) = ray.time;
+    RTCRayN_mask (ptr,N,i) = ray.mask;
+    RTCRayN_Ng_x (ptr,N,i) = ray.Ng[0];
+    RTCRayN_Ng_y (ptr,N,i) = ray.Ng[1];
+    RTCRayN_Ng_z (ptr,N,i) = ray.Ng[2];
+    RTCRayN_u    (ptr,N,i) = ray.u;
+    RTCRayN_v    (ptr,N,i) = ray.v;
+    RTCRayN_geomID(ptr,N,i) = ray.geomID;
+    RTCRayN_primID(ptr,N,i) = ray.primID;
+    RTCRayN_instID(ptr,N,i) = ray.instID;
+  }
+
+  /* re-issues the captured rays through the same API call and measures the traversal time */
+  static void replayRays(CaptureReader& in, std::map<unsigned,RTCScene>& scenes)
+  {
+    const unsigned sceneID = in.read<unsigned>();
+    const int call = in.read<int>();
+    const bool occluded = in.read<int>() != 0;
+    const int flags = in.read<int>();
+    RTCClipVolume clipVolume;
+    if (flags != -1 && (flags & RTC_INTERSECT_CLIP_VOLUME)) clipVolume = in.read<RTCClipVolume>();
+    const size_t N = in.read<unsigned>();
+    const size_t M = in.read<unsigned>();
+    if (call < 0 || call >= NUM_CALLS) THROW_RUNTIME_ERROR("invalid ray record in capture file");
+    if (scenes.find(sceneID) == scenes.end()) THROW_RUNTIME_ERROR("rays traced against a scene that got never committed");
+    RTCScene scene = scenes[sceneID];
+
+    std::vector<int> valid(N*M);
+    avector<RTCRay> rays(N*M);
+    size_t numRays = 0;
+    for (size_t i=0; i<N*M; i++) {
+      valid[i] = in.read<int>();
+      in.read(&rays[i],sizeof(RTCRay));
+      numRays += valid[i] == -1;
+    }
+
+    RTCIntersectContext context;
+    context.flags = (RTCIntersectFlags) flags;
+    context.userRayExt = nullptr;
+    context.clipVolume = &clipVolume;
+    const RTCIntersectContext* ctx = flags == -1 ? nullptr : &context;
+
+    /* the API calls modify the rays in place, thus they get copied into the layout of the call before each repetition */
+    avector<RTCRay> stream;
+    const size_t packetBytes = N == 1 ? sizeof(RTCRay) : 18*N*sizeof(float);
+    std::unique_ptr<char,decltype(&alignedFree)> packets((char*)alignedMalloc(M*packetBytes,64),alignedFree);
+    RTCORE_ALIGN(64) int packetValid[16];
+    if (call == CALL_N && N > 16) THROW_RUNTIME_ERROR("invalid packet size in capture file");
+    std::vector<float> soa(18*N);
+    RTCRayNp raysNp;
+
+    for (size_t r=0; r<g_repeat; r++)
+    {
+      switch (call) {
+      case CALL_N:
+        for (size_t i=0; i<N; i++) packetValid[i] = valid[i];
+        /* fall through */
+      case CALL_NM:
+        for (size_t j=0; j<M; j++)
+          for (size_t i=0; i<N; i++)
+            setRay((RTCRayN*)(packets.get()+j*packetBytes),N,i,rays[j*N+i]);
+        break;
+      case CALL_NP:
+        raysNp.orgx   = &soa[ 0*N]; raysNp.orgy = &soa[1*N]; raysNp.orgz = &soa[2*N];
+        raysNp.dirx   = &soa[ 3*N]; raysNp.diry = &soa[4*N]; raysNp.dirz = &soa[5*N];
+        raysNp.tnear  = &soa[ 6*N]; raysNp.tfar = &soa[7*N];
+        raysNp.time   = &soa[ 8*N]; raysNp.mask = (unsigned*)&soa[9*N];
+        raysNp.Ngx    = &soa[10*N]; raysNp.Ngy  = &soa[11*N]; raysNp.Ngz = &soa[12*N];
+        raysNp.u      = &soa[13*N]; raysNp.v    = &soa[14*N];
+        raysNp.geomID = (unsigned*)&soa[15*N]; raysNp.primID = (unsigned*)&soa[16*N]; raysNp.instID = (unsigned*)&soa[17*N];
+        for (size_t i=0; i<N; i++) {
+          const RTCRay& ray = rays[i];
+          raysNp.orgx[i] = ray.org[0]; raysNp.orgy[i] = ray.org[1]; raysNp.orgz[i] = ray.org[2];
+          raysNp.dirx[i] = ray.dir[0]; raysNp.diry[i] = ray.dir[1]; raysNp.dirz[i] = ray.dir[2];
+          raysNp.tnear[i] = ray.tnear; raysNp.tfar[i] = ray.tfar;
+          raysNp.time[i] = ray.time; raysNp.mask[i] = ray.mask;
+          raysNp.Ngx[i] = ray.Ng[0]; raysNp.Ngy[i] = ray.Ng[1]; raysNp.Ngz[i] = ray.Ng[2];
+          raysNp.u[i] = ray.u; raysNp.v[i] = ray.v;
+          raysNp.geomID[i] = ray.geomID; raysNp.primID[i] = ray.primID; raysNp.instID[i] = ray.instID;
+        }
+        break;
+      default:
+        stream = rays;
+        break;
+      }
+
+      const double t0 = getSeconds();
+      switch (call)
+      {
+      case CALL_1:
+        if (occluded) rtcOccluded (scene,stream[0]);
+        else          rtcIntersect(scene,stream[0]);
+        break;
+      case CALL_N:
+        if (N == 4) {
+          if (occluded) rtcOccluded4 (packetValid,scene,*(RTCRay4*)packets.get());
+          else          rtcIntersect4(packetValid,scene,*(RTCRay4*)packets.get());
+        } else if (N == 8) {
+          if (occluded) rtcOccluded8 (packetValid,scene,*(RTCRay8*)packets.get());
+          else          rtcIntersect8(packetValid,scene,*(RTCRay8*)packets.get());
+        } else if (N == 16) {
+          if (occluded) rtcOccluded16 (packetValid,scene,*(RTCRay16*)packets.get());
+          else          rtcIntersect16(packetValid,scene,*(RTCRay16*)packets.get());
+        } else
+          THROW_RUNTIME_ERROR("invalid packet size in capture file");
+        break;
+      case CALL_1M:
+        if (occluded) rtcOccluded1M (scene,ctx,stream.data(),M,sizeof(RTCRay));
+        else          rtcIntersect1M(scene,ctx,stream.data(),M,sizeof(RTCRay));
+        break;
+      case CALL_NM:
+        if (occluded) rtcOccludedNM (scene,ctx,(RTCRayN*)packets.get(),N,M,packetBytes);
+        else          rtcIntersectNM(scene,ctx,(RTCRayN*)packets.get(),N,M,packetBytes);
+        break;
+      case CALL_NP:
+        if (occluded) rtcOccludedNp (scene,ctx,raysNp,N);
+        else          rtcIntersectNp(scene,ctx,raysNp,N);
+        break;
+      }
+      const double t1 = getSeconds();
+
+      CallStats& stats = g_call_stats[occluded][call];
+      stats.calls++;
+      stats.rays += numRays;
+      stats.time += t1-t0;
+    }
+  }
+
+  static void parseCommandLine(Ref<ParseStream> cin, const FileName& path)
+  {
+    while (true)
+    {
+      std::string tag = cin->getString();
+      if (tag == "") return;
+
+      /* parse command line parameters from a file */
+      else if (tag == "-c") {
+        FileName file = path + cin->getFileName();
+        parseCommandLine(new ParseStream(new LineCommentFilter(file, "#")), file.path());
+      }
+
+      /* rtcore configuration */
+      else if (tag == "-rtcore") {
+        g_rtcore += "," + cin->getString();
+      }
+
+      /* number of times each ray query gets issued */
+      else if (tag == "-repeat") {
+        g_repeat = std::max(1,cin->getInt());
+      }
+
+      /* capture file to replay */
+      else if (tag == "-i") {
+        g_capture_file = path + cin->getFileName();
+      }
+
+      /* skip unknown command line parameter */
+      else {
+        std::cerr << "unknown command line parameter: " << tag << " ";
+        while (cin->peek() != "" && cin->peek()[0] != '-') std::cerr << cin->getString() << " ";
+        std::cerr << std::endl;
+      }
+    }
+  }
+
+  /* main function in embree namespace */
+  int main(int argc, char** argv)
+  {
+    /* create stream for parsing */
+    Ref<ParseStream> stream = new ParseStream(new CommandLineStream(argc, argv));
+
+    /* parse command line */
+    parseCommandLine(stream, FileName());
+    if (g_capture_file.str() == "")
+      THROW_RUNTIME_ERROR("no capture file specified, use -i <file>");
+
+    RTCDevice device = rtcNewDevice(g_rtcore.c_str());
+    error_handler(rtcDeviceGetError(device),nullptr);
+    rtcDeviceSetErrorFunction(device,error_handler);
+
+    CaptureReader in(g_capture_file);
+    if (in.read<int>() != CAPTURE_MAGICK) THROW_RUNTIME_ERROR("not a capture file: " + g_capture_file.str());
+    if (in.read<int>() != CAPTURE_VERSION) THROW_RUNTIME_ERROR("unsupported capture file version");
+
+    /* re-issue all records */
+    std::map<unsigned,RTCScene> scenes;
+    int record;
+    while (in.next(record))
+    {
+      switch (record) {
+      case COMMIT: replayCommit(in,device,scenes); break;
+      case DELETE_SCENE: {
+        const unsigned sceneID = in.read<unsigned>();
+        if (scenes.find(sceneID) != scenes.end()) {
+          rtcDeleteScene(scenes[sceneID]);
+          scenes.erase(sceneID);
+        }
+        break;
+      }
+      case RAYS: replayRays(in,scenes); break;
+      default: THROW_RUNTIME_ERROR("invalid record in capture file");
+      }
+    }
+
+    /* print statistics */
+    std::cout << "commits: " << g_num_commits << ", " << 1000.0*g_build_time << " ms" << std::endl;
+    for (size_t occluded=0; occluded<2; occluded++)
+    {
+      for (size_t call=0; call<NUM_CALLS; call++)
+      {
+        const CallStats& stats = g_call_stats[occluded][call];
+        if (stats.calls == 0) continue;
+        std::cout << callNames[occluded][call] << ": " << stats.calls << " calls, " << stats.rays << " rays, "
+                  << 1000.0*stats.time << " ms, " << 1E-6*double(stats.rays)/stats.time << " Mrays/s" << std::endl;
+      }
+    }
+
+    for (auto& scene : scenes) rtcDeleteScene(scene.second);
+    rtcDeleteDevice(device);
+    return 0;
+  }
+}
+
+int main(int argc, char** argv)
+{
+  try {
+    return embree::main(argc, argv);
+  }
+  catch (const std::exception& e) {
+    std::cout << "Error: " << e.what() << std::endl;
+    return 1;
+  }
+  catch (...) {
+    std::cout << "Error: unknown exception caught." << std::endl;
+    return 1;
+  }
+}
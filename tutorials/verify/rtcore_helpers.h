@@ -547,6 +547,8 @@ namespace embree
     if (sflags & RTC_SCENE_DYNAMIC) str += "Dynamic"; else str += "Static";
     if (sflags & RTC_SCENE_COMPACT) str += "Compact";
     if (sflags & RTC_SCENE_ROBUST ) str += "Robust";
+    if (sflags & RTC_SCENE_HIGH_QUALITY) str += "HighQuality";
+    if (sflags & RTC_SCENE_LARGE) str += "Large";
     return str;
   }
 
@@ -643,11 +645,15 @@ namespace embree
     }
   }
 
-  inline void IntersectWithMode(IntersectMode mode, IntersectVariant ivariant, RTCScene scene, RTCRay* rays, size_t N)
+  /* the clip volume is only passed to the stream modes, as only those take an intersection context */
+  inline void IntersectWithMode(IntersectMode mode, IntersectVariant ivariant, RTCScene scene, RTCRay* rays, size_t N, const RTCClipVolume* clipVolume = nullptr)
   {
     RTCIntersectContext context;
     context.flags = ((ivariant & VARIANT_COHERENT_INCOHERENT_MASK) == VARIANT_COHERENT) ? RTC_INTERSECT_COHERENT :  RTC_INTERSECT_INCOHERENT;
+    if (clipVolume) context.flags = (RTCIntersectFlags) (context.flags | RTC_INTERSECT_CLIP_VOLUME);
     context.userRayExt = nullptr;
+    context.clipVolume = clipVolume;
+    context.occlusionCache = nullptr;
 
     switch (mode) 
     {
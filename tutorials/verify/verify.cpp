@@ -19,8 +19,10 @@
 #include "verify.h"
 #include "../tutorials/common/scenegraph/scenegraph.h"
 #include "../kernels/algorithms/parallel_for.h"
+#include "../kernels/common/primref.h"
 #include <regex>
 #include <stack>
+#include <thread>
 
 #define random  use_random_function_of_test // do use random_int() and random_float() from Test class
 #define drand48 use_random_function_of_test // do use random_int() and random_float() from Test class
@@ -676,6 +678,165 @@ namespace embree
     }
   };
 
+  struct UserGeometryLeafTest : public VerifyApplication::Test
+  {
+    UserGeometryLeafTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    struct Spheres 
+    {
+      std::vector<Sphere> spheres;
+      unsigned geomID;
+      std::atomic<size_t> maxLeafItems;
+    };
+
+    static void boundsFuncSoA(void* userPtr, void* geomUserPtr, size_t begin, size_t end, size_t timeStep, const RTCBoundsSoA* bounds_o)
+    {
+      const Spheres* data = (const Spheres*) geomUserPtr;
+      for (size_t i=begin; i<end; i++) {
+        const BBox3fa b = data->spheres[i].bounds();
+        bounds_o->lower_x[i-begin] = b.lower.x; bounds_o->lower_y[i-begin] = b.lower.y; bounds_o->lower_z[i-begin] = b.lower.z;
+        bounds_o->upper_x[i-begin] = b.upper.x; bounds_o->upper_y[i-begin] = b.upper.y; bounds_o->upper_z[i-begin] = b.upper.z;
+      }
+    }
+
+    static void intersectFuncLeaf(void* ptr, const RTCIntersectContext* context, RTCRay& ray, const unsigned* items, size_t numItems)
+    {
+      Spheres* data = (Spheres*) ptr;
+      size_t maxItems = data->maxLeafItems;
+      while (numItems > maxItems && !data->maxLeafItems.compare_exchange_weak(maxItems,numItems));
+
+      for (size_t i=0; i<numItems; i++)
+      {
+        const Sphere& sphere = data->spheres[items[i]];
+        const Vec3fa org(ray.org[0],ray.org[1],ray.org[2]);
+        const Vec3fa dir(ray.dir[0],ray.dir[1],ray.dir[2]);
+        const Vec3fa v = org-sphere.pos;
+        const float A = dot(dir,dir);
+        const float B = 2.0f*dot(v,dir);
+        const float C = dot(v,v) - sqr(sphere.r);
+        const float D = B*B - 4.0f*A*C;
+        if (D < 0.0f) continue;
+        const float t0 = 0.5f*(-B-sqrt(D))/A;
+        if (t0 <= ray.tnear || t0 >= ray.tfar) continue;
+        ray.tfar = t0;
+        ray.geomID = data->geomID;
+        ray.primID = items[i];
+      }
+    }
+
+    static void occludedFuncLeaf(void* ptr, const RTCIntersectContext* context, RTCRay& ray, const unsigned* items, size_t numItems)
+    {
+      const float tfar = ray.tfar;
+      intersectFuncLeaf(ptr,context,ray,items,numItems);
+      if (ray.tfar < tfar) ray.geomID = 0;
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa)+",object_accel_max_leaf_size=8";
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      error_handler(rtcDeviceGetError(device));
+
+      /* a row of spheres that get stored in leaves of several items */
+      const size_t N = 256;
+      Spheres data; data.maxLeafItems = 0;
+      for (size_t i=0; i<N; i++)
+        data.spheres.push_back(Sphere(Vec3fa(float(i),0.0f,0.0f),0.4f));
+
+      RTCSceneRef scene = rtcDeviceNewScene(device,RTC_SCENE_STATIC,RTC_INTERSECT1);
+      unsigned geomID = data.geomID = rtcNewUserGeometry (scene,N);
+      rtcSetUserData(scene,geomID,&data);
+      rtcSetBoundsFunctionSoA(scene,geomID,boundsFuncSoA,nullptr);
+      rtcSetIntersectFunctionLeaf(scene,geomID,intersectFuncLeaf);
+      rtcSetOccludedFunctionLeaf(scene,geomID,occludedFuncLeaf);
+      rtcCommit (scene);
+      AssertNoError(device);
+
+      BBox3fa bounds; rtcGetBounds(scene,(RTCBounds&)bounds);
+      if (bounds != BBox3fa(Vec3fa(-0.4f,-0.4f,-0.4f),Vec3fa(float(N-1)+0.4f,0.4f,0.4f)))
+        return VerifyApplication::FAILED;
+
+      for (size_t i=0; i<N; i++)
+      {
+        RTCRay ray = makeRay(Vec3fa(float(i),0.0f,-5.0f),Vec3fa(0.0f,0.0f,1.0f));
+        rtcIntersect(scene,ray);
+        if (ray.geomID != geomID || ray.primID != i || abs(ray.tfar-4.6f) > 1E-4f) 
+          return VerifyApplication::FAILED;
+
+        RTCRay shadow = makeRay(Vec3fa(float(i),0.0f,-5.0f),Vec3fa(0.0f,0.0f,1.0f));
+        rtcOccluded(scene,shadow);
+        if (shadow.geomID != 0)
+          return VerifyApplication::FAILED;
+
+        RTCRay miss = makeRay(Vec3fa(float(i)+0.5f,0.0f,-5.0f),Vec3fa(0.0f,0.0f,1.0f));
+        rtcIntersect(scene,miss);
+        if (miss.geomID != RTC_INVALID_GEOMETRY_ID) 
+          return VerifyApplication::FAILED;
+      }
+      AssertNoError(device);
+
+      /* the leaf function has to see several items at once */
+      return (VerifyApplication::TestReturnValue)(data.maxLeafItems > 1);
+    }
+  };
+
+  struct BuildSettingsTest : public UserGeometryLeafTest
+  {
+    size_t maxLeafSize;
+
+    BuildSettingsTest (std::string name, int isa, size_t maxLeafSize)
+      : UserGeometryLeafTest(name,isa), maxLeafSize(maxLeafSize) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      error_handler(rtcDeviceGetError(device));
+
+      /* invalid settings have to get rejected */
+      RTCBuildSettings settings = rtcDefaultBuildSettings();
+      settings.sahBlockSize = 3;
+      rtcDeviceNewScene2(device,RTC_SCENE_STATIC,RTC_INTERSECT1,settings);
+      AssertError(device,RTC_INVALID_ARGUMENT);
+      settings = rtcDefaultBuildSettings();
+      settings.minLeafSize = 8; settings.maxLeafSize = 4;
+      rtcDeviceNewScene2(device,RTC_SCENE_STATIC,RTC_INTERSECT1,settings);
+      AssertError(device,RTC_INVALID_ARGUMENT);
+
+      /* large traversal costs produce leaves of maximal size */
+      settings = rtcDefaultBuildSettings();
+      settings.minLeafSize = 1;
+      settings.maxLeafSize = unsigned(maxLeafSize);
+      settings.travCost = 100.0f;
+
+      const size_t N = 256;
+      Spheres data; data.maxLeafItems = 0;
+      for (size_t i=0; i<N; i++)
+        data.spheres.push_back(Sphere(Vec3fa(float(i),0.0f,0.0f),0.4f));
+
+      RTCSceneRef scene = rtcDeviceNewScene2(device,RTC_SCENE_STATIC,RTC_INTERSECT1,settings);
+      unsigned geomID = data.geomID = rtcNewUserGeometry (scene,N);
+      rtcSetUserData(scene,geomID,&data);
+      rtcSetBoundsFunctionSoA(scene,geomID,boundsFuncSoA,nullptr);
+      rtcSetIntersectFunctionLeaf(scene,geomID,intersectFuncLeaf);
+      rtcSetOccludedFunctionLeaf(scene,geomID,occludedFuncLeaf);
+      rtcCommit (scene);
+      AssertNoError(device);
+
+      for (size_t i=0; i<N; i++)
+      {
+        RTCRay ray = makeRay(Vec3fa(float(i),0.0f,-5.0f),Vec3fa(0.0f,0.0f,1.0f));
+        rtcIntersect(scene,ray);
+        if (ray.geomID != geomID || ray.primID != i) 
+          return VerifyApplication::FAILED;
+      }
+      AssertNoError(device);
+
+      return (VerifyApplication::TestReturnValue)(data.maxLeafItems > 1 && data.maxLeafItems <= maxLeafSize);
+    }
+  };
+
   struct GetUserDataTest : public VerifyApplication::Test
   {
     GetUserDataTest (std::string name, int isa)
@@ -894,16 +1055,979 @@ namespace embree
       rtcCommit (scene);
       AssertNoError(device);
 
-      if ((sflags & RTC_SCENE_DYNAMIC) == 0) 
+      if ((sflags & RTC_SCENE_DYNAMIC) == 0) 
+      {
+        for (unsigned int i=0; i<10; i++) {
+          rtcDisable(scene,i);
+          AssertAnyError(device);
+        }
+      }
+      AssertNoError(device);
+
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct SampledBuildTest : public VerifyApplication::Test
+  {
+    SampledBuildTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    unsigned addTriangles(RTCScene scene, const std::vector<Vec3fa>& vertices, const std::vector<Triangle>& triangles)
+    {
+      unsigned geomID = rtcNewTriangleMesh(scene,RTC_GEOMETRY_STATIC,triangles.size(),vertices.size());
+      rtcSetBuffer(scene,geomID,RTC_VERTEX_BUFFER,vertices.data(),0,sizeof(Vec3fa));
+      rtcSetBuffer(scene,geomID,RTC_INDEX_BUFFER,triangles.data(),0,sizeof(Triangle));
+      return geomID;
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      error_handler(rtcDeviceGetError(device));
+
+      /* more than 1M small random triangles, thus the top levels of the SAH build only bin a subset of them */
+      const size_t numTriangles = 1200*1024;
+      std::vector<Vec3fa> vertices;
+      std::vector<Triangle> triangles;
+      for (size_t i=0; i<numTriangles; i++) {
+        const Vec3fa p = 2.0f*random_Vec3fa()-Vec3fa(1.0f);
+        const unsigned v = unsigned(vertices.size());
+        vertices.push_back(p);
+        vertices.push_back(p+0.02f*random_Vec3fa());
+        vertices.push_back(p+0.02f*random_Vec3fa());
+        triangles.push_back(Triangle(v+0,v+1,v+2));
+      }
+
+      /* the static scene uses the SAH builder, the dynamic scene the Morton builder serves as reference */
+      VerifyScene scene(device,RTC_SCENE_STATIC,RTC_INTERSECT1);
+      VerifyScene refScene(device,RTC_SCENE_DYNAMIC,RTC_INTERSECT1);
+      addTriangles(scene,vertices,triangles);
+      addTriangles(refScene,vertices,triangles);
+      rtcCommit (scene);
+      rtcCommit (refScene);
+      AssertNoError(device);
+
+      size_t numHits = 0;
+      for (size_t i=0; i<size_t(1000*state->intensity); i++)
+      {
+        const Vec3fa org = 4.0f*random_Vec3fa()-Vec3fa(2.0f);
+        const Vec3fa dir = 0.5f*random_Vec3fa()-org;
+        RTCRay ray = makeRay(org,dir);
+        RTCRay ref = makeRay(org,dir);
+        rtcIntersect(scene,ray);
+        rtcIntersect(refScene,ref);
+        if (ray.geomID != ref.geomID) return VerifyApplication::FAILED;
+        if (ref.geomID == RTC_INVALID_GEOMETRY_ID) continue;
+        if (abs(ray.tfar-ref.tfar) > 1E-4f*ref.tfar) return VerifyApplication::FAILED;
+        numHits++;
+      }
+      AssertNoError(device);
+      return numHits ? VerifyApplication::PASSED : VerifyApplication::FAILED;
+    }
+  };
+
+  struct BuildMemoryBudgetTest : public VerifyApplication::Test
+  {
+    RTCSceneFlags sflags;
+    std::string rtcore;
+
+    BuildMemoryBudgetTest (std::string name, int isa, RTCSceneFlags sflags, std::string rtcore = "")
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), rtcore(rtcore) {}
+
+    /* builds a sphere whose primitive references get a budget of budgetFactor times their plain size */
+    VerifyApplication::TestReturnValue build(VerifyApplication* state, float budgetFactor, RTCError expectedError)
+    {
+      Ref<SceneGraph::Node> node = SceneGraph::createTriangleSphere(zero,1.0f,50);
+      const double budget = double(budgetFactor)*double(node->numPrimitives()*sizeof(PrimRef))/(1024.0*1024.0);
+      std::stringstream cfg;
+      cfg << state->rtcore << rtcore << ",isa=" << stringOfISA(isa) << ",build_memory_budget=" << std::fixed << std::setprecision(6) << budget;
+      RTCDeviceRef device = rtcNewDevice(cfg.str().c_str());
+      error_handler(rtcDeviceGetError(device));
+      VerifyScene scene(device,sflags,RTC_INTERSECT1);
+      scene.addGeometry(RTC_GEOMETRY_STATIC,node,false);
+      rtcCommit (scene);
+      AssertError(device,expectedError);
+      if (expectedError != RTC_NO_ERROR) 
+        return VerifyApplication::PASSED;
+
+      for (size_t i=0; i<100; i++)
+      {
+        const Vec3fa dir = normalize(2.0f*RandomSampler_get3D(sampler)-Vec3fa(1.0f));
+        RTCRay ray = makeRay(-5.0f*dir,dir);
+        rtcIntersect(scene,ray);
+        if (ray.geomID == RTC_INVALID_GEOMETRY_ID) 
+          return VerifyApplication::FAILED;
+      }
+      AssertNoError(device);
+      return VerifyApplication::PASSED;
+    }
+    
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      /* the plain primitive references do not fit into the budget */
+      if (build(state,0.9f,RTC_OUT_OF_MEMORY) != VerifyApplication::PASSED)
+        return VerifyApplication::FAILED;
+
+      /* the budget clamps the split headroom of high quality builds below the default factor of 1.2 */
+      return build(state,1.1f,RTC_NO_ERROR);
+    }
+  };
+
+  /* records the threads that report build progress of a scene */
+  struct BuildThreads
+  {
+    BuildThreads (RTCScene scene) {
+      rtcSetProgressMonitorFunction(scene,monitor,this);
+    }
+
+    static bool monitor(void* ptr, const double n)
+    {
+      BuildThreads* threads = (BuildThreads*) ptr;
+      Lock<MutexSys> lock(threads->mutex);
+      threads->ids.insert(std::this_thread::get_id());
+      return true;
+    }
+
+    size_t size() {
+      Lock<MutexSys> lock(mutex);
+      return ids.size();
+    }
+
+    MutexSys mutex;
+    std::set<std::thread::id> ids;
+  };
+
+  struct BuildPriorityTest : public VerifyApplication::Test
+  {
+    BuildPriorityTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    struct BackgroundBuild
+    {
+      BackgroundBuild (const RTCDeviceRef& device) 
+        : device(device), done(false) {}
+
+      const RTCDeviceRef& device;
+      std::atomic<bool> done;
+    };
+
+    /* keeps the worker threads busy with builds of low priority */
+    static void background_build(BackgroundBuild* build)
+    {
+      while (!build->done) {
+        VerifyScene scene(build->device,RTC_SCENE_STATIC,RTC_INTERSECT1);
+        scene.addGeometry(RTC_GEOMETRY_STATIC,SceneGraph::createTriangleSphere(zero,1.0f,200),false);
+        rtcCommit (scene);
+      }
+    }
+    
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      error_handler(rtcDeviceGetError(device));
+
+      BackgroundBuild build(device);
+      thread_t background = createThread((thread_func)background_build,&build);
+
+      bool passed = true;
+      bool helped = false;
+      for (size_t i=0; i<10 && passed; i++)
+      {
+        VerifyScene scene(device,RTC_SCENE_STATIC,RTC_INTERSECT1);
+        rtcSetBuildPriority(scene,1);
+        scene.addGeometry(RTC_GEOMETRY_STATIC,SceneGraph::createQuadSphere(zero,1.0f,200),false);
+        BuildThreads threads(scene);
+        rtcCommit (scene);
+        helped |= threads.size() > 1;
+
+        for (size_t j=0; j<100; j++)
+        {
+          const Vec3fa dir = normalize(2.0f*RandomSampler_get3D(sampler)-Vec3fa(1.0f));
+          RTCRay ray = makeRay(-5.0f*dir,dir);
+          rtcIntersect(scene,ray);
+          passed &= ray.geomID != RTC_INVALID_GEOMETRY_ID;
+        }
+      }
+
+      build.done = true;
+      join(background);
+      AssertNoError(device);
+
+      /* the worker threads have to leave the background builds for the builds of higher priority */
+      if (getNumberOfLogicalThreads() > 1) passed &= helped;
+      return passed ? VerifyApplication::PASSED : VerifyApplication::FAILED;
+    }
+  };
+
+  struct BuildPreemptionTest : public VerifyApplication::Test
+  {
+    BuildPreemptionTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    struct LowPriorityBuild
+    {
+      LowPriorityBuild (RTCScene scene)
+        : scene(scene), done(false) {}
+
+      RTCScene scene;
+      std::atomic<bool> done;
+    };
+
+    static void low_priority_build(LowPriorityBuild* build)
+    {
+      rtcCommit(build->scene);
+      build->done = true;
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      error_handler(rtcDeviceGetError(device));
+
+      /* large scene whose build occupies all worker threads for a while */
+      VerifyScene large(device,RTC_SCENE_STATIC,RTC_INTERSECT1);
+      rtcSetBuildPriority(large,-1);
+      large.addGeometry(RTC_GEOMETRY_STATIC,SceneGraph::createTriangleSphere(zero,1.0f,1500),false);
+
+      VerifyScene small(device,RTC_SCENE_STATIC,RTC_INTERSECT1);
+      rtcSetBuildPriority(small,1);
+      small.addGeometry(RTC_GEOMETRY_STATIC,SceneGraph::createQuadSphere(zero,1.0f,200),false);
+
+      LowPriorityBuild build(large);
+      BuildThreads largeThreads(large);
+      BuildThreads smallThreads(small);
+      thread_t background = createThread((thread_func)low_priority_build,&build);
+      while (largeThreads.size() < min(getNumberOfLogicalThreads(),2u) && !build.done) sleepSeconds(0.001);
+
+      /* the worker threads have to leave the low priority build for the small scene, without
+       * preemption the small scene would get built by the calling thread alone */
+      rtcCommit (small);
+      const bool preempted = !build.done && smallThreads.size() > 1;
+      join(background);
+      AssertNoError(device);
+      if (getNumberOfLogicalThreads() > 1 && !preempted) return VerifyApplication::FAILED;
+
+      for (size_t i=0; i<100; i++)
+      {
+        const Vec3fa dir = normalize(2.0f*RandomSampler_get3D(sampler)-Vec3fa(1.0f));
+        RTCRay ray0 = makeRay(-5.0f*dir,dir); rtcIntersect(small,ray0);
+        RTCRay ray1 = makeRay(-5.0f*dir,dir); rtcIntersect(large,ray1);
+        if (ray0.geomID == RTC_INVALID_GEOMETRY_ID) return VerifyApplication::FAILED;
+        if (ray1.geomID == RTC_INVALID_GEOMETRY_ID) return VerifyApplication::FAILED;
+      }
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct CommitManyTest : public VerifyApplication::Test
+  {
+    RTCSceneFlags sflags;
+
+    CommitManyTest (std::string name, int isa, RTCSceneFlags sflags)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+    
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      error_handler(rtcDeviceGetError(device));
+
+      const size_t N = 100;
+      std::vector<std::unique_ptr<VerifyScene>> scenes(N);
+      std::vector<RTCScene> hscenes;
+      for (size_t i=0; i<N; i++) 
+      {
+        scenes[i].reset(new VerifyScene(device,sflags,RTC_INTERSECT1));
+        scenes[i]->addGeometry(RTC_GEOMETRY_STATIC,SceneGraph::createTriangleSphere(Vec3fa(float(i),0.0f,0.0f),0.25f,5+i%10),false);
+        hscenes.push_back(*scenes[i]);
+      }
+      /* scenes passed multiple times are built only once */
+      hscenes.push_back(*scenes[0]);
+      rtcCommitMany(hscenes.data(),hscenes.size());
+      AssertNoError(device);
+
+      for (size_t i=0; i<N; i++)
+      {
+        RTCRay ray = makeRay(Vec3fa(float(i),0.0f,-1.0f),Vec3fa(0.0f,0.0f,1.0f));
+        rtcIntersect(*scenes[i],ray);
+        if (ray.geomID != 0) return VerifyApplication::FAILED;
+      }
+      AssertNoError(device);
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct CaptureTest : public VerifyApplication::Test
+  {
+    CaptureTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+    
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      const std::string fileName = "capture_" + stringOfISA(isa) + ".bin";
+      {
+        std::string cfg = state->rtcore + ",isa="+stringOfISA(isa) + ",capture=\"" + fileName + "\"";
+        RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+        error_handler(rtcDeviceGetError(device));
+
+        VerifyScene scene(device,RTC_SCENE_STATIC,aflags_all);
+        scene.addGeometry(RTC_GEOMETRY_STATIC,SceneGraph::createTriangleSphere(zero,1.0f,10),false);
+        scene.addGeometry(RTC_GEOMETRY_STATIC,SceneGraph::createHairyPlane(0,Vec3fa(0,0,2),Vec3fa(1,0,0),Vec3fa(0,1,0),0.01f,0.001f,16,true),false);
+        rtcCommit(scene);
+        AssertNoError(device);
+
+        RTCRay rays[16];
+        for (size_t i=0; i<16; i++) rays[i] = makeRay(Vec3fa(0.0f,0.0f,-2.0f),Vec3fa(0.0f,0.0f,1.0f));
+        rtcIntersect(scene,rays[0]);
+        IntersectWithMode(MODE_INTERSECT1M,VARIANT_INTERSECT,scene,rays,16);
+        AssertNoError(device);
+        if (rays[0].geomID != 0) return VerifyApplication::FAILED;
+
+        /* tiles get recorded as a stream of single rays */
+        RTCCamera camera;
+        memset(&camera,0,sizeof(camera));
+        camera.org[2] = -2.0f;
+        camera.dir00[0] = -0.5f; camera.dir00[1] = -0.5f; camera.dir00[2] = 1.0f;
+        camera.dirdx[0] = 0.25f; camera.dirdy[1] = 0.25f;
+        camera.focalDistance = 1.0f; camera.tfar = inf;
+        RTCTileHit hits[16];
+        RTCIntersectContext context;
+        context.flags = RTC_INTERSECT_COHERENT;
+        context.userRayExt = nullptr;
+        rtcIntersectTile(scene,&context,camera,0,0,4,4,hits,4*sizeof(RTCTileHit));
+        AssertNoError(device);
+      }
+
+      /* the log starts with the header and a commit of the first scene and ends with its deletion */
+      std::ifstream file(fileName.c_str(),std::ios::in | std::ios::binary);
+      if (!file.is_open()) return VerifyApplication::FAILED;
+      int header[4]; file.read((char*)header,sizeof(header));
+      if (header[0] != 0x43455243 || header[1] != 2) return VerifyApplication::FAILED;
+      if (header[2] != 1 /* COMMIT */ || header[3] != 0) return VerifyApplication::FAILED;
+      int footer[2]; file.seekg(-int(sizeof(footer)),std::ios::end); file.read((char*)footer,sizeof(footer));
+      if (!file || footer[0] != 2 /* DELETE_SCENE */ || footer[1] != 0) return VerifyApplication::FAILED;
+      file.close();
+      remove(fileName.c_str());
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct DistanceOnlyTest : public VerifyApplication::Test
+  {
+    DistanceOnlyTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      error_handler(rtcDeviceGetError(device));
+
+      VerifyScene scene(device,RTC_SCENE_STATIC,aflags_all);
+      scene.addGeometry(RTC_GEOMETRY_STATIC,SceneGraph::createTriangleSphere(zero,1.0f,10),false);
+      rtcCommit(scene);
+      AssertNoError(device);
+
+      /* u and v are initialized to a marker that has to survive distance only queries */
+      const size_t N = 16;
+      RTCRay rays[N], refs[N];
+      for (size_t i=0; i<N; i++) {
+        rays[i] = makeRay(Vec3fa(0.1f*float(i)-0.8f,0.0f,-2.0f),Vec3fa(0.0f,0.0f,1.0f));
+        rays[i].u = rays[i].v = -1.0f;
+        refs[i] = rays[i];
+      }
+
+      RTCIntersectContext context;
+      context.flags = (RTCIntersectFlags) (RTC_INTERSECT_INCOHERENT | RTC_INTERSECT_DISTANCE_ONLY);
+      context.userRayExt = nullptr;
+      rtcIntersect1M(scene,&context,rays,N,sizeof(RTCRay));
+      IntersectWithMode(MODE_INTERSECT1M,VARIANT_INTERSECT,scene,refs,N);
+      AssertNoError(device);
+
+      for (size_t i=0; i<N; i++)
+      {
+        if (rays[i].geomID != refs[i].geomID) return VerifyApplication::FAILED;
+        if (rays[i].primID != refs[i].primID) return VerifyApplication::FAILED;
+        if (rays[i].tfar   != refs[i].tfar  ) return VerifyApplication::FAILED;
+        if (rays[i].u != -1.0f || rays[i].v != -1.0f) return VerifyApplication::FAILED;
+      }
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct ClipVolumeTest : public VerifyApplication::IntersectTest
+  {
+    bool box;
+
+    ClipVolumeTest (std::string name, int isa, IntersectMode imode, IntersectVariant ivariant, bool box)
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), box(box) {}
+
+    /* returns true if the ray through (x,y) along z hits the z=0 plane inside the clip volume */
+    bool inside(float x, float y) const {
+      return box ? abs(x) < 1.0f && abs(y) < 1.0f : x > 0.0f;
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      error_handler(rtcDeviceGetError(device));
+      if (!supportsIntersectMode(device,imode))
+        return VerifyApplication::SKIPPED;
+
+      /* the plane at z=-0.75 occludes the plane at z=0 but lies outside of the box */
+      VerifyScene scene(device,RTC_SCENE_STATIC,to_aflags(imode));
+      unsigned geomID0 = scene.addGeometry(RTC_GEOMETRY_STATIC,SceneGraph::createTrianglePlane(Vec3fa(-4.0f,-4.0f, 0.00f),Vec3fa(8.0f,0.0f,0.0f),Vec3fa(0.0f,8.0f,0.0f),8,8),false);
+      unsigned geomID1 = scene.addGeometry(RTC_GEOMETRY_STATIC,SceneGraph::createTrianglePlane(Vec3fa(-4.0f,-4.0f,-0.75f),Vec3fa(8.0f,0.0f,0.0f),Vec3fa(0.0f,8.0f,0.0f),8,8),false);
+      rtcCommit (scene);
+      AssertNoError(device);
+
+      RTCClipVolume clip;
+      if (box) {
+        const float planes[6][4] = { { 1,0,0,1 }, { -1,0,0,1 }, { 0,1,0,1 }, { 0,-1,0,1 }, { 0,0,1,0.5f }, { 0,0,-1,0.5f } };
+        clip.numPlanes = 6;
+        memcpy(clip.planes,planes,sizeof(planes));
+      } else {
+        const float plane[4] = { 1,0,0,0 };
+        clip.numPlanes = 1;
+        memcpy(clip.planes[0],plane,sizeof(plane));
+      }
+
+      /* rays are kept away from the boundary of the clip volume */
+      const size_t N = 256;
+      float x[N], y[N];
+      RTCRay rays[N];
+      for (size_t i=0; i<N; i++)
+      {
+        do {
+          x[i] = 6.0f*random_float()-3.0f;
+          y[i] = 6.0f*random_float()-3.0f;
+        } while (abs(abs(x[i])-1.0f) < 0.01f || abs(abs(y[i])-1.0f) < 0.01f || abs(x[i]) < 0.01f);
+        rays[i] = makeRay(Vec3fa(x[i],y[i],-1.0f),Vec3fa(0.0f,0.0f,1.0f),0.0f,100.0f);
+      }
+
+      /* single rays take a separate path through rtcIntersect1M */
+      if (imode == MODE_INTERSECT1M) {
+        for (size_t i=0; i<N/2; i++)
+          IntersectWithMode(imode,ivariant,scene,&rays[i],1,&clip);
+        IntersectWithMode(imode,ivariant,scene,&rays[N/2],N-N/2,&clip);
+      }
+      else
+        IntersectWithMode(imode,ivariant,scene,rays,N,&clip);
+      AssertNoError(device);
+
+      for (size_t i=0; i<N; i++)
+      {
+        if (rays[i].tnear != 0.0f) return VerifyApplication::FAILED;
+        if (!inside(x[i],y[i])) 
+        {
+          if (rays[i].geomID != RTC_INVALID_GEOMETRY_ID) return VerifyApplication::FAILED;
+          if (rays[i].tfar != 100.0f) return VerifyApplication::FAILED;
+          continue;
+        }
+        if (ivariant & VARIANT_OCCLUDED) {
+          if (rays[i].geomID != 0) return VerifyApplication::FAILED;
+          continue;
+        }
+        const unsigned geomID = box ? geomID0 : geomID1;
+        const float t = box ? 1.0f : 0.25f;
+        if (rays[i].geomID != geomID) return VerifyApplication::FAILED;
+        if (abs(rays[i].tfar-t) > 1E-5f) return VerifyApplication::FAILED;
+      }
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct ClipVolumeArgumentTest : public VerifyApplication::Test
+  {
+    ClipVolumeArgumentTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    /* every API call taking a context has to reject the invalid clip volume */
+    void checkContext(RTCDevice device, RTCScene scene, const RTCIntersectContext& context)
+    {
+      RTCRay ray = makeRay(Vec3fa(0.0f,0.0f,-2.0f),Vec3fa(0.0f,0.0f,1.0f));
+      rtcIntersect1M(scene,&context,&ray,1,sizeof(RTCRay));
+      AssertError(device,RTC_INVALID_ARGUMENT);
+      rtcOccluded1M(scene,&context,&ray,1,sizeof(RTCRay));
+      AssertError(device,RTC_INVALID_ARGUMENT);
+
+      RTCCamera camera;
+      memset(&camera,0,sizeof(camera));
+      RTCTileHit hits[4];
+      rtcIntersectTile(scene,&context,camera,0,0,2,2,hits,2*sizeof(RTCTileHit));
+      AssertError(device,RTC_INVALID_ARGUMENT);
+
+      RTCRayQueue queue = rtcNewRayQueue(scene,&context,RTC_RAY_QUEUE_INTERSECT,[] (void*, RTCRay*, const unsigned int*, size_t) {},nullptr);
+      AssertError(device,RTC_INVALID_ARGUMENT);
+      if (queue) throw std::runtime_error("ray queue created for invalid context");
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      error_handler(rtcDeviceGetError(device));
+
+      VerifyScene scene(device,RTC_SCENE_STATIC,aflags_all);
+      scene.addGeometry(RTC_GEOMETRY_STATIC,SceneGraph::createTriangleSphere(zero,1.0f,10),false);
+      rtcCommit(scene);
+      AssertNoError(device);
+
+      RTCIntersectContext context;
+      context.flags = RTC_INTERSECT_CLIP_VOLUME;
+      context.userRayExt = nullptr;
+      context.clipVolume = nullptr;
+      context.occlusionCache = nullptr;
+      checkContext(device,scene,context);
+
+      RTCClipVolume clip;
+      memset(&clip,0,sizeof(clip));
+      clip.numPlanes = RTC_MAX_CLIP_PLANES+1;
+      context.clipVolume = &clip;
+      checkContext(device,scene,context);
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct IntersectTileTest : public VerifyApplication::Test
+  {
+    IntersectTileTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    /* renders a tile and compares each pixel against a single ray through the same camera */
+    bool checkTile(RTCScene scene, const RTCCamera& camera, unsigned x0, unsigned y0, unsigned width, unsigned height)
+    {
+      /* rows get padded by 3 hit records that have to stay untouched */
+      const unsigned pad = 3;
+      const size_t stride = (width+pad)*sizeof(RTCTileHit);
+      const unsigned marker = 0x12345678;
+      std::vector<RTCTileHit> hits((width+pad)*height);
+      for (auto& hit : hits) hit.geomID = marker;
+
+      RTCIntersectContext context;
+      context.flags = RTC_INTERSECT_COHERENT;
+      context.userRayExt = nullptr;
+      rtcIntersectTile(scene,&context,camera,x0,y0,width,height,hits.data(),stride);
+
+      const Vec3fa dir00(camera.dir00[0],camera.dir00[1],camera.dir00[2]);
+      const Vec3fa dirdx(camera.dirdx[0],camera.dirdx[1],camera.dirdx[2]);
+      const Vec3fa dirdy(camera.dirdy[0],camera.dirdy[1],camera.dirdy[2]);
+      Vec3fa lensOffset(zero);
+      if (camera.lensRadius > 0.0f)
+        lensOffset = camera.lensRadius*(camera.lensSample[0]*normalize(dirdx) + camera.lensSample[1]*normalize(dirdy));
+      const Vec3fa org = Vec3fa(camera.org[0],camera.org[1],camera.org[2]) + lensOffset;
+
+      size_t numHits = 0;
+      for (unsigned y=0; y<height; y++)
+      {
+        for (unsigned x=0; x<width+pad; x++)
+        {
+          const RTCTileHit& hit = hits[y*(width+pad)+x];
+          if (x >= width) {
+            if (hit.geomID != marker) return false;
+            continue;
+          }
+          Vec3fa dir = dir00 + (float(x0+x)+0.5f)*dirdx + (float(y0+y)+0.5f)*dirdy;
+          if (camera.lensRadius > 0.0f) dir = camera.focalDistance*dir - lensOffset;
+          RTCRay ray = makeRay(org,dir,camera.tnear,camera.tfar);
+          ray.time = camera.time;
+          ray.mask = camera.mask;
+          rtcIntersect(scene,ray);
+
+          if (hit.geomID != ray.geomID) return false;
+          if (ray.geomID == RTC_INVALID_GEOMETRY_ID) continue;
+          if (hit.primID != ray.primID) return false;
+          if (hit.instID != ray.instID) return false;
+          if (abs(hit.t-ray.tfar) > 1E-4f*ray.tfar) return false;
+          if (abs(hit.u-ray.u) > 1E-3f || abs(hit.v-ray.v) > 1E-3f) return false;
+          numHits++;
+        }
+      }
+      return numHits != 0;
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      error_handler(rtcDeviceGetError(device));
+
+      VerifyScene scene(device,RTC_SCENE_STATIC,aflags_all);
+      scene.addGeometry(RTC_GEOMETRY_STATIC,SceneGraph::createTriangleSphere(zero,1.0f,10),false);
+      scene.addGeometry(RTC_GEOMETRY_STATIC,SceneGraph::createQuadSphere(Vec3fa(1.0f,1.0f,1.0f),0.75f,10),false);
+      rtcCommit(scene);
+      AssertNoError(device);
+
+      /* camera looking at the spheres, the image plane at distance 3 spans [-2,2]x[-2,2] for 16x16 pixels */
+      RTCCamera camera;
+      camera.org[0]   = 0.0f;  camera.org[1]   = 0.0f;  camera.org[2]   = -3.0f;
+      camera.dir00[0] = -2.0f; camera.dir00[1] = -2.0f; camera.dir00[2] = 3.0f;
+      camera.dirdx[0] = 0.25f; camera.dirdx[1] = 0.0f;  camera.dirdx[2] = 0.0f;
+      camera.dirdy[0] = 0.0f;  camera.dirdy[1] = 0.25f; camera.dirdy[2] = 0.0f;
+      camera.lensRadius = 0.0f; camera.focalDistance = 1.0f;
+      camera.lensSample[0] = camera.lensSample[1] = 0.0f;
+      camera.tnear = 0.0f; camera.tfar = inf; camera.time = 0.0f;
+      camera.mask = -1;
+
+      bool passed = true;
+      passed &= checkTile(scene,camera,0,0,16,16);
+      passed &= checkTile(scene,camera,4,8,8,4);
+      passed &= checkTile(scene,camera,3,5,7,5);
+      passed &= checkTile(scene,camera,1,2,13,11);
+
+      /* thin lens camera focused on the front of the sphere */
+      camera.lensRadius = 0.2f; camera.focalDistance = 0.7f;
+      camera.lensSample[0] = 0.3f; camera.lensSample[1] = -0.6f;
+      passed &= checkTile(scene,camera,0,0,16,16);
+      passed &= checkTile(scene,camera,3,5,7,5);
+      AssertNoError(device);
+
+      return (VerifyApplication::TestReturnValue) passed;
+    }
+  };
+
+  struct OcclusionCacheTest : public VerifyApplication::Test
+  {
+    OcclusionCacheTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      error_handler(rtcDeviceGetError(device));
+
+      VerifyScene scene(device,RTC_SCENE_STATIC,aflags_all);
+      scene.addGeometry(RTC_GEOMETRY_STATIC,SceneGraph::createTriangleSphere(zero,1.0f,10),false);
+      rtcCommit(scene);
+      AssertNoError(device);
+
+      RTCOcclusionCache cache;
+      memset(&cache,0,sizeof(cache));
+      RTCIntersectContext context;
+      context.flags = (RTCIntersectFlags) (RTC_INTERSECT_INCOHERENT | RTC_INTERSECT_OCCLUSION_CACHE);
+      context.userRayExt = nullptr;
+      context.occlusionCache = &cache;
+
+      /* alternating occluded and unoccluded rays through the same slot,
+       * using single rays and streams, a stale cache entry must never
+       * report an occlusion */
+      const size_t N = 16;
+      for (size_t iter=0; iter<4; iter++)
+      {
+        RTCRay rays[N];
+        for (size_t i=0; i<N; i++) {
+          const float y = (i+iter)%2 ? 5.0f : 0.05f*float(i);
+          rays[i] = makeRay(Vec3fa(0.0f,y,-2.0f),Vec3fa(0.0f,0.0f,1.0f));
+        }
+        cache.slot = unsigned(iter%2);
+        for (size_t i=0; i<N; i++)
+          rtcOccluded1M(scene,&context,&rays[i],1,sizeof(RTCRay));
+        for (size_t i=0; i<N; i++) {
+          const unsigned expected = (i+iter)%2 ? RTC_INVALID_GEOMETRY_ID : 0;
+          if (rays[i].geomID != expected) return VerifyApplication::FAILED;
+        }
+
+        for (size_t i=0; i<N; i++) {
+          const float y = (i+iter)%2 ? 5.0f : 0.05f*float(i);
+          rays[i] = makeRay(Vec3fa(0.0f,y,-2.0f),Vec3fa(0.0f,0.0f,1.0f));
+        }
+        rtcOccluded1M(scene,&context,rays,N,sizeof(RTCRay));
+        for (size_t i=0; i<N; i++) {
+          const unsigned expected = (i+iter)%2 ? RTC_INVALID_GEOMETRY_ID : 0;
+          if (rays[i].geomID != expected) return VerifyApplication::FAILED;
+        }
+      }
+      AssertNoError(device);
+
+      /* moving geometry of a dynamic scene has to invalidate the cached leaves of older commits */
+      return checkRecommit(device,context) ? VerifyApplication::PASSED : VerifyApplication::FAILED;
+    }
+
+    bool occluded(RTCScene scene, RTCIntersectContext& context, const Vec3fa& org)
+    {
+      RTCRay ray = makeRay(org,Vec3fa(0.0f,0.0f,1.0f));
+      rtcOccluded1M(scene,&context,&ray,1,sizeof(RTCRay));
+      return ray.geomID != RTC_INVALID_GEOMETRY_ID;
+    }
+
+    bool checkRecommit(const RTCDeviceRef& device, RTCIntersectContext& context)
+    {
+      VerifyScene scene(device,RTC_SCENE_DYNAMIC,aflags_all);
+      Ref<SceneGraph::TriangleMeshNode> mesh = SceneGraph::createTriangleSphere(zero,1.0f,10).dynamicCast<SceneGraph::TriangleMeshNode>();
+      unsigned geomID = scene.addGeometry(RTC_GEOMETRY_DEFORMABLE,mesh.dynamicCast<SceneGraph::Node>(),false);
+      rtcCommit(scene);
+      AssertNoError(device);
+
+      RTCOcclusionCache& cache = *context.occlusionCache;
+      memset(&cache,0,sizeof(cache));
+      cache.slot = 3;
+
+      /* the first ray caches its occluding leaf, the second one gets occluded by that leaf */
+      const Vec3fa org0(0.0f,0.1f,-2.0f);
+      if (!occluded(scene,context,org0)) return false;
+      size_t* entry = cache.entries[cache.slot];
+      const size_t build = entry[1], leaf = entry[2];
+      if (leaf == 0) return false;
+      if (!occluded(scene,context,org0+Vec3fa(0.0f,0.01f,0.0f))) return false;
+      if (entry[1] != build || entry[2] != leaf) return false;
+
+      /* move the sphere away, the refitted BVH may reuse the cached leaf */
+      for (auto& v : mesh->v) v.x += 4.0f;
+      rtcUpdate(scene,geomID);
+      rtcCommit(scene);
+      AssertNoError(device);
+      if (occluded(scene,context,org0)) return false;
+
+      /* a ray towards the new position finds the sphere again and replaces the stale entry */
+      const Vec3fa org1 = org0+Vec3fa(4.0f,0.0f,0.0f);
+      if (!occluded(scene,context,org1)) return false;
+      if (entry[1] == build) return false;
+      if (!occluded(scene,context,org1+Vec3fa(0.0f,0.01f,0.0f))) return false;
+      AssertNoError(device);
+      return true;
+    }
+  };
+
+  struct RayQueueTest : public VerifyApplication::Test
+  {
+    RayQueueTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    struct QueueState
+    {
+      QueueState (size_t numRays)
+        : numRays(numRays), hits(new std::atomic<int>[2*numRays]), passed(true) 
+      {
+        for (size_t i=0; i<2*numRays; i++) hits[i] = 0;
+      }
+
+      RTCRayQueue queue;
+      size_t numRays;
+      std::unique_ptr<std::atomic<int>[]> hits;
+      std::atomic<bool> passed;
+    };
+
+    /* appends a range of primary rays in small batches */
+    struct AppendTask
+    {
+      QueueState* state;
+      size_t begin, end;
+    };
+
+    /* counts the hits per ray and spawns a second bounce from the sphere center for each primary ray, 
+     * gets called concurrently by all threads that complete a chunk */
+    static void traced(void* userPtr, RTCRay* rays, const unsigned int* rayIDs, size_t N)
+    {
+      QueueState* state = (QueueState*) userPtr;
+      for (size_t i=0; i<N; i++)
+      {
+        if (rays[i].geomID != 0) state->passed = false;
+        state->hits[rayIDs[i]]++;
+        if (rayIDs[i] >= state->numRays) continue;
+        RTCRay ray = makeRay(Vec3fa(0.0f,0.0f,0.0f),Vec3fa(0.0f,0.0f,1.0f));
+        unsigned int rayID = unsigned(rayIDs[i]+state->numRays);
+        rtcRayQueueAppend(state->queue,&ray,&rayID,1,sizeof(RTCRay));
+      }
+    }
+
+    /* every second ray is terminated and has to get dropped by the queue */
+    static void append(AppendTask* task)
+    {
+      const size_t batch = 37;
+      RTCRay rays[batch];
+      unsigned int rayIDs[batch];
+      for (size_t i=task->begin; i<task->end; i+=batch)
+      {
+        const size_t n = min(batch,task->end-i);
+        for (size_t j=0; j<n; j++) {
+          rays[j] = makeRay(Vec3fa(0.0f,0.0f,-2.0f),Vec3fa(0.0f,0.0f,1.0f));
+          if ((i+j)%2) rays[j].tfar = -1.0f;
+          rayIDs[j] = unsigned(i+j);
+        }
+        rtcRayQueueAppend(task->state->queue,rays,rayIDs,n,sizeof(RTCRay));
+      }
+    }
+
+    bool trace(RTCScene scene, size_t N, size_t numThreads)
+    {
+      QueueState qstate(N);
+      RTCIntersectContext context;
+      context.flags = RTC_INTERSECT_INCOHERENT;
+      context.userRayExt = nullptr;
+      qstate.queue = rtcNewRayQueue(scene,&context,RTC_RAY_QUEUE_INTERSECT,traced,&qstate);
+
+      std::vector<AppendTask> tasks(numThreads);
+      std::vector<thread_t> threads;
+      for (size_t t=0; t<numThreads; t++) {
+        tasks[t].state = &qstate;
+        tasks[t].begin = (t+0)*N/numThreads;
+        tasks[t].end   = (t+1)*N/numThreads;
+        threads.push_back(createThread((thread_func)append,&tasks[t]));
+      }
+      for (size_t t=0; t<numThreads; t++) 
+        join(threads[t]);
+
+      rtcRayQueueFlush(qstate.queue);
+      rtcDeleteRayQueue(qstate.queue);
+
+      /* each active ray and its bounce has to come back exactly once */
+      for (size_t i=0; i<N; i++) {
+        const int expected = i%2 ? 0 : 1;
+        if (qstate.hits[i] != expected || qstate.hits[N+i] != expected) return false;
+      }
+      return qstate.passed;
+    }
+    
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      error_handler(rtcDeviceGetError(device));
+
+      VerifyScene scene(device,RTC_SCENE_STATIC,aflags_all);
+      scene.addGeometry(RTC_GEOMETRY_STATIC,SceneGraph::createTriangleSphere(zero,1.0f,10),false);
+      rtcCommit(scene);
+      AssertNoError(device);
+
+      bool passed = true;
+      passed &= trace(scene,2500,1);
+      passed &= trace(scene,20000,8);
+      AssertNoError(device);
+      return (VerifyApplication::TestReturnValue) passed;
+    }
+  };
+
+  struct BuildBVHTest : public VerifyApplication::Test
+  {
+    RTCBuildQuality quality;
+
+    BuildBVHTest (std::string name, int isa, RTCBuildQuality quality)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), quality(quality) {}
+
+    struct Node 
+    {
+      size_t numChildren;     // 0 for leaves
+      BBox3fa bounds[4];      // bounds of children
+      Node* children[4];      // children of inner nodes
+      size_t numPrims;        // number of primitives of leaves
+      RTCBuildPrimitive prims[RTC_BUILD_MAX_PRIMITIVES_PER_LEAF];
+    };
+
+    static void* createNode (RTCThreadLocalAllocator alloc, size_t numChildren, void* userPtr)
+    {
+      Node* node = (Node*) rtcThreadLocalAlloc(alloc,sizeof(Node),32);
+      node->numChildren = numChildren;
+      node->numPrims = 0;
+      return node;
+    }
+
+    static void setNodeChildren (void* nodePtr, void** children, size_t numChildren, void* userPtr)
+    {
+      for (size_t i=0; i<numChildren; i++)
+        ((Node*)nodePtr)->children[i] = (Node*) children[i];
+    }
+
+    static void setNodeBounds (void* nodePtr, const RTCBounds** bounds, size_t numChildren, void* userPtr)
+    {
+      for (size_t i=0; i<numChildren; i++)
+        ((Node*)nodePtr)->bounds[i] = *(const BBox3fa*) bounds[i];
+    }
+
+    static void* createLeaf (RTCThreadLocalAllocator alloc, const RTCBuildPrimitive* prims, size_t numPrims, void* userPtr)
+    {
+      Node* node = (Node*) rtcThreadLocalAlloc(alloc,sizeof(Node),32);
+      node->numChildren = 0;
+      node->numPrims = numPrims;
+      for (size_t i=0; i<numPrims; i++) node->prims[i] = prims[i];
+      return node;
+    }
+
+    static void splitPrimitive (const RTCBuildPrimitive* prim, unsigned dim, float pos, RTCBounds* lbounds, RTCBounds* rbounds, void* userPtr)
+    {
+      *(BBox3fa*) lbounds = BBox3fa(Vec3fa(prim->lower_x,prim->lower_y,prim->lower_z),Vec3fa(prim->upper_x,prim->upper_y,prim->upper_z));
+      *(BBox3fa*) rbounds = *(BBox3fa*) lbounds;
+      (&lbounds->upper_x)[dim] = pos;
+      (&rbounds->lower_x)[dim] = pos;
+    }
+
+    /* checks that all primitives of a subtree are contained in the bounds stored in the parent */
+    static bool verify(const Node* node, const BBox3fa& bounds, std::vector<size_t>& counts)
+    {
+      if (node->numChildren == 0)
+      {
+        if (node->numPrims > 4) return false;
+        for (size_t i=0; i<node->numPrims; i++) {
+          const RTCBuildPrimitive& prim = node->prims[i];
+          const BBox3fa b(Vec3fa(prim.lower_x,prim.lower_y,prim.lower_z),Vec3fa(prim.upper_x,prim.upper_y,prim.upper_z));
+          if (!subset(b,bounds)) return false;
+          if (prim.geomID != 7 || prim.primID < 0 || size_t(prim.primID) >= counts.size()) return false;
+          counts[prim.primID]++;
+        }
+        return true;
+      }
+      if (node->numChildren < 2 || node->numChildren > 4) return false;
+      for (size_t i=0; i<node->numChildren; i++) {
+        if (!subset(node->bounds[i],bounds)) return false;
+        if (!verify(node->children[i],node->bounds[i],counts)) return false;
+      }
+      return true;
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      error_handler(rtcDeviceGetError(device));
+
+      const size_t N = 10000;
+      const size_t extraSpace = quality == RTC_BUILD_QUALITY_HIGH ? N : 0;
+      avector<RTCBuildPrimitive> prims(N+extraSpace);
+      BBox3fa sceneBounds = empty;
+      for (size_t i=0; i<N; i++) 
       {
-        for (unsigned int i=0; i<10; i++) {
-          rtcDisable(scene,i);
-          AssertAnyError(device);
-        }
+        const Vec3fa p = 100.0f*Vec3fa(random_float(),random_float(),random_float());
+        const Vec3fa d = 5.0f*Vec3fa(random_float(),random_float(),random_float());
+        RTCBuildPrimitive& prim = prims[i];
+        prim.lower_x = p.x; prim.lower_y = p.y; prim.lower_z = p.z; prim.geomID = 7;
+        prim.upper_x = p.x+d.x; prim.upper_y = p.y+d.y; prim.upper_z = p.z+d.z; prim.primID = int(i);
+        sceneBounds.extend(BBox3fa(p,p+d));
       }
+
+      RTCBuildSettings settings = rtcDefaultBuildSettings();
+      settings.quality = quality;
+      settings.maxBranchingFactor = 4;
+      settings.maxLeafSize = 4;
+      settings.extraSpace = unsigned(extraSpace);
+
+      RTCBVH bvh = rtcNewBVH(device);
+      const Node* root = (const Node*) rtcBuildBVH(bvh,settings,prims.data(),N,createNode,setNodeChildren,setNodeBounds,createLeaf,splitPrimitive,nullptr,nullptr);
+      AssertNoError(device);
+      rtcMakeStaticBVH(bvh);
       AssertNoError(device);
 
-      return VerifyApplication::PASSED;
+      /* every primitive has to be referenced, spatial splits may reference it multiple times */
+      std::vector<size_t> counts(N,0);
+      bool passed = root != nullptr && verify(root,sceneBounds,counts);
+      for (size_t i=0; i<N && passed; i++) {
+        if (counts[i] == 0) passed = false;
+        if (quality != RTC_BUILD_QUALITY_HIGH && counts[i] != 1) passed = false;
+      }
+
+      /* spatial split builds reserve the upper 8 bits of the geomID */
+      if (quality == RTC_BUILD_QUALITY_HIGH) {
+        prims[0].geomID = 1 << 24;
+        rtcBuildBVH(bvh,settings,prims.data(),N,createNode,setNodeChildren,setNodeBounds,createLeaf,splitPrimitive,nullptr,nullptr);
+        AssertError(device,RTC_INVALID_ARGUMENT);
+      }
+      rtcDeleteBVH(bvh);
+      AssertNoError(device);
+      return (VerifyApplication::TestReturnValue) passed;
     }
   };
 
@@ -1435,6 +2559,35 @@ namespace embree
     }
   };
 
+  /* interpolates an odd number of hits with some inactive ones using rtcInterpolateN and compares against rtcInterpolate */
+  bool checkInterpolationN(VerifyApplication::Test* test, const RTCSceneRef& scene, int geomID, RTCBufferType buffer, size_t numPrims, float maxUV, size_t N)
+  {
+    const size_t numUVs = 13;
+    int valid[numUVs]; unsigned primIDs[numUVs]; float u[numUVs], v[numUVs];
+    for (size_t i=0; i<numUVs; i++) {
+      valid[i] = (i%5 == 3) ? 0 : -1;
+      primIDs[i] = unsigned(i*7) % numPrims;
+      u[i] = maxUV*test->random_float();
+      v[i] = maxUV*test->random_float();
+    }
+    std::vector<float> P(N*numUVs,-1.0f), dPdu(N*numUVs,-1.0f), dPdv(N*numUVs,-1.0f);
+    rtcInterpolateN(scene,geomID,valid,primIDs,u,v,numUVs,buffer,P.data(),dPdu.data(),dPdv.data(),N);
+
+    bool passed = true;
+    for (size_t i=0; i<numUVs; i++)
+    {
+      float P1[256], dPdu1[256], dPdv1[256];
+      rtcInterpolate(scene,geomID,primIDs[i],u[i],v[i],buffer,P1,dPdu1,dPdv1,N);
+      for (size_t j=0; j<N; j++) {
+        if (!valid[i]) { passed &= P[j*numUVs+i] == -1.0f; continue; }
+        passed &= fabs(P   [j*numUVs+i]-P1   [j]) < 1E-4f;
+        passed &= fabs(dPdu[j*numUVs+i]-dPdu1[j]) < 1E-4f;
+        passed &= fabs(dPdv[j*numUVs+i]-dPdv1[j]) < 1E-4f;
+      }
+    }
+    return passed;
+  }
+
   struct InterpolateTrianglesTest : public VerifyApplication::Test
   {
     size_t N;
@@ -1519,6 +2672,9 @@ namespace embree
       //passed &= checkTriangleInterpolation(scene,geomID,RTC_VERTEX_BUFFER1,vertices1,1,N);
       passed &= checkTriangleInterpolation(scene,geomID,RTC_USER_VERTEX_BUFFER0,user_vertices0,1,N);
       passed &= checkTriangleInterpolation(scene,geomID,RTC_USER_VERTEX_BUFFER1,user_vertices1,1,N);
+
+      passed &= checkInterpolationN(this,scene,geomID,RTC_VERTEX_BUFFER0,num_interpolation_triangle_faces,0.5f,N);
+      passed &= checkInterpolationN(this,scene,geomID,RTC_USER_VERTEX_BUFFER0,num_interpolation_triangle_faces,0.5f,N);
       
       delete[] vertices0;
       //delete[] vertices1;
@@ -1530,6 +2686,53 @@ namespace embree
     }
   };
   
+  struct InterpolateQuadsTest : public VerifyApplication::Test
+  {
+    size_t N;
+    
+    InterpolateQuadsTest (std::string name, int isa, size_t N)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), N(N) {}
+    
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      error_handler(rtcDeviceGetError(device));
+
+      size_t M = num_interpolation_vertices*N+16; // padds the arrays with some valid data
+      
+      RTCSceneRef scene = rtcDeviceNewScene(device,RTC_SCENE_DYNAMIC,RTC_INTERPOLATE);
+      AssertNoError(device);
+      unsigned int geomID = rtcNewQuadMesh(scene, RTC_GEOMETRY_STATIC, num_interpolation_quad_faces, num_interpolation_vertices, 1);
+      AssertNoError(device);
+      
+      rtcSetBuffer(scene, geomID, RTC_INDEX_BUFFER,  interpolation_quad_indices , 0, 4*sizeof(unsigned int));
+      AssertNoError(device);
+      
+      std::vector<float> vertices0(M);
+      for (size_t i=0; i<M; i++) vertices0[i] = random_float();
+      rtcSetBuffer(scene, geomID, RTC_VERTEX_BUFFER0, vertices0.data(), 0, N*sizeof(float));
+      AssertNoError(device);
+      
+      std::vector<float> user_vertices0(M);
+      for (size_t i=0; i<M; i++) user_vertices0[i] = random_float();
+      rtcSetBuffer(scene, geomID, RTC_USER_VERTEX_BUFFER0, user_vertices0.data(), 0, N*sizeof(float));
+      AssertNoError(device);
+      
+      rtcDisable(scene,geomID);
+      AssertNoError(device);
+      rtcCommit(scene);
+      AssertNoError(device);
+      
+      bool passed = true;
+      passed &= checkInterpolationN(this,scene,geomID,RTC_VERTEX_BUFFER0,num_interpolation_quad_faces,1.0f,N);
+      passed &= checkInterpolationN(this,scene,geomID,RTC_USER_VERTEX_BUFFER0,num_interpolation_quad_faces,1.0f,N);
+      AssertNoError(device);
+
+      return (VerifyApplication::TestReturnValue) passed;
+    }
+  };
+  
   const size_t num_interpolation_hair_vertices = 13;
   const size_t num_interpolation_hairs = 4;
 
@@ -1540,9 +2743,10 @@ namespace embree
   struct InterpolateHairTest : public VerifyApplication::Test
   {
     size_t N;
+    RTCCurveBasis basis;
     
-    InterpolateHairTest (std::string name, int isa, size_t N)
-      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), N(N) {}
+    InterpolateHairTest (std::string name, int isa, size_t N, RTCCurveBasis basis = RTC_BASIS_BEZIER)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), N(N), basis(basis) {}
     
     bool checkHairInterpolation(const RTCSceneRef& scene, int geomID, int primID, float u, float v, int v0, RTCBufferType buffer, float* data, size_t N, size_t N_total)
     {
@@ -1551,10 +2755,24 @@ namespace embree
       rtcInterpolate(scene,geomID,primID,u,v,buffer,P,dPdu,dPdv,N);
       
       for (size_t i=0; i<N; i++) {
-        const float p00 = data[(v0+0)*N_total+i];
-        const float p01 = data[(v0+1)*N_total+i];
-        const float p02 = data[(v0+2)*N_total+i];
-        const float p03 = data[(v0+3)*N_total+i];
+        float p00 = data[(v0+0)*N_total+i];
+        float p01 = data[(v0+1)*N_total+i];
+        float p02 = data[(v0+2)*N_total+i];
+        float p03 = data[(v0+3)*N_total+i];
+        if (basis == RTC_BASIS_BSPLINE) {
+          const float q00 = (p00 + 4.0f*p01 + p02)/6.0f;
+          const float q01 = (2.0f*p01 + p02)/3.0f;
+          const float q02 = (p01 + 2.0f*p02)/3.0f;
+          const float q03 = (p01 + 4.0f*p02 + p03)/6.0f;
+          p00 = q00; p01 = q01; p02 = q02; p03 = q03;
+        }
+        else if (basis == RTC_BASIS_CATMULL_ROM) {
+          const float q00 = p01;
+          const float q01 = p01 + (p02-p00)/6.0f;
+          const float q02 = p02 - (p03-p01)/6.0f;
+          const float q03 = p02;
+          p00 = q00; p01 = q01; p02 = q02; p03 = q03;
+        }
         const float t0 = 1.0f - u, t1 = u;
         const float p10 = p00 * t0 + p01 * t1;
         const float p11 = p01 * t0 + p02 * t1;
@@ -1589,6 +2807,9 @@ namespace embree
       AssertNoError(device);
       unsigned int geomID = rtcNewHairGeometry(scene, RTC_GEOMETRY_STATIC, num_interpolation_hairs, num_interpolation_hair_vertices, 1);
       AssertNoError(device);
+
+      rtcSetCurveBasis(scene, geomID, basis);
+      AssertNoError(device);
       
       rtcSetBuffer(scene, geomID, RTC_INDEX_BUFFER,  interpolation_hair_indices , 0, sizeof(unsigned int));
       AssertNoError(device);
@@ -1684,49 +2905,328 @@ namespace embree
       rtcCommit (scene);
       AssertNoError(device);
 
-      float u[256], v[256];
-      RTCRay rays[256];
-      for (size_t i=0; i<256; i++)
-      {
-        u[i] = random_float(); 
-        v[i] = random_float();
-        Vec3fa from(0.0f,0.0f,-1.0f);
-        Vec3fa to = uniformSampleTriangle(vertices[1],vertices[2],vertices[0],u[i],v[i]);
-        rays[i] = makeRay(from,to-from);
-      }
-      IntersectWithMode(imode,ivariant,scene,rays,256);
-
-      for (size_t i=0; i<256; i++)
+      float u[256], v[256];
+      RTCRay rays[256];
+      for (size_t i=0; i<256; i++)
+      {
+        u[i] = random_float(); 
+        v[i] = random_float();
+        Vec3fa from(0.0f,0.0f,-1.0f);
+        Vec3fa to = uniformSampleTriangle(vertices[1],vertices[2],vertices[0],u[i],v[i]);
+        rays[i] = makeRay(from,to-from);
+      }
+      IntersectWithMode(imode,ivariant,scene,rays,256);
+
+      for (size_t i=0; i<256; i++)
+      {
+        if (rays[i].geomID != 0) return VerifyApplication::FAILED;
+        
+        if (ivariant & VARIANT_OCCLUDED) continue;
+
+        if (rays[i].primID != 0) return VerifyApplication::FAILED;
+        if (abs(rays[i].u - u[i]) > 16.0f*float(ulp)) return VerifyApplication::FAILED;
+        if (abs(rays[i].v - v[i]) > 16.0f*float(ulp)) return VerifyApplication::FAILED;
+        if (abs(rays[i].tfar - 1.0f) > 16.0f*float(ulp)) return VerifyApplication::FAILED;
+        const Vec3fa org(rays[i].org[0],rays[i].org[1],rays[i].org[2]);
+        const Vec3fa dir(rays[i].dir[0],rays[i].dir[1],rays[i].dir[2]);
+        const Vec3fa ht  = org + rays[i].tfar*dir;
+        const Vec3fa huv = vertices[0] + rays[i].u*(vertices[1]-vertices[0]) + rays[i].v*(vertices[2]-vertices[0]);
+        if (reduce_max(abs(ht-huv)) > 16.0f*float(ulp)) return VerifyApplication::FAILED;
+        const Vec3fa Ng = normalize(Vec3fa(rays[i].Ng[0],rays[i].Ng[1],rays[i].Ng[2])); // FIXME: some geom normals are scaled!!!??
+        if (reduce_max(abs(Ng - Vec3fa(0.0f,0.0f,-1.0f))) > 16.0f*float(ulp)) return VerifyApplication::FAILED;
+      }
+      AssertNoError(device);
+
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct QuadHitTest : public VerifyApplication::IntersectTest
+  {
+    RTCSceneFlags sflags; 
+    RTCGeometryFlags gflags; 
+
+    QuadHitTest (std::string name, int isa, RTCSceneFlags sflags, RTCGeometryFlags gflags, IntersectMode imode, IntersectVariant ivariant)
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), gflags(gflags) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      error_handler(rtcDeviceGetError(device));
+      if (!supportsIntersectMode(device,imode))
+        return VerifyApplication::SKIPPED;
+     
+      Vec3f vertices[4] = {
+        Vec3f(0.0f,0.0f,0.0f),
+        Vec3f(1.0f,0.0f,0.0f),
+        Vec3f(1.0f,1.0f,0.0f),
+        Vec3f(0.0f,1.0f,0.0f)
+      };
+      int quads[4] = {
+        0,1,2,3
+      };
+      RTCSceneRef scene = rtcDeviceNewScene(device,sflags,to_aflags(imode));
+      int geomID = rtcNewQuadMesh (scene, gflags, 1, 4);
+      rtcSetBuffer(scene, geomID, RTC_VERTEX_BUFFER, vertices , 0, sizeof(Vec3f));
+      rtcSetBuffer(scene, geomID, RTC_INDEX_BUFFER , quads, 0, 4*sizeof(int));
+      rtcCommit (scene);
+      AssertNoError(device);
+
+      float u[256], v[256];
+      RTCRay rays[256];
+      for (size_t i=0; i<256; i++)
+      {
+        u[i] = random_float(); 
+        v[i] = random_float();
+        if (u[i] < 0.001f || v[i] < 0.001f || u[i] > 0.999f || v[i] > 0.999f) { u[i] = 0.333f; v[i] = 0.333f; } // avoid hitting edges
+        Vec3fa from(0.0f,0.0f,-1.0f);
+        Vec3fa to = vertices[0] + u[i]*(vertices[1]-vertices[0]) + v[i]*(vertices[3]-vertices[0]);
+        rays[i] = makeRay(from,to-from);
+      }
+      IntersectWithMode(imode,ivariant,scene,rays,256);
+
+      for (size_t i=0; i<256; i++)
+      {
+        if (rays[i].geomID != 0) return VerifyApplication::FAILED;
+        if (ivariant & VARIANT_OCCLUDED) continue;
+        if (rays[i].primID != 0) return VerifyApplication::FAILED;
+        if (abs(rays[i].u - u[i]) > 16.0f*float(ulp)) return VerifyApplication::FAILED;
+        if (abs(rays[i].v - v[i]) > 16.0f*float(ulp)) return VerifyApplication::FAILED;
+        if (abs(rays[i].tfar - 1.0f) > 16.0f*float(ulp)) return VerifyApplication::FAILED;
+
+        const Vec3fa org(rays[i].org[0],rays[i].org[1],rays[i].org[2]);
+        const Vec3fa dir(rays[i].dir[0],rays[i].dir[1],rays[i].dir[2]);
+        const Vec3fa ht  = org + rays[i].tfar*dir;
+        const Vec3fa huv = vertices[0] + rays[i].u*(vertices[1]-vertices[0]) + rays[i].v*(vertices[3]-vertices[0]);
+        if (reduce_max(abs(ht-huv)) > 16.0f*float(ulp)) return VerifyApplication::FAILED;
+        const Vec3fa Ng = normalize(Vec3fa(rays[i].Ng[0],rays[i].Ng[1],rays[i].Ng[2])); // FIXME: some geom normals are scaled!!!??
+        if (reduce_max(abs(Ng - Vec3fa(0.0f,0.0f,-1.0f))) > 16.0f*float(ulp)) return VerifyApplication::FAILED;
+      }
+      AssertNoError(device);
+      
+      return VerifyApplication::PASSED;
+    }
+  };
+  
+  struct RibbonHitTest : public VerifyApplication::IntersectTest
+  {
+    RTCSceneFlags sflags; 
+    RTCGeometryFlags gflags; 
+
+    RibbonHitTest (std::string name, int isa, RTCSceneFlags sflags, RTCGeometryFlags gflags, IntersectMode imode, IntersectVariant ivariant)
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), gflags(gflags) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      error_handler(rtcDeviceGetError(device));
+      if (!supportsIntersectMode(device,imode))
+        return VerifyApplication::SKIPPED;
+
+      /* straight ribbon of width 1 along the x-axis facing the -z direction */
+      Vec3fa vertices[4] = {
+        Vec3fa(0.0f/3.0f,0.0f,0.0f,0.5f),
+        Vec3fa(1.0f/3.0f,0.0f,0.0f,0.5f),
+        Vec3fa(2.0f/3.0f,0.0f,0.0f,0.5f),
+        Vec3fa(3.0f/3.0f,0.0f,0.0f,0.5f)
+      };
+      Vec3fa normals[4] = {
+        Vec3fa(0.0f,0.0f,-1.0f),
+        Vec3fa(0.0f,0.0f,-1.0f),
+        Vec3fa(0.0f,0.0f,-1.0f),
+        Vec3fa(0.0f,0.0f,-1.0f)
+      };
+      int curves[1] = { 0 };
+      RTCSceneRef scene = rtcDeviceNewScene(device,sflags,to_aflags(imode));
+      int geomID = rtcNewRibbonGeometry (scene, gflags, 1, 4);
+      rtcSetBuffer(scene, geomID, RTC_VERTEX_BUFFER, vertices, 0, sizeof(Vec3fa));
+      rtcSetBuffer(scene, geomID, RTC_NORMAL_BUFFER, normals , 0, sizeof(Vec3fa));
+      rtcSetBuffer(scene, geomID, RTC_INDEX_BUFFER , curves, 0, sizeof(int));
+      rtcCommit (scene);
+      AssertNoError(device);
+
+      float x[256], y[256];
+      RTCRay rays[256];
+      for (size_t i=0; i<256; i++)
+      {
+        x[i] = 0.001f+0.998f*random_float();
+        y[i] = (i%8 == 0) ? 0.6f : 0.9f*(random_float()-0.5f); // every 8th ray passes next to the ribbon
+        rays[i] = makeRay(Vec3fa(x[i],y[i],-1.0f),Vec3fa(0.0f,0.0f,1.0f));
+      }
+      IntersectWithMode(imode,ivariant,scene,rays,256);
+
+      for (size_t i=0; i<256; i++)
+      {
+        if (i%8 == 0) {
+          if (rays[i].geomID != RTC_INVALID_GEOMETRY_ID) return VerifyApplication::FAILED;
+          continue;
+        }
+        if (rays[i].geomID != 0) return VerifyApplication::FAILED;
+        if (ivariant & VARIANT_OCCLUDED) continue;
+        if (rays[i].primID != 0) return VerifyApplication::FAILED;
+        if (abs(rays[i].u - x[i]) > 1E-4f) return VerifyApplication::FAILED;
+        if (abs(rays[i].v - (0.5f-y[i])) > 1E-4f) return VerifyApplication::FAILED;
+        if (abs(rays[i].tfar - 1.0f) > 1E-4f) return VerifyApplication::FAILED;
+        const Vec3fa Ng = normalize(Vec3fa(rays[i].Ng[0],rays[i].Ng[1],rays[i].Ng[2]));
+        if (reduce_max(abs(Ng - Vec3fa(0.0f,0.0f,-1.0f))) > 1E-4f) return VerifyApplication::FAILED;
+      }
+      AssertNoError(device);
+      
+      return VerifyApplication::PASSED;
+    }
+  };
+  
+  struct PointHitTest : public VerifyApplication::IntersectTest
+  {
+    RTCSceneFlags sflags; 
+    RTCGeometryFlags gflags; 
+
+    PointHitTest (std::string name, int isa, RTCSceneFlags sflags, RTCGeometryFlags gflags, IntersectMode imode, IntersectVariant ivariant)
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), gflags(gflags) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      error_handler(rtcDeviceGetError(device));
+      if (!supportsIntersectMode(device,imode))
+        return VerifyApplication::SKIPPED;
+
+      /* a unit sphere at the origin and a unit disc next to it */
+      Vec3fa spheres[2] = { Vec3fa(-10.0f,0.0f,0.0f,1.0f), Vec3fa(0.0f,0.0f,0.0f,1.0f) };
+      Vec3fa discs  [1] = { Vec3fa(3.0f,0.0f,0.0f,1.0f) };
+      RTCSceneRef scene = rtcDeviceNewScene(device,sflags,to_aflags(imode));
+      unsigned geomID0 = rtcNewPoints (scene, gflags, 2);
+      rtcSetBuffer(scene, geomID0, RTC_VERTEX_BUFFER, spheres, 0, sizeof(Vec3fa));
+      unsigned geomID1 = rtcNewDiscPoints (scene, gflags, 1);
+      rtcSetBuffer(scene, geomID1, RTC_VERTEX_BUFFER, discs, 0, sizeof(Vec3fa));
+      rtcCommit (scene);
+      AssertNoError(device);
+
+      float x[256], y[256];
+      RTCRay rays[256];
+      for (size_t i=0; i<256; i++)
+      {
+        const float r = 0.9f*sqrt(random_float());
+        const float phi = float(two_pi)*random_float();
+        x[i] = ((i%2) ? 3.0f : 0.0f) + r*cos(phi);
+        y[i] = (i%8 == 0) ? 1.2f : r*sin(phi); // every 8th ray passes next to the points
+        rays[i] = makeRay(Vec3fa(x[i],y[i],-5.0f),Vec3fa(0.0f,0.0f,1.0f));
+      }
+      IntersectWithMode(imode,ivariant,scene,rays,256);
+
+      for (size_t i=0; i<256; i++)
+      {
+        if (i%8 == 0) {
+          if (rays[i].geomID != RTC_INVALID_GEOMETRY_ID) return VerifyApplication::FAILED;
+          continue;
+        }
+        const bool disc = i%2;
+        /* occlusion queries only report a hit by setting geomID to 0 */
+        if (ivariant & VARIANT_OCCLUDED) {
+          if (rays[i].geomID != 0) return VerifyApplication::FAILED;
+          continue;
+        }
+        if (rays[i].geomID != (disc ? geomID1 : geomID0)) return VerifyApplication::FAILED;
+        if (rays[i].primID != (disc ? 0u : 1u)) return VerifyApplication::FAILED;
+        const float dx = disc ? x[i]-3.0f : x[i];
+        const float dz = disc ? 0.0f : sqrt(1.0f-dx*dx-y[i]*y[i]);
+        if (abs(rays[i].tfar - (5.0f-dz)) > 1E-3f) return VerifyApplication::FAILED;
+        const Vec3fa Ng = normalize(Vec3fa(rays[i].Ng[0],rays[i].Ng[1],rays[i].Ng[2]));
+        const Vec3fa Ng_expected = disc ? Vec3fa(0.0f,0.0f,-1.0f) : Vec3fa(dx,y[i],-dz);
+        if (reduce_max(abs(Ng - Ng_expected)) > 1E-3f) return VerifyApplication::FAILED;
+      }
+      AssertNoError(device);
+      
+      return VerifyApplication::PASSED;
+    }
+  };
+  
+  struct CompressedTrianglesTest : public VerifyApplication::IntersectTest
+  {
+    CompressedTrianglesTest (std::string name, int isa, IntersectMode imode)
+      : VerifyApplication::IntersectTest(name,isa,imode,VARIANT_INTERSECT,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    /* creates the scene on a device that uses the specified triangle acceleration structure */
+    RTCDevice createDevice(VerifyApplication* state, const std::string& accel) {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa)+",tri_accel="+accel;
+      return rtcNewDevice(cfg.c_str());
+    }
+
+    void addGeometry(VerifyScene& scene, int seed)
+    {
+      /* triangles of the sphere share most vertices, triangles of the
+       * soup share none, thus their leaves span multiple blocks */
+      scene.addGeometry(RTC_GEOMETRY_STATIC,SceneGraph::createTriangleSphere(zero,1.0f,50),false);
+      Ref<SceneGraph::TriangleMeshNode> soup = new SceneGraph::TriangleMeshNode(nullptr);
+      RandomSampler sampler; RandomSampler_init(sampler,seed);
+      for (unsigned i=0; i<2000; i++) {
+        const Vec3fa p = 4.0f*RandomSampler_get3D(sampler)-Vec3fa(2.0f);
+        soup->v.push_back(p);
+        soup->v.push_back(p+0.1f*RandomSampler_get3D(sampler));
+        soup->v.push_back(p+0.1f*RandomSampler_get3D(sampler));
+        soup->triangles.push_back(SceneGraph::TriangleMeshNode::Triangle(3*i+0,3*i+1,3*i+2));
+      }
+      scene.addGeometry(RTC_GEOMETRY_STATIC,soup.dynamicCast<SceneGraph::Node>(),false);
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      RTCDeviceRef device  = createDevice(state,"bvh4.triangle4c");
+      RTCDeviceRef device2 = createDevice(state,"bvh4.triangle4i");
+      error_handler(rtcDeviceGetError(device));
+      error_handler(rtcDeviceGetError(device2));
+      if (!supportsIntersectMode(device,imode))
+        return VerifyApplication::SKIPPED;
+
+      const int seed = RandomSampler_getInt(sampler);
+      VerifyScene scene(device,RTC_SCENE_STATIC,to_aflags(imode));
+      VerifyScene refScene(device2,RTC_SCENE_STATIC,RTC_INTERSECT1);
+      addGeometry(scene,seed);
+      addGeometry(refScene,seed);
+      rtcCommit (scene);
+      rtcCommit (refScene);
+      AssertNoError(device);
+      AssertNoError(device2);
+
+      size_t numHits = 0;
+      const size_t M = 64;
+      for (size_t i=0; i<size_t(100*state->intensity); i++)
       {
-        if (rays[i].geomID != 0) return VerifyApplication::FAILED;
-        
-        if (ivariant & VARIANT_OCCLUDED) continue;
-
-        if (rays[i].primID != 0) return VerifyApplication::FAILED;
-        if (abs(rays[i].u - u[i]) > 16.0f*float(ulp)) return VerifyApplication::FAILED;
-        if (abs(rays[i].v - v[i]) > 16.0f*float(ulp)) return VerifyApplication::FAILED;
-        if (abs(rays[i].tfar - 1.0f) > 16.0f*float(ulp)) return VerifyApplication::FAILED;
-        const Vec3fa org(rays[i].org[0],rays[i].org[1],rays[i].org[2]);
-        const Vec3fa dir(rays[i].dir[0],rays[i].dir[1],rays[i].dir[2]);
-        const Vec3fa ht  = org + rays[i].tfar*dir;
-        const Vec3fa huv = vertices[0] + rays[i].u*(vertices[1]-vertices[0]) + rays[i].v*(vertices[2]-vertices[0]);
-        if (reduce_max(abs(ht-huv)) > 16.0f*float(ulp)) return VerifyApplication::FAILED;
-        const Vec3fa Ng = normalize(Vec3fa(rays[i].Ng[0],rays[i].Ng[1],rays[i].Ng[2])); // FIXME: some geom normals are scaled!!!??
-        if (reduce_max(abs(Ng - Vec3fa(0.0f,0.0f,-1.0f))) > 16.0f*float(ulp)) return VerifyApplication::FAILED;
+        __aligned(16) RTCRay rays[M];
+        __aligned(16) RTCRay refs[M];
+        for (size_t j=0; j<M; j++) {
+          const Vec3fa org = 6.0f*random_Vec3fa()-Vec3fa(3.0f);
+          const Vec3fa dir = random_Vec3fa()-Vec3fa(0.5f)-org;
+          rays[j] = refs[j] = makeRay(org,dir);
+          rtcIntersect(refScene,refs[j]);
+        }
+        IntersectWithMode(imode,VARIANT_INTERSECT,scene,rays,M);
+        for (size_t j=0; j<M; j++) 
+        {
+          if (rays[j].geomID != refs[j].geomID) return VerifyApplication::FAILED;
+          if (refs[j].geomID == RTC_INVALID_GEOMETRY_ID) continue;
+          if (rays[j].primID != refs[j].primID) return VerifyApplication::FAILED;
+          if (abs(rays[j].tfar-refs[j].tfar) > 1E-5f*refs[j].tfar) return VerifyApplication::FAILED;
+          if (abs(rays[j].u-refs[j].u) > 1E-4f || abs(rays[j].v-refs[j].v) > 1E-4f) return VerifyApplication::FAILED;
+          numHits++;
+        }
       }
       AssertNoError(device);
-
-      return VerifyApplication::PASSED;
+      return numHits ? VerifyApplication::PASSED : VerifyApplication::FAILED;
     }
   };
 
-  struct QuadHitTest : public VerifyApplication::IntersectTest
+  struct VertexFormatTest : public VerifyApplication::IntersectTest
   {
     RTCSceneFlags sflags; 
     RTCGeometryFlags gflags; 
+    RTCVertexFormat format;
 
-    QuadHitTest (std::string name, int isa, RTCSceneFlags sflags, RTCGeometryFlags gflags, IntersectMode imode, IntersectVariant ivariant)
-      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), gflags(gflags) {}
+    VertexFormatTest (std::string name, int isa, RTCSceneFlags sflags, RTCGeometryFlags gflags, RTCVertexFormat format, IntersectMode imode, IntersectVariant ivariant)
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), gflags(gflags), format(format) {}
 
     VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
     {
@@ -1735,52 +3235,67 @@ namespace embree
       error_handler(rtcDeviceGetError(device));
       if (!supportsIntersectMode(device,imode))
         return VerifyApplication::SKIPPED;
-     
-      Vec3f vertices[4] = {
-        Vec3f(0.0f,0.0f,0.0f),
-        Vec3f(1.0f,0.0f,0.0f),
-        Vec3f(1.0f,1.0f,0.0f),
-        Vec3f(0.0f,1.0f,0.0f)
-      };
-      int quads[4] = {
-        0,1,2,3
-      };
+
+      /* a 4x2 grid of triangle pairs in [-2,2]x[-2,0] and a 4x2 grid of quads in [-2,2]x[0,2], both at z=1 */
+      const float scale[3]  = { 1.0f/8192.0f, 1.0f/8192.0f, 1.0f/8192.0f };
+      const float offset[3] = { -2.0f, -2.0f, 0.0f };
+      unsigned short vertices[2][5*3*3];
+      for (size_t m=0; m<2; m++) {
+        for (size_t y=0; y<3; y++) {
+          for (size_t x=0; x<5; x++) {
+            const Vec3fa p(-2.0f+float(x),-2.0f+float(2*m+y),1.0f);
+            unsigned short* v = &vertices[m][3*(5*y+x)];
+            for (size_t k=0; k<3; k++)
+              v[k] = format == RTC_VERTEX_FORMAT_HALF3 ? float_to_half(p[k]) : (unsigned short) ((p[k]-offset[k])/scale[k]);
+          }
+        }
+      }
+      Triangle triangles[16]; SceneGraph::QuadMeshNode::Quad quads[8];
+      for (int y=0; y<2; y++) {
+        for (int x=0; x<4; x++) {
+          const int v00 = 5*y+x, v10 = v00+1, v01 = v00+5, v11 = v00+6;
+          triangles[2*(4*y+x)+0] = Triangle(v00,v10,v11);
+          triangles[2*(4*y+x)+1] = Triangle(v00,v11,v01);
+          quads[4*y+x] = SceneGraph::QuadMeshNode::Quad(v00,v10,v11,v01);
+        }
+      }
+
       RTCSceneRef scene = rtcDeviceNewScene(device,sflags,to_aflags(imode));
-      int geomID = rtcNewQuadMesh (scene, gflags, 1, 4);
-      rtcSetBuffer(scene, geomID, RTC_VERTEX_BUFFER, vertices , 0, sizeof(Vec3f));
-      rtcSetBuffer(scene, geomID, RTC_INDEX_BUFFER , quads, 0, 4*sizeof(int));
+      unsigned geomID0 = rtcNewTriangleMesh (scene, gflags, 16, 15);
+      rtcSetVertexFormat(scene, geomID0, format, scale, offset);
+      rtcSetBuffer(scene, geomID0, RTC_VERTEX_BUFFER, vertices[0], 0, 3*sizeof(unsigned short));
+      rtcSetBuffer(scene, geomID0, RTC_INDEX_BUFFER, triangles, 0, sizeof(Triangle));
+      unsigned geomID1 = rtcNewQuadMesh (scene, gflags, 8, 15);
+      rtcSetVertexFormat(scene, geomID1, format, scale, offset);
+      rtcSetBuffer(scene, geomID1, RTC_VERTEX_BUFFER, vertices[1], 0, 3*sizeof(unsigned short));
+      rtcSetBuffer(scene, geomID1, RTC_INDEX_BUFFER, quads, 0, sizeof(SceneGraph::QuadMeshNode::Quad));
       rtcCommit (scene);
       AssertNoError(device);
 
-      float u[256], v[256];
       RTCRay rays[256];
       for (size_t i=0; i<256; i++)
       {
-        u[i] = random_float(); 
-        v[i] = random_float();
-        if (u[i] < 0.001f || v[i] < 0.001f || u[i] > 0.999f || v[i] > 0.999f) { u[i] = 0.333f; v[i] = 0.333f; } // avoid hitting edges
-        Vec3fa from(0.0f,0.0f,-1.0f);
-        Vec3fa to = vertices[0] + u[i]*(vertices[1]-vertices[0]) + v[i]*(vertices[3]-vertices[0]);
-        rays[i] = makeRay(from,to-from);
+        const int x = i%4, y = (i/4)%4;
+        const bool upper = (i/16)%2; // selects the triangle above the diagonal of the cell
+        const float dx = upper ? 0.25f : 0.75f, dy = upper ? 0.75f : 0.25f;
+        rays[i] = makeRay(Vec3fa(-2.0f+float(x)+dx,-2.0f+float(y)+dy,-1.0f),Vec3fa(0.0f,0.0f,1.0f));
       }
       IntersectWithMode(imode,ivariant,scene,rays,256);
 
       for (size_t i=0; i<256; i++)
       {
-        if (rays[i].geomID != 0) return VerifyApplication::FAILED;
-        if (ivariant & VARIANT_OCCLUDED) continue;
-        if (rays[i].primID != 0) return VerifyApplication::FAILED;
-        if (abs(rays[i].u - u[i]) > 16.0f*float(ulp)) return VerifyApplication::FAILED;
-        if (abs(rays[i].v - v[i]) > 16.0f*float(ulp)) return VerifyApplication::FAILED;
-        if (abs(rays[i].tfar - 1.0f) > 16.0f*float(ulp)) return VerifyApplication::FAILED;
-
-        const Vec3fa org(rays[i].org[0],rays[i].org[1],rays[i].org[2]);
-        const Vec3fa dir(rays[i].dir[0],rays[i].dir[1],rays[i].dir[2]);
-        const Vec3fa ht  = org + rays[i].tfar*dir;
-        const Vec3fa huv = vertices[0] + rays[i].u*(vertices[1]-vertices[0]) + rays[i].v*(vertices[3]-vertices[0]);
-        if (reduce_max(abs(ht-huv)) > 16.0f*float(ulp)) return VerifyApplication::FAILED;
-        const Vec3fa Ng = normalize(Vec3fa(rays[i].Ng[0],rays[i].Ng[1],rays[i].Ng[2])); // FIXME: some geom normals are scaled!!!??
-        if (reduce_max(abs(Ng - Vec3fa(0.0f,0.0f,-1.0f))) > 16.0f*float(ulp)) return VerifyApplication::FAILED;
+        const int x = i%4, y = (i/4)%4;
+        const bool upper = (i/16)%2;
+        const bool quad = y >= 2;
+        /* occlusion queries only report a hit by setting geomID to 0 */
+        if (ivariant & VARIANT_OCCLUDED) {
+          if (rays[i].geomID != 0) return VerifyApplication::FAILED;
+          continue;
+        }
+        if (rays[i].geomID != (quad ? geomID1 : geomID0)) return VerifyApplication::FAILED;
+        const unsigned primID = quad ? 4*(y-2)+x : 2*(4*y+x)+upper;
+        if (rays[i].primID != primID) return VerifyApplication::FAILED;
+        if (abs(rays[i].tfar - 2.0f) > 1E-5f) return VerifyApplication::FAILED;
       }
       AssertNoError(device);
       
@@ -1844,6 +3359,123 @@ namespace embree
     }
   };
 
+  struct InstanceMasksTest : public VerifyApplication::IntersectTest
+  {
+    RTCSceneFlags sflags; 
+
+    InstanceMasksTest (std::string name, int isa, RTCSceneFlags sflags, IntersectMode imode, IntersectVariant ivariant)
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      error_handler(rtcDeviceGetError(device));
+      if (!supportsIntersectMode(device,imode))
+        return VerifyApplication::SKIPPED;
+
+      bool passed = true;
+      Vec3fa pos[2] = { Vec3fa(-10,0,0), Vec3fa(+10,0,0) };
+
+      VerifyScene object(device,RTC_SCENE_STATIC,to_aflags(imode));
+      object.addSphere(sampler,RTC_GEOMETRY_STATIC,zero,1.0f,50);
+      rtcCommit (object);
+
+      /* both instances share the same scene but get different masks */
+      VerifyScene scene(device,sflags,to_aflags(imode));
+      for (unsigned j=0; j<2; j++)
+      {
+        const float xfm[12] = { 1,0,0, 0,1,0, 0,0,1, pos[j].x,pos[j].y,pos[j].z };
+        unsigned geomID = rtcNewInstance2(scene,object);
+        rtcSetTransform2(scene,geomID,RTC_MATRIX_COLUMN_MAJOR,xfm);
+        rtcSetMask(scene,geomID,1<<j);
+      }
+      rtcCommit (scene);
+      AssertNoError(device);
+      
+      for (unsigned i=0; i<4; i++) 
+      {
+        RTCRay rays[2];
+        for (size_t j=0; j<2; j++) {
+          rays[j] = makeRay(pos[j]+Vec3fa(0,10,0),Vec3fa(0,-1,0));
+          rays[j].mask = i;
+        }
+        IntersectWithMode(imode,ivariant,scene,rays,2);
+        for (size_t j=0; j<2; j++)
+          passed &= i & (1<<j) ? rays[j].geomID != RTC_INVALID_GEOMETRY_ID : rays[j].geomID == RTC_INVALID_GEOMETRY_ID;
+      }
+      AssertNoError(device);
+
+      return (VerifyApplication::TestReturnValue) passed;
+    }
+  };
+
+  struct LargeSceneTest : public VerifyApplication::IntersectTest
+  {
+    LargeSceneTest (std::string name, int isa, IntersectVariant ivariant)
+      : VerifyApplication::IntersectTest(name,isa,MODE_INTERSECT1,ivariant,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    /* sphere, subdivision sphere, and a grid of instanced spheres; both levels use the same scene flags */
+    struct TwoLevelScene
+    {
+      TwoLevelScene (const RTCDeviceRef& device, RTCSceneFlags sflags)
+        : object(device,sflags,RTC_INTERSECT1), scene(device,sflags,RTC_INTERSECT1)
+      {
+        object.addGeometry(RTC_GEOMETRY_STATIC,SceneGraph::createTriangleSphere(zero,0.5f,50),false);
+        rtcCommit (object);
+
+        scene.addGeometry(RTC_GEOMETRY_STATIC,SceneGraph::createTriangleSphere(zero,1.0f,100),false);
+        scene.addGeometry(RTC_GEOMETRY_STATIC,SceneGraph::createSubdivSphere(Vec3fa(0.0f,0.0f,2.5f),1.0f,8,4),false);
+        for (int z=-1; z<=1; z++) {
+          for (int x=-1; x<=1; x++) 
+          {
+            const float xfm[12] = { 1,0,0, 0,1,0, 0,0,1, 3.0f*x,3.0f,3.0f*z };
+            unsigned geomID = rtcNewInstance2(scene,object);
+            rtcSetTransform2(scene,geomID,RTC_MATRIX_COLUMN_MAJOR,xfm);
+          }
+        }
+        rtcCommit (scene);
+      }
+
+      VerifyScene object;
+      VerifyScene scene;
+    };
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      error_handler(rtcDeviceGetError(device));
+      if (!supportsIntersectMode(device,imode))
+        return VerifyApplication::SKIPPED;
+
+      /* the large scene reorders the traversal stack, which has to skip instance and lazy nodes */
+      TwoLevelScene large(device,RTCSceneFlags(RTC_SCENE_STATIC | RTC_SCENE_LARGE));
+      TwoLevelScene small(device,RTC_SCENE_STATIC);
+      AssertNoError(device);
+
+      size_t numHits = 0;
+      for (size_t i=0; i<size_t(1000*state->intensity); i++)
+      {
+        const Vec3fa org = 16.0f*random_Vec3fa()-Vec3fa(8.0f);
+        const Vec3fa dir = 8.0f*random_Vec3fa()-Vec3fa(4.0f)-org;
+        RTCRay ray0 = makeRay(org,dir);
+        RTCRay ray1 = makeRay(org,dir);
+        IntersectWithMode(imode,ivariant,large.scene,&ray0,1);
+        IntersectWithMode(imode,ivariant,small.scene,&ray1,1);
+        if (ray0.geomID != ray1.geomID) return VerifyApplication::FAILED;
+        if (ray1.geomID == RTC_INVALID_GEOMETRY_ID) continue;
+        numHits++;
+        if (ivariant & VARIANT_OCCLUDED) continue;
+        if (ray0.instID != ray1.instID) return VerifyApplication::FAILED;
+        if (ray0.primID != ray1.primID) return VerifyApplication::FAILED;
+        if (abs(ray0.tfar-ray1.tfar) > 1E-4f*ray1.tfar) return VerifyApplication::FAILED;
+      }
+      AssertNoError(device);
+      return numHits ? VerifyApplication::PASSED : VerifyApplication::FAILED;
+    }
+  };
+
   struct BackfaceCullingTest : public VerifyApplication::IntersectTest
   {
     RTCSceneFlags sflags;
@@ -2132,6 +3764,128 @@ namespace embree
     }
   };
 
+  struct LineSpatialSplitTest : public VerifyApplication::IntersectTest
+  {
+    LineSpatialSplitTest (std::string name, int isa, IntersectMode imode)
+      : VerifyApplication::IntersectTest(name,isa,imode,VARIANT_INTERSECT,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    /* long thin segments that cross the whole scene, thus spatial splits cut most of them */
+    unsigned addLines(RTCScene scene, const std::vector<Vec3fa>& vertices, const std::vector<int>& indices)
+    {
+      unsigned geomID = rtcNewLineSegments(scene,RTC_GEOMETRY_STATIC,indices.size(),vertices.size());
+      rtcSetBuffer(scene,geomID,RTC_VERTEX_BUFFER,vertices.data(),0,sizeof(Vec3fa));
+      rtcSetBuffer(scene,geomID,RTC_INDEX_BUFFER,indices.data(),0,sizeof(int));
+      return geomID;
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      error_handler(rtcDeviceGetError(device));
+      if (!supportsIntersectMode(device,imode))
+        return VerifyApplication::SKIPPED;
+
+      const size_t numLines = 1000;
+      std::vector<Vec3fa> vertices;
+      std::vector<int> indices;
+      for (size_t i=0; i<numLines; i++) {
+        indices.push_back(int(vertices.size()));
+        vertices.push_back(Vec3fa(2.0f*random_Vec3fa()-Vec3fa(1.0f),0.01f));
+        vertices.push_back(Vec3fa(2.0f*random_Vec3fa()-Vec3fa(1.0f),0.01f));
+      }
+
+      /* the high quality scene uses the spatial split builder, the static scene serves as reference */
+      VerifyScene scene(device,RTCSceneFlags(RTC_SCENE_STATIC | RTC_SCENE_HIGH_QUALITY),to_aflags(imode));
+      VerifyScene refScene(device,RTC_SCENE_STATIC,RTC_INTERSECT1);
+      addLines(scene,vertices,indices);
+      addLines(refScene,vertices,indices);
+      rtcCommit (scene);
+      rtcCommit (refScene);
+      AssertNoError(device);
+
+      size_t numHits = 0;
+      const size_t M = 64;
+      for (size_t i=0; i<size_t(100*state->intensity); i++)
+      {
+        __aligned(16) RTCRay rays[M];
+        __aligned(16) RTCRay refs[M];
+        for (size_t j=0; j<M; j++) {
+          const Vec3fa org = 4.0f*random_Vec3fa()-Vec3fa(2.0f);
+          const Vec3fa dir = 0.5f*random_Vec3fa()-org;
+          rays[j] = refs[j] = makeRay(org,dir);
+          rtcIntersect(refScene,refs[j]);
+        }
+        IntersectWithMode(imode,VARIANT_INTERSECT,scene,rays,M);
+        for (size_t j=0; j<M; j++) 
+        {
+          if (rays[j].geomID != refs[j].geomID) return VerifyApplication::FAILED;
+          if (refs[j].geomID == RTC_INVALID_GEOMETRY_ID) continue;
+          if (abs(rays[j].tfar-refs[j].tfar) > 1E-4f*refs[j].tfar) return VerifyApplication::FAILED;
+          numHits++;
+        }
+      }
+      AssertNoError(device);
+      return numHits ? VerifyApplication::PASSED : VerifyApplication::FAILED;
+    }
+  };
+
+  struct HairLeafTest : public VerifyApplication::IntersectTest
+  {
+    std::string accel;
+    std::string refAccel;
+
+    HairLeafTest (std::string name, int isa, IntersectMode imode, std::string accel, std::string refAccel)
+      : VerifyApplication::IntersectTest(name,isa,imode,VARIANT_INTERSECT,VerifyApplication::TEST_SHOULD_PASS), accel(accel), refAccel(refAccel) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice((cfg+",hair_accel="+accel).c_str());
+      error_handler(rtcDeviceGetError(device));
+      RTCDeviceRef refDevice = rtcNewDevice((cfg+",hair_accel="+refAccel).c_str());
+      error_handler(rtcDeviceGetError(refDevice));
+      if (!supportsIntersectMode(device,imode))
+        return VerifyApplication::SKIPPED;
+
+      /* the same hairs stored in multi curve leaves and in the single curve reference leaves */
+      const int hash = random_int();
+      VerifyScene scene(device,RTC_SCENE_STATIC,to_aflags(imode));
+      VerifyScene refScene(refDevice,RTC_SCENE_STATIC,RTC_INTERSECT1);
+      scene.addGeometry(RTC_GEOMETRY_STATIC,SceneGraph::createHairyPlane(hash,Vec3fa(-1,0,-1),Vec3fa(2,0,0),Vec3fa(0,0,2),0.5f,0.01f,1000,true),false);
+      refScene.addGeometry(RTC_GEOMETRY_STATIC,SceneGraph::createHairyPlane(hash,Vec3fa(-1,0,-1),Vec3fa(2,0,0),Vec3fa(0,0,2),0.5f,0.01f,1000,true),false);
+      rtcCommit (scene);
+      rtcCommit (refScene);
+      AssertNoError(device);
+      AssertNoError(refDevice);
+
+      size_t numHits = 0;
+      const size_t M = 64;
+      for (size_t i=0; i<size_t(100*state->intensity); i++)
+      {
+        __aligned(16) RTCRay rays[M];
+        __aligned(16) RTCRay refs[M];
+        for (size_t j=0; j<M; j++) {
+          const Vec3fa org = Vec3fa(2.0f*random_float()-1.0f,1.0f,2.0f*random_float()-1.0f);
+          const Vec3fa dir = Vec3fa(0.2f*random_float()-0.1f,-1.0f,0.2f*random_float()-0.1f);
+          rays[j] = refs[j] = makeRay(org,dir);
+          rtcIntersect(refScene,refs[j]);
+        }
+        IntersectWithMode(imode,VARIANT_INTERSECT,scene,rays,M);
+        for (size_t j=0; j<M; j++)
+        {
+          if (rays[j].geomID != refs[j].geomID) return VerifyApplication::FAILED;
+          if (refs[j].geomID == RTC_INVALID_GEOMETRY_ID) continue;
+          if (rays[j].primID != refs[j].primID) return VerifyApplication::FAILED;
+          if (abs(rays[j].tfar-refs[j].tfar) > 1E-4f*refs[j].tfar) return VerifyApplication::FAILED;
+          numHits++;
+        }
+      }
+      AssertNoError(device);
+      return numHits ? VerifyApplication::PASSED : VerifyApplication::FAILED;
+    }
+  };
+
   struct WatertightTest : public VerifyApplication::IntersectTest
   {
     ALIGNED_STRUCT;
@@ -3623,6 +5377,9 @@ namespace embree
 
       groups.top()->add(new UnmappedBeforeCommitTest("unmapped_before_commit",isa));
       groups.top()->add(new GetBoundsTest("get_bounds",isa));
+      groups.top()->add(new UserGeometryLeafTest("user_geometry_leaf",isa));
+      groups.top()->add(new BuildSettingsTest("build_settings_leaf_size_2",isa,2));
+      groups.top()->add(new BuildSettingsTest("build_settings_leaf_size_6",isa,6));
       groups.top()->add(new GetUserDataTest("get_user_data",isa));
 
       push(new TestGroup("buffer_stride",true,true));
@@ -3648,6 +5405,45 @@ namespace embree
       for (auto sflags : sceneFlags) 
         groups.top()->add(new BuildTest(to_string(sflags),isa,sflags,RTC_GEOMETRY_STATIC));
       groups.pop();
+
+      groups.top()->add(new SampledBuildTest("sampled_build",isa));
+
+      push(new TestGroup("build_memory_budget",true,true));
+      groups.top()->add(new BuildMemoryBudgetTest("static",isa,RTC_SCENE_STATIC));
+      groups.top()->add(new BuildMemoryBudgetTest("high_quality",isa,RTCSceneFlags(RTC_SCENE_STATIC | RTC_SCENE_HIGH_QUALITY)));
+      groups.top()->add(new BuildMemoryBudgetTest("spatial_list",isa,RTC_SCENE_STATIC,",tri_accel=bvh4.triangle4,tri_builder=sah_spatial"));
+      groups.pop();
+
+      groups.top()->add(new BuildPriorityTest("build_priority",isa));
+#if defined(TASKING_INTERNAL)
+      groups.top()->add(new BuildPreemptionTest("build_preemption",isa));
+#endif
+
+      push(new TestGroup("commit_many",true,true));
+      for (auto sflags : sceneFlags) 
+        groups.top()->add(new CommitManyTest(to_string(sflags),isa,sflags));
+      groups.pop();
+
+      groups.top()->add(new CaptureTest("capture",isa));
+      groups.top()->add(new DistanceOnlyTest("distance_only",isa));
+      push(new TestGroup("clip_volume",true,true));
+      for (auto imode : intersectModes) 
+        for (auto ivariant : intersectVariants)
+          if (has_variant(imode,ivariant) && imode >= MODE_INTERSECT1M) {
+            groups.top()->add(new ClipVolumeTest("plane."+to_string(imode,ivariant),isa,imode,ivariant,false));
+            groups.top()->add(new ClipVolumeTest("box."+to_string(imode,ivariant),isa,imode,ivariant,true));
+          }
+      groups.top()->add(new ClipVolumeArgumentTest("invalid_argument",isa));
+      groups.pop();
+      groups.top()->add(new IntersectTileTest("intersect_tile",isa));
+      groups.top()->add(new OcclusionCacheTest("occlusion_cache",isa));
+      groups.top()->add(new RayQueueTest("ray_queue",isa));
+
+      push(new TestGroup("build_bvh",true,true));
+      groups.top()->add(new BuildBVHTest("low",isa,RTC_BUILD_QUALITY_LOW));
+      groups.top()->add(new BuildBVHTest("medium",isa,RTC_BUILD_QUALITY_MEDIUM));
+      groups.top()->add(new BuildBVHTest("high",isa,RTC_BUILD_QUALITY_HIGH));
+      groups.pop();
       
       push(new TestGroup("overlapping_primitives",true,true));
       for (auto sflags : sceneFlags)
@@ -3691,6 +5487,11 @@ namespace embree
         groups.top()->add(new InterpolateTrianglesTest(std::to_string((long long)(s)),isa,s));
       groups.pop();
 
+      push(new TestGroup("quads",true,true));
+      for (auto s : interpolateTests) 
+        groups.top()->add(new InterpolateQuadsTest(std::to_string((long long)(s)),isa,s));
+      groups.pop();
+
       push(new TestGroup("subdiv",true,true));
       for (auto s : interpolateTests)
         groups.top()->add(new InterpolateSubdivTest(std::to_string((long long)(s)),isa,s));
@@ -3699,6 +5500,10 @@ namespace embree
       push(new TestGroup("hair",true,true));
       for (auto s : interpolateTests) 
         groups.top()->add(new InterpolateHairTest(std::to_string((long long)(s)),isa,s));
+      for (auto s : interpolateTests) 
+        groups.top()->add(new InterpolateHairTest("bspline_"+std::to_string((long long)(s)),isa,s,RTC_BASIS_BSPLINE));
+      for (auto s : interpolateTests) 
+        groups.top()->add(new InterpolateHairTest("catmull_rom_"+std::to_string((long long)(s)),isa,s,RTC_BASIS_CATMULL_ROM));
       groups.pop();
 
       groups.pop();
@@ -3723,6 +5528,39 @@ namespace embree
                 groups.top()->add(new QuadHitTest(to_string(sflags,imode,ivariant),isa,sflags,RTC_GEOMETRY_STATIC,imode,ivariant));
       groups.pop();
 
+      push(new TestGroup("ribbon_hit",true,true));
+      for (auto sflags : sceneFlags) 
+        for (auto imode : intersectModes) 
+          for (auto ivariant : intersectVariants)
+            if (has_variant(imode,ivariant))
+                groups.top()->add(new RibbonHitTest(to_string(sflags,imode,ivariant),isa,sflags,RTC_GEOMETRY_STATIC,imode,ivariant));
+      groups.pop();
+
+      if (rtcDeviceGetParameter1i(device,RTC_CONFIG_POINT_GEOMETRY))
+      {
+        push(new TestGroup("point_hit",true,true));
+        for (auto sflags : sceneFlags) 
+          for (auto imode : intersectModes) 
+            for (auto ivariant : intersectVariants)
+              if (has_variant(imode,ivariant))
+                groups.top()->add(new PointHitTest(to_string(sflags,imode,ivariant),isa,sflags,RTC_GEOMETRY_STATIC,imode,ivariant));
+        groups.pop();
+      }
+
+      push(new TestGroup("compressed_triangles",true,true));
+      for (auto imode : intersectModes) 
+        groups.top()->add(new CompressedTrianglesTest(to_string(imode),isa,imode));
+      groups.pop();
+
+      push(new TestGroup("vertex_format",true,true));
+      for (auto format : { RTC_VERTEX_FORMAT_HALF3, RTC_VERTEX_FORMAT_FIXED16 })
+        for (auto sflags : sceneFlags) 
+          for (auto imode : intersectModes) 
+            for (auto ivariant : intersectVariants)
+              if (has_variant(imode,ivariant))
+                groups.top()->add(new VertexFormatTest(std::string(format == RTC_VERTEX_FORMAT_HALF3 ? "half." : "fixed16.")+to_string(sflags,imode,ivariant),isa,sflags,RTC_GEOMETRY_STATIC,format,imode,ivariant));
+      groups.pop();
+
       if (rtcDeviceGetParameter1i(device,RTC_CONFIG_RAY_MASK)) 
       {
         push(new TestGroup("ray_masks",true,true));
@@ -3732,8 +5570,22 @@ namespace embree
               if (has_variant(imode,ivariant))
                   groups.top()->add(new RayMasksTest(to_string(sflags,imode,ivariant),isa,sflags,RTC_GEOMETRY_STATIC,imode,ivariant));
         groups.pop();
+
+        push(new TestGroup("instance_masks",true,true));
+        for (auto sflags : sceneFlags) 
+          for (auto imode : intersectModes) 
+            for (auto ivariant : intersectVariants)
+              if (has_variant(imode,ivariant))
+                  groups.top()->add(new InstanceMasksTest(to_string(sflags,imode,ivariant),isa,sflags,imode,ivariant));
+        groups.pop();
       }
       
+      push(new TestGroup("large_scene",true,true));
+      for (auto ivariant : intersectVariants)
+        if (has_variant(MODE_INTERSECT1,ivariant))
+          groups.top()->add(new LargeSceneTest(to_string(MODE_INTERSECT1,ivariant),isa,ivariant));
+      groups.pop();
+
       if (rtcDeviceGetParameter1i(device,RTC_CONFIG_BACKFACE_CULLING)) 
       {
         push(new TestGroup("backface_culling",true,true));
@@ -3789,9 +5641,29 @@ namespace embree
           for (auto imode : intersectModes) 
             for (std::string model : watertightModels) 
               groups.top()->add(new WatertightTest(to_string(sflags,imode)+"."+model,isa,sflags,imode,model,watertight_pos));
+        /* high quality static scenes use spatial splits for quads */
+        const RTCSceneFlags sflags_hq = RTCSceneFlags(RTC_SCENE_STATIC | RTC_SCENE_ROBUST | RTC_SCENE_HIGH_QUALITY);
+        for (auto imode : intersectModes) 
+          for (std::string model : watertightModels) 
+            groups.top()->add(new WatertightTest(to_string(sflags_hq,imode)+"."+model,isa,sflags_hq,imode,model,watertight_pos));
         groups.pop();
       }
 
+      push(new TestGroup("line_spatial_splits",true,true));
+      for (auto imode : intersectModes) 
+        groups.top()->add(new LineSpatialSplitTest(to_string(imode),isa,imode));
+      groups.pop();
+
+      push(new TestGroup("hair_leaves",true,true));
+      for (auto imode : intersectModes) {
+        groups.top()->add(new HairLeafTest("bvh4obb.bezier4v."+to_string(imode),isa,imode,"bvh4obb.bezier4v","bvh4obb.bezier1v"));
+#if defined(__TARGET_AVX__)
+        if ((isa & AVX) == AVX)
+          groups.top()->add(new HairLeafTest("bvh8obb.bezier8v."+to_string(imode),isa,imode,"bvh8obb.bezier8v","bvh8obb.bezier1v"));
+#endif
+      }
+      groups.pop();
+
       push(new TestGroup("watertight_subdiv",true,true)); {
         std::string watertightModels [] = { "sphere.subdiv", "plane.subdiv"};
         const Vec3fa watertight_pos = Vec3fa(148376.0f,1234.0f,-223423.0f);
@@ -3903,6 +5775,12 @@ namespace embree
             groups.top()->add(new IncoherentRaysBenchmark("incoherent."+to_string(gtype)+"_1000k."+to_string(sflags.first,imode.first,imode.second),
                                                           isa,gtype,sflags.first,sflags.second,imode.first,imode.second,501));
 
+      /* out of cache scene traversed with and without the large scene hint */
+      for (auto sflags : { RTC_SCENE_STATIC, RTCSceneFlags(RTC_SCENE_STATIC | RTC_SCENE_LARGE) })
+        for (auto ivariant : { VARIANT_INTERSECT, VARIANT_OCCLUDED })
+          groups.top()->add(new IncoherentRaysBenchmark("incoherent."+to_string(TRIANGLE_MESH)+"_16000k."+to_string(sflags,MODE_INTERSECT1,ivariant),
+                                                        isa,TRIANGLE_MESH,sflags,RTC_GEOMETRY_STATIC,MODE_INTERSECT1,ivariant,2001));
+
       std::vector<std::pair<RTCSceneFlags,RTCGeometryFlags>> benchmark_create_sflags_gflags;
       benchmark_create_sflags_gflags.push_back(std::make_pair(RTC_SCENE_STATIC,RTC_GEOMETRY_STATIC));
       //benchmark_create_sflags_gflags.push_back(std::make_pair(RTC_SCENE_DYNAMIC,RTC_GEOMETRY_STATIC));